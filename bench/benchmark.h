@@ -0,0 +1,740 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include "histogram.h"
+#include "perfcounters.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * MINIMAL GOOGLE-BENCHMARK-STYLE HARNESS
+ *
+ * USAGE (mirrors Google Benchmark so results and habits carry over):
+ *
+ *   static void BM_StackPush(BenchmarkState& state) {
+ *       int n = state.range(0);
+ *       while (state.keepRunning()) { ... }
+ *       state.setItemsProcessed(state.iterations() * n);
+ *   }
+ *   BENCHMARK(BM_StackPush)->range(8, 4096);
+ *
+ *   int main(int argc, char* argv[]) { return runBenchmarks(argc, argv); }
+ *
+ * RUNNER:
+ * - Iteration count grows geometrically until a run lasts --min-time seconds
+ * - Reports wall time and CPU time per iteration plus items per second
+ * - --json FILE writes Google Benchmark compatible JSON
+ * - --filter TEXT runs only benchmarks whose name contains TEXT
+ * - --sizes a,b,c overrides every benchmark's size parameter list
+ * - --perf adds hardware counters (cycles, instructions, L1D/LLC misses,
+ *   branch misses) per operation next to the timings; an operation is one
+ *   processed item when the benchmark sets items, otherwise one iteration.
+ *   Counters run only while the timer runs, so pauseTiming() excludes
+ *   setup work from both. Falls back to timings alone when unavailable.
+ *
+ * SCENARIO BENCHMARKS (fixed amount of work, run once):
+ *
+ *   BenchmarkOptions options(BenchmarkOptions::SCENARIO);
+ *   options.option("--patients", patients);   // declared scenario options
+ *   if (!options.parse(argc, argv)) return 1;
+ *   BenchmarkState state(patients);
+ *   state.begin(); ...work...; state.end();
+ *   results.push_back(benchmarkResult("register", state).counter("hit_ratio", hits));
+ *   results.push_back(latencyResult("search", searchHistogram));
+ *   checks.expect(found == patients, "every patient found");
+ *   return finishBenchmarks(options, results, checks);
+ *
+ * - Results share the Google Benchmark JSON schema of the microbenchmarks;
+ *   scenario figures (percentiles, ratios) are extra per-result counters
+ *   and the declared options are written to the JSON context
+ * - finishBenchmarks() prints "Check: ok" or the failed checks and turns
+ *   them into the exit code
+ */
+
+/**
+ * MONOTONIC NANOSECONDS - timestamps of single operations (latencies)
+ */
+inline long long benchmarkNanos() {
+    return (long long)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * PREVENT THE OPTIMIZER FROM DISCARDING A VALUE
+ */
+template <typename T>
+inline void doNotOptimize(T const& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/**
+ * BENCHMARK STATE - Timing loop and counters for one run
+ */
+class BenchmarkState {
+private:
+    std::vector<long long> arguments;
+    long long maxIterations;
+    long long completed;
+    long long items;
+    bool started;
+    bool paused;
+    std::chrono::steady_clock::time_point wallStart;
+    std::clock_t cpuStart;
+    double wallSeconds;
+    double cpuSeconds;
+    PerfCounters* counters;  ///< Hardware counters (NULL unless --perf)
+
+    void startTimer() {
+        if (counters != NULL) {
+            counters->start();
+        }
+        wallStart = std::chrono::steady_clock::now();
+        cpuStart = std::clock();
+    }
+
+    void stopTimer() {
+        wallSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+        cpuSeconds += (double)(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+        if (counters != NULL) {
+            counters->stop();
+        }
+    }
+
+public:
+    BenchmarkState(const std::vector<long long>& args, long long iterationCount, PerfCounters* perf = NULL)
+        : arguments(args), maxIterations(iterationCount), completed(0), items(0),
+          started(false), paused(false), wallSeconds(0.0), cpuSeconds(0.0), counters(perf) {}
+
+    /**
+     * SCENARIO STATE - iterationCount operations timed with begin()/end()
+     * or with keepRunning()
+     */
+    explicit BenchmarkState(long long iterationCount, PerfCounters* perf = NULL)
+        : maxIterations(iterationCount), completed(0), items(0),
+          started(false), paused(false), wallSeconds(0.0), cpuSeconds(0.0), counters(perf) {}
+
+    /**
+     * TIMED LOOP CONDITION
+     * - Starts the timer on the first call, stops it after the last iteration
+     */
+    bool keepRunning() {
+        if (!started) {
+            started = true;
+            startTimer();
+        } else {
+            completed++;
+        }
+        if (completed < maxIterations) {
+            return true;
+        }
+        if (!paused) {
+            stopTimer();
+        }
+        return false;
+    }
+
+    /**
+     * EXCLUDE SETUP WORK (e.g. refilling a container) FROM THE TIMING
+     */
+    void pauseTiming() {
+        if (!paused) {
+            stopTimer();
+            paused = true;
+        }
+    }
+
+    void resumeTiming() {
+        if (paused) {
+            startTimer();
+            paused = false;
+        }
+    }
+
+    /**
+     * TIME A SCENARIO REGION (instead of the keepRunning() loop)
+     * - The region counts as the iteration count given to the constructor
+     */
+    void begin() {
+        started = true;
+        paused = false;
+        startTimer();
+    }
+
+    void end() {
+        if (started && !paused) {
+            stopTimer();
+            paused = true;
+        }
+        completed = maxIterations;
+    }
+
+    /**
+     * END A REGION WHOSE ITERATION COUNT IS ONLY KNOWN AFTERWARDS
+     */
+    void end(long long iterationCount) {
+        maxIterations = iterationCount;
+        end();
+    }
+
+    long long range(int index) const {
+        return index < (int)arguments.size() ? arguments[index] : 0;
+    }
+
+    long long iterations() const { return maxIterations; }
+    void setItemsProcessed(long long count) { items = count; }
+    long long itemsProcessed() const { return items; }
+    double elapsedWall() const { return wallSeconds; }
+    double elapsedCpu() const { return cpuSeconds; }
+};
+
+typedef void (*BenchmarkFunction)(BenchmarkState&);
+
+/**
+ * REGISTERED BENCHMARK - Name, function and argument lists
+ */
+class Benchmark {
+public:
+    std::string name;
+    BenchmarkFunction function;
+    std::vector<long long> argumentList;
+
+    Benchmark(const std::string& n, BenchmarkFunction f) : name(n), function(f) {}
+
+    /**
+     * ADD ONE SIZE ARGUMENT
+     */
+    Benchmark* arg(long long value) {
+        argumentList.push_back(value);
+        return this;
+    }
+
+    /**
+     * ADD SIZES lo, lo*multiplier, ... up to hi (hi always included)
+     */
+    Benchmark* range(long long lo, long long hi, long long multiplier = 8) {
+        for (long long value = lo; value < hi; value *= multiplier) {
+            argumentList.push_back(value);
+        }
+        argumentList.push_back(hi);
+        return this;
+    }
+};
+
+/**
+ * GLOBAL BENCHMARK REGISTRY
+ */
+inline std::vector<Benchmark*>& benchmarkRegistry() {
+    static std::vector<Benchmark*> registry;
+    return registry;
+}
+
+inline Benchmark* registerBenchmark(const char* name, BenchmarkFunction function) {
+    Benchmark* benchmark = new Benchmark(name, function);
+    benchmarkRegistry().push_back(benchmark);
+    return benchmark;
+}
+
+#define BENCHMARK_CONCAT_INNER(a, b) a##b
+#define BENCHMARK_CONCAT(a, b) BENCHMARK_CONCAT_INNER(a, b)
+#define BENCHMARK(function) \
+    static Benchmark* BENCHMARK_CONCAT(benchmark_registration_, __LINE__) = registerBenchmark(#function, function)
+
+/**
+ * ONE MEASURED RESULT
+ */
+struct BenchmarkResult {
+    std::string name;
+    long long iterations;
+    double realNanosPerIteration;
+    double cpuNanosPerIteration;
+    double itemsPerSecond;
+    bool counted[PerfCounters::COUNTER_COUNT];             ///< Counter was measured
+    double countersPerOperation[PerfCounters::COUNTER_COUNT];
+    std::vector<std::pair<std::string, double> > userCounters;  ///< Extra named figures, in insertion order
+
+    /**
+     * ADD A NAMED FIGURE (written next to the timings)
+     */
+    BenchmarkResult& counter(const std::string& counterName, double value) {
+        userCounters.push_back(std::make_pair(counterName, value));
+        return *this;
+    }
+
+    /**
+     * ADD p50 / p99 / p99.9 / max OF A NANOSECOND HISTOGRAM
+     */
+    BenchmarkResult& latency(const Histogram& histogram, const std::string& prefix = "") {
+        counter(prefix + "p50_ns", (double)histogram.percentile(50.0));
+        counter(prefix + "p99_ns", (double)histogram.percentile(99.0));
+        counter(prefix + "p999_ns", (double)histogram.percentile(99.9));
+        return counter(prefix + "max_ns", (double)histogram.max());
+    }
+};
+
+/**
+ * RESULT OF A TIMED STATE
+ * - Times are per iteration; items per second only when the state set items
+ * - counters: the hardware counters the state ran with (NULL for none)
+ */
+inline BenchmarkResult benchmarkResult(const std::string& name, const BenchmarkState& state,
+                                       PerfCounters* counters = NULL) {
+    BenchmarkResult result;
+    double elapsed = state.elapsedWall();
+    long long iterations = state.iterations() > 0 ? state.iterations() : 1;
+    result.name = name;
+    result.iterations = state.iterations();
+    result.realNanosPerIteration = elapsed * 1e9 / (double)iterations;
+    result.cpuNanosPerIteration = state.elapsedCpu() * 1e9 / (double)iterations;
+    result.itemsPerSecond = state.itemsProcessed() > 0 && elapsed > 0
+                            ? (double)state.itemsProcessed() / elapsed : 0.0;
+    double operations = (double)(state.itemsProcessed() > 0 ? state.itemsProcessed() : iterations);
+    for (int c = 0; c < PerfCounters::COUNTER_COUNT; c++) {
+        result.counted[c] = counters != NULL && counters->available(c);
+        result.countersPerOperation[c] = result.counted[c] ? counters->value(c) / operations : 0.0;
+    }
+    return result;
+}
+
+/**
+ * RESULT OF INDIVIDUALLY TIMED OPERATIONS (a nanosecond histogram)
+ * - One iteration per recorded operation; real_time is the mean latency,
+ *   cpu_time is not measured (0); percentiles as counters
+ */
+inline BenchmarkResult latencyResult(const std::string& name, const Histogram& histogram) {
+    BenchmarkResult result;
+    result.name = name;
+    result.iterations = (long long)histogram.count();
+    result.realNanosPerIteration = histogram.mean();
+    result.cpuNanosPerIteration = 0.0;
+    result.itemsPerSecond = 0.0;
+    for (int c = 0; c < PerfCounters::COUNTER_COUNT; c++) {
+        result.counted[c] = false;
+        result.countersPerOperation[c] = 0.0;
+    }
+    return result.latency(histogram);
+}
+
+/**
+ * RUN ONE BENCHMARK WITH ONE ARGUMENT SET
+ * - Doubles the iteration count (by up to 10x) until minTime is reached
+ * - counters (optional) are reset per attempt; the final attempt's counts
+ *   are reported per operation
+ */
+inline BenchmarkResult runSingleBenchmark(Benchmark* benchmark, const std::vector<long long>& args,
+                                          double minTime, PerfCounters* counters = NULL) {
+    long long iterations = 1;
+    while (true) {
+        if (counters != NULL) {
+            counters->reset();
+        }
+        BenchmarkState state(args, iterations, counters);
+        benchmark->function(state);
+        double elapsed = state.elapsedWall();
+
+        if (elapsed >= minTime || iterations >= 1000000000LL) {
+            std::string name = benchmark->name;
+            for (size_t i = 0; i < args.size(); i++) {
+                name += '/';
+                name += std::to_string(args[i]);
+            }
+            return benchmarkResult(name, state, counters);
+        }
+
+        double factor = elapsed > 0 ? (minTime * 1.4) / elapsed : 10.0;
+        if (factor > 10.0) factor = 10.0;
+        if (factor < 2.0) factor = 2.0;
+        iterations = (long long)((double)iterations * factor);
+    }
+}
+
+/**
+ * WRITE RESULTS AS GOOGLE BENCHMARK JSON
+ * @param context: Extra "key": "value" pairs of the context object
+ *                 (scenario options and their values)
+ */
+inline void writeBenchmarkJson(const std::string& path, const std::vector<BenchmarkResult>& results,
+                               const std::vector<std::pair<std::string, std::string> >& context =
+                                   std::vector<std::pair<std::string, std::string> >()) {
+    std::ofstream file(path.c_str());
+    std::time_t now = std::time(NULL);
+    char date[64];
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    file << "{\n  \"context\": {\n    \"date\": \"" << date << "\",\n";
+    for (size_t i = 0; i < context.size(); i++) {
+        file << "    \"" << context[i].first << "\": \"" << context[i].second << "\",\n";
+    }
+    file << "    \"library_build_type\": \"release\"\n  },\n  \"benchmarks\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchmarkResult& r = results[i];
+        file << std::setprecision(6) << std::fixed;
+        file << "    {\n      \"name\": \"" << r.name << "\",\n"
+             << "      \"run_type\": \"iteration\",\n"
+             << "      \"iterations\": " << r.iterations << ",\n"
+             << "      \"real_time\": " << r.realNanosPerIteration << ",\n"
+             << "      \"cpu_time\": " << r.cpuNanosPerIteration << ",\n"
+             << "      \"time_unit\": \"ns\"";
+        if (r.itemsPerSecond > 0) {
+            file << ",\n      \"items_per_second\": " << r.itemsPerSecond;
+        }
+        for (int c = 0; c < PerfCounters::COUNTER_COUNT; c++) {
+            if (r.counted[c]) {
+                file << ",\n      \"" << PerfCounters::name(c) << "_per_op\": " << r.countersPerOperation[c];
+            }
+        }
+        for (size_t u = 0; u < r.userCounters.size(); u++) {
+            file << ",\n      \"" << r.userCounters[u].first << "\": " << r.userCounters[u].second;
+        }
+        file << "\n    }" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    file << "  ]\n}\n";
+}
+
+/**
+ * HARNESS OPTIONS
+ * - MICROBENCHMARKS (runBenchmarks): --min-time, --json, --filter,
+ *   --sizes and --perf
+ * - SCENARIO: --json plus the options the benchmark declares with
+ *   option() / flag(); a list option given on the command line replaces
+ *   its defaults
+ */
+class BenchmarkOptions {
+public:
+    enum Mode { MICROBENCHMARKS, SCENARIO };
+
+private:
+    enum OptionType { INTEGER, LONG_INTEGER, REAL, TEXT, INTEGER_LIST, FLAG };
+
+    /**
+     * DECLARED SCENARIO OPTION - target points at the benchmark's variable
+     */
+    struct Declared {
+        std::string name;
+        OptionType type;
+        void* target;
+        bool given;
+    };
+
+    Mode mode;
+    std::vector<Declared> declared;
+
+    void declare(const std::string& name, OptionType type, void* target) {
+        Declared option;
+        option.name = name;
+        option.type = type;
+        option.target = target;
+        option.given = false;
+        declared.push_back(option);
+    }
+
+    /**
+     * STORE value INTO A DECLARED OPTION
+     */
+    static void assign(Declared& option, const std::string& value) {
+        switch (option.type) {
+            case INTEGER: *(int*)option.target = std::atoi(value.c_str()); break;
+            case LONG_INTEGER: *(long long*)option.target = std::atoll(value.c_str()); break;
+            case REAL: *(double*)option.target = std::atof(value.c_str()); break;
+            case TEXT: *(std::string*)option.target = value; break;
+            case INTEGER_LIST: {
+                std::vector<int>& list = *(std::vector<int>*)option.target;
+                if (!option.given) {
+                    list.clear();
+                }
+                std::stringstream fields(value);
+                std::string field;
+                while (std::getline(fields, field, ',')) {
+                    list.push_back(std::atoi(field.c_str()));
+                }
+                break;
+            }
+            case FLAG: break;
+        }
+        option.given = true;
+    }
+
+    static std::string describe(const Declared& option) {
+        std::ostringstream text;
+        switch (option.type) {
+            case INTEGER: text << *(const int*)option.target; break;
+            case LONG_INTEGER: text << *(const long long*)option.target; break;
+            case REAL: text << *(const double*)option.target; break;
+            case TEXT: text << *(const std::string*)option.target; break;
+            case INTEGER_LIST: {
+                const std::vector<int>& list = *(const std::vector<int>*)option.target;
+                for (size_t i = 0; i < list.size(); i++) {
+                    text << (i > 0 ? "," : "") << list[i];
+                }
+                break;
+            }
+            case FLAG: text << (*(const bool*)option.target ? "true" : "false"); break;
+        }
+        return text.str();
+    }
+
+public:
+    double minTime;
+    std::string jsonPath;
+    std::string filter;
+    std::vector<long long> sizes;
+    bool perf;
+
+    explicit BenchmarkOptions(Mode harnessMode = MICROBENCHMARKS)
+        : mode(harnessMode), minTime(0.2), perf(false) {}
+
+    /**
+     * DECLARE A SCENARIO OPTION "--name VALUE" STORED INTO target
+     * - target keeps its value when the option is not given
+     */
+    void option(const std::string& name, int& target) { declare(name, INTEGER, &target); }
+    void option(const std::string& name, long long& target) { declare(name, LONG_INTEGER, &target); }
+    void option(const std::string& name, double& target) { declare(name, REAL, &target); }
+    void option(const std::string& name, std::string& target) { declare(name, TEXT, &target); }
+    void option(const std::string& name, std::vector<int>& target) { declare(name, INTEGER_LIST, &target); }
+
+    /**
+     * DECLARE A SCENARIO SWITCH "--name" (no value) SETTING target TO true
+     */
+    void flag(const std::string& name, bool& target) { declare(name, FLAG, &target); }
+
+    /**
+     * PARSE THE COMMAND LINE
+     * @return false (after printing a message) on an unknown option or a
+     *         missing value
+     */
+    bool parse(int argc, char* argv[]) {
+        for (int i = 1; i < argc; i++) {
+            std::string option = argv[i];
+            Declared* match = NULL;
+            for (size_t d = 0; d < declared.size(); d++) {
+                if (declared[d].name == option) {
+                    match = &declared[d];
+                }
+            }
+            if (match != NULL && match->type == FLAG) {
+                *(bool*)match->target = true;
+                match->given = true;
+                continue;
+            }
+            if (mode == MICROBENCHMARKS && option == "--perf") {
+                perf = true;
+                continue;
+            }
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for option " << option << std::endl;
+                return false;
+            }
+            std::string value = argv[++i];
+            if (match != NULL) {
+                assign(*match, value);
+            } else if (option == "--json") {
+                jsonPath = value;
+            } else if (mode == MICROBENCHMARKS && option == "--min-time") {
+                minTime = std::atof(value.c_str());
+            } else if (mode == MICROBENCHMARKS && option == "--filter") {
+                filter = value;
+            } else if (mode == MICROBENCHMARKS && option == "--sizes") {
+                std::stringstream fields(value);
+                std::string field;
+                while (std::getline(fields, field, ',')) {
+                    sizes.push_back(std::atoll(field.c_str()));
+                }
+            } else {
+                std::cerr << "Unknown benchmark option " << option << std::endl;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * DECLARED OPTIONS AND THEIR VALUES, FOR THE JSON CONTEXT
+     */
+    std::vector<std::pair<std::string, std::string> > context() const {
+        std::vector<std::pair<std::string, std::string> > values;
+        for (size_t d = 0; d < declared.size(); d++) {
+            values.push_back(std::make_pair(declared[d].name.substr(2), describe(declared[d])));
+        }
+        return values;
+    }
+};
+
+/**
+ * CORRECTNESS CHECKS OF A SCENARIO BENCHMARK
+ * - A benchmark whose result is wrong must not report a speed: every
+ *   check that fails is listed and makes the process exit with 1
+ */
+class BenchmarkChecks {
+private:
+    std::vector<std::string> failures;
+    int checked;
+
+public:
+    BenchmarkChecks() : checked(0) {}
+
+    /**
+     * RECORD what AS FAILED UNLESS condition HOLDS
+     * @return condition, for per-row "ok" / "BROKEN" columns
+     */
+    bool expect(bool condition, const std::string& what) {
+        checked++;
+        if (!condition) {
+            failures.push_back(what);
+        }
+        return condition;
+    }
+
+    bool passed() const { return failures.empty(); }
+
+    /**
+     * PRINT "Check: ok" OR "Check: BROKEN" WITH EVERY FAILURE (nothing
+     * when the benchmark checks nothing)
+     * @return Process exit code
+     */
+    int report() const {
+        if (checked == 0) {
+            return 0;
+        }
+        std::cout << "Check: " << (failures.empty() ? "ok" : "BROKEN") << std::endl;
+        for (size_t i = 0; i < failures.size(); i++) {
+            std::cout << "  failed: " << failures[i] << std::endl;
+        }
+        return failures.empty() ? 0 : 1;
+    }
+};
+
+/**
+ * TITLE BANNER OF A SCENARIO REPORT
+ */
+inline void printBenchmarkBanner(const std::string& title) {
+    std::cout << "\n==================================================" << std::endl;
+    std::cout << "       " << title << std::endl;
+    std::cout << "==================================================" << std::endl;
+}
+
+/**
+ * END OF A SCENARIO BENCHMARK - checks, then the JSON file (if asked for)
+ * @return Process exit code (1 when a check failed)
+ */
+inline int finishBenchmarks(const BenchmarkOptions& options, const std::vector<BenchmarkResult>& results,
+                            const BenchmarkChecks& checks = BenchmarkChecks()) {
+    int status = checks.report();
+    if (!options.jsonPath.empty()) {
+        writeBenchmarkJson(options.jsonPath, results, options.context());
+        std::cout << "Results written to " << options.jsonPath << std::endl;
+    }
+    return status;
+}
+
+/**
+ * PRINT PER-OPERATION COUNTERS ("n/a" for events the PMU lacks)
+ */
+inline void printCounterColumns(const BenchmarkResult& result) {
+    for (int c = 0; c < PerfCounters::COUNTER_COUNT; c++) {
+        if (c == PerfCounters::L1D_MISSES) {
+            bool ipc = result.counted[PerfCounters::CYCLES] && result.counted[PerfCounters::INSTRUCTIONS]
+                       && result.countersPerOperation[PerfCounters::CYCLES] > 0;
+            if (ipc) {
+                std::cout << std::setw(8) << std::setprecision(2)
+                          << result.countersPerOperation[PerfCounters::INSTRUCTIONS]
+                             / result.countersPerOperation[PerfCounters::CYCLES];
+            } else {
+                std::cout << std::setw(8) << "n/a";
+            }
+        }
+        if (result.counted[c]) {
+            std::cout << std::setw(12) << std::setprecision(c >= PerfCounters::L1D_MISSES ? 3 : 1)
+                      << result.countersPerOperation[c];
+        } else {
+            std::cout << std::setw(12) << "n/a";
+        }
+    }
+}
+
+/**
+ * RUN EVERY REGISTERED BENCHMARK
+ * @return Process exit code
+ */
+inline int runBenchmarks(int argc, char* argv[]) {
+    BenchmarkOptions options;
+    if (!options.parse(argc, argv)) {
+        return 1;
+    }
+
+    PerfCounters counters;
+    PerfCounters* perf = NULL;
+    if (options.perf) {
+        if (counters.open()) {
+            perf = &counters;
+        } else {
+            std::cout << "[WARNING] Hardware counters unavailable (" << counters.error()
+                      << "); reporting timings only" << std::endl;
+        }
+    }
+
+    std::vector<BenchmarkResult> results;
+    std::cout << std::left << std::setw(48) << "Benchmark" << std::right
+              << std::setw(14) << "Time (ns)" << std::setw(14) << "CPU (ns)"
+              << std::setw(14) << "Iterations" << std::setw(16) << "Items/s";
+    if (perf != NULL) {
+        std::cout << std::setw(12) << "Cycles/op" << std::setw(12) << "Instr/op" << std::setw(8) << "IPC"
+                  << std::setw(12) << "L1D-miss/op" << std::setw(12) << "LLC-miss/op" << std::setw(12) << "Br-miss/op";
+    }
+    std::cout << std::endl;
+    std::cout << std::string(perf != NULL ? 174 : 106, '-') << std::endl;
+
+    std::vector<Benchmark*>& registry = benchmarkRegistry();
+    for (size_t b = 0; b < registry.size(); b++) {
+        Benchmark* benchmark = registry[b];
+        if (!options.filter.empty() && benchmark->name.find(options.filter) == std::string::npos) {
+            continue;
+        }
+        std::vector<long long> sizes = benchmark->argumentList;
+        if (!options.sizes.empty() && !sizes.empty()) {
+            sizes = options.sizes;
+        }
+        if (sizes.empty()) {
+            sizes.push_back(-1);  // Marker: benchmark takes no argument
+        }
+
+        for (size_t s = 0; s < sizes.size(); s++) {
+            std::vector<long long> args;
+            if (sizes[s] >= 0) {
+                args.push_back(sizes[s]);
+            }
+            BenchmarkResult result = runSingleBenchmark(benchmark, args, options.minTime, perf);
+            results.push_back(result);
+
+            std::cout << std::left << std::setw(48) << result.name << std::right << std::fixed
+                      << std::setprecision(1) << std::setw(14) << result.realNanosPerIteration
+                      << std::setw(14) << result.cpuNanosPerIteration
+                      << std::setw(14) << result.iterations;
+            if (result.itemsPerSecond > 0) {
+                std::cout << std::setw(15) << std::setprecision(2) << result.itemsPerSecond / 1e6 << "M";
+            } else if (perf != NULL) {
+                std::cout << std::setw(16) << "";
+            }
+            if (perf != NULL) {
+                printCounterColumns(result);
+            }
+            std::cout << std::endl;
+        }
+    }
+
+    if (!options.jsonPath.empty()) {
+        writeBenchmarkJson(options.jsonPath, results);
+        std::cout << "\nResults written to " << options.jsonPath << std::endl;
+    }
+    return 0;
+}
+
+#endif
@@ -0,0 +1,428 @@
+#include "benchmark.h"
+#include "array.h"
+#include "list.h"
+#include "stack.h"
+#include "circularqueue.h"
+#include "priorityqueue.h"
+#include "patient.h"
+#include <functional>
+#include <random>
+#include <vector>
+
+/**
+ * CONTAINER MICROBENCHMARKS
+ *
+ * Every operation of the engine's data structures, parameterized by the
+ * container size n. Batch benchmarks (build n, drain n) report items/s so
+ * per-element cost can be compared across sizes; steady-state benchmarks
+ * keep the size at n and time a single operation per iteration.
+ *
+ * CONTIGUOUS BASELINES: List and CircularQueue allocate one node per
+ * element. The RingBuffer benchmarks run the same access patterns over a
+ * contiguous buffer so --perf can attribute the gap to cache and branch
+ * misses rather than instruction count.
+ */
+
+/**
+ * PATIENT FIXTURE - n patients with a TRIAGE mix and sequential IDs
+ */
+class PatientFixture {
+public:
+    std::vector<Patient*> patients;
+
+    explicit PatientFixture(long long n) {
+        std::mt19937 rng(7);
+        for (long long i = 0; i < n; i++) {
+            patients.push_back(new Patient((int)i + 1, "Patient", 40, 1 + (int)(rng() % 5), "Fever"));
+        }
+    }
+
+    ~PatientFixture() {
+        for (size_t i = 0; i < patients.size(); i++) {
+            delete patients[i];
+        }
+    }
+};
+
+/**
+ * RING BUFFER BASELINE - Contiguous FIFO, doubles when full
+ * - Constructed with capacity n it never grows (CircularQueue analogue)
+ * - Constructed small it is an array backend for List's FIFO usage
+ */
+template <typename T>
+class RingBuffer {
+private:
+    T* slots;
+    long long capacity;
+    long long head;
+    long long count;
+
+    void grow() {
+        T* larger = new T[(size_t)(capacity * 2)];
+        for (long long i = 0; i < count; i++) {
+            larger[i] = slots[(head + i) % capacity];
+        }
+        delete[] slots;
+        slots = larger;
+        capacity *= 2;
+        head = 0;
+    }
+
+public:
+    explicit RingBuffer(long long cap) : slots(new T[(size_t)cap]), capacity(cap), head(0), count(0) {}
+    ~RingBuffer() { delete[] slots; }
+
+    void push(T value) {
+        if (count == capacity) {
+            grow();
+        }
+        long long tail = head + count;
+        slots[tail >= capacity ? tail - capacity : tail] = value;
+        count++;
+    }
+
+    T pop() {
+        T value = slots[head];
+        head = head + 1 == capacity ? 0 : head + 1;
+        count--;
+        return value;
+    }
+};
+
+/**
+ * HEAP SCATTER - Interleaves odd-sized allocations between container
+ * nodes, the way patient records and strings interleave in the engine
+ */
+class HeapScatter {
+private:
+    std::vector<char*> blocks;
+    std::mt19937 rng;
+
+public:
+    HeapScatter() : rng(11) {}
+
+    ~HeapScatter() {
+        for (size_t i = 0; i < blocks.size(); i++) {
+            delete[] blocks[i];
+        }
+    }
+
+    void allocate() {
+        blocks.push_back(new char[16 + rng() % 240]);
+    }
+};
+
+static std::vector<int> randomValues(long long n) {
+    std::mt19937 rng(42);
+    std::vector<int> values((size_t)n);
+    for (size_t i = 0; i < values.size(); i++) {
+        values[i] = (int)(rng() % 1000000);
+    }
+    return values;
+}
+
+// ==================== ARRAY ====================
+
+/**
+ * ARRAY INSERT AT FRONT - O(n) shift, size held at n
+ */
+static void BM_ArrayInsertFront(BenchmarkState& state) {
+    long long n = state.range(0);
+    Array<int> array(16);
+    for (long long i = 0; i < n; i++) {
+        array.append((int)i);
+    }
+    while (state.keepRunning()) {
+        array.insert(0, 1);
+        array.remove(array.len() - 1);
+    }
+    doNotOptimize(array[0]);
+}
+BENCHMARK(BM_ArrayInsertFront)->range(8, 4096);
+
+/**
+ * ARRAY APPEND - Build n elements (includes golden-ratio growth)
+ */
+static void BM_ArrayAppend(BenchmarkState& state) {
+    long long n = state.range(0);
+    while (state.keepRunning()) {
+        Array<int> array(16);
+        for (long long i = 0; i < n; i++) {
+            array.append((int)i);
+        }
+        doNotOptimize(array.len());
+    }
+    state.setItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_ArrayAppend)->range(8, 4096);
+
+/**
+ * ARRAY REMOVE FROM FRONT - O(n) shift, size held at n
+ */
+static void BM_ArrayRemoveFront(BenchmarkState& state) {
+    long long n = state.range(0);
+    Array<int> array(16);
+    for (long long i = 0; i < n; i++) {
+        array.append((int)i);
+    }
+    while (state.keepRunning()) {
+        array.remove(0);
+        array.append(1);
+    }
+    doNotOptimize(array[0]);
+}
+BENCHMARK(BM_ArrayRemoveFront)->range(8, 4096);
+
+/**
+ * ARRAY MERGE SORT - Random integers, refill excluded from timing
+ */
+static void BM_ArraySort(BenchmarkState& state) {
+    long long n = state.range(0);
+    std::vector<int> values = randomValues(n);
+    Array<int> array((int)n + 2);
+    for (long long i = 0; i < n; i++) {
+        array.append(values[(size_t)i]);
+    }
+    while (state.keepRunning()) {
+        state.pauseTiming();
+        for (long long i = 0; i < n; i++) {
+            array[(int)i] = values[(size_t)i];
+        }
+        state.resumeTiming();
+        array.sort();
+    }
+    doNotOptimize(array[0]);
+    state.setItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_ArraySort)->range(8, 4096);
+
+// ==================== LIST ====================
+
+/**
+ * LIST ADD + POP - n FIFO insertions followed by n removals
+ */
+static void BM_ListAddPop(BenchmarkState& state) {
+    long long n = state.range(0);
+    List<int> list;
+    while (state.keepRunning()) {
+        for (long long i = 0; i < n; i++) {
+            list.add((int)i);
+        }
+        for (long long i = 0; i < n; i++) {
+            doNotOptimize(list.pop());
+        }
+    }
+    state.setItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_ListAddPop)->range(8, 4096);
+
+/**
+ * LIST MERGE SORT - Random integers, rebuild excluded from timing
+ */
+static void BM_ListSort(BenchmarkState& state) {
+    long long n = state.range(0);
+    std::vector<int> values = randomValues(n);
+    List<int> list;
+    while (state.keepRunning()) {
+        state.pauseTiming();
+        list.clear();
+        for (long long i = 0; i < n; i++) {
+            list.add(values[(size_t)i]);
+        }
+        state.resumeTiming();
+        list.sort();
+    }
+    doNotOptimize(list.peek());
+    state.setItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_ListSort)->range(8, 4096);
+
+/**
+ * LIST SCAN - Worst-case contains() over n nodes on a fragmented heap
+ */
+static void BM_ListScan(BenchmarkState& state) {
+    long long n = state.range(0);
+    HeapScatter scatter;
+    List<int> list;
+    for (long long i = 0; i < n; i++) {
+        list.add((int)i);
+        scatter.allocate();
+    }
+    std::function<bool(int)> absent = [](int value) { return value < 0; };
+    while (state.keepRunning()) {
+        doNotOptimize(list.contains(absent));
+    }
+    state.setItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_ListScan)->range(64, 262144, 64);
+
+/**
+ * ARRAY SCAN - Same predicate over the contiguous backend (baseline)
+ */
+static void BM_ArrayScan(BenchmarkState& state) {
+    long long n = state.range(0);
+    Array<int> array((int)n + 2);
+    for (long long i = 0; i < n; i++) {
+        array.append((int)i);
+    }
+    std::function<bool(int)> absent = [](int value) { return value < 0; };
+    while (state.keepRunning()) {
+        bool found = false;
+        for (int i = 0; i < array.len() && !found; i++) {
+            found = absent(array[i]);
+        }
+        doNotOptimize(found);
+    }
+    state.setItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_ArrayScan)->range(64, 262144, 64);
+
+/**
+ * ARRAY BACKEND ADD + POP - BM_ListAddPop over a growable ring (baseline)
+ */
+static void BM_ArrayBackendAddPop(BenchmarkState& state) {
+    long long n = state.range(0);
+    RingBuffer<int> queue(16);
+    while (state.keepRunning()) {
+        for (long long i = 0; i < n; i++) {
+            queue.push((int)i);
+        }
+        for (long long i = 0; i < n; i++) {
+            doNotOptimize(queue.pop());
+        }
+    }
+    state.setItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_ArrayBackendAddPop)->range(8, 4096);
+
+// ==================== STACK ====================
+
+/**
+ * STACK PUSH - n pushes, then clear (clear included)
+ */
+static void BM_StackPush(BenchmarkState& state) {
+    long long n = state.range(0);
+    Stack<int> stack;
+    while (state.keepRunning()) {
+        for (long long i = 0; i < n; i++) {
+            stack.add((int)i);
+        }
+        stack.clear();
+    }
+    state.setItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_StackPush)->range(8, 4096);
+
+/**
+ * STACK CONTAINS - Worst case (absent element) over n entries
+ */
+static void BM_StackContains(BenchmarkState& state) {
+    long long n = state.range(0);
+    Stack<int> stack;
+    for (long long i = 0; i < n; i++) {
+        stack.add((int)i);
+    }
+    while (state.keepRunning()) {
+        doNotOptimize(stack.contains(-1));
+    }
+    state.setItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_StackContains)->range(8, 4096);
+
+// ==================== CIRCULAR QUEUE ====================
+
+/**
+ * CIRCULAR QUEUE ENQUEUE + DEQUEUE - Fill to capacity n, then drain
+ */
+static void BM_CircularQueueEnqueueDequeue(BenchmarkState& state) {
+    long long n = state.range(0);
+    CircularQueue<int> queue((int)n);
+    while (state.keepRunning()) {
+        for (long long i = 0; i < n; i++) {
+            queue.enqueue((int)i);
+        }
+        for (long long i = 0; i < n; i++) {
+            doNotOptimize(queue.dequeue());
+        }
+    }
+    state.setItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_CircularQueueEnqueueDequeue)->range(8, 4096);
+
+/**
+ * RING BUFFER ENQUEUE + DEQUEUE - Fixed capacity n, contiguous (baseline)
+ */
+static void BM_RingBufferEnqueueDequeue(BenchmarkState& state) {
+    long long n = state.range(0);
+    RingBuffer<int> queue(n);
+    while (state.keepRunning()) {
+        for (long long i = 0; i < n; i++) {
+            queue.push((int)i);
+        }
+        for (long long i = 0; i < n; i++) {
+            doNotOptimize(queue.pop());
+        }
+    }
+    state.setItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_RingBufferEnqueueDequeue)->range(8, 4096);
+
+/**
+ * CIRCULAR QUEUE FIND PATIENT ROOM - Target in the last occupied room
+ */
+static void BM_CircularQueueFindPatientRoom(BenchmarkState& state) {
+    long long n = state.range(0);
+    PatientFixture fixture(n);
+    CircularQueue<Patient*> rooms((int)n);
+    for (long long i = 0; i < n; i++) {
+        rooms.enqueue(fixture.patients[(size_t)i]);
+    }
+    int target = (int)n;
+    while (state.keepRunning()) {
+        doNotOptimize(rooms.findPatientRoom(target));
+    }
+    state.setItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_CircularQueueFindPatientRoom)->range(8, 4096);
+
+// ==================== PRIORITY QUEUE ====================
+
+/**
+ * PRIORITY QUEUE ADD + POP - n mixed-level patients in, n out
+ */
+static void BM_PriorityQueueAddPop(BenchmarkState& state) {
+    long long n = state.range(0);
+    PatientFixture fixture(n);
+    PriorityQueue<Patient*> triage;
+    while (state.keepRunning()) {
+        for (long long i = 0; i < n; i++) {
+            triage.add(fixture.patients[(size_t)i]);
+        }
+        for (long long i = 0; i < n; i++) {
+            doNotOptimize(triage.pop());
+        }
+    }
+    state.setItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_PriorityQueueAddPop)->range(8, 4096);
+
+/**
+ * PRIORITY QUEUE CONTAINS - Worst case (absent ID) over n waiting patients
+ */
+static void BM_PriorityQueueContains(BenchmarkState& state) {
+    long long n = state.range(0);
+    PatientFixture fixture(n);
+    PriorityQueue<Patient*> triage;
+    for (long long i = 0; i < n; i++) {
+        triage.add(fixture.patients[(size_t)i]);
+    }
+    while (state.keepRunning()) {
+        doNotOptimize(triage.contains(-1));
+    }
+    state.setItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_PriorityQueueContains)->range(8, 4096);
+
+int main(int argc, char* argv[]) {
+    return runBenchmarks(argc, argv);
+}
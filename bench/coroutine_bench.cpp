@@ -0,0 +1,168 @@
+#include "asyncengine.h"
+#include "benchmark.h"
+#include "hospitalsystem.h"
+#include <condition_variable>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * COROUTINE ENGINE BENCHMARK
+ *
+ * Each visitor repeats a visit: register -> wait for a free room -> attend
+ * -> free. With far more visitors than rooms most of them are waiting for
+ * a room at any moment. Two implementations of the same visitors:
+ * - coroutine: one coroutine per visitor on AsyncHospitalEngine's fixed
+ *   pool (--threads workers); waiting visitors are parked frames
+ * - thread: one OS thread per visitor over a mutex-guarded HospitalSystem;
+ *   waiting visitors block on a condition variable (skipped above
+ *   --max-threads visitors)
+ *
+ * OPTIONS: --visits N (total, default 100000), --visitors 10,100,1000,10000,
+ *          --rooms R (10), --threads T (2), --max-threads M (1000),
+ *          --json FILE
+ */
+
+struct RunResult {
+    std::string mode;
+    int visitors;
+    int threads;
+    long long roomWaits;
+    BenchmarkResult measured;  ///< Visits per second plus threads and room waits
+};
+
+static HospitalTask visitorCoroutine(AsyncHospitalEngine& engine, int visitor, long long visits) {
+    for (long long v = 0; v < visits; v++) {
+        co_await engine.registerPatient("Desk Patient", 40, 1 + (int)((v + visitor) % 5), "Fever");
+        PatientSnapshot attended;
+        do {
+            co_await engine.waitForFreeRoom();
+            attended = co_await engine.attendNext();
+        } while (!attended.found);
+        co_await engine.freeRoom();
+    }
+}
+
+/**
+ * BLOCKING BASELINE - The same visit with one thread per visitor
+ */
+struct BlockingHospital {
+    HospitalSystem system;
+    std::mutex lock;
+    std::condition_variable roomFreed;
+    long long roomWaits;
+
+    explicit BlockingHospital(int rooms) : system(rooms, false), roomWaits(0) {}
+};
+
+static void visitorThread(BlockingHospital& hospital, int visitor, long long visits) {
+    for (long long v = 0; v < visits; v++) {
+        {
+            std::lock_guard<std::mutex> guard(hospital.lock);
+            hospital.system.registerPatient("Desk Patient", 40, 1 + (int)((v + visitor) % 5), "Fever");
+        }
+        {
+            std::unique_lock<std::mutex> guard(hospital.lock);
+            while (true) {
+                SystemStatus current = hospital.system.status();
+                if (current.inConsultation < current.rooms) break;
+                hospital.roomWaits++;
+                hospital.roomFreed.wait(guard);
+            }
+            hospital.system.attendNextPatient();
+        }
+        {
+            std::lock_guard<std::mutex> guard(hospital.lock);
+            hospital.system.freeConsultationRoom();
+        }
+        hospital.roomFreed.notify_one();
+    }
+}
+
+static RunResult runMode(const std::string& mode, int visitors, long long visits, int rooms, int threads) {
+    RunResult result;
+    result.mode = mode;
+    result.visitors = visitors;
+    long long perVisitor = visits / visitors > 0 ? visits / visitors : 1;
+    long long total = perVisitor * visitors;
+
+    BenchmarkState state(total);
+    state.begin();
+    if (mode == "coroutine") {
+        AsyncHospitalEngine engine(rooms, threads);
+        for (int v = 0; v < visitors; v++) {
+            engine.spawn(visitorCoroutine(engine, v, perVisitor));
+        }
+        engine.drain();
+        result.roomWaits = engine.roomWaits();
+        result.threads = threads;
+    } else {
+        BlockingHospital hospital(rooms);
+        std::vector<std::thread> pool;
+        for (int v = 0; v < visitors; v++) {
+            pool.push_back(std::thread(visitorThread, std::ref(hospital), v, perVisitor));
+        }
+        for (size_t t = 0; t < pool.size(); t++) {
+            pool[t].join();
+        }
+        result.roomWaits = hospital.roomWaits;
+        result.threads = visitors;
+    }
+    state.end();
+    state.setItemsProcessed(total);
+    result.measured = benchmarkResult(mode + "/visitors:" + std::to_string(visitors), state)
+                          .counter("threads", result.threads)
+                          .counter("room_waits", (double)result.roomWaits);
+    return result;
+}
+
+int main(int argc, char* argv[]) {
+    long long visits = 100000;
+    int rooms = 10;
+    int threads = 2;
+    int maxThreads = 1000;
+    std::vector<int> visitorCounts = {10, 100, 1000, 10000};
+
+    BenchmarkOptions options(BenchmarkOptions::SCENARIO);
+    options.option("--visits", visits);
+    options.option("--visitors", visitorCounts);
+    options.option("--rooms", rooms);
+    options.option("--threads", threads);
+    options.option("--max-threads", maxThreads);
+    if (!options.parse(argc, argv)) {
+        return 1;
+    }
+    if (visits <= 0 || threads <= 0 || rooms < 2) {
+        std::cerr << "--visits and --threads must be positive, --rooms must be >= 2" << std::endl;
+        return 1;
+    }
+
+    std::vector<RunResult> runs;
+    for (size_t i = 0; i < visitorCounts.size(); i++) {
+        if (visitorCounts[i] <= 0) continue;
+        runs.push_back(runMode("coroutine", visitorCounts[i], visits, rooms, threads));
+        if (visitorCounts[i] <= maxThreads) {
+            runs.push_back(runMode("thread", visitorCounts[i], visits, rooms, threads));
+        }
+    }
+
+    printBenchmarkBanner("COROUTINE ENGINE BENCHMARK");
+    std::cout << "Visits: " << visits << " | Rooms: " << rooms << " | Pool threads: " << threads
+              << " | Hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+    std::cout << "\n" << std::left << std::setw(11) << "Mode" << std::right << std::setw(10) << "Visitors"
+              << std::setw(10) << "Threads" << std::setw(12) << "Visits/s" << std::setw(13) << "Room waits" << std::endl;
+    std::vector<BenchmarkResult> results;
+    for (size_t i = 0; i < runs.size(); i++) {
+        const RunResult& r = runs[i];
+        results.push_back(r.measured);
+        std::cout << std::left << std::setw(11) << r.mode << std::right << std::setw(10) << r.visitors
+                  << std::setw(10) << r.threads << std::fixed << std::setprecision(0) << std::setw(12)
+                  << r.measured.itemsPerSecond << std::setw(13) << r.roomWaits << std::endl;
+    }
+    std::cout << "==================================================" << std::endl;
+
+    return finishBenchmarks(options, results);
+}
@@ -0,0 +1,176 @@
+#include "benchmark.h"
+#include "hospitaldispatcher.h"
+#include <atomic>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * DISPATCH WAKE-UP LATENCY BENCHMARK
+ *
+ * D dispatcher threads wait for work while a producer thread triggers one
+ * dispatch per round and waits until it has happened:
+ * - patient scenario: rooms are plentiful, the trigger is a registration
+ * - room scenario: triage is preloaded and every room is occupied, the
+ *   trigger is freeConsultationRoom()
+ *
+ * LATENCY: trigger call -> dispatcher holding the attended patient, in an
+ * HDR histogram. Two dispatcher implementations are compared:
+ * - condvar: HospitalDispatcher::waitAndAttend (blocking, notify_one)
+ * - poll: tryAttend() then sleep --poll-us microseconds when idle
+ * CPU time of the whole process is reported next to the latency, since
+ * polling trades CPU for latency.
+ *
+ * OPTIONS: --rounds N (default 5000), --dispatchers 1,4,16,64,
+ *          --poll-us U (100), --json FILE
+ */
+
+struct RunResult {
+    std::string mode;
+    std::string scenario;
+    int dispatchers;
+    double cpuSeconds;
+    long long futileWakeups;
+    Histogram latency;
+    BenchmarkResult measured;  ///< Rounds timed with the wake-up percentiles
+};
+
+/**
+ * STATE SHARED BY THE PRODUCER AND THE DISPATCHERS OF ONE RUN
+ */
+struct Round {
+    std::atomic<long long> startedAt;   ///< Trigger time of the current round (ns)
+    std::atomic<long long> dispatched;  ///< Rounds completed
+    std::atomic<bool> stop;
+
+    Round() : startedAt(0), dispatched(0), stop(false) {}
+};
+
+static void dispatcherThread(HospitalDispatcher& hospital, Round& round, bool polling, int pollMicros,
+                             Histogram& latency) {
+    while (!round.stop.load(std::memory_order_acquire)) {
+        PatientSnapshot attended = polling ? hospital.tryAttend()
+                                           : hospital.waitAndAttend(std::chrono::milliseconds(50));
+        if (!attended.found) {
+            if (polling) {
+                std::this_thread::sleep_for(std::chrono::microseconds(pollMicros));
+            }
+            continue;
+        }
+        latency.record((std::uint64_t)(benchmarkNanos() - round.startedAt.load(std::memory_order_acquire)));
+        round.dispatched.fetch_add(1, std::memory_order_release);
+    }
+}
+
+static RunResult runScenario(const std::string& mode, const std::string& scenario, int dispatchers,
+                             long long rounds, int pollMicros) {
+    RunResult result;
+    result.mode = mode;
+    result.scenario = scenario;
+    result.dispatchers = dispatchers;
+
+    bool roomScenario = scenario == "room";
+    int rooms = roomScenario ? 2 : (int)rounds + 1;
+    HospitalDispatcher hospital(rooms);
+    if (roomScenario) {
+        for (long long p = 0; p < rounds + rooms; p++) {
+            hospital.registerPatient("Waiting Patient", 40, 1 + (int)(p % 5), "Fever");
+        }
+        for (int r = 0; r < rooms; r++) {
+            hospital.tryAttend();
+        }
+    }
+
+    Round round;
+    std::vector<Histogram> latencies((size_t)dispatchers);
+    std::vector<std::thread> threads;
+    for (int d = 0; d < dispatchers; d++) {
+        threads.push_back(std::thread(dispatcherThread, std::ref(hospital), std::ref(round), mode == "poll",
+                                      pollMicros, std::ref(latencies[(size_t)d])));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));  // Let every dispatcher reach its wait
+
+    BenchmarkState state(rounds);
+    state.begin();
+    for (long long r = 0; r < rounds; r++) {
+        round.startedAt.store(benchmarkNanos(), std::memory_order_release);
+        if (roomScenario) {
+            hospital.freeConsultationRoom();
+        } else {
+            hospital.registerPatient("Arriving Patient", 40, 1 + (int)(r % 5), "Fever");
+        }
+        while (round.dispatched.load(std::memory_order_acquire) <= r) {
+            std::this_thread::yield();
+        }
+    }
+    state.end();
+    result.cpuSeconds = state.elapsedCpu();
+
+    round.stop.store(true, std::memory_order_release);
+    hospital.close();
+    for (size_t t = 0; t < threads.size(); t++) {
+        threads[t].join();
+    }
+    for (size_t d = 0; d < latencies.size(); d++) {
+        result.latency.merge(latencies[d]);
+    }
+    result.futileWakeups = hospital.waitStats().futileWakeups;
+    result.measured = benchmarkResult(scenario + "/" + mode + "/dispatchers:" + std::to_string(dispatchers), state)
+                          .latency(result.latency)
+                          .counter("futile_wakeups", (double)result.futileWakeups);
+    return result;
+}
+
+int main(int argc, char* argv[]) {
+    long long rounds = 5000;
+    int pollMicros = 100;
+    std::vector<int> dispatcherCounts = {1, 4, 16, 64};
+
+    BenchmarkOptions options(BenchmarkOptions::SCENARIO);
+    options.option("--rounds", rounds);
+    options.option("--dispatchers", dispatcherCounts);
+    options.option("--poll-us", pollMicros);
+    if (!options.parse(argc, argv)) {
+        return 1;
+    }
+    if (rounds <= 0 || pollMicros <= 0) {
+        std::cerr << "--rounds and --poll-us must be positive" << std::endl;
+        return 1;
+    }
+
+    const char* scenarios[] = {"patient", "room"};
+    const char* modes[] = {"condvar", "poll"};
+    std::vector<RunResult> runs;
+    for (int s = 0; s < 2; s++) {
+        for (size_t i = 0; i < dispatcherCounts.size(); i++) {
+            if (dispatcherCounts[i] <= 0) continue;
+            for (int m = 0; m < 2; m++) {
+                runs.push_back(runScenario(modes[m], scenarios[s], dispatcherCounts[i], rounds, pollMicros));
+            }
+        }
+    }
+
+    printBenchmarkBanner("DISPATCH WAKE-UP LATENCY BENCHMARK");
+    std::cout << "Rounds: " << rounds << " | Poll interval: " << pollMicros << " us | Hardware threads: "
+              << std::thread::hardware_concurrency() << std::endl;
+    std::cout << "\n" << std::left << std::setw(9) << "Scenario" << std::setw(9) << "Mode" << std::right
+              << std::setw(12) << "Dispatchers" << std::setw(11) << "p50 (us)" << std::setw(11) << "p99 (us)"
+              << std::setw(11) << "max (us)" << std::setw(11) << "CPU (ms)" << std::setw(9) << "Futile" << std::endl;
+    std::vector<BenchmarkResult> results;
+    for (size_t i = 0; i < runs.size(); i++) {
+        const RunResult& r = runs[i];
+        results.push_back(r.measured);
+        std::cout << std::left << std::setw(9) << r.scenario << std::setw(9) << r.mode << std::right
+                  << std::setw(12) << r.dispatchers << std::fixed << std::setprecision(1)
+                  << std::setw(11) << r.latency.percentile(50.0) / 1000.0
+                  << std::setw(11) << r.latency.percentile(99.0) / 1000.0
+                  << std::setw(11) << r.latency.max() / 1000.0
+                  << std::setprecision(0) << std::setw(11) << r.cpuSeconds * 1000.0
+                  << std::setw(9) << r.futileWakeups << std::endl;
+    }
+    std::cout << "==================================================" << std::endl;
+
+    return finishBenchmarks(options, results);
+}
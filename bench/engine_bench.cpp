@@ -0,0 +1,183 @@
+#include "benchmark.h"
+#include "hospitalengine.h"
+#include "hospitalsystem.h"
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * ACTOR ENGINE BENCHMARK
+ *
+ * Each producer thread plays a desk/terminal issuing "visits": register,
+ * attend, free, search (4 commands). Two front ends are compared for the
+ * same producer counts:
+ * - engine: HospitalEngine, commands through the lock-free MPSC queue,
+ *   up to --window futures outstanding per producer
+ * - mutex: the same HospitalSystem calls made directly under one mutex
+ *
+ * LATENCY: submit -> result available to the producer, per command, in an
+ * HDR histogram (for the engine this includes queueing behind the window)
+ *
+ * OPTIONS: --visits N (total, default 200000), --producers 1,2,4,8,
+ *          --window W (default 64), --rooms R, --json FILE
+ */
+
+struct RunResult {
+    std::string mode;
+    int producers;
+    Histogram latency;
+    BenchmarkResult measured;  ///< Commands per second plus latency percentiles
+};
+
+/**
+ * OUTSTANDING ENGINE COMMAND - One of the two futures is valid
+ */
+struct Pending {
+    std::future<int> id;
+    std::future<PatientSnapshot> patient;
+    long long submitted;
+};
+
+static void completePending(Pending& pending, Histogram& latency) {
+    if (pending.id.valid()) {
+        pending.id.get();
+    } else {
+        pending.patient.get();
+    }
+    latency.record((std::uint64_t)(benchmarkNanos() - pending.submitted));
+}
+
+static void engineProducer(HospitalEngine& engine, int producer, long long visits, int window, Histogram& latency) {
+    std::vector<Pending> ring((size_t)window);
+    long long submitted = 0;
+    long long completed = 0;
+    for (long long v = 0; v < visits; v++) {
+        for (int step = 0; step < 4; step++) {
+            Pending& slot = ring[(size_t)(submitted % window)];
+            if (submitted - completed == window) {
+                completePending(slot, latency);
+                completed++;
+            }
+            slot.submitted = benchmarkNanos();
+            switch (step) {
+                case 0: slot.id = engine.registerPatient("Desk Patient", 40, 1 + (int)((v + producer) % 5), "Fever"); break;
+                case 1: slot.patient = engine.attendNextPatient(); break;
+                case 2: slot.patient = engine.freeConsultationRoom(); break;
+                default: slot.patient = engine.searchPatient(1 + (int)v); break;
+            }
+            submitted++;
+        }
+    }
+    while (completed < submitted) {
+        completePending(ring[(size_t)(completed % window)], latency);
+        completed++;
+    }
+}
+
+static void mutexProducer(HospitalSystem& system, std::mutex& guard, int producer, long long visits, Histogram& latency) {
+    for (long long v = 0; v < visits; v++) {
+        for (int step = 0; step < 4; step++) {
+            long long start = benchmarkNanos();
+            {
+                std::lock_guard<std::mutex> lock(guard);
+                switch (step) {
+                    case 0: system.registerPatient("Desk Patient", 40, 1 + (int)((v + producer) % 5), "Fever"); break;
+                    case 1: system.attendNextPatient(); break;
+                    case 2: system.freeConsultationRoom(); break;
+                    default: system.searchPatient(1 + (int)v); break;
+                }
+            }
+            latency.record((std::uint64_t)(benchmarkNanos() - start));
+        }
+    }
+}
+
+static RunResult runMode(const std::string& mode, int producers, long long visits, int window, int rooms) {
+    RunResult result;
+    result.mode = mode;
+    result.producers = producers;
+    long long perProducer = visits / producers;
+    long long commands = perProducer * producers * 4;
+
+    std::vector<Histogram> latencies((size_t)producers);
+    std::vector<std::thread> threads;
+    std::unique_ptr<HospitalEngine> engine(mode == "engine" ? new HospitalEngine(rooms) : NULL);
+    std::unique_ptr<HospitalSystem> system(mode == "mutex" ? new HospitalSystem(rooms, false) : NULL);
+    std::mutex guard;
+
+    BenchmarkState state(commands);
+    state.begin();
+    for (int p = 0; p < producers; p++) {
+        if (engine != NULL) {
+            threads.push_back(std::thread(engineProducer, std::ref(*engine), p, perProducer, window,
+                                          std::ref(latencies[(size_t)p])));
+        } else {
+            threads.push_back(std::thread(mutexProducer, std::ref(*system), std::ref(guard), p, perProducer,
+                                          std::ref(latencies[(size_t)p])));
+        }
+    }
+    for (size_t t = 0; t < threads.size(); t++) {
+        threads[t].join();
+    }
+    state.end();
+    state.setItemsProcessed(commands);
+
+    for (int p = 0; p < producers; p++) {
+        result.latency.merge(latencies[(size_t)p]);
+    }
+    result.measured = benchmarkResult(mode + "/producers:" + std::to_string(producers), state)
+                          .latency(result.latency);
+    return result;
+}
+
+int main(int argc, char* argv[]) {
+    long long visits = 200000;
+    int window = 64;
+    int rooms = 10;
+    std::vector<int> producerCounts = {1, 2, 4, 8};
+
+    BenchmarkOptions options(BenchmarkOptions::SCENARIO);
+    options.option("--visits", visits);
+    options.option("--producers", producerCounts);
+    options.option("--window", window);
+    options.option("--rooms", rooms);
+    if (!options.parse(argc, argv)) {
+        return 1;
+    }
+    if (visits <= 0 || window <= 0 || rooms < 2) {
+        std::cerr << "--visits and --window must be positive, --rooms must be >= 2" << std::endl;
+        return 1;
+    }
+
+    std::vector<RunResult> runs;
+    for (size_t i = 0; i < producerCounts.size(); i++) {
+        if (producerCounts[i] <= 0) continue;
+        runs.push_back(runMode("engine", producerCounts[i], visits, window, rooms));
+        runs.push_back(runMode("mutex", producerCounts[i], visits, window, rooms));
+    }
+
+    printBenchmarkBanner("ACTOR ENGINE BENCHMARK");
+    std::cout << "Visits: " << visits << " (4 commands each) | Window: " << window
+              << " | Rooms: " << rooms << " | Hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+    std::cout << "\n" << std::left << std::setw(8) << "Mode" << std::right << std::setw(11) << "Producers"
+              << std::setw(14) << "Commands/s" << std::setw(12) << "p50 (us)" << std::setw(12) << "p99 (us)"
+              << std::setw(12) << "p99.9 (us)" << std::endl;
+    std::vector<BenchmarkResult> results;
+    for (size_t i = 0; i < runs.size(); i++) {
+        const RunResult& r = runs[i];
+        results.push_back(r.measured);
+        std::cout << std::left << std::setw(8) << r.mode << std::right << std::setw(11) << r.producers
+                  << std::fixed << std::setprecision(0) << std::setw(14) << r.measured.itemsPerSecond
+                  << std::setprecision(2) << std::setw(12) << r.latency.percentile(50.0) / 1000.0
+                  << std::setw(12) << r.latency.percentile(99.0) / 1000.0
+                  << std::setw(12) << r.latency.percentile(99.9) / 1000.0 << std::endl;
+    }
+    std::cout << "==================================================" << std::endl;
+
+    return finishBenchmarks(options, results);
+}
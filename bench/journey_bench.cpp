@@ -0,0 +1,358 @@
+#include "benchmark.h"
+#include "journeylog.h"
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * PATIENT JOURNEY LOG BENCHMARK
+ *
+ * --patients synthetic journeys arrive at 300 per hour on average; each is
+ * registered, triaged 0-120 s later, waits (exponential, mean 20 min) and
+ * is roomed for 10-60 min, or is transferred from triage (3%). Their
+ * events are merged in time order (about four per patient) and then:
+ *
+ * APPEND: every event is appended to
+ * - log: JourneyLog, validation plus all incremental projections
+ * - columns: the same columns pushed without projections (the floor)
+ * and rebuildProjections() replays the finished log once.
+ *
+ * QUERIES, answered from the projections and by rescanning the columns:
+ * - patient: stage durations of a random patient (scan of the ID column)
+ * - hour: events of one type in a random hour (binary search on the
+ *   sorted time column, then a scan of that hour)
+ * - status: patients currently waiting for a room (one pass keeping the
+ *   latest status of every patient)
+ * - p90: 90th percentile of the triage wait (one pass, then nth_element)
+ *
+ * CHECK: every rescanned answer must match the projection, and the
+ * rebuilt projections must match the incremental ones for every patient
+ * and every hour.
+ *
+ * OPTIONS: --patients N (default 1000000), --queries Q (default 1000000),
+ *          --scan-queries S (default 50), --json FILE
+ */
+
+static const long long SECOND = 1000000000LL;
+
+struct RawEvent {
+    long long time;
+    int patientId;
+    JourneyEventType type;
+    int detail;
+    bool operator<(const RawEvent& other) const { return time < other.time; }
+};
+
+/**
+ * SAME COLUMNS, NO PROJECTIONS - append floor and rescan baseline
+ */
+struct ColumnLog {
+    std::vector<long long> times;
+    std::vector<int> patients;
+    std::vector<unsigned char> types;
+    std::vector<int> details;
+
+    void append(const RawEvent& event) {
+        times.push_back(event.time);
+        patients.push_back(event.patientId);
+        types.push_back((unsigned char)event.type);
+        details.push_back(event.detail);
+    }
+
+    void stages(int patientId, long long out[3]) const {
+        long long at[JourneyLog::EVENT_TYPES] = {-1, -1, -1, -1, -1};
+        for (size_t i = 0; i < patients.size(); i++) {
+            if (patients[i] == patientId) {
+                at[types[i]] = times[i];
+            }
+        }
+        out[STAGE_INTAKE] = at[JOURNEY_TRIAGED] >= 0 ? at[JOURNEY_TRIAGED] - at[JOURNEY_REGISTERED] : -1;
+        out[STAGE_WAITING] = at[JOURNEY_ROOMED] >= 0 ? at[JOURNEY_ROOMED] - at[JOURNEY_TRIAGED] : -1;
+        out[STAGE_CONSULTATION] = at[JOURNEY_DISCHARGED] >= 0 ? at[JOURNEY_DISCHARGED] - at[JOURNEY_ROOMED] : -1;
+    }
+
+    int hour(int index, JourneyEventType type) const {
+        long long from = times[0] + index * JourneyLog::HOUR_NANOS;
+        size_t i = (size_t)(std::lower_bound(times.begin(), times.end(), from) - times.begin());
+        int count = 0;
+        for (; i < times.size() && times[i] < from + JourneyLog::HOUR_NANOS; i++) {
+            count += types[i] == type;
+        }
+        return count;
+    }
+
+    int status(JourneyEventType type, int maxId, std::vector<unsigned char>& latest) const {
+        latest.assign((size_t)maxId + 1, 255);
+        for (size_t i = 0; i < patients.size(); i++) {
+            latest[(size_t)patients[i]] = types[i];
+        }
+        int count = 0;
+        for (size_t i = 0; i < latest.size(); i++) {
+            count += latest[i] == type;
+        }
+        return count;
+    }
+
+    long long p90Wait(int maxId, std::vector<long long>& triagedAt, std::vector<long long>& waits) const {
+        triagedAt.assign((size_t)maxId + 1, -1);
+        waits.clear();
+        for (size_t i = 0; i < patients.size(); i++) {
+            if (types[i] == JOURNEY_TRIAGED) {
+                triagedAt[(size_t)patients[i]] = times[i];
+            } else if (types[i] == JOURNEY_ROOMED) {
+                waits.push_back(times[i] - triagedAt[(size_t)patients[i]]);
+            }
+        }
+        if (waits.empty()) {
+            return 0;
+        }
+        size_t rank = (size_t)(0.9 * (double)waits.size() + 0.5);  // Same rank rule as Histogram
+        rank = rank < 1 ? 0 : rank - 1;
+        std::nth_element(waits.begin(), waits.begin() + (long)rank, waits.end());
+        return waits[rank];
+    }
+};
+
+/**
+ * SYNTHETIC JOURNEYS IN TIME ORDER
+ */
+static std::vector<RawEvent> buildEvents(int patientCount, unsigned seed) {
+    std::mt19937_64 rng(seed);
+    std::exponential_distribution<double> gap(1.0 / 12.0);       // 300 arrivals per hour
+    std::uniform_int_distribution<int> intake(0, 120);
+    std::exponential_distribution<double> wait(1.0 / 1200.0);    // Mean 20 min
+    std::uniform_int_distribution<int> consultation(600, 3600);
+    std::uniform_int_distribution<int> percent(0, 99);
+    std::vector<RawEvent> events;
+    events.reserve((size_t)patientCount * 4);
+
+    double arrival = 0.0;
+    for (int id = 1; id <= patientCount; id++) {
+        arrival += gap(rng);
+        long long t = (long long)(arrival * SECOND);
+        int level = 1 + (int)(rng() % 5);
+        RawEvent registered = {t, id, JOURNEY_REGISTERED, 0};
+        events.push_back(registered);
+        t += intake(rng) * SECOND;
+        RawEvent triaged = {t, id, JOURNEY_TRIAGED, level};
+        events.push_back(triaged);
+        t += 1 + (long long)(wait(rng) * SECOND);
+        if (percent(rng) < 3) {
+            RawEvent transferred = {t, id, JOURNEY_TRANSFERRED, 0};
+            events.push_back(transferred);
+            continue;
+        }
+        int room = (int)(rng() % 40);
+        RawEvent roomed = {t, id, JOURNEY_ROOMED, room};
+        events.push_back(roomed);
+        t += consultation(rng) * SECOND;
+        RawEvent discharged = {t, id, JOURNEY_DISCHARGED, room};
+        events.push_back(discharged);
+    }
+    std::stable_sort(events.begin(), events.end());  // Ties keep each journey's order
+    return events;
+}
+
+struct QueryCost {
+    const char* name;
+    BenchmarkState projection;
+    BenchmarkState scan;
+
+    QueryCost(const char* queryName, long long queries, long long scans)
+        : name(queryName), projection(queries), scan(scans) {}
+};
+
+int main(int argc, char* argv[]) {
+    int patientCount = 1000000;
+    int queries = 1000000;
+    int scanQueries = 50;
+
+    BenchmarkOptions options(BenchmarkOptions::SCENARIO);
+    options.option("--patients", patientCount);
+    options.option("--queries", queries);
+    options.option("--scan-queries", scanQueries);
+    if (!options.parse(argc, argv)) {
+        return 1;
+    }
+    if (patientCount <= 0 || queries <= 0 || scanQueries <= 0) {
+        std::cerr << "--patients, --queries and --scan-queries must be positive" << std::endl;
+        return 1;
+    }
+
+    std::vector<RawEvent> events = buildEvents(patientCount, 7300u);
+    size_t n = events.size();
+    BenchmarkChecks checks;
+
+    // APPEND
+    JourneyLog log;
+    log.reserve((int)n, patientCount);
+    BenchmarkState append((long long)n);
+    append.begin();
+    for (size_t i = 0; i < n; i++) {
+        log.append(events[i].type, events[i].patientId, events[i].detail, events[i].time);
+    }
+    append.end();
+    append.setItemsProcessed((long long)n);
+
+    ColumnLog columns;
+    columns.times.reserve(n);
+    columns.patients.reserve(n);
+    columns.types.reserve(n);
+    columns.details.reserve(n);
+    BenchmarkState columnAppend((long long)n);
+    columnAppend.begin();
+    for (size_t i = 0; i < n; i++) {
+        columns.append(events[i]);
+    }
+    columnAppend.end();
+    columnAppend.setItemsProcessed((long long)n);
+
+    // Snapshot of the incremental projections, then rebuild and compare
+    std::vector<PatientJourney> incremental((size_t)patientCount + 1);
+    for (int id = 1; id <= patientCount; id++) {
+        incremental[(size_t)id] = log.patient(id);
+    }
+    std::vector<int> hourly;
+    for (int hour = 0; hour < log.hours(); hour++) {
+        for (int type = 0; type < JourneyLog::EVENT_TYPES; type++) {
+            hourly.push_back(log.throughput(hour, (JourneyEventType)type));
+        }
+    }
+    int waitingBefore = log.count(JOURNEY_TRIAGED);
+    std::uint64_t p90Before = log.stageDurations(STAGE_WAITING).percentile(90.0);
+
+    BenchmarkState rebuild((long long)n);
+    rebuild.begin();
+    log.rebuildProjections();
+    rebuild.end();
+    rebuild.setItemsProcessed((long long)n);
+
+    bool rebuilt = waitingBefore == log.count(JOURNEY_TRIAGED) &&
+                   p90Before == log.stageDurations(STAGE_WAITING).percentile(90.0);
+    for (int id = 1; id <= patientCount && rebuilt; id++) {
+        PatientJourney now = log.patient(id);
+        const PatientJourney& then = incremental[(size_t)id];
+        rebuilt = now.status == then.status && now.since == then.since;
+        for (int stage = 0; stage < JourneyLog::STAGES; stage++) {
+            rebuilt = rebuilt && now.stageNanos[stage] == then.stageNanos[stage];
+        }
+    }
+    for (int hour = 0, k = 0; hour < log.hours() && rebuilt; hour++) {
+        for (int type = 0; type < JourneyLog::EVENT_TYPES; type++, k++) {
+            rebuilt = rebuilt && hourly[(size_t)k] == log.throughput(hour, (JourneyEventType)type);
+        }
+    }
+    checks.expect(rebuilt, "rebuilt projections match the incremental ones");
+
+    // QUERIES - the same random arguments for projection and scan
+    std::mt19937 rng(7301u);
+    std::vector<int> ids((size_t)queries);
+    std::vector<int> hoursAsked((size_t)queries);
+    for (int q = 0; q < queries; q++) {
+        ids[(size_t)q] = 1 + (int)(rng() % (unsigned)patientCount);
+        hoursAsked[(size_t)q] = (int)(rng() % (unsigned)log.hours());
+    }
+    int scans = std::min(scanQueries, queries);
+    long long sink = 0;
+    QueryCost costs[4] = {QueryCost("patient", queries, scans), QueryCost("hour", queries, scans),
+                          QueryCost("status", queries, scans), QueryCost("p90", queries, scans)};
+
+    costs[0].projection.begin();
+    for (int q = 0; q < queries; q++) {
+        sink += log.patient(ids[(size_t)q]).stageNanos[STAGE_WAITING];
+    }
+    costs[0].projection.end();
+    bool matched = true;
+    costs[0].scan.begin();
+    for (int q = 0; q < scans; q++) {
+        long long stages[3];
+        columns.stages(ids[(size_t)q], stages);
+        PatientJourney projected = log.patient(ids[(size_t)q]);
+        for (int stage = 0; stage < JourneyLog::STAGES; stage++) {
+            matched = matched && stages[stage] == projected.stageNanos[stage];
+        }
+    }
+    costs[0].scan.end();
+    checks.expect(matched, "rescanned patient stages match the projection");
+
+    costs[1].projection.begin();
+    for (int q = 0; q < queries; q++) {
+        sink += log.throughput(hoursAsked[(size_t)q], JOURNEY_DISCHARGED);
+    }
+    costs[1].projection.end();
+    matched = true;
+    costs[1].scan.begin();
+    for (int q = 0; q < scans; q++) {
+        int hour = hoursAsked[(size_t)q];
+        matched = matched && columns.hour(hour, JOURNEY_DISCHARGED) == log.throughput(hour, JOURNEY_DISCHARGED);
+    }
+    costs[1].scan.end();
+    checks.expect(matched, "rescanned hourly throughput matches the projection");
+
+    costs[2].projection.begin();
+    for (int q = 0; q < queries; q++) {
+        sink += log.count((JourneyEventType)(q % JourneyLog::EVENT_TYPES));
+    }
+    costs[2].projection.end();
+    std::vector<unsigned char> latest;
+    matched = true;
+    costs[2].scan.begin();
+    for (int q = 0; q < scans; q++) {
+        matched = matched && columns.status(JOURNEY_TRIAGED, patientCount, latest) == log.count(JOURNEY_TRIAGED);
+    }
+    costs[2].scan.end();
+    checks.expect(matched, "rescanned status count matches the projection");
+
+    costs[3].projection.begin();
+    for (int q = 0; q < queries; q++) {
+        sink += (long long)log.stageDurations((JourneyStage)(q % JourneyLog::STAGES)).percentile(90.0);
+    }
+    costs[3].projection.end();
+    std::vector<long long> triagedAt;
+    std::vector<long long> waits;
+    long long exactP90 = 0;
+    costs[3].scan.begin();
+    for (int q = 0; q < scans; q++) {
+        exactP90 = columns.p90Wait(patientCount, triagedAt, waits);
+    }
+    costs[3].scan.end();
+    // The histogram reports its bucket's upper bound: within 1/64 above the exact value
+    std::uint64_t histogramP90 = log.stageDurations(STAGE_WAITING).percentile(90.0);
+    checks.expect(histogramP90 >= (std::uint64_t)exactP90 &&
+                  histogramP90 <= (std::uint64_t)exactP90 + (std::uint64_t)exactP90 / 64 + 1,
+                  "histogram p90 wait within 1/64 of the exact value");
+
+    std::vector<BenchmarkResult> results;
+    results.push_back(benchmarkResult("append/log", append));
+    results.push_back(benchmarkResult("append/columns", columnAppend));
+    results.push_back(benchmarkResult("rebuild", rebuild));
+    for (int i = 0; i < 4; i++) {
+        results.push_back(benchmarkResult(std::string("query/") + costs[i].name + "/projection", costs[i].projection));
+        results.push_back(benchmarkResult(std::string("query/") + costs[i].name + "/rescan", costs[i].scan));
+    }
+
+    double appendNs = results[0].realNanosPerIteration;
+    printBenchmarkBanner("PATIENT JOURNEY LOG BENCHMARK");
+    std::cout << "Patients: " << patientCount << " | events: " << n << " | hours: " << log.hours()
+              << " | check sum " << (sink & 0xFFFF) << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "\nAppend (log + projections): " << appendNs << " ns/event (" << 1000.0 / appendNs
+              << " M events/s)" << std::endl;
+    std::cout << "Append (columns only):      " << results[1].realNanosPerIteration << " ns/event" << std::endl;
+    std::cout << "Rebuild projections:        " << results[2].realNanosPerIteration << " ns/event" << std::endl;
+    std::cout << "\n" << std::setw(10) << "Query" << std::setw(16) << "Projection ns" << std::setw(16)
+              << "Rescan ns" << std::setw(12) << "Speedup" << std::endl;
+    for (int i = 0; i < 4; i++) {
+        double projectionNs = results[3 + 2 * i].realNanosPerIteration;
+        double scanNs = results[4 + 2 * i].realNanosPerIteration;
+        std::cout << std::setw(10) << costs[i].name << std::setw(16) << projectionNs << std::setw(16)
+                  << scanNs << std::setw(11) << scanNs / projectionNs << "x" << std::endl;
+    }
+    std::cout << "==================================================" << std::endl;
+
+    return finishBenchmarks(options, results, checks);
+}
@@ -0,0 +1,329 @@
+#include "benchmark.h"
+#include "hospitalsystem.h"
+#include "metricsregistry.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * METRICS REGISTRY BENCHMARK
+ *
+ * PUBLISH COST - one operation's worth of updates, the way HospitalSystem
+ * publishes after every operation: one latency observation, one event
+ * counter and GAUGES gauge stores (triage levels, rooms, history...):
+ * - atomics: MetricsRegistry series (relaxed single-writer atomics)
+ * - mutex: the same values in a plain struct behind a std::mutex, the
+ *   usual alternative when a scraper thread reads them
+ * Each is measured alone and while a scraper thread renders the
+ * exposition in a loop.
+ *
+ * SCRAPE COST: rendering the full HospitalMetrics exposition.
+ *
+ * SYSTEM OVERHEAD: register -> attend -> free cycles through HospitalSystem
+ * with and without HospitalMetrics attached, best of ROUNDS interleaved
+ * runs each.
+ *
+ * CHECK: every concurrent scrape must have cumulative buckets that never
+ * decrease and a +Inf bucket equal to _count; after the run the totals
+ * must equal the number of updates for both variants, and the system's
+ * event counters the number of cycles.
+ *
+ * OPTIONS: --updates N (default 2000000), --cycles C (default 200000),
+ *          --scrapes S (default 2000), --json FILE
+ */
+
+static const int GAUGES = 10;
+static const int ROUNDS = 3;  ///< System runs per variant, best kept
+
+/**
+ * MUTEX BASELINE - same values as the registry series
+ */
+struct LockedMetrics {
+    std::mutex lock;
+    std::uint64_t buckets[MetricHistogram::BOUNDS + 1];
+    std::uint64_t sumNanos;
+    std::uint64_t events;
+    std::int64_t gauges[GAUGES];
+
+    LockedMetrics() : buckets(), sumNanos(0), events(0), gauges() {}
+
+    void publish(std::uint64_t nanos, std::int64_t value) {
+        std::lock_guard<std::mutex> guard(lock);
+        int bucket = 0;
+        while (bucket < MetricHistogram::BOUNDS && nanos > MetricHistogram::BOUND_NANOS[bucket]) {
+            bucket++;
+        }
+        buckets[bucket]++;
+        sumNanos += nanos;
+        events++;
+        for (int g = 0; g < GAUGES; g++) {
+            gauges[g] = value + g;
+        }
+    }
+
+    std::string render() {
+        std::string out;
+        char line[96];
+        std::lock_guard<std::mutex> guard(lock);
+        std::uint64_t cumulative = 0;
+        for (int i = 0; i <= MetricHistogram::BOUNDS; i++) {
+            cumulative += buckets[i];
+            std::string bound = i < MetricHistogram::BOUNDS ? std::to_string(MetricHistogram::BOUND_NANOS[i]) : "+Inf";
+            std::snprintf(line, sizeof(line), "bench_latency_bucket{le=\"%s\"} %llu\n", bound.c_str(),
+                          (unsigned long long)cumulative);
+            out += line;
+        }
+        std::snprintf(line, sizeof(line), "bench_latency_count %llu\nbench_events_total %llu\n",
+                      (unsigned long long)cumulative, (unsigned long long)events);
+        out += line;
+        for (int g = 0; g < GAUGES; g++) {
+            std::snprintf(line, sizeof(line), "bench_gauge{index=\"%d\"} %lld\n", g, (long long)gauges[g]);
+            out += line;
+        }
+        return out;
+    }
+};
+
+/**
+ * REGISTRY VARIANT - one histogram, one counter, GAUGES gauges
+ */
+struct RegistryMetrics {
+    MetricsRegistry registry;
+    MetricHistogram* latency;
+    MetricCounter* events;
+    MetricGauge* gauges[GAUGES];
+
+    RegistryMetrics() {
+        latency = &registry.histogram("bench_latency_seconds", "Bench latency");
+        events = &registry.counter("bench_events_total", "Bench events");
+        for (int g = 0; g < GAUGES; g++) {
+            gauges[g] = &registry.gauge("bench_gauge", "Bench gauge", MetricsRegistry::label("index", std::to_string(g)));
+        }
+    }
+
+    void publish(std::uint64_t nanos, std::int64_t value) {
+        latency->observe(nanos);
+        events->add();
+        for (int g = 0; g < GAUGES; g++) {
+            gauges[g]->set(value + g);
+        }
+    }
+};
+
+/**
+ * VALUE OF THE FIRST SAMPLE LINE STARTING WITH prefix, -1 IF ABSENT
+ */
+static long long sampleValue(const std::string& page, const std::string& prefix, size_t from = 0) {
+    size_t at = page.find("\n" + prefix, from);
+    if (at == std::string::npos) {
+        return -1;
+    }
+    size_t space = page.find(' ', at + 1 + prefix.size());
+    return std::atoll(page.c_str() + space + 1);
+}
+
+/**
+ * SCRAPE CONSISTENCY: per series, cumulative buckets non-decreasing and
+ * +Inf == _count
+ */
+static bool consistentScrape(const std::string& page, const std::string& name) {
+    long long previous = 0;
+    int series = 0;
+    size_t at = 0;
+    while ((at = page.find("\n" + name + "_bucket{", at)) != std::string::npos) {
+        size_t space = page.find(' ', at + 1);
+        long long value = std::atoll(page.c_str() + space + 1);
+        if (value < previous) {
+            return false;
+        }
+        previous = value;
+        if (page.compare(space - 7, 7, "\"+Inf\"}") == 0) {
+            if (value != sampleValue(page, name + "_count", space)) {
+                return false;
+            }
+            previous = 0;
+            series++;
+        }
+        at = space;
+    }
+    return series > 0;
+}
+
+/**
+ * LATENCY SAMPLE SPREAD OVER THE BUCKETS (deterministic)
+ */
+static std::uint64_t sampleNanos(long long i) {
+    return (std::uint64_t)(200 + (i * 7919) % 5000);
+}
+
+template <typename Publish>
+static BenchmarkState timePublish(long long updates, Publish publish) {
+    BenchmarkState state(updates);
+    state.begin();
+    for (long long i = 0; i < updates; i++) {
+        publish(sampleNanos(i), i);
+    }
+    state.end();
+    return state;
+}
+
+/**
+ * SYSTEM CYCLES - register, attend, free; one iteration per operation
+ */
+static BenchmarkState timeSystem(HospitalSystem& system, int cycles) {
+    BenchmarkState state(3LL * cycles);
+    state.begin();
+    for (int i = 0; i < cycles; i++) {
+        system.registerPatient("Patient", 20 + i % 60, 1 + i % 5, "fever");
+        system.attendNextPatient();
+        system.freeConsultationRoom();
+    }
+    state.end();
+    return state;
+}
+
+int main(int argc, char* argv[]) {
+    long long updates = 2000000;
+    int cycles = 200000;
+    int scrapes = 2000;
+
+    BenchmarkOptions options(BenchmarkOptions::SCENARIO);
+    options.option("--updates", updates);
+    options.option("--cycles", cycles);
+    options.option("--scrapes", scrapes);
+    if (!options.parse(argc, argv)) {
+        return 1;
+    }
+    if (updates <= 0 || cycles <= 0 || scrapes <= 0) {
+        std::cerr << "--updates, --cycles and --scrapes must be positive" << std::endl;
+        return 1;
+    }
+
+    // PUBLISH COST, NO READER
+    RegistryMetrics atomics;
+    LockedMetrics locked;
+    BenchmarkState atomicAlone = timePublish(updates, [&](std::uint64_t nanos, long long i) { atomics.publish(nanos, i); });
+    BenchmarkState mutexAlone = timePublish(updates, [&](std::uint64_t nanos, long long i) { locked.publish(nanos, i); });
+
+    // PUBLISH COST WHILE A SCRAPER RENDERS IN A LOOP
+    std::atomic<bool> running(true);
+    std::atomic<long long> atomicScrapes(0);
+    std::atomic<bool> scrapesConsistent(true);
+    std::thread atomicScraper([&]() {
+        while (running.load(std::memory_order_relaxed)) {
+            std::string page = atomics.registry.render();
+            if (!consistentScrape(page, "bench_latency_seconds")) {
+                scrapesConsistent.store(false);
+            }
+            atomicScrapes.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+    BenchmarkState atomicScraped = timePublish(updates, [&](std::uint64_t nanos, long long i) { atomics.publish(nanos, i); });
+    running.store(false);
+    atomicScraper.join();
+
+    running.store(true);
+    std::atomic<long long> mutexScrapes(0);
+    std::thread mutexScraper([&]() {
+        while (running.load(std::memory_order_relaxed)) {
+            std::string page = locked.render();
+            if (!consistentScrape(page, "bench_latency")) {
+                scrapesConsistent.store(false);
+            }
+            mutexScrapes.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+    BenchmarkState mutexScraped = timePublish(updates, [&](std::uint64_t nanos, long long i) { locked.publish(nanos, i); });
+    running.store(false);
+    mutexScraper.join();
+
+    // TOTALS AFTER BOTH PHASES
+    std::string finalPage = atomics.registry.render();
+    bool totalsConsistent = atomics.latency->count() == (std::uint64_t)(2 * updates) &&
+                            atomics.events->value() == (std::uint64_t)(2 * updates) &&
+                            sampleValue(finalPage, "bench_latency_seconds_count") == 2 * updates &&
+                            locked.events == (std::uint64_t)(2 * updates);
+
+    // SCRAPE COST OF THE REAL EXPOSITION + SYSTEM OVERHEAD
+    HospitalConfig config = HospitalConfig::withRooms(10);
+    MetricsRegistry registry;
+    HospitalMetrics metrics(registry, config);
+    BenchmarkState plainBest(0);
+    BenchmarkState publishedBest(0);
+    for (int round = 0; round < ROUNDS; round++) {
+        HospitalSystem plain(config, false);
+        BenchmarkState run = timeSystem(plain, cycles);
+        if (round == 0 || run.elapsedWall() < plainBest.elapsedWall()) {
+            plainBest = run;
+        }
+        HospitalSystem published(config, false);
+        published.attachMetrics(&metrics);
+        run = timeSystem(published, cycles);
+        if (round == 0 || run.elapsedWall() < publishedBest.elapsedWall()) {
+            publishedBest = run;
+        }
+    }
+    std::uint64_t systemCycles = (std::uint64_t)cycles * ROUNDS;
+    bool systemConsistent = metrics.events[ROLLING_ARRIVALS]->value() == systemCycles &&
+                            metrics.events[ROLLING_DISCHARGES]->value() == systemCycles &&
+                            metrics.latency[HospitalMetrics::OP_REGISTER]->count() == systemCycles &&
+                            metrics.latency[HospitalMetrics::OP_COMPLETE]->count() == systemCycles &&
+                            consistentScrape(registry.render(), "hospital_operation_duration_seconds");
+
+    std::string page;
+    size_t pageBytes = 0;
+    BenchmarkState scrape(scrapes);
+    scrape.begin();
+    for (int s = 0; s < scrapes; s++) {
+        page.clear();
+        registry.render(page);
+        pageBytes = page.size();
+    }
+    scrape.end();
+
+    BenchmarkChecks checks;
+    checks.expect(scrapesConsistent.load(), "concurrent scrapes have cumulative buckets and +Inf == _count");
+    checks.expect(totalsConsistent, "publish totals equal the number of updates");
+    checks.expect(systemConsistent, "system event counters equal the number of cycles");
+
+    std::vector<BenchmarkResult> results;
+    results.push_back(benchmarkResult("publish/atomics", atomicAlone));
+    results.push_back(benchmarkResult("publish/mutex", mutexAlone));
+    results.push_back(benchmarkResult("publish/atomics/scraped", atomicScraped)
+                          .counter("scrapes", (double)atomicScrapes.load()));
+    results.push_back(benchmarkResult("publish/mutex/scraped", mutexScraped)
+                          .counter("scrapes", (double)mutexScrapes.load()));
+    results.push_back(benchmarkResult("scrape", scrape).counter("bytes", (double)pageBytes));
+    results.push_back(benchmarkResult("system/plain", plainBest));
+    results.push_back(benchmarkResult("system/metrics", publishedBest));
+    double atomicNs = results[0].realNanosPerIteration;
+    double mutexNs = results[1].realNanosPerIteration;
+    double scrapeUs = results[4].realNanosPerIteration / 1000.0;
+    double plainNs = results[5].realNanosPerIteration;
+    double publishedNs = results[6].realNanosPerIteration;
+
+    printBenchmarkBanner("METRICS REGISTRY BENCHMARK");
+    std::cout << "Publish: 1 histogram + 1 counter + " << GAUGES << " gauges | " << updates << " updates per run"
+              << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "\n" << std::setw(22) << "Publish ns/op" << std::setw(12) << "Alone" << std::setw(14)
+              << "With scraper" << std::setw(10) << "Scrapes" << std::endl;
+    std::cout << std::setw(22) << "Relaxed atomics" << std::setw(12) << atomicNs << std::setw(14) << results[2].realNanosPerIteration
+              << std::setw(10) << atomicScrapes.load() << std::endl;
+    std::cout << std::setw(22) << "Mutex + plain struct" << std::setw(12) << mutexNs << std::setw(14)
+              << results[3].realNanosPerIteration << std::setw(10) << mutexScrapes.load() << std::endl;
+    std::cout << "\nScrape (render /metrics): " << scrapeUs << " us | " << pageBytes << " bytes" << std::endl;
+    std::cout << "HospitalSystem operation: " << plainNs << " ns plain | " << publishedNs << " ns with metrics ("
+              << std::showpos << (publishedNs / plainNs - 1.0) * 100.0 << std::noshowpos << "%)" << std::endl;
+    std::cout << "==================================================" << std::endl;
+
+    return finishBenchmarks(options, results, checks);
+}
@@ -0,0 +1,200 @@
+#include "benchmark.h"
+#include "nameindex.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * NAME PREFIX INDEX BENCHMARK
+ *
+ * Builds a NameIndex over --names synthetic patients ("Given Surname
+ * Surname", surnames generated from Spanish syllables so most full names
+ * are distinct, some written with accents or in capitals), then runs
+ * --queries prefix lookups for --k results:
+ * - Prefixes are the first 1..12 characters of random indexed names,
+ *   half of them re-cased or written without accents, so every query
+ *   exercises folding
+ * - Per-query latency goes to an HDR histogram, bucketed by prefix length
+ *
+ * BASELINE: a linear scan that folds every name, keeps the matches and
+ * sorts the first k - what a search over registeredPatients would cost
+ * (run --scan-queries times only)
+ *
+ * OPTIONS: --names N (default 5000000), --queries Q (200000), --k K (10),
+ *          --scan-queries S (5), --json FILE
+ */
+
+static const char* const GIVEN_NAMES[] = {
+    "Juan", "María", "Carlos", "Ana", "Luis", "Laura", "Andrés", "Camila", "Jorge", "Valentina",
+    "Diego", "Daniela", "Santiago", "Sofía", "Felipe", "Paula", "Alejandro", "Natalia", "Sebastián",
+    "Carolina", "Mateo", "Isabella", "Nicolás", "Mariana", "José", "Gabriela", "Miguel", "Juliana",
+    "David", "Catalina", "Esteban", "Lucía", "Iván", "Ángela", "Óscar", "Verónica", "Raúl", "Inés"
+};
+
+static const char* const SYLLABLES[] = {
+    "ma", "ri", "go", "mez", "ro", "dri", "guez", "lo", "pez", "her", "nan", "dez", "san", "chez",
+    "ra", "mi", "rez", "pe", "di", "az", "mu", "ñoz", "ja", "var", "gas", "cas", "tro", "gu", "tié",
+    "al", "va", "or", "tiz", "sua", "to", "rres", "ruiz", "me", "jía", "res", "tre", "po", "car",
+    "de", "nas", "os", "pi", "na", "sa", "za", "quin", "te", "ti", "llo", "rin", "cón", "bel", "trán"
+};
+
+static const int GIVEN_COUNT = sizeof(GIVEN_NAMES) / sizeof(GIVEN_NAMES[0]);
+static const int SYLLABLE_COUNT = sizeof(SYLLABLES) / sizeof(SYLLABLES[0]);
+static const int MAX_PREFIX = 12;
+
+static std::string surname(std::mt19937_64& rng) {
+    std::string result;
+    int syllables = 2 + (int)(rng() % 3);
+    for (int s = 0; s < syllables; s++) {
+        result += SYLLABLES[rng() % SYLLABLE_COUNT];
+    }
+    result[0] = (char)(result[0] - 'a' + 'A');
+    return result;
+}
+
+/**
+ * QUERY PREFIX - First 'length' folded characters of a name, then
+ * re-cased so the index has to fold it back
+ */
+static std::string makePrefix(const std::string& name, int length, bool shout) {
+    std::string folded = NameIndex::fold(name);
+    std::string prefix = folded.substr(0, std::min((size_t)length, folded.size()));
+    if (shout) {
+        for (size_t i = 0; i < prefix.size(); i++) {
+            if (prefix[i] >= 'a' && prefix[i] <= 'z') prefix[i] = (char)(prefix[i] - 'a' + 'A');
+        }
+    }
+    return prefix;
+}
+
+/**
+ * LINEAR SCAN BASELINE - Fold every name, sort the matches, keep k
+ */
+static int scanSearch(const std::vector<Patient>& patients, const std::string& prefix, int k) {
+    std::string folded = NameIndex::fold(prefix);
+    std::vector<std::pair<std::string, int> > matches;
+    for (size_t i = 0; i < patients.size(); i++) {
+        std::string name = NameIndex::fold(patients[i].name);
+        if (name.compare(0, folded.size(), folded) == 0) {
+            matches.push_back(std::make_pair(name, patients[i].id));
+        }
+    }
+    size_t keep = std::min(matches.size(), (size_t)k);
+    std::partial_sort(matches.begin(), matches.begin() + keep, matches.end());
+    return (int)keep;
+}
+
+int main(int argc, char* argv[]) {
+    long long names = 5000000;
+    long long queries = 200000;
+    int k = 10;
+    int scanQueries = 5;
+
+    BenchmarkOptions options(BenchmarkOptions::SCENARIO);
+    options.option("--names", names);
+    options.option("--queries", queries);
+    options.option("--k", k);
+    options.option("--scan-queries", scanQueries);
+    if (!options.parse(argc, argv)) {
+        return 1;
+    }
+    if (names <= 0 || queries <= 0 || k <= 0 || scanQueries < 0) {
+        std::cerr << "--names, --queries and --k must be positive" << std::endl;
+        return 1;
+    }
+
+    std::mt19937_64 rng(2024);
+    std::vector<Patient> patients;
+    patients.reserve((size_t)names);
+    for (long long i = 0; i < names; i++) {
+        std::string name = std::string(GIVEN_NAMES[rng() % GIVEN_COUNT]) + " " + surname(rng) + " " + surname(rng);
+        patients.push_back(Patient((int)i + 1, name, 40, 3, "Fever"));
+    }
+
+    NameIndex index;
+    BenchmarkState build(names);
+    build.begin();
+    for (size_t i = 0; i < patients.size(); i++) {
+        index.insert(&patients[i]);
+    }
+    build.end();
+    build.setItemsProcessed(names);
+    double buildSeconds = build.elapsedWall();
+
+    Histogram overall;
+    std::vector<Histogram> byLength(MAX_PREFIX + 1);
+    std::vector<Patient*> results;
+    results.reserve((size_t)k);
+    long long returned = 0;
+    BenchmarkState search(queries);
+    search.begin();
+    for (long long q = 0; q < queries; q++) {
+        int length = 1 + (int)(rng() % MAX_PREFIX);
+        std::string prefix = makePrefix(patients[rng() % patients.size()].name, length, q % 2 == 0);
+        results.clear();
+        long long start = benchmarkNanos();
+        returned += index.prefixSearch(prefix, k, results);
+        std::uint64_t nanos = (std::uint64_t)(benchmarkNanos() - start);
+        overall.record(nanos);
+        byLength[(size_t)length].record(nanos);
+    }
+    search.end();
+    search.setItemsProcessed(queries);
+    double querySeconds = search.elapsedWall();
+
+    std::vector<std::string> scanPrefixes;
+    for (int q = 0; q < scanQueries; q++) {
+        scanPrefixes.push_back(makePrefix(patients[rng() % patients.size()].name, 4, false));
+    }
+    BenchmarkState scan(scanQueries);
+    scan.begin();
+    for (int q = 0; q < scanQueries; q++) {
+        doNotOptimize(scanSearch(patients, scanPrefixes[(size_t)q], k));
+    }
+    scan.end();
+    double scanMillis = scanQueries > 0 ? scan.elapsedWall() * 1e3 / scanQueries : 0.0;
+
+    std::vector<BenchmarkResult> measured;
+    measured.push_back(benchmarkResult("nameindex/build", build)
+                           .counter("nodes", (double)index.nodeCount())
+                           .counter("index_bytes", (double)index.memoryBytes()));
+    measured.push_back(benchmarkResult("nameindex/search", search)
+                           .latency(overall)
+                           .counter("results_per_query", (double)returned / queries));
+    for (int length = 1; length <= MAX_PREFIX; length++) {
+        measured.push_back(latencyResult("nameindex/search/length:" + std::to_string(length),
+                                         byLength[(size_t)length]));
+    }
+    if (scanQueries > 0) {
+        measured.push_back(benchmarkResult("nameindex/scan", scan));
+    }
+
+    printBenchmarkBanner("NAME PREFIX INDEX BENCHMARK");
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "Names: " << names << " | Nodes: " << index.nodeCount() << " | Index memory: "
+              << index.memoryBytes() / (1024.0 * 1024.0) << " MB (" << (double)index.memoryBytes() / names
+              << " bytes/name)" << std::endl;
+    std::cout << "Build: " << buildSeconds << " s | " << std::setprecision(0) << names / buildSeconds
+              << " inserts/s" << std::endl;
+    std::cout << "Queries: " << queries << " (top " << k << ") | " << queries / querySeconds << " queries/s | "
+              << std::setprecision(2) << (double)returned / queries << " results/query" << std::endl;
+    std::cout << "Latency (us): p50 " << overall.percentile(50.0) / 1000.0 << " | p99 "
+              << overall.percentile(99.0) / 1000.0 << " | p99.9 " << overall.percentile(99.9) / 1000.0 << std::endl;
+    std::cout << "\n" << std::setw(14) << "Prefix length" << std::setw(12) << "p50 (us)" << std::setw(12) << "p99 (us)"
+              << std::endl;
+    for (int length = 1; length <= MAX_PREFIX; length++) {
+        std::cout << std::setw(14) << length << std::setw(12) << byLength[(size_t)length].percentile(50.0) / 1000.0
+                  << std::setw(12) << byLength[(size_t)length].percentile(99.0) / 1000.0 << std::endl;
+    }
+    if (scanQueries > 0) {
+        std::cout << "\nLinear scan baseline: " << std::setprecision(1) << scanMillis << " ms/query ("
+                  << std::setprecision(0) << scanMillis * 1e6 / std::max(1.0, (double)overall.percentile(50.0))
+                  << "x the indexed p50)" << std::endl;
+    }
+    std::cout << "==================================================" << std::endl;
+
+    return finishBenchmarks(options, measured);
+}
@@ -0,0 +1,233 @@
+#include "benchmark.h"
+#include "hospitalnetwork.h"
+#include <atomic>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * SHARDED HOSPITAL NETWORK BENCHMARK
+ *
+ * SCALING: for each shard count S, a network of S sites (least-loaded
+ * routing, owner threads pinned to cores 0..S-1) is driven by S client
+ * threads. Each client issues visits: register (routed), then attend and
+ * free on the shard the registration went to, with up to --window
+ * futures outstanding. A monitor thread reads aggregateStatus() in a loop
+ * to show that cross-shard status costs no queue round trip; its cost
+ * per call is then timed on the idle network.
+ * Reported: commands/s, speed-up over one shard, aggregate reads.
+ *
+ * ROUTING: registrations only, from locations clustered around site 0,
+ * into sites with different room counts. For every policy the share of
+ * patients per room of each site is reported (max / min = imbalance).
+ *
+ * OPTIONS: --shards 1,2,4,8 (default 1,2,4 and the hardware threads),
+ *          --visits N per client (default 50000), --window W (64),
+ *          --json FILE
+ */
+
+struct ScalingResult {
+    int shards;
+    double seconds;
+    long long aggregateReads;
+    double aggregateNanos;  ///< Cost of one aggregateStatus() call, measured after the run
+    bool pinned;
+    BenchmarkResult measured;
+};
+
+struct RoutingResult {
+    std::string policy;
+    std::vector<int> registered;
+    double imbalance;  ///< Max / min patients per room across sites
+    BenchmarkResult measured;
+};
+
+static void client(HospitalNetwork& network, int clientId, long long visits, int window) {
+    std::vector<std::future<int> > ids((size_t)window);
+    std::vector<std::future<PatientSnapshot> > attends((size_t)window);
+    std::vector<std::future<PatientSnapshot> > frees((size_t)window);
+    for (long long v = 0; v < visits; v++) {
+        size_t slot = (size_t)(v % window);
+        if (v >= window) {
+            ids[slot].get();
+            attends[slot].get();
+            frees[slot].get();
+        }
+        NetworkTicket ticket = network.registerPatient("Network Patient", 40, 1 + (int)((v + clientId) % 5), "Fever");
+        ids[slot] = std::move(ticket.patientId);
+        attends[slot] = network.attendNextPatient(ticket.shard);
+        frees[slot] = network.freeConsultationRoom(ticket.shard);
+    }
+    for (long long v = visits > window ? visits - window : 0; v < visits; v++) {
+        size_t slot = (size_t)(v % window);
+        ids[slot].get();
+        attends[slot].get();
+        frees[slot].get();
+    }
+}
+
+static ScalingResult runScaling(int shards, long long visits, int window) {
+    std::vector<SiteConfig> sites;
+    for (int s = 0; s < shards; s++) {
+        sites.push_back(SiteConfig("Site " + std::to_string(s), 10));
+    }
+    HospitalNetwork network(sites, new LeastLoadedPolicy());
+
+    std::atomic<bool> running(true);
+    long long reads = 0;
+    std::thread monitor([&]() {
+        while (running.load(std::memory_order_relaxed)) {
+            SystemStatus total = network.aggregateStatus();
+            reads += total.rooms > 0 ? 1 : 0;
+            std::this_thread::yield();
+        }
+    });
+
+    long long commands = visits * shards * 3;
+    BenchmarkState state(commands);
+    state.begin();
+    std::vector<std::thread> clients;
+    for (int c = 0; c < shards; c++) {
+        clients.push_back(std::thread(client, std::ref(network), c, visits, window));
+    }
+    for (size_t c = 0; c < clients.size(); c++) {
+        clients[c].join();
+    }
+    state.end();
+    state.setItemsProcessed(commands);
+    ScalingResult result;
+    result.seconds = state.elapsedWall();
+    running.store(false, std::memory_order_relaxed);
+    monitor.join();
+
+    const int calls = 1000000;
+    int checksum = 0;
+    long long readStart = benchmarkNanos();
+    for (int c = 0; c < calls; c++) {
+        checksum += network.aggregateStatus().registered;
+    }
+    result.aggregateNanos = (double)(benchmarkNanos() - readStart) / calls;
+    doNotOptimize(checksum);
+
+    result.shards = shards;
+    result.aggregateReads = reads;
+    result.pinned = true;
+    for (int s = 0; s < shards; s++) {
+        result.pinned = result.pinned && network.engine(s).isPinned();
+    }
+    result.measured = benchmarkResult("scaling/shards:" + std::to_string(shards), state)
+                          .counter("aggregate_reads_per_second", reads / result.seconds)
+                          .counter("aggregate_read_ns", result.aggregateNanos)
+                          .counter("pinned", result.pinned ? 1.0 : 0.0);
+    return result;
+}
+
+static RoutingResult runRouting(RoutingPolicy* policy, long long patients) {
+    std::vector<SiteConfig> sites;
+    sites.push_back(SiteConfig("Centro", 20, 0.0, 0.0));
+    sites.push_back(SiteConfig("Norte", 10, 0.0, 10.0));
+    sites.push_back(SiteConfig("Sur", 10, 0.0, -10.0));
+    sites.push_back(SiteConfig("Rural", 5, 30.0, 0.0));
+    HospitalNetwork network(sites, policy, false);
+
+    RoutingResult result;
+    result.policy = network.policyName();
+    std::mt19937_64 rng(7);
+    std::normal_distribution<double> near(0.0, 6.0);  // Most patients live around Centro
+    std::vector<std::future<int> > ids;
+    ids.reserve((size_t)patients);
+    BenchmarkState state(patients);
+    state.begin();
+    for (long long p = 0; p < patients; p++) {
+        ids.push_back(network.registerPatient("Routed Patient", 40, 1 + (int)(p % 5), "Fever", near(rng), near(rng))
+                          .patientId);
+    }
+    for (size_t i = 0; i < ids.size(); i++) {
+        ids[i].get();
+    }
+    state.end();
+    state.setItemsProcessed(patients);
+
+    double lowest = 0.0, highest = 0.0;
+    for (int s = 0; s < network.shardCount(); s++) {
+        int registered = network.engine(s).publishedStatus().registered;
+        result.registered.push_back(registered);
+        double perRoom = (double)registered / sites[(size_t)s].rooms;
+        if (s == 0 || perRoom < lowest) lowest = perRoom;
+        if (s == 0 || perRoom > highest) highest = perRoom;
+    }
+    result.imbalance = lowest > 0.0 ? highest / lowest : 0.0;
+
+    result.measured = benchmarkResult("routing/" + result.policy, state);
+    for (size_t s = 0; s < result.registered.size(); s++) {
+        result.measured.counter("registered_" + std::to_string(s), result.registered[s]);
+    }
+    result.measured.counter("imbalance", result.imbalance);
+    return result;
+}
+
+int main(int argc, char* argv[]) {
+    long long visits = 50000;
+    int window = 64;
+    std::vector<int> shardCounts = {1, 2, 4};
+    int cores = (int)std::thread::hardware_concurrency();
+    if (cores > 4) shardCounts.push_back(cores);
+
+    BenchmarkOptions options(BenchmarkOptions::SCENARIO);
+    options.option("--shards", shardCounts);
+    options.option("--visits", visits);
+    options.option("--window", window);
+    if (!options.parse(argc, argv)) {
+        return 1;
+    }
+    if (visits <= 0 || window <= 0) {
+        std::cerr << "--visits and --window must be positive" << std::endl;
+        return 1;
+    }
+
+    std::vector<ScalingResult> scaling;
+    for (size_t i = 0; i < shardCounts.size(); i++) {
+        if (shardCounts[i] > 0) scaling.push_back(runScaling(shardCounts[i], visits, window));
+    }
+    std::vector<RoutingResult> routing;
+    routing.push_back(runRouting(new LeastLoadedPolicy(), visits));
+    routing.push_back(runRouting(new NearestPolicy(), visits));
+    routing.push_back(runRouting(new RoundRobinPolicy(), visits));
+
+    printBenchmarkBanner("SHARDED HOSPITAL NETWORK BENCHMARK");
+    std::cout << "Visits per client: " << visits << " (3 commands each) | Window: " << window
+              << " | Hardware threads: " << cores << std::endl;
+    std::cout << "\n" << std::setw(7) << "Shards" << std::setw(14) << "Commands/s" << std::setw(10) << "Speed-up"
+              << std::setw(18) << "Aggregate reads/s" << std::setw(12) << "ns/read" << std::setw(8) << "Pinned"
+              << std::endl;
+    std::vector<BenchmarkResult> results;
+    double base = scaling.empty() ? 1.0 : scaling[0].measured.itemsPerSecond;
+    for (size_t i = 0; i < scaling.size(); i++) {
+        const ScalingResult& r = scaling[i];
+        results.push_back(r.measured);
+        std::cout << std::setw(7) << r.shards << std::fixed << std::setprecision(0) << std::setw(14)
+                  << r.measured.itemsPerSecond << std::setprecision(2) << std::setw(10)
+                  << r.measured.itemsPerSecond / base << std::setprecision(0) << std::setw(18)
+                  << r.aggregateReads / r.seconds << std::setprecision(1) << std::setw(12) << r.aggregateNanos
+                  << std::setw(8) << (r.pinned ? "yes" : "no") << std::endl;
+    }
+    std::cout << "\nRouting " << visits << " registrations (rooms 20/10/10/5, patients near site 0):" << std::endl;
+    std::cout << std::left << std::setw(14) << "Policy" << std::right << std::setw(9) << "Centro" << std::setw(9)
+              << "Norte" << std::setw(9) << "Sur" << std::setw(9) << "Rural" << std::setw(12) << "Imbalance"
+              << std::endl;
+    for (size_t i = 0; i < routing.size(); i++) {
+        results.push_back(routing[i].measured);
+        std::cout << std::left << std::setw(14) << routing[i].policy << std::right;
+        for (size_t s = 0; s < routing[i].registered.size(); s++) {
+            std::cout << std::setw(9) << routing[i].registered[s];
+        }
+        std::cout << std::setprecision(2) << std::setw(12) << routing[i].imbalance << std::endl;
+    }
+    std::cout << "==================================================" << std::endl;
+
+    return finishBenchmarks(options, results);
+}
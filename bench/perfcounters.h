@@ -0,0 +1,191 @@
+#ifndef PERFCOUNTERS_H
+#define PERFCOUNTERS_H
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/**
+ * HARDWARE PERFORMANCE COUNTERS (LINUX perf_event_open)
+ *
+ * USAGE:
+ *   PerfCounters counters;
+ *   if (counters.open()) {
+ *       counters.reset(); counters.start(); ... counters.stop();
+ *       double misses = counters.value(PerfCounters::L1D_MISSES);
+ *   }
+ *
+ * DESIGN:
+ * - One counter per event for the calling thread, user space only
+ *   (works with the default perf_event_paranoid = 2)
+ * - Events are opened independently: a PMU that lacks one event (common
+ *   for LLC counters in virtual machines) still reports the others
+ * - Values are scaled by time_enabled / time_running when the kernel
+ *   multiplexes more events than the PMU has registers
+ *
+ * FALLBACK: On non-Linux systems, in containers without a PMU, or when
+ * perf_event_open is forbidden, open() returns false and every counter
+ * reads as unavailable; the caller keeps its wall-clock timings.
+ */
+class PerfCounters {
+public:
+    enum Counter { CYCLES, INSTRUCTIONS, L1D_MISSES, LLC_MISSES, BRANCH_MISSES, COUNTER_COUNT };
+
+    static const char* name(int counter) {
+        static const char* const NAMES[COUNTER_COUNT] = {
+            "cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses"
+        };
+        return NAMES[counter];
+    }
+
+private:
+    int descriptors[COUNTER_COUNT];  ///< One perf fd per counter (-1 = unavailable)
+    double totals[COUNTER_COUNT];    ///< Scaled counts accumulated by stop()
+    std::string failure;             ///< Reason open() failed
+
+#ifdef __linux__
+    struct ReadFormat {
+        std::uint64_t value;
+        std::uint64_t timeEnabled;
+        std::uint64_t timeRunning;
+    };
+
+    ReadFormat baseline[COUNTER_COUNT];  ///< Readings taken by start()
+
+    static int openEvent(std::uint32_t type, std::uint64_t config) {
+        perf_event_attr attributes;
+        std::memset(&attributes, 0, sizeof(attributes));
+        attributes.size = sizeof(attributes);
+        attributes.type = type;
+        attributes.config = config;
+        attributes.disabled = 1;
+        attributes.exclude_kernel = 1;
+        attributes.exclude_hv = 1;
+        attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        return (int)syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0);
+    }
+
+    static ReadFormat readRaw(int descriptor) {
+        ReadFormat data;
+        if (::read(descriptor, &data, sizeof(data)) != (ssize_t)sizeof(data)) {
+            std::memset(&data, 0, sizeof(data));
+        }
+        return data;
+    }
+
+    /**
+     * EVENTS COUNTED SINCE A BASELINE, EXTRAPOLATED OVER MULTIPLEXED GAPS
+     */
+    static double scaledDelta(const ReadFormat& from, const ReadFormat& to) {
+        std::uint64_t running = to.timeRunning - from.timeRunning;
+        if (running == 0) {
+            return 0.0;
+        }
+        double enabled = (double)(to.timeEnabled - from.timeEnabled);
+        return (double)(to.value - from.value) * (enabled / (double)running);
+    }
+#endif
+
+public:
+    PerfCounters() : failure("not opened") {
+        for (int i = 0; i < COUNTER_COUNT; i++) {
+            descriptors[i] = -1;
+            totals[i] = 0.0;
+        }
+    }
+
+    ~PerfCounters() {
+        close();
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    /**
+     * OPEN ALL COUNTERS FOR THE CALLING THREAD
+     * @return true if at least one counter is available
+     */
+    bool open() {
+        close();
+#ifdef __linux__
+        const std::uint64_t l1dReadMiss = PERF_COUNT_HW_CACHE_L1D
+                                          | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                                          | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        descriptors[CYCLES] = openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+        descriptors[INSTRUCTIONS] = openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+        descriptors[L1D_MISSES] = openEvent(PERF_TYPE_HW_CACHE, l1dReadMiss);
+        descriptors[LLC_MISSES] = openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+        descriptors[BRANCH_MISSES] = openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+        int saved = errno;
+        for (int i = 0; i < COUNTER_COUNT; i++) {
+            if (descriptors[i] >= 0) {
+                failure.clear();
+                return true;
+            }
+        }
+        failure = std::string("perf_event_open failed: ") + std::strerror(saved);
+#else
+        failure = "perf_event_open is only available on Linux";
+#endif
+        return false;
+    }
+
+    void close() {
+        for (int i = 0; i < COUNTER_COUNT; i++) {
+#ifdef __linux__
+            if (descriptors[i] >= 0) {
+                ::close(descriptors[i]);
+            }
+#endif
+            descriptors[i] = -1;
+        }
+    }
+
+    /**
+     * ZERO THE ACCUMULATED TOTALS
+     */
+    void reset() {
+        for (int i = 0; i < COUNTER_COUNT; i++) {
+            totals[i] = 0.0;
+        }
+    }
+
+    /**
+     * START / STOP COUNTING - Pairs may repeat; totals accumulate
+     */
+    void start() {
+#ifdef __linux__
+        for (int i = 0; i < COUNTER_COUNT; i++) {
+            if (descriptors[i] >= 0) {
+                ioctl(descriptors[i], PERF_EVENT_IOC_ENABLE, 0);
+                baseline[i] = readRaw(descriptors[i]);
+            }
+        }
+#endif
+    }
+
+    void stop() {
+#ifdef __linux__
+        for (int i = 0; i < COUNTER_COUNT; i++) {
+            if (descriptors[i] >= 0) {
+                ioctl(descriptors[i], PERF_EVENT_IOC_DISABLE, 0);
+                totals[i] += scaledDelta(baseline[i], readRaw(descriptors[i]));
+            }
+        }
+#endif
+    }
+
+    bool available(int counter) const { return descriptors[counter] >= 0; }
+    double value(int counter) const { return totals[counter]; }
+    const std::string& error() const { return failure; }
+};
+
+#endif
@@ -0,0 +1,127 @@
+#include "benchmark.h"
+#include "hospitalsystem.h"
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+
+/**
+ * END-TO-END PIPELINE BENCHMARK
+ *
+ * Drives register -> attend -> free through a silent HospitalSystem while
+ * holding occupancy steady:
+ * - Warm-up fills triage to --waiting patients and all but one room
+ * - Each cycle registers one patient, attends one (rooms become full) and
+ *   frees one (back to rooms - 1), then searches one random registered ID
+ * - Triage depth and room occupancy are therefore constant, so any growth
+ *   of per-operation latency with --patients is a scalability regression
+ *   (e.g. an O(n) database scan hidden inside an operation)
+ *
+ * OUTPUT: ops/sec and p50/p99/p99.9 latency per operation type from HDR
+ * histograms, optionally written as JSON (--json FILE)
+ *
+ * OPTIONS: --patients N (default 1000000, scales to 10M), --rooms R,
+ *          --waiting W, --json FILE
+ */
+
+enum PipelineOperation { OP_REGISTER, OP_ATTEND, OP_FREE, OP_SEARCH, OP_COUNT };
+
+static const char* const OPERATION_NAMES[OP_COUNT] = {"register", "attend", "free", "search"};
+
+int main(int argc, char* argv[]) {
+    long long patients = 1000000;
+    int rooms = 10;
+    int waiting = 100;
+
+    BenchmarkOptions options(BenchmarkOptions::SCENARIO);
+    options.option("--patients", patients);
+    options.option("--rooms", rooms);
+    options.option("--waiting", waiting);
+    if (!options.parse(argc, argv)) {
+        return 1;
+    }
+    if (patients <= waiting + rooms || rooms < 2) {
+        std::cerr << "--patients must exceed --waiting + --rooms, and --rooms must be >= 2" << std::endl;
+        return 1;
+    }
+
+    std::unique_ptr<Histogram[]> latency(new Histogram[OP_COUNT]);
+    HospitalSystem hospital(rooms, false);
+    std::mt19937_64 rng(99);
+    const std::string name = "Bench Patient";
+    const std::string symptom = "Fever";
+
+    // Warm-up: steady triage depth and rooms - 1 occupied
+    long long registered = 0;
+    for (int i = 0; i < waiting + rooms - 1; i++) {
+        hospital.registerPatient(name, 40, 1 + (int)(rng() % 5), symptom);
+        registered++;
+    }
+    for (int i = 0; i < rooms - 1; i++) {
+        hospital.attendNextPatient();
+    }
+
+    long long cycles = patients - registered;
+    BenchmarkState state(cycles * OP_COUNT);
+    long long failures = 0;
+
+    state.begin();
+    while (registered < patients) {
+        int priority = 1 + (int)(rng() % 5);
+        int searchId = 1 + (int)(rng() % (unsigned long long)registered);
+
+        long long t = benchmarkNanos();
+        hospital.registerPatient(name, 40, priority, symptom);
+        long long after = benchmarkNanos();
+        latency[OP_REGISTER].record((std::uint64_t)(after - t));
+        registered++;
+
+        t = after;
+        failures += hospital.attendNextPatient() == NULL;
+        after = benchmarkNanos();
+        latency[OP_ATTEND].record((std::uint64_t)(after - t));
+
+        t = after;
+        failures += hospital.freeConsultationRoom() == NULL;
+        after = benchmarkNanos();
+        latency[OP_FREE].record((std::uint64_t)(after - t));
+
+        t = after;
+        failures += hospital.searchPatient(searchId) == NULL;
+        latency[OP_SEARCH].record((std::uint64_t)(benchmarkNanos() - t));
+    }
+    state.end();
+    state.setItemsProcessed(cycles * OP_COUNT);
+
+    double seconds = state.elapsedWall();
+    std::vector<BenchmarkResult> results;
+    results.push_back(benchmarkResult("pipeline", state).counter("patients_per_second", cycles / seconds));
+    for (int op = 0; op < OP_COUNT; op++) {
+        results.push_back(latencyResult(std::string("pipeline/") + OPERATION_NAMES[op], latency[op]));
+    }
+
+    printBenchmarkBanner("END-TO-END PIPELINE BENCHMARK");
+    std::cout << "Patients: " << patients << " | Rooms: " << rooms
+              << " | Steady triage depth: " << waiting << std::endl;
+    std::cout << std::fixed << std::setprecision(3) << "Elapsed: " << seconds << " s | "
+              << std::setprecision(0) << results[0].itemsPerSecond << " ops/s | "
+              << cycles / seconds << " patients/s" << std::endl;
+
+    std::cout << "\n=== LATENCY PER OPERATION (nanoseconds) ===" << std::endl;
+    std::cout << std::left << std::setw(10) << "Operation" << std::right << std::setw(12) << "Count"
+              << std::setw(10) << "Mean" << std::setw(10) << "p50" << std::setw(10) << "p99"
+              << std::setw(10) << "p99.9" << std::setw(12) << "Max" << std::endl;
+    for (int op = 0; op < OP_COUNT; op++) {
+        const Histogram& h = latency[op];
+        std::cout << std::left << std::setw(10) << OPERATION_NAMES[op] << std::right
+                  << std::setw(12) << h.count() << std::setw(10) << std::setprecision(0) << h.mean()
+                  << std::setw(10) << h.percentile(50.0) << std::setw(10) << h.percentile(99.0)
+                  << std::setw(10) << h.percentile(99.9) << std::setw(12) << h.max() << std::endl;
+    }
+    std::cout << "==================================================" << std::endl;
+
+    BenchmarkChecks checks;
+    checks.expect(failures == 0, std::to_string(failures) + " operations returned no patient");
+    return finishBenchmarks(options, results, checks);
+}
@@ -0,0 +1,313 @@
+#include "benchmark.h"
+#include "rollingmetrics.h"
+#include <algorithm>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * ROLLING METRICS BENCHMARK
+ *
+ * A queue of --rooms rooms is run for --days simulated days: Poisson
+ * arrivals at --rate per hour, exponential consultations sized for 90%
+ * occupancy, first come first served. Every operation (arrival, patient
+ * roomed, discharge) is recorded the way HospitalSystem does it: one
+ * counter event plus the occupied-rooms and waiting gauges.
+ *
+ * UPDATE COST per operation:
+ * - rolling: RollingMetrics (three bucket rings)
+ * - raw: append the operation to an event vector (what a rescan needs)
+ *
+ * QUERIES at the end of the run, from the rings and by rescanning the raw
+ * operations (binary search to the window, then a pass over it):
+ * - arrivals per 5 minutes over the last 24 hours (288 points)
+ * - occupied rooms per hour over the last 24 hours (mean and max)
+ * - arrivals per day over the last 30 days
+ *
+ * CHECK: every point must be identical (counts, maxima and the exact
+ * time-weighted means).
+ *
+ * OPTIONS: --days D (default 30), --rate R (default 600), --rooms N
+ *          (default 40), --queries Q (default 1000), --json FILE
+ */
+
+static const long long SECOND = 1000000000LL;
+
+struct Operation {
+    long long time;
+    RollingCounter counter;
+    int occupied;  ///< Gauges after the operation
+    int waiting;
+};
+
+/**
+ * SIMULATED OPERATIONS IN TIME ORDER
+ */
+static std::vector<Operation> simulate(long long start, double days, double rate, int rooms, unsigned seed) {
+    std::mt19937_64 rng(seed);
+    std::exponential_distribution<double> gap(rate / 3600.0);
+    std::exponential_distribution<double> service(rate / 3600.0 / (0.9 * rooms));
+    std::priority_queue<long long, std::vector<long long>, std::greater<long long> > ends;
+    std::vector<Operation> operations;
+    long long horizon = start + (long long)(days * 86400.0 * SECOND);
+    long long nextArrival = start + (long long)(gap(rng) * SECOND);
+    int occupied = 0;
+    int waiting = 0;
+
+    while (true) {
+        bool arrival = ends.empty() || nextArrival <= ends.top();
+        long long now = arrival ? nextArrival : ends.top();
+        if (now >= horizon) {
+            break;
+        }
+        if (arrival) {
+            waiting++;
+            Operation op = {now, ROLLING_ARRIVALS, occupied, waiting};
+            operations.push_back(op);
+            nextArrival = now + 1 + (long long)(gap(rng) * SECOND);
+        } else {
+            ends.pop();
+            occupied--;
+            Operation op = {now, ROLLING_DISCHARGES, occupied, waiting};
+            operations.push_back(op);
+        }
+        if (waiting > 0 && occupied < rooms) {
+            waiting--;
+            occupied++;
+            ends.push(now + 1 + (long long)(service(rng) * SECOND));
+            Operation op = {now, ROLLING_ATTENDED, occupied, waiting};
+            operations.push_back(op);
+        }
+    }
+    return operations;
+}
+
+/**
+ * RESCAN OF THE RAW OPERATIONS - same points as RollingMetrics
+ */
+struct RawScan {
+    const std::vector<Operation>& ops;
+    long long origin;  ///< Time the rolling metrics were created at
+    long long now;
+
+    size_t firstAtOrAfter(long long time) const {
+        size_t low = 0, high = ops.size();
+        while (low < high) {
+            size_t mid = (low + high) / 2;
+            if (ops[mid].time < time) low = mid + 1; else high = mid;
+        }
+        return low;
+    }
+
+    std::vector<RollingPoint> counter(RollingCounter counter, long long unit, long long current, int groups,
+                                      int width) const {
+        std::vector<RollingPoint> series((size_t)groups);
+        long long start = (current / width - (groups - 1)) * width;
+        size_t i = firstAtOrAfter(start * unit);
+        for (int g = 0; g < groups; g++, start += width) {
+            RollingPoint& point = series[(size_t)g];
+            point.startNanos = start * unit;
+            point.count = 0;
+            point.mean = 0.0;
+            point.max = 0;
+            for (; i < ops.size() && ops[i].time < (start + width) * unit; i++) {
+                point.count += ops[i].counter == counter;
+            }
+        }
+        return series;
+    }
+
+    std::vector<RollingPoint> occupancy(long long unit, long long current, int groups, int width) const {
+        std::vector<RollingPoint> series((size_t)groups);
+        long long start = (current / width - (groups - 1)) * width;
+        for (int g = 0; g < groups; g++, start += width) {
+            RollingPoint& point = series[(size_t)g];
+            point.startNanos = start * unit;
+            point.count = 0;
+            point.mean = 0.0;
+            point.max = 0;
+            long long from = std::max(start * unit, origin);
+            long long to = std::min((start + width) * unit, now);
+            if (from > to || (from == to && from != now)) {
+                continue;
+            }
+            // Value carried into the window (changes at exactly 'from' apply after it)
+            size_t i = firstAtOrAfter(from);
+            int value = i > 0 ? ops[i - 1].occupied : 0;
+            point.max = value;
+            RollingMetrics::GaugeArea area = 0;
+            long long at = from;
+            for (; i < ops.size() && ops[i].time < (start + width) * unit && ops[i].time <= to; i++) {
+                area += (RollingMetrics::GaugeArea)value * (ops[i].time - at);
+                at = ops[i].time;
+                value = ops[i].occupied;
+                point.max = std::max(point.max, value);
+            }
+            area += (RollingMetrics::GaugeArea)value * (to - at);
+            point.mean = to > from ? (double)area / (double)(to - from) : 0.0;
+        }
+        return series;
+    }
+};
+
+static bool same(const std::vector<RollingPoint>& a, const std::vector<RollingPoint>& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); i++) {
+        if (a[i].startNanos != b[i].startNanos || a[i].count != b[i].count || a[i].mean != b[i].mean ||
+            a[i].max != b[i].max) {
+            return false;
+        }
+    }
+    return true;
+}
+
+struct QueryCost {
+    const char* name;
+    BenchmarkState rolling;
+    BenchmarkState scan;
+
+    QueryCost(const char* queryName, long long queries) : name(queryName), rolling(queries), scan(queries) {}
+};
+
+int main(int argc, char* argv[]) {
+    double days = 30.0;
+    double rate = 600.0;
+    int rooms = 40;
+    int queries = 1000;
+
+    BenchmarkOptions options(BenchmarkOptions::SCENARIO);
+    options.option("--days", days);
+    options.option("--rate", rate);
+    options.option("--rooms", rooms);
+    options.option("--queries", queries);
+    if (!options.parse(argc, argv)) {
+        return 1;
+    }
+    if (days <= 0 || rate <= 0 || rooms <= 0 || queries <= 0) {
+        std::cerr << "--days, --rate, --rooms and --queries must be positive" << std::endl;
+        return 1;
+    }
+
+    // Start part-way through a day so points are not trivially aligned with the run
+    long long origin = 20000 * RollingMetrics::DAY_NANOS + 7 * RollingMetrics::HOUR_NANOS + 123456789LL;
+    std::vector<Operation> ops = simulate(origin, days, rate, rooms, 7400u);
+    if (ops.empty()) {
+        std::cerr << "No operations simulated" << std::endl;
+        return 1;
+    }
+    size_t n = ops.size();
+
+    // UPDATE COST
+    RollingMetrics metrics(origin);
+    BenchmarkState rollingUpdate((long long)n);
+    rollingUpdate.begin();
+    for (size_t i = 0; i < n; i++) {
+        metrics.count(ops[i].counter, ops[i].time);
+        metrics.set(ROLLING_OCCUPIED_ROOMS, ops[i].occupied, ops[i].time);
+        metrics.set(ROLLING_WAITING, ops[i].waiting, ops[i].time);
+    }
+    rollingUpdate.end();
+    rollingUpdate.setItemsProcessed((long long)n);
+
+    std::vector<Operation> raw;
+    BenchmarkState rawUpdate((long long)n);
+    rawUpdate.begin();
+    for (size_t i = 0; i < n; i++) {
+        raw.push_back(ops[i]);
+    }
+    rawUpdate.end();
+    rawUpdate.setItemsProcessed((long long)n);
+
+    // QUERIES
+    long long now = ops.back().time;
+    metrics.advance(now);
+    RawScan scan = {raw, origin, now};
+    long long minute = now / RollingMetrics::MINUTE_NANOS;
+    long long hour = now / RollingMetrics::HOUR_NANOS;
+    long long day = now / RollingMetrics::DAY_NANOS;
+    int dayPoints = std::min(30, metrics.capacity(ROLLING_DAY));
+    QueryCost costs[3] = {QueryCost("arrivals_5min_24h", queries), QueryCost("occupancy_1h_24h", queries),
+                          QueryCost("arrivals_1d_30d", queries)};
+    BenchmarkChecks checks;
+    long long sink = 0;
+    std::vector<RollingPoint> fromRings;
+    std::vector<RollingPoint> fromScan;
+
+    costs[0].rolling.begin();
+    for (int q = 0; q < queries; q++) {
+        fromRings = metrics.counterSeries(ROLLING_ARRIVALS, ROLLING_MINUTE, 288, 5);
+        sink += fromRings.back().count;
+    }
+    costs[0].rolling.end();
+    costs[0].scan.begin();
+    for (int q = 0; q < queries; q++) {
+        fromScan = scan.counter(ROLLING_ARRIVALS, RollingMetrics::MINUTE_NANOS, minute, 288, 5);
+        sink += fromScan.back().count;
+    }
+    costs[0].scan.end();
+    checks.expect(same(fromRings, fromScan), std::string(costs[0].name) + ": rings match the rescan");
+
+    costs[1].rolling.begin();
+    for (int q = 0; q < queries; q++) {
+        fromRings = metrics.gaugeSeries(ROLLING_OCCUPIED_ROOMS, ROLLING_HOUR, 24);
+        sink += fromRings.back().max;
+    }
+    costs[1].rolling.end();
+    costs[1].scan.begin();
+    for (int q = 0; q < queries; q++) {
+        fromScan = scan.occupancy(RollingMetrics::HOUR_NANOS, hour, 24, 1);
+        sink += fromScan.back().max;
+    }
+    costs[1].scan.end();
+    checks.expect(same(fromRings, fromScan), std::string(costs[1].name) + ": rings match the rescan");
+
+    costs[2].rolling.begin();
+    for (int q = 0; q < queries; q++) {
+        fromRings = metrics.counterSeries(ROLLING_ARRIVALS, ROLLING_DAY, dayPoints);
+        sink += fromRings.back().count;
+    }
+    costs[2].rolling.end();
+    costs[2].scan.begin();
+    for (int q = 0; q < queries; q++) {
+        fromScan = scan.counter(ROLLING_ARRIVALS, RollingMetrics::DAY_NANOS, day, dayPoints, 1);
+        sink += fromScan.back().count;
+    }
+    costs[2].scan.end();
+    checks.expect(same(fromRings, fromScan), std::string(costs[2].name) + ": rings match the rescan");
+
+    std::vector<BenchmarkResult> results;
+    results.push_back(benchmarkResult("update/rolling", rollingUpdate));
+    results.push_back(benchmarkResult("update/raw", rawUpdate));
+    for (int i = 0; i < 3; i++) {
+        results.push_back(benchmarkResult(std::string("query/") + costs[i].name + "/rolling", costs[i].rolling));
+        results.push_back(benchmarkResult(std::string("query/") + costs[i].name + "/rescan", costs[i].scan));
+    }
+    long long ringBytes = (long long)(metrics.capacity(ROLLING_MINUTE) + metrics.capacity(ROLLING_HOUR) +
+                                      metrics.capacity(ROLLING_DAY)) * 80;
+
+    printBenchmarkBanner("ROLLING METRICS BENCHMARK");
+    std::cout << "Simulated: " << days << " days | " << rate << " arrivals/h | " << rooms << " rooms | "
+              << n << " operations | check sum " << (sink & 0xFFFF) << std::endl;
+    std::cout << "Memory: rings ~" << ringBytes / 1024 << " KB (fixed) | raw operations "
+              << (long long)(raw.capacity() * sizeof(Operation)) / 1024 << " KB (grows)" << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "\nUpdate (rolling rings): " << results[0].realNanosPerIteration << " ns/operation" << std::endl;
+    std::cout << "Update (raw append):    " << results[1].realNanosPerIteration << " ns/operation" << std::endl;
+    std::cout << "\n" << std::setw(20) << "Query" << std::setw(14) << "Rings ns" << std::setw(14) << "Rescan ns"
+              << std::setw(10) << "Speedup" << std::endl;
+    for (int i = 0; i < 3; i++) {
+        double rollingNs = results[2 + 2 * i].realNanosPerIteration;
+        double scanNs = results[3 + 2 * i].realNanosPerIteration;
+        std::cout << std::setw(20) << costs[i].name << std::setw(14) << rollingNs << std::setw(14)
+                  << scanNs << std::setw(9) << scanNs / rollingNs << "x" << std::endl;
+    }
+    std::cout << "==================================================" << std::endl;
+
+    return finishBenchmarks(options, results, checks);
+}
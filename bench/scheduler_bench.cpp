@@ -0,0 +1,310 @@
+#include "benchmark.h"
+#include "roomscheduler.h"
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * SPECIALTY ROOM SCHEDULER BENCHMARK
+ *
+ * A department of R rooms split into five specialties (general 50%,
+ * pediatrics 20%, trauma 15%, cardiology 10%, orthopedics 5%) runs in
+ * steady state: --waiting patients queue (specialty drawn with the same
+ * weights, TRIAGE I-V drawn 5/15/30/30/20%) and every room is busy. One
+ * step frees a random occupied room, registers a new arrival and makes
+ * one dispatch decision, so the queues and occupancy never drift.
+ *
+ * Measured per fallback policy (none, general, any) and room count:
+ * - Dispatch decisions per second (whole step: release + add + dispatch)
+ * - Share of patients that got a room of another specialty (fallback)
+ *
+ * BASELINE: the same decisions taken by scanning - every room of the
+ * eligible pools is tested for occupancy and every specialty queue is
+ * probed level by level, which is what matching on CircularQueue-style
+ * room slots costs once rooms are typed.
+ *
+ * CHECK: the first --scan-decisions decisions are replayed on both
+ * schedulers from the same seed; every patient, room and pool must match,
+ * and no room may ever be handed out while occupied.
+ *
+ * OPTIONS: --rooms 50,500,5000 (default), --decisions N per run
+ *          (default 2000000), --scan-decisions S replayed on the baseline
+ *          (default 20000), --waiting W (default 2000), --json FILE
+ */
+
+static const char* const SPECIALTIES[] = {"general", "pediatrics", "trauma", "cardiology", "orthopedics"};
+static const int SHARE_PERCENT[] = {50, 20, 15, 10, 5};
+static const int LEVEL_PERCENT[] = {5, 15, 30, 30, 20};
+static const char* const POLICIES[] = {"none", "general", "any"};
+
+/**
+ * SCANNING SCHEDULER - Same decisions as RoomScheduler, found by loops
+ */
+class ScanScheduler {
+private:
+    std::vector<std::vector<std::deque<Patient*> > > queues;  ///< [pool][level - 1]
+    std::vector<Patient*> occupants;
+    std::vector<int> firstRoom;
+    std::vector<int> poolRooms;
+    FallbackPolicy fallback;
+    int anyRoomLevel;
+
+    int freeRoomOf(int pool) const {
+        for (int r = firstRoom[(size_t)pool]; r < firstRoom[(size_t)pool] + poolRooms[(size_t)pool]; r++) {
+            if (occupants[(size_t)r] == NULL) {
+                return r;
+            }
+        }
+        return -1;
+    }
+
+public:
+    explicit ScanScheduler(const HospitalConfig& config)
+        : fallback(config.fallback), anyRoomLevel(config.anyRoomLevel) {
+        int room = 0;
+        for (size_t p = 0; p < config.specialties.size(); p++) {
+            queues.push_back(std::vector<std::deque<Patient*> >((size_t)config.triageLevels));
+            firstRoom.push_back(room);
+            poolRooms.push_back(config.specialties[p].rooms);
+            room += config.specialties[p].rooms;
+        }
+        occupants.assign((size_t)room, NULL);
+    }
+
+    void add(Patient* patient) {
+        queues[(size_t)patient->specialty][(size_t)patient->priority - 1].push_back(patient);
+    }
+
+    void release(int room) {
+        occupants[(size_t)room] = NULL;
+    }
+
+    RoomAssignment dispatch() {
+        RoomAssignment best = {NULL, -1, -1};
+        int pools = (int)queues.size();
+        for (size_t level = 1; level <= queues[0].size() && best.patient == NULL; level++) {
+            for (int pool = 0; pool < pools; pool++) {
+                std::deque<Patient*>& queue = queues[(size_t)pool][level - 1];
+                if (queue.empty() || (best.patient != NULL && queue.front()->id > best.patient->id)) {
+                    continue;
+                }
+                int room = freeRoomOf(pool);
+                int roomPool = pool;
+                bool anyPool = (int)level <= anyRoomLevel || fallback == FALLBACK_ANY;
+                for (int other = 0; room < 0 && other < pools; other++) {
+                    if (other != pool && (anyPool || (fallback == FALLBACK_GENERAL && other == 0))) {
+                        room = freeRoomOf(other);
+                        roomPool = other;
+                    }
+                }
+                if (room >= 0) {
+                    best.patient = queue.front();
+                    best.room = room;
+                    best.pool = roomPool;
+                }
+            }
+            if (best.patient != NULL) {
+                queues[(size_t)best.patient->specialty][level - 1].pop_front();
+                occupants[(size_t)best.room] = best.patient;
+            }
+        }
+        return best;
+    }
+};
+
+struct SchedulerRun {
+    int rooms;
+    FallbackPolicy policy;
+    long long fallbacks;
+    bool consistent;
+    BenchmarkResult measured;  ///< RoomScheduler, one iteration per decision
+    BenchmarkResult scan;      ///< ScanScheduler on the replayed prefix
+};
+
+static HospitalConfig departmentConfig(int rooms, FallbackPolicy policy) {
+    HospitalConfig config;
+    config.specialties.clear();
+    int assigned = 0;
+    for (int s = 0; s < 5; s++) {
+        int share = s == 4 ? rooms - assigned : rooms * SHARE_PERCENT[s] / 100;
+        share = share < 1 ? 1 : share;
+        config.specialties.push_back(SpecialtyConfig(SPECIALTIES[s], share));
+        assigned += share;
+    }
+    config.fallback = policy;
+    return config;
+}
+
+/**
+ * RANDOM ARRIVAL - Specialty and level with the department weights
+ */
+static void arrive(Patient& patient, int id, std::mt19937& rng) {
+    int pick = (int)(rng() % 100);
+    int specialty = 0;
+    while (pick >= SHARE_PERCENT[specialty]) {
+        pick -= SHARE_PERCENT[specialty++];
+    }
+    pick = (int)(rng() % 100);
+    int level = 0;
+    while (pick >= LEVEL_PERCENT[level]) {
+        pick -= LEVEL_PERCENT[level++];
+    }
+    patient.id = id;
+    patient.specialty = specialty;
+    patient.priority = level + 1;
+}
+
+/**
+ * RESULT OF ONE STEADY-STATE RUN
+ */
+struct StepStats {
+    long long fallbacks;
+    std::uint64_t hash;  ///< Digest of every (patient, room, pool) decision
+    bool roomsExclusive; ///< No room was handed out while occupied
+};
+
+/**
+ * STEADY STATE: FILL, THEN release + arrive + dispatch PER DECISION
+ * - The discharged patient's record is reused for the new arrival, so the
+ *   population stays at waiting + rooms
+ * - state times the decisions (the fill is not timed)
+ */
+template <typename Scheduler>
+static StepStats runSteps(Scheduler& scheduler, int rooms, int waiting, long long decisions, unsigned seed,
+                          BenchmarkState& state) {
+    std::mt19937 rng(seed);
+    std::vector<Patient> patients((size_t)(waiting + rooms), Patient(0, "Scheduled Patient", 40, 1, "Fever"));
+    std::vector<Patient*> roomPatient((size_t)rooms, NULL);
+    std::vector<int> occupied;
+    occupied.reserve((size_t)rooms);
+    int nextId = 1;
+    for (size_t i = 0; i < patients.size(); i++) {
+        arrive(patients[i], nextId++, rng);
+        scheduler.add(&patients[i]);
+    }
+
+    StepStats stats = {0, 1469598103934665603ULL, true};
+    for (RoomAssignment a = scheduler.dispatch(); a.patient != NULL; a = scheduler.dispatch()) {
+        roomPatient[(size_t)a.room] = a.patient;
+        occupied.push_back(a.room);
+    }
+
+    long long d = 0;
+    state.begin();
+    for (; d < decisions && !occupied.empty(); d++) {
+        // A consultation ends; its record comes back as a new arrival
+        size_t slot = (size_t)(rng() % occupied.size());
+        int room = occupied[slot];
+        occupied[slot] = occupied.back();
+        occupied.pop_back();
+        Patient* discharged = roomPatient[(size_t)room];
+        roomPatient[(size_t)room] = NULL;
+        scheduler.release(room);
+        arrive(*discharged, nextId++, rng);
+        scheduler.add(discharged);
+
+        RoomAssignment a = scheduler.dispatch();
+        if (a.patient != NULL) {
+            stats.roomsExclusive = stats.roomsExclusive && roomPatient[(size_t)a.room] == NULL;
+            roomPatient[(size_t)a.room] = a.patient;
+            occupied.push_back(a.room);
+            stats.fallbacks += a.pool != a.patient->specialty ? 1 : 0;
+            stats.hash = (stats.hash ^ (std::uint64_t)a.patient->id) * 1099511628211ULL;
+            stats.hash = (stats.hash ^ (std::uint64_t)(a.room * 64 + a.pool)) * 1099511628211ULL;
+        } else {
+            stats.hash = (stats.hash ^ 0xFFFFFFFFULL) * 1099511628211ULL;
+        }
+    }
+    state.end(d);
+    state.setItemsProcessed(d);
+    return stats;
+}
+
+static SchedulerRun runPolicy(int rooms, FallbackPolicy policy, int waiting, long long decisions,
+                              long long scanDecisions) {
+    HospitalConfig config = departmentConfig(rooms, policy);
+    SchedulerRun run;
+    run.rooms = config.totalRooms();
+    run.policy = policy;
+    unsigned seed = 20240 + (unsigned)rooms + 7u * (unsigned)policy;
+    std::string name = "rooms:" + std::to_string(run.rooms) + "/fallback:" + POLICIES[policy];
+
+    RoomScheduler timed(config);
+    BenchmarkState fastState(decisions);
+    StepStats fast = runSteps(timed, run.rooms, waiting, decisions, seed, fastState);
+    run.fallbacks = fast.fallbacks;
+
+    // Replay a prefix on both implementations: the decisions must agree
+    RoomScheduler checked(config);
+    BenchmarkState checkState(scanDecisions);
+    StepStats check = runSteps(checked, run.rooms, waiting, scanDecisions, seed, checkState);
+    ScanScheduler scanner(config);
+    BenchmarkState scanState(scanDecisions);
+    StepStats scan = runSteps(scanner, run.rooms, waiting, scanDecisions, seed, scanState);
+    run.consistent = fast.roomsExclusive && check.roomsExclusive && check.hash == scan.hash;
+
+    run.measured = benchmarkResult("scheduler/" + name, fastState)
+                       .counter("fallback_percent", 100.0 * run.fallbacks / std::max(1LL, fastState.iterations()));
+    run.scan = benchmarkResult("scan/" + name, scanState);
+    return run;
+}
+
+int main(int argc, char* argv[]) {
+    long long decisions = 2000000;
+    long long scanDecisions = 20000;
+    int waiting = 2000;
+    std::vector<int> roomCounts = {50, 500, 5000};
+
+    BenchmarkOptions options(BenchmarkOptions::SCENARIO);
+    options.option("--rooms", roomCounts);
+    options.option("--decisions", decisions);
+    options.option("--scan-decisions", scanDecisions);
+    options.option("--waiting", waiting);
+    if (!options.parse(argc, argv)) {
+        return 1;
+    }
+    if (decisions <= 0 || scanDecisions <= 0 || waiting < 0) {
+        std::cerr << "--decisions and --scan-decisions must be positive, --waiting not negative" << std::endl;
+        return 1;
+    }
+
+    std::vector<SchedulerRun> runs;
+    for (size_t r = 0; r < roomCounts.size(); r++) {
+        if (roomCounts[r] < 5) {
+            continue;
+        }
+        for (int policy = FALLBACK_NONE; policy <= FALLBACK_ANY; policy++) {
+            runs.push_back(runPolicy(roomCounts[r], (FallbackPolicy)policy, waiting, decisions, scanDecisions));
+        }
+    }
+
+    printBenchmarkBanner("SPECIALTY ROOM SCHEDULER BENCHMARK");
+    std::cout << "Decisions per run: " << decisions << " (scan baseline: " << scanDecisions
+              << ") | Waiting: " << waiting << " | 5 specialties" << std::endl;
+    std::cout << "\n" << std::setw(7) << "Rooms" << std::setw(10) << "Fallback" << std::setw(15) << "Decisions/s"
+              << std::setw(10) << "ns/dec" << std::setw(14) << "Scan dec/s" << std::setw(10) << "Speed-up"
+              << std::setw(11) << "Fallback%" << std::setw(8) << "Check" << std::endl;
+    std::vector<BenchmarkResult> results;
+    BenchmarkChecks checks;
+    for (size_t i = 0; i < runs.size(); i++) {
+        const SchedulerRun& r = runs[i];
+        results.push_back(r.measured);
+        results.push_back(r.scan);
+        checks.expect(r.consistent, r.measured.name + " matches the scanning scheduler");
+        double rate = r.measured.itemsPerSecond;
+        double scanRate = r.scan.itemsPerSecond;
+        std::cout << std::setw(7) << r.rooms << std::setw(10) << POLICIES[r.policy] << std::fixed
+                  << std::setprecision(0) << std::setw(15) << rate << std::setprecision(1) << std::setw(10)
+                  << 1e9 / rate << std::setprecision(0) << std::setw(14) << scanRate << std::setprecision(1)
+                  << std::setw(10) << rate / scanRate << std::setw(11) << 100.0 * r.fallbacks / r.measured.iterations
+                  << std::setw(8) << (r.consistent ? "ok" : "BROKEN") << std::endl;
+    }
+    std::cout << "==================================================" << std::endl;
+
+    return finishBenchmarks(options, results, checks);
+}
@@ -0,0 +1,247 @@
+#include "benchmark.h"
+#include "protocol.h"
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+/**
+ * HOSPITAL SERVER LOAD GENERATOR
+ *
+ * Opens --connections sockets to a running server (hospital_system
+ * --serve) and keeps up to --depth pipelined requests in flight on each.
+ * Every connection cycles register -> attend -> free -> search (an ID it
+ * registered earlier), with a status request every 64 operations.
+ *
+ * LATENCY: Per request, from the moment its frame is handed to send() to
+ * the moment its response is parsed (includes queueing behind the
+ * pipeline), recorded in an HDR histogram
+ *
+ * OPTIONS: --connect ENDPOINT (default tcp:127.0.0.1:7400),
+ *          --connections C (4), --depth D (32), --requests N (total,
+ *          200000), --json FILE
+ */
+
+struct ConnectionResult {
+    Histogram latency;
+    long long completed;
+    long long errors;
+
+    ConnectionResult() : completed(0), errors(0) {}
+};
+
+static int connectTo(const protocol::Endpoint& endpoint) {
+    int fd = -1;
+    if (endpoint.unixSocket) {
+        sockaddr_un address;
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, endpoint.path.c_str(), sizeof(address.sun_path) - 1);
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd >= 0 && connect(fd, (sockaddr*)&address, sizeof(address)) < 0) {
+            close(fd);
+            fd = -1;
+        }
+    } else {
+        sockaddr_in address;
+        std::memset(&address, 0, sizeof(address));
+        address.sin_family = AF_INET;
+        address.sin_port = htons((uint16_t)endpoint.port);
+        inet_pton(AF_INET, endpoint.host.c_str(), &address.sin_addr);
+        fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (fd >= 0 && connect(fd, (sockaddr*)&address, sizeof(address)) < 0) {
+            close(fd);
+            fd = -1;
+        } else if (fd >= 0) {
+            int noDelay = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+        }
+    }
+    return fd;
+}
+
+/**
+ * ENCODE THE n-TH REQUEST OF A CONNECTION
+ */
+static void encodeRequest(std::string& out, long long n, long long lastRegisteredId) {
+    protocol::Writer writer(out);
+    if (n % 64 == 63) {
+        writer.byte(protocol::OP_STATUS);
+        writer.varint((std::uint64_t)n);
+    } else {
+        switch (n % 4) {
+            case 0:
+                writer.byte(protocol::OP_REGISTER);
+                writer.varint((std::uint64_t)n);
+                writer.byte(1 + (int)(n / 4 % 5));
+                writer.byte(40);
+                writer.text("Kiosk Patient");
+                writer.text("Fever");
+                break;
+            case 1:
+                writer.byte(protocol::OP_ATTEND);
+                writer.varint((std::uint64_t)n);
+                break;
+            case 2:
+                writer.byte(protocol::OP_FREE);
+                writer.varint((std::uint64_t)n);
+                break;
+            default:
+                writer.byte(protocol::OP_SEARCH);
+                writer.varint((std::uint64_t)n);
+                writer.varint((std::uint64_t)(lastRegisteredId > 0 ? lastRegisteredId : 1));
+                break;
+        }
+    }
+    writer.finish();
+}
+
+static void runConnection(const protocol::Endpoint& endpoint, long long requests, int depth, ConnectionResult& result) {
+    int fd = connectTo(endpoint);
+    if (fd < 0) {
+        std::cerr << "[ERROR!] Cannot connect to " << endpoint.describe() << ": " << std::strerror(errno) << std::endl;
+        result.errors = requests;
+        return;
+    }
+
+    std::vector<long long> sentAt((size_t)depth);
+    std::string output;
+    std::string input;
+    char chunk[64 * 1024];
+    long long sent = 0;
+    long long received = 0;
+    long long lastRegisteredId = 0;
+
+    while (received < requests) {
+        // Top up the pipeline in one write
+        output.clear();
+        long long firstNew = sent;
+        while (sent < requests && sent - received < depth) {
+            encodeRequest(output, sent, lastRegisteredId);
+            sent++;
+        }
+        long long now = benchmarkNanos();
+        for (long long n = firstNew; n < sent; n++) {
+            sentAt[(size_t)(n % depth)] = now;
+        }
+        for (size_t offset = 0; offset < output.size();) {
+            ssize_t written = send(fd, output.data() + offset, output.size() - offset, MSG_NOSIGNAL);
+            if (written <= 0) {
+                result.errors += requests - received;
+                close(fd);
+                return;
+            }
+            offset += (size_t)written;
+        }
+
+        // Read until at least one response completes
+        ssize_t bytes = recv(fd, chunk, sizeof(chunk), 0);
+        if (bytes <= 0) {
+            result.errors += requests - received;
+            close(fd);
+            return;
+        }
+        input.append(chunk, (size_t)bytes);
+        size_t consumed = 0;
+        long long length;
+        while ((length = protocol::completeFrame(input.data() + consumed, input.size() - consumed)) >= 0) {
+            protocol::Reader response(input.data() + consumed + protocol::HEADER_BYTES, (size_t)length);
+            int opcode = response.byte();
+            int status = response.byte();
+            response.varint();
+            if (status == protocol::STATUS_ERROR) {
+                result.errors++;
+            } else if (opcode == protocol::OP_REGISTER && status == protocol::STATUS_OK) {
+                lastRegisteredId = (long long)response.varint();
+            }
+            result.latency.record((std::uint64_t)(benchmarkNanos() - sentAt[(size_t)(received % depth)]));
+            received++;
+            consumed += protocol::HEADER_BYTES + (size_t)length;
+        }
+        input.erase(0, consumed);
+    }
+    result.completed = received;
+    close(fd);
+}
+
+int main(int argc, char* argv[]) {
+    std::string target = "tcp:127.0.0.1:7400";
+    int connections = 4;
+    int depth = 32;
+    long long requests = 200000;
+
+    BenchmarkOptions options(BenchmarkOptions::SCENARIO);
+    options.option("--connect", target);
+    options.option("--connections", connections);
+    options.option("--depth", depth);
+    options.option("--requests", requests);
+    if (!options.parse(argc, argv)) {
+        return 1;
+    }
+    if (connections <= 0 || depth <= 0 || requests < connections) {
+        std::cerr << "--connections and --depth must be positive, --requests >= --connections" << std::endl;
+        return 1;
+    }
+
+    protocol::Endpoint endpoint;
+    try {
+        endpoint = protocol::Endpoint::parse(target);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    std::vector<ConnectionResult> connectionResults((size_t)connections);
+    std::vector<std::thread> threads;
+    long long perConnection = requests / connections;
+    BenchmarkState state(perConnection * connections);
+    state.begin();
+    for (int c = 0; c < connections; c++) {
+        threads.push_back(std::thread(runConnection, std::cref(endpoint), perConnection, depth,
+                                      std::ref(connectionResults[(size_t)c])));
+    }
+    for (size_t t = 0; t < threads.size(); t++) {
+        threads[t].join();
+    }
+    state.end();
+    double seconds = state.elapsedWall();
+
+    Histogram latency;
+    long long completed = 0;
+    long long errors = 0;
+    for (size_t c = 0; c < connectionResults.size(); c++) {
+        latency.merge(connectionResults[c].latency);
+        completed += connectionResults[c].completed;
+        errors += connectionResults[c].errors;
+    }
+    state.setItemsProcessed(completed);
+
+    std::vector<BenchmarkResult> results;
+    results.push_back(benchmarkResult("server/connections:" + std::to_string(connections) + "/depth:" +
+                                      std::to_string(depth), state)
+                          .latency(latency)
+                          .counter("errors", (double)errors));
+    BenchmarkChecks checks;
+    checks.expect(errors == 0, std::to_string(errors) + " requests failed");
+
+    printBenchmarkBanner("HOSPITAL SERVER LOAD TEST");
+    std::cout << "Endpoint: " << endpoint.describe() << " | Connections: " << connections
+              << " | Pipeline depth: " << depth << std::endl;
+    std::cout << std::fixed << std::setprecision(3) << "Completed: " << completed << " requests in "
+              << seconds << " s | " << std::setprecision(0) << completed / seconds << " requests/s" << std::endl;
+    std::cout << std::setprecision(1) << "Latency (us): p50 " << latency.percentile(50.0) / 1000.0
+              << " | p99 " << latency.percentile(99.0) / 1000.0 << " | p99.9 " << latency.percentile(99.9) / 1000.0
+              << " | max " << latency.max() / 1000.0 << std::endl;
+    std::cout << "==================================================" << std::endl;
+
+    return finishBenchmarks(options, results, checks);
+}
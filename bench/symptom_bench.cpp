@@ -0,0 +1,231 @@
+#include "benchmark.h"
+#include "symptomindex.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * SYMPTOM INVERTED INDEX BENCHMARK
+ *
+ * Indexes --patients synthetic symptom descriptions (1-4 terms from a
+ * vocabulary with Zipf-like frequencies, written in mixed case, with
+ * accents and "," / "y" / "and" separators), then measures:
+ * - Build rate and posting-list size against 4 bytes per raw ID
+ * - Query latency per query shape, in HDR histograms:
+ *     and-common   two of the 5 most frequent terms
+ *     and-rare     one rare term AND one frequent term
+ *     and-3        three random terms
+ *     or-2         two random terms
+ * - The intersection kernel alone (SSE2 vs scalar merge) on the decoded
+ *   lists of the two most frequent terms
+ *
+ * BASELINE: a linear scan that tokenizes every symptom per query - what
+ * a search over registeredPatients would cost (run --scan-queries times)
+ *
+ * OPTIONS: --patients N (default 2000000), --queries Q (20000 per shape),
+ *          --scan-queries S (3), --json FILE
+ */
+
+static const char* const TERMS[] = {
+    "Fever", "Cough", "Dolor de cabeza", "Headache", "Náusea", "Vómito", "Mareo", "Fatiga", "Rash",
+    "Diarrea", "Dolor abdominal", "Chest pain", "Disnea", "Fractura", "Herida", "Quemadura", "Sangrado",
+    "Convulsión", "Alergia", "Asma", "Hipertensión", "Dolor lumbar", "Otitis", "Conjuntivitis", "Migraña",
+    "Palpitaciones", "Síncope", "Deshidratación", "Infección urinaria", "Esguince", "Insomnio", "Ansiedad",
+    "Escalofríos", "Congestión", "Faringitis", "Dermatitis", "Hemorragia nasal", "Edema", "Ictericia",
+    "Taquicardia", "Hipotermia", "Picadura", "Intoxicación", "Neumonía", "Gastritis", "Anemia", "Artritis",
+    "Bronquitis", "Cólico", "Varicela"
+};
+static const int TERM_COUNT = sizeof(TERMS) / sizeof(TERMS[0]);
+static const char* const SEPARATORS[] = {", ", " y ", " and ", "; "};
+
+struct QueryShape {
+    std::string name;
+    Histogram latency;
+    long long results;
+    long long queries;
+};
+
+/**
+ * LINEAR SCAN BASELINE - Tokenize every symptom, keep those with all terms
+ */
+static long long scanAll(const std::vector<std::string>& symptoms, const std::vector<std::string>& terms) {
+    std::vector<std::string> wanted, tokens;
+    for (size_t t = 0; t < terms.size(); t++) {
+        std::vector<std::string> parts;
+        SymptomIndex::tokenize(terms[t], parts);
+        wanted.insert(wanted.end(), parts.begin(), parts.end());
+    }
+    long long matches = 0;
+    for (size_t i = 0; i < symptoms.size(); i++) {
+        SymptomIndex::tokenize(symptoms[i], tokens);
+        bool all = true;
+        for (size_t w = 0; w < wanted.size() && all; w++) {
+            all = std::find(tokens.begin(), tokens.end(), wanted[w]) != tokens.end();
+        }
+        if (all) matches++;
+    }
+    return matches;
+}
+
+int main(int argc, char* argv[]) {
+    long long patients = 2000000;
+    long long queries = 20000;
+    int scanQueries = 3;
+
+    BenchmarkOptions options(BenchmarkOptions::SCENARIO);
+    options.option("--patients", patients);
+    options.option("--queries", queries);
+    options.option("--scan-queries", scanQueries);
+    if (!options.parse(argc, argv)) {
+        return 1;
+    }
+    if (patients <= 0 || queries <= 0 || scanQueries < 0) {
+        std::cerr << "--patients and --queries must be positive" << std::endl;
+        return 1;
+    }
+
+    // Zipf-like term frequencies: term r is picked with weight 1 / (r + 1)
+    std::vector<double> weights;
+    for (int t = 0; t < TERM_COUNT; t++) weights.push_back(1.0 / (t + 1));
+    std::discrete_distribution<int> pickTerm(weights.begin(), weights.end());
+    std::mt19937_64 rng(2024);
+
+    std::vector<std::string> symptoms;
+    symptoms.reserve((size_t)patients);
+    for (long long p = 0; p < patients; p++) {
+        int count = 1 + (int)(rng() % 4);
+        std::string symptom;
+        for (int c = 0; c < count; c++) {
+            std::string term = TERMS[pickTerm(rng)];
+            if (rng() % 4 == 0) std::transform(term.begin(), term.end(), term.begin(), ::tolower);
+            if (c > 0) symptom += SEPARATORS[rng() % 4];
+            symptom += term;
+        }
+        symptoms.push_back(symptom);
+    }
+
+    SymptomIndex index;
+    BenchmarkState build(patients);
+    build.begin();
+    for (size_t p = 0; p < symptoms.size(); p++) {
+        index.insert((int)p + 1, symptoms[p]);
+    }
+    build.end();
+    build.setItemsProcessed(patients);
+    double buildSeconds = build.elapsedWall();
+
+    QueryShape shapes[4];
+    shapes[0].name = "and-common";
+    shapes[1].name = "and-rare";
+    shapes[2].name = "and-3";
+    shapes[3].name = "or-2";
+    std::vector<int> ids;
+    for (int s = 0; s < 4; s++) {
+        shapes[s].results = 0;
+        shapes[s].queries = queries;
+        for (long long q = 0; q < queries; q++) {
+            std::vector<std::string> terms;
+            if (s == 0) {
+                terms.push_back(TERMS[rng() % 5]);
+                terms.push_back(TERMS[rng() % 5]);
+            } else if (s == 1) {
+                terms.push_back(TERMS[TERM_COUNT - 10 + (int)(rng() % 10)]);
+                terms.push_back(TERMS[rng() % 5]);
+            } else {
+                int count = s == 2 ? 3 : 2;
+                for (int c = 0; c < count; c++) terms.push_back(TERMS[rng() % TERM_COUNT]);
+            }
+            long long start = benchmarkNanos();
+            int found = s == 3 ? index.matchAny(terms, ids) : index.matchAll(terms, ids);
+            shapes[s].latency.record((std::uint64_t)(benchmarkNanos() - start));
+            shapes[s].results += found;
+        }
+    }
+
+    // Kernel only: the two longest lists, decoded once
+    std::vector<int> first, second;
+    index.matchAll(std::vector<std::string>(1, TERMS[0]), first);
+    index.matchAll(std::vector<std::string>(1, TERMS[1]), second);
+    std::vector<int> out(std::min(first.size(), second.size()) + 1);
+    int kernelRepeats = 20;
+    long long kernelIds = kernelRepeats * (long long)(first.size() + second.size());
+    BenchmarkState kernels[2] = {BenchmarkState(kernelRepeats), BenchmarkState(kernelRepeats)};
+    double kernelNanos[2];
+    long long kernelMatches = 0;
+    for (int k = 0; k < 2; k++) {
+        kernels[k].begin();
+        for (int r = 0; r < kernelRepeats; r++) {
+            kernelMatches = k == 0
+                ? SymptomIndex::intersect(first.data(), (int)first.size(), second.data(), (int)second.size(), out.data())
+                : SymptomIndex::intersectScalar(first.data(), (int)first.size(), second.data(), (int)second.size(),
+                                                out.data());
+        }
+        kernels[k].end();
+        kernels[k].setItemsProcessed(kernelIds);
+        kernelNanos[k] = kernels[k].elapsedWall() * 1e9 / (double)std::max(1LL, kernelIds);
+    }
+
+    std::vector<std::vector<std::string> > scanTerms((size_t)scanQueries);
+    for (int q = 0; q < scanQueries; q++) {
+        scanTerms[(size_t)q].push_back(TERMS[rng() % 5]);
+        scanTerms[(size_t)q].push_back(TERMS[rng() % TERM_COUNT]);
+    }
+    BenchmarkState scan(scanQueries);
+    scan.begin();
+    for (int q = 0; q < scanQueries; q++) {
+        doNotOptimize(scanAll(symptoms, scanTerms[(size_t)q]));
+    }
+    scan.end();
+    double scanMillis = scanQueries > 0 ? scan.elapsedWall() * 1e3 / scanQueries : 0.0;
+
+    double bytesPerPosting = (double)index.postingBytes() / (double)index.postingCount();
+
+    std::vector<BenchmarkResult> results;
+    results.push_back(benchmarkResult("symptom/build", build)
+                          .counter("terms", (double)index.termCount())
+                          .counter("postings", (double)index.postingCount())
+                          .counter("posting_bytes", (double)index.postingBytes()));
+    for (int s = 0; s < 4; s++) {
+        results.push_back(latencyResult("symptom/" + shapes[s].name, shapes[s].latency)
+                              .counter("avg_results", (double)shapes[s].results / shapes[s].queries));
+    }
+    results.push_back(benchmarkResult("symptom/intersect/simd", kernels[0]).counter("ns_per_id", kernelNanos[0]));
+    results.push_back(benchmarkResult("symptom/intersect/scalar", kernels[1]).counter("ns_per_id", kernelNanos[1]));
+    if (scanQueries > 0) {
+        results.push_back(benchmarkResult("symptom/scan", scan));
+    }
+
+    printBenchmarkBanner("SYMPTOM INVERTED INDEX BENCHMARK");
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Patients: " << patients << " | Terms: " << index.termCount() << " | Postings: "
+              << index.postingCount() << std::endl;
+    std::cout << "Posting lists: " << index.postingBytes() / (1024.0 * 1024.0) << " MB (" << bytesPerPosting
+              << " bytes/posting vs 4.00 raw)" << std::endl;
+    std::cout << "Build: " << std::setprecision(0) << patients / buildSeconds << " patients/s" << std::endl;
+    std::cout << "\n" << std::left << std::setw(12) << "Query" << std::right << std::setw(12) << "p50 (us)"
+              << std::setw(12) << "p99 (us)" << std::setw(14) << "avg results" << std::endl;
+    for (int s = 0; s < 4; s++) {
+        std::cout << std::left << std::setw(12) << shapes[s].name << std::right << std::setprecision(1)
+                  << std::setw(12) << shapes[s].latency.percentile(50.0) / 1000.0
+                  << std::setw(12) << shapes[s].latency.percentile(99.0) / 1000.0 << std::setprecision(0)
+                  << std::setw(14) << (double)shapes[s].results / shapes[s].queries << std::endl;
+    }
+    std::cout << "\nIntersection kernel (" << first.size() << " x " << second.size() << " IDs, " << kernelMatches
+              << " common): " << std::setprecision(2)
+#if defined(__SSE2__)
+              << "SSE2 "
+#else
+              << "scalar fallback "
+#endif
+              << kernelNanos[0] << " ns/ID | scalar " << kernelNanos[1] << " ns/ID" << std::endl;
+    if (scanQueries > 0) {
+        std::cout << "Linear scan baseline: " << std::setprecision(1) << scanMillis << " ms/query" << std::endl;
+    }
+    std::cout << "==================================================" << std::endl;
+
+    return finishBenchmarks(options, results);
+}
@@ -0,0 +1,251 @@
+#include "benchmark.h"
+#include "roomtimers.h"
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * CONSULTATION ROOM TIMER BENCHMARK
+ *
+ * R rooms are kept busy for --hours simulated hours at one tick per second.
+ * Every consultation gets an expected end from its triage level (60 / 45 /
+ * 30 / 20 / 15 minutes, levels drawn 5/15/30/30/20%) and really lasts
+ * between 0.5x and 1.8x of it, so about 60% run past their expected end.
+ * When a consultation really ends its room is finished and a new one
+ * starts at once. Every tick the timers are advanced and the rooms that
+ * just went overdue are collected.
+ *
+ * Measured per room count, for three ways of keeping the expected ends:
+ * - wheel: RoomTimers (hierarchical TimingWheel, O(1) per tick)
+ * - heap: binary min-heap of (expected end, room, start serial); a
+ *   finished consultation is skipped lazily when it reaches the top
+ * - scan: every occupied room's expected end is compared each tick, the
+ *   cost of a per-tick sweep over the consultation rooms
+ * The driver (who ends when) is the same for all three and is included.
+ *
+ * CHECK: the set of (tick, room) overdue events must be identical.
+ *
+ * OPTIONS: --rooms 50,500,5000 (default), --hours H (default 24),
+ *          --json FILE
+ */
+
+static const int MINUTES[] = {60, 45, 30, 20, 15};
+static const int LEVEL_PERCENT[] = {5, 15, 30, 30, 20};
+static const int MAX_TICKS_AHEAD = 60 * 60 * 2;  ///< Longest consultation: 1.8 x 60 min, rounded up
+
+/**
+ * TIMER KEEPERS COMPARED - start / finish / advance like RoomTimers
+ */
+class HeapTimers {
+private:
+    struct Entry {
+        long long expiry;
+        int room;
+        int serial;
+        bool operator>(const Entry& other) const { return expiry > other.expiry; }
+    };
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry> > heap;
+    std::vector<int> serials;
+    std::vector<char> overdue;
+
+public:
+    explicit HeapTimers(int rooms) : serials((size_t)rooms, 0), overdue((size_t)rooms, 0) {}
+
+    void start(int room, long long endTick) {
+        Entry entry = {endTick, room, ++serials[(size_t)room]};
+        heap.push(entry);
+    }
+
+    bool finish(int room) {
+        serials[(size_t)room]++;
+        bool late = overdue[(size_t)room] != 0;
+        overdue[(size_t)room] = 0;
+        return late;
+    }
+
+    int advance(long long nowTick, std::vector<int>& due) {
+        int count = 0;
+        while (!heap.empty() && heap.top().expiry <= nowTick) {
+            Entry entry = heap.top();
+            heap.pop();
+            if (entry.serial == serials[(size_t)entry.room]) {
+                overdue[(size_t)entry.room] = 1;
+                due.push_back(entry.room);
+                count++;
+            }
+        }
+        return count;
+    }
+};
+
+class ScanTimers {
+private:
+    std::vector<long long> expectedEnds;  ///< -1 when free or already overdue
+    std::vector<char> overdue;
+
+public:
+    explicit ScanTimers(int rooms) : expectedEnds((size_t)rooms, -1), overdue((size_t)rooms, 0) {}
+
+    void start(int room, long long endTick) { expectedEnds[(size_t)room] = endTick; }
+
+    bool finish(int room) {
+        expectedEnds[(size_t)room] = -1;
+        bool late = overdue[(size_t)room] != 0;
+        overdue[(size_t)room] = 0;
+        return late;
+    }
+
+    int advance(long long nowTick, std::vector<int>& due) {
+        int count = 0;
+        for (size_t room = 0; room < expectedEnds.size(); room++) {
+            if (expectedEnds[room] >= 0 && expectedEnds[room] <= nowTick) {
+                expectedEnds[room] = -1;
+                overdue[room] = 1;
+                due.push_back((int)room);
+                count++;
+            }
+        }
+        return count;
+    }
+};
+
+struct TimerRun {
+    BenchmarkResult measured;  ///< One iteration per tick
+    long long overdue;
+    long long consultations;
+    std::uint64_t digest;  ///< Order-independent sum over (tick, room) overdue events
+};
+
+static std::uint64_t mix(std::uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+/**
+ * STEADY STATE FOR ticks SECONDS
+ * - Real ends live in a ring of per-second buckets, so the driver costs
+ *   the same for every timer keeper
+ */
+template <typename Timers>
+static TimerRun runTicks(const std::string& name, Timers& timers, int rooms, long long ticks, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> stretch(0.5, 1.8);
+    std::vector<std::vector<int> > endsAt((size_t)MAX_TICKS_AHEAD + 1);
+    std::vector<int> due;
+    due.reserve((size_t)rooms);
+    TimerRun run;
+    run.overdue = 0;
+    run.consultations = 0;
+    run.digest = 0;
+
+    BenchmarkState state(ticks);
+    state.begin();
+    for (int room = 0; room < rooms; room++) {
+        endsAt[0].push_back(room);  // Every room starts a consultation at tick 0
+    }
+    for (long long tick = 0; tick < ticks; tick++) {
+        std::vector<int>& ending = endsAt[(size_t)(tick % (MAX_TICKS_AHEAD + 1))];
+        for (size_t i = 0; i < ending.size(); i++) {
+            int room = ending[i];
+            if (tick > 0) {
+                timers.finish(room);
+            }
+            int pick = (int)(rng() % 100);
+            int level = 0;
+            while (pick >= LEVEL_PERCENT[level]) {
+                pick -= LEVEL_PERCENT[level++];
+            }
+            long long expected = MINUTES[level] * 60LL;
+            long long actual = (long long)(expected * stretch(rng));
+            timers.start(room, tick + expected);
+            endsAt[(size_t)((tick + (actual > 0 ? actual : 1)) % (MAX_TICKS_AHEAD + 1))].push_back(room);
+            run.consultations++;
+        }
+        ending.clear();
+
+        due.clear();
+        run.overdue += timers.advance(tick, due);
+        for (size_t i = 0; i < due.size(); i++) {
+            run.digest += mix((std::uint64_t)tick * 1000003ULL + (std::uint64_t)due[i]);
+        }
+    }
+    state.end();
+    run.measured = benchmarkResult(name + "/rooms:" + std::to_string(rooms), state)
+                       .counter("consultations", (double)run.consultations)
+                       .counter("overdue", (double)run.overdue);
+    return run;
+}
+
+struct RoomRun {
+    int rooms;
+    TimerRun wheel;
+    TimerRun heap;
+    TimerRun scan;
+    bool consistent;
+};
+
+int main(int argc, char* argv[]) {
+    double hours = 24.0;
+    std::vector<int> roomCounts = {50, 500, 5000};
+
+    BenchmarkOptions options(BenchmarkOptions::SCENARIO);
+    options.option("--rooms", roomCounts);
+    options.option("--hours", hours);
+    if (!options.parse(argc, argv)) {
+        return 1;
+    }
+    if (hours <= 0) {
+        std::cerr << "--hours must be positive" << std::endl;
+        return 1;
+    }
+    long long ticks = (long long)(hours * 3600.0);
+
+    std::vector<RoomRun> runs;
+    for (size_t r = 0; r < roomCounts.size(); r++) {
+        if (roomCounts[r] <= 0) {
+            continue;
+        }
+        RoomRun run;
+        run.rooms = roomCounts[r];
+        unsigned seed = 7200u + (unsigned)run.rooms;
+        RoomTimers wheel(run.rooms);
+        run.wheel = runTicks("wheel", wheel, run.rooms, ticks, seed);
+        HeapTimers heap(run.rooms);
+        run.heap = runTicks("heap", heap, run.rooms, ticks, seed);
+        ScanTimers scan(run.rooms);
+        run.scan = runTicks("scan", scan, run.rooms, ticks, seed);
+        run.consistent = run.wheel.digest == run.heap.digest && run.wheel.digest == run.scan.digest &&
+                         run.wheel.overdue == run.heap.overdue && run.wheel.overdue == run.scan.overdue;
+        runs.push_back(run);
+    }
+
+    printBenchmarkBanner("CONSULTATION ROOM TIMER BENCHMARK");
+    std::cout << "Simulated: " << hours << " h at 1 tick/s (" << ticks << " ticks) | all rooms busy" << std::endl;
+    std::cout << "\n" << std::setw(7) << "Rooms" << std::setw(14) << "Consults" << std::setw(10) << "Overdue%"
+              << std::setw(13) << "Wheel ns/t" << std::setw(12) << "Heap ns/t" << std::setw(12) << "Scan ns/t"
+              << std::setw(8) << "Check" << std::endl;
+    std::vector<BenchmarkResult> results;
+    BenchmarkChecks checks;
+    for (size_t i = 0; i < runs.size(); i++) {
+        const RoomRun& r = runs[i];
+        results.push_back(r.wheel.measured);
+        results.push_back(r.heap.measured);
+        results.push_back(r.scan.measured);
+        checks.expect(r.consistent, std::to_string(r.rooms) + " rooms: identical overdue events");
+        std::cout << std::setw(7) << r.rooms << std::setw(14) << r.wheel.consultations << std::fixed
+                  << std::setprecision(1) << std::setw(10) << 100.0 * r.wheel.overdue / r.wheel.consultations
+                  << std::setw(13) << r.wheel.measured.realNanosPerIteration << std::setw(12)
+                  << r.heap.measured.realNanosPerIteration << std::setw(12) << r.scan.measured.realNanosPerIteration
+                  << std::setw(8) << (r.consistent ? "ok" : "BROKEN") << std::endl;
+    }
+    std::cout << "==================================================" << std::endl;
+
+    return finishBenchmarks(options, results, checks);
+}
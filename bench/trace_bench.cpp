@@ -0,0 +1,60 @@
+#include "benchmark.h"
+#include "trace.h"
+#include "priorityqueue.h"
+#include "patient.h"
+#include <vector>
+
+/**
+ * TRACING OVERHEAD BENCHMARKS
+ *
+ * Always compiled with -DHOSPITAL_TRACING so the enabled cost is measured:
+ * - BM_TraceTimestamp: one Tracer::now() read
+ * - BM_TraceScope: one empty TRACE_SCOPE (two timestamps + ring write),
+ *   the per-event overhead added to every traced operation
+ * - BM_PriorityQueueTracedPop: add + traced pop on a live triage queue,
+ *   to put the per-event cost in the context of a real operation
+ */
+
+/**
+ * SINGLE TIMESTAMP READ
+ */
+static void BM_TraceTimestamp(BenchmarkState& state) {
+    while (state.keepRunning()) {
+        doNotOptimize(Tracer::now());
+    }
+}
+BENCHMARK(BM_TraceTimestamp);
+
+/**
+ * EMPTY TRACED SCOPE - Full cost of recording one event
+ */
+static void BM_TraceScope(BenchmarkState& state) {
+    while (state.keepRunning()) {
+        TRACE_SCOPE("BM_TraceScope");
+    }
+}
+BENCHMARK(BM_TraceScope);
+
+/**
+ * TRIAGE ADD + TRACED POP - Queue depth held at n
+ */
+static void BM_PriorityQueueTracedPop(BenchmarkState& state) {
+    long long n = state.range(0);
+    std::vector<Patient*> patients;
+    PriorityQueue<Patient*> triage;
+    for (long long i = 0; i < n; i++) {
+        patients.push_back(new Patient((int)i + 1, "Patient", 40, 1 + (int)(i % 5), "Fever"));
+        triage.add(patients.back());
+    }
+    while (state.keepRunning()) {
+        triage.add(triage.pop());
+    }
+    for (size_t i = 0; i < patients.size(); i++) {
+        delete patients[i];
+    }
+}
+BENCHMARK(BM_PriorityQueueTracedPop)->arg(64)->arg(4096);
+
+int main(int argc, char* argv[]) {
+    return runBenchmarks(argc, argv);
+}
@@ -0,0 +1,159 @@
+#include "benchmark.h"
+#include "hospitalnetwork.h"
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * CROSS-SHARD TRANSFER BENCHMARK
+ *
+ * Two sites; site 0 is preloaded with --waiting patients, alternating
+ * TRIAGE IV and V, plus one TRIAGE II patient in ten that must never
+ * move. For every batch size B the TRIAGE IV-V population is bounced
+ * between the sites with transferPatients(from, to, B) until --patients
+ * patients have moved: each call is one batch, timed from submission to
+ * admission at the receiving site (HDR histogram).
+ *
+ * BASELINE: B = 1 is the naive transfer, one patient per round trip.
+ *
+ * ORDER CHECK: within a batch the source IDs of each level must increase
+ * (arrival order kept) and at most one level change may occur (V, then
+ * IV); at the end no patient may be lost and every TRIAGE II patient must
+ * still wait at site 0.
+ *
+ * OPTIONS: --batches 1,16,64,256,512, --patients N moved per batch size
+ *          (default 200000), --waiting W (default 20000), --json FILE
+ */
+
+struct TransferRun {
+    int batch;
+    long long moved;
+    long long calls;
+    double seconds;
+    bool ordered;
+    Histogram latency;
+    BenchmarkResult measured;  ///< One iteration per batch, items = patients moved
+};
+
+/**
+ * A BATCH IS ORDERED WHEN ITS IDS FORM AT MOST TWO INCREASING RUNS
+ * (TRIAGE V then TRIAGE IV), EACH IN ARRIVAL ORDER
+ */
+static bool batchOrdered(const TransferResult& result) {
+    int runs = result.sourceIds.empty() ? 0 : 1;
+    for (size_t i = 1; i < result.sourceIds.size(); i++) {
+        if (result.sourceIds[i] <= result.sourceIds[i - 1]) {
+            runs++;
+        }
+    }
+    for (size_t i = 1; i < result.destinationIds.size(); i++) {
+        if (result.destinationIds[i] <= result.destinationIds[i - 1]) {
+            return false;
+        }
+    }
+    return runs <= 2;
+}
+
+static TransferRun runBatches(int batch, long long patients, int waiting) {
+    std::vector<SiteConfig> sites;
+    sites.push_back(SiteConfig("Saturada", 10));
+    sites.push_back(SiteConfig("Hermana", 10));
+    HospitalNetwork network(sites, new RoundRobinPolicy());
+
+    std::vector<std::future<int> > ids;
+    ids.reserve((size_t)waiting);
+    for (int p = 0; p < waiting; p++) {
+        int priority = p % 10 == 0 ? 2 : 4 + p % 2;
+        ids.push_back(network.engine(0).registerPatient("Transfer Patient", 40, priority, "Fever"));
+    }
+    for (size_t i = 0; i < ids.size(); i++) {
+        ids[i].get();
+    }
+
+    TransferRun run;
+    run.batch = batch;
+    run.moved = 0;
+    run.calls = 0;
+    run.ordered = true;
+    int from = 0;
+    BenchmarkState state(0);
+    state.begin();
+    while (run.moved < patients) {
+        long long sent = benchmarkNanos();
+        TransferResult result = network.transferPatients(from, 1 - from, batch).get();
+        run.latency.record((std::uint64_t)(benchmarkNanos() - sent));
+        run.calls++;
+        run.moved += result.count();
+        run.ordered = run.ordered && batchOrdered(result);
+        if (result.count() < batch) {
+            from = 1 - from;  // Sender drained: bounce the population back
+        }
+    }
+    state.end(run.calls);
+    state.setItemsProcessed(run.moved);
+    run.seconds = state.elapsedWall();
+
+    // Nobody lost, and only TRIAGE IV-V may have moved
+    std::vector<WaitingSnapshot> saturated = network.engine(0).longestWaiting(waiting).get();
+    std::vector<WaitingSnapshot> sister = network.engine(1).longestWaiting(waiting).get();
+    int urgent = 0;
+    for (size_t i = 0; i < saturated.size(); i++) {
+        urgent += saturated[i].patient.priority == 2 ? 1 : 0;
+    }
+    for (size_t i = 0; i < sister.size(); i++) {
+        run.ordered = run.ordered && sister[i].patient.priority >= 4;
+    }
+    run.ordered = run.ordered && urgent == (waiting + 9) / 10 && (int)(saturated.size() + sister.size()) == waiting;
+    run.measured = benchmarkResult("transfer/batch:" + std::to_string(batch), state).latency(run.latency);
+    return run;
+}
+
+int main(int argc, char* argv[]) {
+    long long patients = 200000;
+    int waiting = 20000;
+    std::vector<int> batches = {1, 16, 64, 256, HospitalNetwork::TRANSFER_CAPACITY};
+
+    BenchmarkOptions options(BenchmarkOptions::SCENARIO);
+    options.option("--batches", batches);
+    options.option("--patients", patients);
+    options.option("--waiting", waiting);
+    if (!options.parse(argc, argv)) {
+        return 1;
+    }
+    if (patients <= 0 || waiting < 10) {
+        std::cerr << "--patients must be positive and --waiting at least 10" << std::endl;
+        return 1;
+    }
+
+    std::vector<TransferRun> runs;
+    for (size_t i = 0; i < batches.size(); i++) {
+        if (batches[i] > 0 && batches[i] <= HospitalNetwork::TRANSFER_CAPACITY) {
+            runs.push_back(runBatches(batches[i], patients, waiting));
+        }
+    }
+
+    printBenchmarkBanner("CROSS-SHARD PATIENT TRANSFER BENCHMARK");
+    std::cout << "Patients moved per batch size: " << patients << " | Waiting at start: " << waiting
+              << " (TRIAGE IV-V: " << waiting - (waiting + 9) / 10 << ")" << std::endl;
+    std::cout << "\n" << std::setw(7) << "Batch" << std::setw(16) << "Transfers/s" << std::setw(12) << "Batches/s"
+              << std::setw(12) << "p50 (us)" << std::setw(12) << "p99 (us)" << std::setw(10) << "Speed-up"
+              << std::setw(9) << "Order" << std::endl;
+    std::vector<BenchmarkResult> results;
+    BenchmarkChecks checks;
+    double base = runs.empty() ? 1.0 : runs[0].moved / runs[0].seconds;
+    for (size_t i = 0; i < runs.size(); i++) {
+        const TransferRun& r = runs[i];
+        results.push_back(r.measured);
+        checks.expect(r.ordered, "batch " + std::to_string(r.batch) + " kept arrival order and TRIAGE II in place");
+        std::cout << std::setw(7) << r.batch << std::fixed << std::setprecision(0) << std::setw(16)
+                  << r.moved / r.seconds << std::setw(12) << r.calls / r.seconds << std::setprecision(2)
+                  << std::setw(12) << r.latency.percentile(50.0) / 1000.0 << std::setw(12)
+                  << r.latency.percentile(99.0) / 1000.0 << std::setw(10) << (r.moved / r.seconds) / base
+                  << std::setw(9) << (r.ordered ? "kept" : "BROKEN") << std::endl;
+    }
+    std::cout << "==================================================" << std::endl;
+
+    return finishBenchmarks(options, results, checks);
+}
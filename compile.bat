@@ -36,7 +36,10 @@ echo 🔨 Compiling source files...
 echo.
 
 :: Compile the project
-g++ -std=c++11 -Wall -g -Isrc -o build/hospital_system.exe src/main.cpp src/hospitalsystem.cpp
+g++ -std=c++20 -Wall -g -pthread -Isrc -o build/hospital_system.exe src/main.cpp src/hospitalsystem.cpp ^
+    src/simulation.cpp src/replication.cpp src/workload.cpp src/hospitalengine.cpp src/hospitalserver.cpp src/asyncengine.cpp ^
+    src/hospitaldispatcher.cpp src/nameindex.cpp src/symptomindex.cpp src/patientcensus.cpp src/hospitalnetwork.cpp src/hospitalconfig.cpp ^
+    src/roomscheduler.cpp src/roomtimers.cpp src/journeylog.cpp src/rollingmetrics.cpp src/metricsregistry.cpp src/metricsserver.cpp
 
 :: Check if compilation was successful
 if %errorlevel% neq 0 (
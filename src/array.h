@@ -1,6 +1,9 @@
 #ifndef ARRAY_H
 #define ARRAY_H
 
+#include "memorystats.h"
+#include <stdexcept>
+
 /**
  * DYNAMIC ARRAY TEMPLATE CLASS
  * 
@@ -22,6 +25,7 @@ protected:
     T* buffer;    // Pointer to dynamically allocated array
     int size;     // Current capacity of the array
     int length;   // Current number of elements in array
+    MEMORY_ACCOUNT  // Buffer allocation counters (only with HOSPITAL_MEMORY_STATS)
 
 public:
     /**
@@ -34,9 +38,14 @@ public:
      * - 'buffer' points to the first element of the array
      */
     Array(int m, int l = 0) {
+        // Validation: a negative capacity would wrap to a huge allocation
+        if (m < 0) {
+            throw std::invalid_argument("Array capacity must be non-negative");
+        }
         length = l;
         size = m;
         buffer = new T[size]; // Dynamic memory allocation
+        MEMORY_ACCOUNT_ALLOCATE(sizeof(T) * size);
     }
 
     /**
@@ -47,6 +56,7 @@ public:
      * - Prevents memory leaks by freeing allocated memory
      */
     ~Array() {
+        MEMORY_ACCOUNT_RELEASE(sizeof(T) * size);
         delete[] buffer; // Free dynamically allocated array
     }
 
@@ -215,12 +225,29 @@ public:
         return length;
     }
 
+    /**
+     * GET CURRENT CAPACITY
+     * @return Number of elements the buffer can hold before growing
+     */
+    int capacity() {
+        return size;
+    }
+
+    /**
+     * BUFFER ALLOCATION STATISTICS
+     * @return Live bytes, allocation counts and peak usage of the buffer
+     *         (all zero unless compiled with HOSPITAL_MEMORY_STATS)
+     */
+    MemoryStats memoryStats() {
+        return MEMORY_ACCOUNT_SNAPSHOT();
+    }
+
 protected:
     /**
      * GROW ARRAY CAPACITY WHEN FULL
      * 
      * MEMORY STRATEGY:
-     * - Uses golden ratio (1.618) for growth factor
+     * - Uses golden ratio (1.618) for growth factor, at least one slot
      * - Allocates new larger array
      * - Copies existing elements to new array
      * - Deletes old array to prevent memory leaks
@@ -228,13 +255,18 @@ protected:
     void grow() {
         if (length == size) {
             int newSize = (int)(size * 1.618); // Golden ratio growth
+            if (newSize <= size) {
+                newSize = size + 1;            // Capacities 0 and 1 would not grow
+            }
             T* newBuffer = new T[newSize];     // Allocate new larger array
+            MEMORY_ACCOUNT_ALLOCATE(sizeof(T) * newSize);
             
             // Copy existing elements to new array
             for (int i = 0; i < size; i++) {
                 newBuffer[i] = buffer[i];
             }
             
+            MEMORY_ACCOUNT_RELEASE(sizeof(T) * size);
             delete[] buffer; // Free old array memory
             buffer = newBuffer; // Point to new array
             size = newSize; // Update capacity
@@ -253,12 +285,14 @@ protected:
         if (size > 20 && length <= (int)(size / (1.618 * 1.618))) {
             int newSize = size / 1.618; // Golden ratio shrink
             T* newBuffer = new T[newSize]; // Allocate new smaller array
+            MEMORY_ACCOUNT_ALLOCATE(sizeof(T) * newSize);
             
             // Copy existing elements to new array
             for (int i = 0; i < newSize; i++) {
                 newBuffer[i] = buffer[i];
             }
             
+            MEMORY_ACCOUNT_RELEASE(sizeof(T) * size);
             delete[] buffer; // Free old array memory
             buffer = newBuffer; // Point to new array
             size = newSize; // Update capacity
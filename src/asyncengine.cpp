@@ -0,0 +1,145 @@
+#include "asyncengine.h"
+#include <stdexcept>
+
+using namespace std;
+
+void HospitalTask::FinalAwaiter::await_suspend(coroutine_handle<promise_type> handle) noexcept {
+    AsyncHospitalEngine* engine = handle.promise().engine;
+    handle.destroy();
+    engine->taskFinished();
+}
+
+void HospitalTask::promise_type::unhandled_exception() {
+    engine->taskFailed(current_exception());
+}
+
+AsyncHospitalEngine::AsyncHospitalEngine(int numRooms, int threads)
+    : AsyncHospitalEngine(HospitalConfig::withRooms(numRooms), threads) {}
+
+AsyncHospitalEngine::AsyncHospitalEngine(const HospitalConfig& config, int threads)
+    : system(config, false), parkedWaits(0), liveTasks(0), stopping(false) {
+    if (threads <= 0) {
+        throw invalid_argument("Async engine needs at least one worker thread");
+    }
+    for (int i = 0; i < threads; i++) {
+        workers.push_back(thread(&AsyncHospitalEngine::workerLoop, this));
+    }
+}
+
+AsyncHospitalEngine::~AsyncHospitalEngine() {
+    {
+        lock_guard<mutex> guard(readyLock);
+        stopping = true;
+    }
+    readyAvailable.notify_all();
+    for (size_t i = 0; i < workers.size(); i++) {
+        workers[i].join();
+    }
+    lock_guard<mutex> guard(stateLock);
+    for (size_t i = 0; i < roomWaiters.size(); i++) {
+        roomWaiters[i].destroy();
+    }
+    roomWaiters.clear();
+}
+
+AsyncHospitalEngine::Operation<int> AsyncHospitalEngine::registerPatient(const string& name, int age, int priority,
+                                                                         const string& symptom) {
+    return Operation<int>(this, [this, name, age, priority, symptom] {
+        return system.registerPatient(name, age, priority, symptom);
+    });
+}
+
+AsyncHospitalEngine::Operation<PatientSnapshot> AsyncHospitalEngine::attendNext() {
+    return Operation<PatientSnapshot>(this, [this] {
+        return PatientSnapshot(system.attendNextPatient());
+    });
+}
+
+/**
+ * FREE A ROOM AND HAND IT TO THE LONGEST-PARKED WAITER
+ * - The waiter goes to the run queue, never resumed inline under stateLock
+ */
+AsyncHospitalEngine::Operation<PatientSnapshot> AsyncHospitalEngine::freeRoom() {
+    return Operation<PatientSnapshot>(this, [this] {
+        Patient* completed = system.freeConsultationRoom();
+        if (completed != NULL && !roomWaiters.empty()) {
+            schedule(roomWaiters.front());
+            roomWaiters.pop_front();
+        }
+        return PatientSnapshot(completed);
+    });
+}
+
+AsyncHospitalEngine::Operation<PatientSnapshot> AsyncHospitalEngine::searchPatient(int patientId) {
+    return Operation<PatientSnapshot>(this, [this, patientId] {
+        return PatientSnapshot(system.searchPatient(patientId));
+    });
+}
+
+void AsyncHospitalEngine::spawn(HospitalTask task) {
+    coroutine_handle<HospitalTask::promise_type> handle = task.handle;
+    task.handle = nullptr;
+    handle.promise().engine = this;
+    {
+        lock_guard<mutex> guard(doneLock);
+        liveTasks++;
+    }
+    schedule(handle);
+}
+
+void AsyncHospitalEngine::schedule(coroutine_handle<> handle) {
+    {
+        lock_guard<mutex> guard(readyLock);
+        ready.push_back(handle);
+    }
+    readyAvailable.notify_one();
+}
+
+/**
+ * WORKER LOOP - Resume queued coroutines until shutdown
+ * - Work already queued when the destructor runs is still finished
+ */
+void AsyncHospitalEngine::workerLoop() {
+    while (true) {
+        coroutine_handle<> next;
+        {
+            unique_lock<mutex> guard(readyLock);
+            readyAvailable.wait(guard, [this] { return stopping || !ready.empty(); });
+            if (ready.empty()) {
+                return;
+            }
+            next = ready.front();
+            ready.pop_front();
+        }
+        next.resume();
+    }
+}
+
+void AsyncHospitalEngine::drain() {
+    unique_lock<mutex> guard(doneLock);
+    allDone.wait(guard, [this] { return liveTasks == 0; });
+    if (firstError) {
+        exception_ptr error = firstError;
+        firstError = nullptr;
+        rethrow_exception(error);
+    }
+}
+
+long long AsyncHospitalEngine::roomWaits() {
+    lock_guard<mutex> guard(stateLock);
+    return parkedWaits;
+}
+
+void AsyncHospitalEngine::taskFinished() {
+    lock_guard<mutex> guard(doneLock);
+    if (--liveTasks == 0) {
+        allDone.notify_all();
+    }
+}
+
+void AsyncHospitalEngine::taskFailed(exception_ptr error) {
+    lock_guard<mutex> guard(doneLock);
+    if (!firstError) {
+        firstError = error;
+    }
+}
@@ -0,0 +1,235 @@
+#ifndef ASYNCENGINE_H
+#define ASYNCENGINE_H
+
+#include "hospitalengine.h"
+#include "hospitalsystem.h"
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class AsyncHospitalEngine;
+
+/**
+ * DETACHED HOSPITAL COROUTINE
+ * - Return type of coroutines started with AsyncHospitalEngine::spawn()
+ * - Created suspended; spawn() queues its first resumption on the engine
+ * - The frame frees itself when the body finishes; an exception escaping
+ *   the body is handed to the engine and rethrown by drain()
+ */
+class HospitalTask {
+public:
+    struct promise_type;
+
+    /**
+     * FINAL SUSPENSION - Frees the frame, then reports completion
+     */
+    struct FinalAwaiter {
+        bool await_ready() noexcept { return false; }
+        void await_suspend(std::coroutine_handle<promise_type> handle) noexcept;
+        void await_resume() noexcept {}
+    };
+
+    struct promise_type {
+        AsyncHospitalEngine* engine = nullptr;  ///< Set by spawn()
+
+        HospitalTask get_return_object() {
+            return HospitalTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        FinalAwaiter final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception();
+    };
+
+    HospitalTask(HospitalTask&& other) noexcept : handle(other.handle) { other.handle = nullptr; }
+
+    /**
+     * DESTRUCTOR - Frees a coroutine that was never spawned
+     */
+    ~HospitalTask() {
+        if (handle) handle.destroy();
+    }
+
+    HospitalTask(const HospitalTask&) = delete;
+    HospitalTask& operator=(const HospitalTask&) = delete;
+
+private:
+    std::coroutine_handle<promise_type> handle;
+
+    explicit HospitalTask(std::coroutine_handle<promise_type> h) : handle(h) {}
+
+    friend class AsyncHospitalEngine;
+};
+
+/**
+ * ASYNC HOSPITAL ENGINE - C++20 COROUTINE FRONT END FOR HospitalSystem
+ *
+ * EXECUTION MODEL:
+ * - Coroutines run on a small fixed set of worker threads (default 2),
+ *   never on a thread of their own: thousands of waiting registration
+ *   desks or room terminals cost one coroutine frame each, not one thread
+ * - Workers share one FIFO run queue of coroutine handles. Every operation
+ *   is an awaitable that re-queues the coroutine at the back and applies
+ *   the call under the state mutex when a worker resumes it, so runnable
+ *   coroutines take turns instead of one running to completion (the
+ *   work-stealing ThreadPool is LIFO per worker, right for batch jobs but
+ *   not for fairness between clients)
+ *
+ * ROOM WAITING:
+ * - co_await waitForFreeRoom() completes immediately while a room is free;
+ *   otherwise the coroutine is parked (no thread blocked) in FIFO order
+ * - Each room released by freeRoom() resumes exactly one parked coroutine
+ * - The wake-up is a hand-over, not a reservation: a resumed coroutine is
+ *   expected to attendNext() right away and to wait again if it lost the
+ *   room to another caller
+ *
+ * ERRORS: Exceptions thrown by HospitalSystem are rethrown at the co_await
+ * that issued the operation.
+ *
+ * USAGE:
+ *   HospitalTask doctor(AsyncHospitalEngine& engine) {
+ *       co_await engine.waitForFreeRoom();
+ *       PatientSnapshot attended = co_await engine.attendNext();
+ *   }
+ *   engine.spawn(doctor(engine));
+ *   engine.drain();
+ */
+class AsyncHospitalEngine {
+public:
+    /**
+     * AWAITABLE HOSPITAL OPERATION
+     * - Suspends to the back of the run queue; the call is applied under
+     *   the state mutex by the worker that resumes the coroutine
+     */
+    template<typename T>
+    class Operation {
+    private:
+        AsyncHospitalEngine* engine;
+        std::function<T()> apply;  ///< Runs with stateLock held
+
+    public:
+        Operation(AsyncHospitalEngine* owner, std::function<T()> operation)
+            : engine(owner), apply(std::move(operation)) {}
+
+        bool await_ready() const noexcept { return false; }
+
+        void await_suspend(std::coroutine_handle<> handle) {
+            engine->schedule(handle);
+        }
+
+        T await_resume() {
+            std::lock_guard<std::mutex> guard(engine->stateLock);
+            return apply();
+        }
+    };
+
+    /**
+     * AWAITABLE ROOM WAIT - Parks the coroutine while every room is occupied
+     */
+    class RoomAwaiter {
+    private:
+        AsyncHospitalEngine* engine;
+
+    public:
+        explicit RoomAwaiter(AsyncHospitalEngine* owner) : engine(owner) {}
+
+        bool await_ready() const noexcept { return false; }
+
+        /**
+         * @return false (resume at once) if a room is free right now
+         */
+        bool await_suspend(std::coroutine_handle<> handle) {
+            std::lock_guard<std::mutex> guard(engine->stateLock);
+            SystemStatus current = engine->system.status();
+            if (current.inConsultation < current.rooms) {
+                return false;
+            }
+            engine->roomWaiters.push_back(handle);
+            engine->parkedWaits++;
+            return true;
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    /**
+     * CONSTRUCTOR
+     * @param numRooms: Consultation rooms of the owned HospitalSystem
+     * @param threads: Worker threads that run every coroutine (fixed)
+     */
+    explicit AsyncHospitalEngine(int numRooms = 10, int threads = 2);
+
+    /**
+     * CONFIGURED ENGINE
+     * @param config: Topology of the owned HospitalSystem (specialties,
+     *                triage levels, consultation times, pre-sizing)
+     * @param threads: Worker threads that run every coroutine (fixed)
+     * EXCEPTION: Throws invalid_argument for an invalid configuration
+     */
+    explicit AsyncHospitalEngine(const HospitalConfig& config, int threads = 2);
+
+    /**
+     * DESTRUCTOR - Finishes running work; coroutines still parked on a
+     * room wait are destroyed without being resumed
+     */
+    ~AsyncHospitalEngine();
+
+    Operation<int> registerPatient(const std::string& name, int age, int priority, const std::string& symptom);
+    Operation<PatientSnapshot> attendNext();
+    Operation<PatientSnapshot> freeRoom();
+    Operation<PatientSnapshot> searchPatient(int patientId);
+    RoomAwaiter waitForFreeRoom() { return RoomAwaiter(this); }
+
+    /**
+     * START A COROUTINE ON THE WORKERS
+     */
+    void spawn(HospitalTask task);
+
+    /**
+     * WAIT UNTIL EVERY SPAWNED COROUTINE HAS FINISHED
+     * - Coroutines parked on a room wait keep drain() waiting until a room
+     *   is freed for them
+     * EXCEPTION: Rethrows the first exception that escaped a coroutine
+     */
+    void drain();
+
+    /**
+     * NUMBER OF TIMES A COROUTINE WAS PARKED BY waitForFreeRoom()
+     */
+    long long roomWaits();
+
+    AsyncHospitalEngine(const AsyncHospitalEngine&) = delete;
+    AsyncHospitalEngine& operator=(const AsyncHospitalEngine&) = delete;
+
+private:
+    HospitalSystem system;                            ///< Guarded by stateLock
+    std::mutex stateLock;
+    std::deque<std::coroutine_handle<>> roomWaiters;  ///< Parked coroutines, FIFO (stateLock)
+    long long parkedWaits;                            ///< Guarded by stateLock
+
+    std::mutex doneLock;
+    std::condition_variable allDone;
+    int liveTasks;                                    ///< Spawned and not finished (doneLock)
+    std::exception_ptr firstError;                    ///< First escaped exception (doneLock)
+
+    std::mutex readyLock;
+    std::condition_variable readyAvailable;
+    std::deque<std::coroutine_handle<>> ready;        ///< Run queue, FIFO (readyLock)
+    bool stopping;                                    ///< Set under readyLock by the destructor
+    std::vector<std::thread> workers;
+
+    void schedule(std::coroutine_handle<> handle);
+    void workerLoop();
+    void taskFinished();
+    void taskFailed(std::exception_ptr error);
+
+    friend class HospitalTask;
+};
+
+#endif
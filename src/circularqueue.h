@@ -2,6 +2,8 @@
 #define CIRCULARQUEUE_H
 
 #include "list.h"
+#include "memorystats.h"
+#include "trace.h"
 #include <stdexcept>
 
 /**
@@ -20,7 +22,7 @@
  * - Enqueue: O(1) - constant time insertion at tail
  * - Dequeue: O(1) - constant time removal from head  
  * - Search: O(n) - linear search through circular list
- * - Memory: Dynamic allocation per node
+ * - Memory: Dynamic allocation per node, or none at all after reserve()
  */
 template <typename T>
 class CircularQueue {
@@ -29,6 +31,9 @@ private:
     Node<T>* tail;           ///< Pointer to the last node in the circular queue (rear)
     int currentSize;         ///< Current number of elements in the queue
     int capacity;            ///< Maximum capacity of the queue (fixed at construction)
+    Node<T>* spare;          ///< Free nodes kept by reserve() (linked through next)
+    bool reserved;           ///< Dequeued nodes go back to spare instead of being freed
+    MEMORY_ACCOUNT           ///< Node allocation counters (only with HOSPITAL_MEMORY_STATS)
 
 public:
     /**
@@ -42,7 +47,8 @@ public:
      * 
      * MEMORY STATE: No dynamic allocation until elements are added
      */
-    CircularQueue(int cap) : head(nullptr), tail(nullptr), currentSize(0), capacity(cap) {
+    CircularQueue(int cap)
+        : head(nullptr), tail(nullptr), currentSize(0), capacity(cap), spare(nullptr), reserved(false) {
         // Validation: Ensure positive capacity
         if (cap <= 0) {
             throw std::invalid_argument("Circular queue capacity must be positive");
@@ -59,6 +65,34 @@ public:
      */
     ~CircularQueue() {
         clear();
+        while (spare != nullptr) {
+            Node<T>* temp = spare;
+            spare = spare->next;
+            MEMORY_ACCOUNT_RELEASE(sizeof(Node<T>));
+            delete temp;
+        }
+    }
+
+    /**
+     * PRE-ALLOCATE ONE NODE PER SLOT
+     * 
+     * BEHAVIOR:
+     * - Allocates a spare node for every free slot of the fixed capacity
+     * - From then on dequeue() keeps nodes as spares and enqueue() reuses
+     *   them, so room turnover never allocates
+     */
+    void reserve() {
+        reserved = true;
+        int spares = 0;
+        for (Node<T>* node = spare; node != nullptr; node = node->next) {
+            spares++;
+        }
+        for (; currentSize + spares < capacity; spares++) {
+            MEMORY_ACCOUNT_ALLOCATE(sizeof(Node<T>));
+            Node<T>* node = new Node<T>(T());
+            node->next = spare;
+            spare = node;
+        }
     }
 
     /**
@@ -92,12 +126,21 @@ public:
      * - Strong exception safety guarantee
      */
     void enqueue(T data) {
+        TRACE_SCOPE("CircularQueue::enqueue");
         if (isFull()) {
             throw std::runtime_error("Circular queue is full - No available consultation rooms");
         }
         
-        // Create new node with provided data
-        Node<T>* newNode = new Node<T>(data);
+        // Take a reserved node, or create a new one, with the provided data
+        Node<T>* newNode = spare;
+        if (newNode != nullptr) {
+            spare = spare->next;
+            newNode->data = data;
+            newNode->next = nullptr;
+        } else {
+            newNode = new Node<T>(data);
+            MEMORY_ACCOUNT_ALLOCATE(sizeof(Node<T>));
+        }
         
         if (isEmpty()) {
             // First element in queue - establish circular structure
@@ -147,7 +190,13 @@ public:
             tail->next = head;     // Update tail to point to new head (maintain circle)
         }
         
-        delete temp;        // Free the old head node memory
+        if (reserved) {
+            temp->next = spare;  // Keep the node for the next enqueue
+            spare = temp;
+        } else {
+            MEMORY_ACCOUNT_RELEASE(sizeof(Node<T>));
+            delete temp;     // Free the old head node memory
+        }
         currentSize--;      // Decrement element count
         return data;        // Return the retrieved data
     }
@@ -196,6 +245,15 @@ public:
         return capacity;
     }
 
+    /**
+     * NODE ALLOCATION STATISTICS
+     * @return Live bytes, allocation counts and peak usage of the nodes
+     *         (all zero unless compiled with HOSPITAL_MEMORY_STATS)
+     */
+    MemoryStats memoryStats() {
+        return MEMORY_ACCOUNT_SNAPSHOT();
+    }
+
     /**
      * PEEK AT FRONT ELEMENT WITHOUT REMOVING
      * @return Element at the front of the queue
@@ -0,0 +1,150 @@
+#ifndef EVENTCALENDAR_H
+#define EVENTCALENDAR_H
+
+#include "array.h"
+#include <stdexcept>
+
+/**
+ * EVENT CALENDAR TEMPLATE CLASS - BINARY MIN-HEAP
+ *
+ * IMPLEMENTATION: Implicit binary heap stored in the project's dynamic Array
+ * - Parent of position i is (i - 1) / 2, children are 2i + 1 and 2i + 2
+ * - The root (position 0) always holds the earliest pending event
+ * - Ties on time are broken by insertion sequence, so two events scheduled
+ *   for the same instant fire in the order they were scheduled (determinism)
+ *
+ * SIMULATION CONTEXT: Future event list of the discrete-event simulator
+ * (arrivals and consultation completions ordered by simulated time)
+ *
+ * TIME COMPLEXITY:
+ * - schedule(): O(log n) - sift up
+ * - pop(): O(log n) - sift down
+ * - nextTime(): O(1) - root inspection
+ */
+template <typename T>
+class EventCalendar {
+private:
+    /**
+     * HEAP ENTRY - Simulated time, tie-breaker and user payload
+     */
+    struct Entry {
+        double time;                  ///< Simulated time the event fires
+        unsigned long long sequence;  ///< Insertion order (tie-breaker)
+        T payload;                    ///< Event data
+
+        bool before(const Entry& other) const {
+            return time < other.time || (time == other.time && sequence < other.sequence);
+        }
+    };
+
+    Array<Entry>* heap;               ///< Heap storage (grows with golden ratio)
+    unsigned long long nextSequence;  ///< Sequence number for the next event
+
+    void swapEntries(int a, int b) {
+        Entry temp = (*heap)[a];
+        (*heap)[a] = (*heap)[b];
+        (*heap)[b] = temp;
+    }
+
+public:
+    /**
+     * CONSTRUCTOR
+     * @param initialCapacity: Pre-sized heap capacity (grows automatically)
+     */
+    EventCalendar(int initialCapacity = 64) : nextSequence(0) {
+        heap = new Array<Entry>(initialCapacity < 2 ? 2 : initialCapacity);
+    }
+
+    ~EventCalendar() {
+        delete heap;
+    }
+
+    EventCalendar(const EventCalendar&) = delete;
+    EventCalendar& operator=(const EventCalendar&) = delete;
+
+    /**
+     * SCHEDULE AN EVENT
+     * @param time: Simulated time at which the event fires
+     * @param payload: Event data returned by pop()
+     *
+     * ALGORITHM: Append at the bottom, then sift up while earlier than parent
+     */
+    void schedule(double time, T payload) {
+        Entry entry;
+        entry.time = time;
+        entry.sequence = nextSequence++;
+        entry.payload = payload;
+        heap->append(entry);
+
+        int index = heap->len() - 1;
+        while (index > 0) {
+            int parent = (index - 1) / 2;
+            if (!(*heap)[index].before((*heap)[parent])) {
+                break;
+            }
+            swapEntries(index, parent);
+            index = parent;
+        }
+    }
+
+    /**
+     * REMOVE AND RETURN THE EARLIEST EVENT
+     * @param time: Receives the simulated time of the event
+     * @return Payload of the earliest event
+     *
+     * ALGORITHM: Move the last entry to the root, then sift down
+     * EXCEPTION: Throws runtime_error if the calendar is empty
+     */
+    T pop(double& time) {
+        if (isEmpty()) {
+            throw std::runtime_error("Event calendar is empty - no pending events");
+        }
+        Entry root = (*heap)[0];
+        int lastIndex = heap->len() - 1;
+        (*heap)[0] = (*heap)[lastIndex];
+        heap->del();
+
+        int length = heap->len();
+        int index = 0;
+        while (true) {
+            int left = 2 * index + 1;
+            if (left >= length) {
+                break;
+            }
+            int smallest = left;
+            int right = left + 1;
+            if (right < length && (*heap)[right].before((*heap)[left])) {
+                smallest = right;
+            }
+            if (!(*heap)[smallest].before((*heap)[index])) {
+                break;
+            }
+            swapEntries(index, smallest);
+            index = smallest;
+        }
+
+        time = root.time;
+        return root.payload;
+    }
+
+    /**
+     * TIME OF THE EARLIEST EVENT WITHOUT REMOVAL
+     * EXCEPTION: Throws runtime_error if the calendar is empty
+     */
+    double nextTime() {
+        if (isEmpty()) {
+            throw std::runtime_error("Event calendar is empty - no pending events");
+        }
+        return (*heap)[0].time;
+    }
+
+    bool isEmpty() {
+        return heap->len() == 0;
+    }
+
+    int len() {
+        return heap->len();
+    }
+};
+
+#endif
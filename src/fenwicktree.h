@@ -0,0 +1,94 @@
+#ifndef FENWICKTREE_H
+#define FENWICKTREE_H
+
+#include <stdexcept>
+#include <vector>
+
+/**
+ * TWO-DIMENSIONAL FENWICK TREE (BINARY INDEXED TREE) TEMPLATE CLASS
+ *
+ * IMPLEMENTATION: rows x columns grid of partial sums in one flat vector;
+ * cell (r, c) of the tree covers the input rectangle ending at (r, c)
+ * whose sides are the lowest set bits of r + 1 and c + 1
+ * HOSPITAL APPLICATION: Patient counts per age x triage level
+ *
+ * PERFORMANCE CHARACTERISTICS:
+ * - add(row, column, delta): O(log rows * log columns)
+ * - prefixSum / rangeSum: O(log rows * log columns)
+ * - Memory: rows * columns values, no allocation after construction
+ */
+template <typename T>
+class FenwickTree2D {
+private:
+    int rows;
+    int columns;
+    std::vector<T> tree;  ///< tree[r * columns + c], 0-based storage of the 1-based tree
+
+    /**
+     * SUM OF CELLS [0, row] x [0, column] (-1 for an empty prefix)
+     */
+    T prefixSum(int row, int column) const {
+        T sum = T();
+        for (int r = row + 1; r > 0; r -= r & -r) {
+            for (int c = column + 1; c > 0; c -= c & -c) {
+                sum += tree[(size_t)(r - 1) * columns + (c - 1)];
+            }
+        }
+        return sum;
+    }
+
+public:
+    /**
+     * CONSTRUCTOR - All cells start at zero
+     * EXCEPTION: Throws invalid_argument for non-positive dimensions
+     */
+    FenwickTree2D(int _rows, int _columns) : rows(_rows), columns(_columns) {
+        if (_rows <= 0 || _columns <= 0) {
+            throw std::invalid_argument("Fenwick tree dimensions must be positive");
+        }
+        tree.assign((size_t)_rows * _columns, T());
+    }
+
+    /**
+     * BYTES HELD BY THE GRID (fixed at construction)
+     */
+    std::size_t memoryBytes() const {
+        return tree.capacity() * sizeof(T);
+    }
+
+    /**
+     * ADD delta TO ONE CELL
+     * EXCEPTION: Throws out_of_range for a cell outside the grid
+     */
+    void add(int row, int column, T delta) {
+        if (row < 0 || row >= rows || column < 0 || column >= columns) {
+            throw std::out_of_range("Fenwick tree cell out of range");
+        }
+        for (int r = row + 1; r <= rows; r += r & -r) {
+            for (int c = column + 1; c <= columns; c += c & -c) {
+                tree[(size_t)(r - 1) * columns + (c - 1)] += delta;
+            }
+        }
+    }
+
+    /**
+     * SUM OVER THE RECTANGLE [firstRow, lastRow] x [firstColumn, lastColumn]
+     * - Bounds are clamped to the grid; an empty rectangle sums to zero
+     */
+    T rangeSum(int firstRow, int lastRow, int firstColumn, int lastColumn) const {
+        if (firstRow < 0) firstRow = 0;
+        if (firstColumn < 0) firstColumn = 0;
+        if (lastRow >= rows) lastRow = rows - 1;
+        if (lastColumn >= columns) lastColumn = columns - 1;
+        if (firstRow > lastRow || firstColumn > lastColumn) {
+            return T();
+        }
+        return prefixSum(lastRow, lastColumn) - prefixSum(firstRow - 1, lastColumn)
+               - prefixSum(lastRow, firstColumn - 1) + prefixSum(firstRow - 1, firstColumn - 1);
+    }
+
+    int getRows() const { return rows; }
+    int getColumns() const { return columns; }
+};
+
+#endif
@@ -0,0 +1,147 @@
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+
+#include <cstdint>
+#include <cstring>
+
+/**
+ * HDR-STYLE HISTOGRAM CLASS
+ *
+ * PURPOSE: Records millions of non-negative integer samples (wait times,
+ * latencies) in constant memory and answers percentile queries.
+ *
+ * BUCKET LAYOUT (log-linear, as in HdrHistogram):
+ * - Values below 2^SUB_BUCKET_BITS are recorded exactly
+ * - Larger values fall into one of 2^(SUB_BUCKET_BITS-1) linear sub-buckets
+ *   inside their power-of-two range, so the relative error stays below
+ *   1 / 2^(SUB_BUCKET_BITS-1) (about 1.6%) across the full 64-bit range
+ *
+ * PERFORMANCE CHARACTERISTICS:
+ * - record(): O(1) - one count-leading-zeros plus one array increment
+ * - percentile(): O(buckets) - single pass over the counts array
+ * - Memory: fixed BUCKET_COUNT counters, no allocation after construction
+ */
+class Histogram {
+public:
+    static const int SUB_BUCKET_BITS = 7;                          ///< Precision bits
+    static const int SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;      ///< Exact range (128)
+    static const int SUB_BUCKET_HALF = SUB_BUCKET_COUNT / 2;       ///< Sub-buckets per range (64)
+    static const int BUCKET_COUNT = SUB_BUCKET_COUNT + (64 - SUB_BUCKET_BITS) * SUB_BUCKET_HALF;
+
+private:
+    std::uint64_t counts[BUCKET_COUNT];  ///< Sample count per bucket
+    std::uint64_t totalCount;            ///< Number of recorded samples
+    std::uint64_t minValue;              ///< Smallest recorded sample
+    std::uint64_t maxValue;              ///< Largest recorded sample
+    double sum;                          ///< Running sum for the mean
+
+    /**
+     * MAP A VALUE TO ITS BUCKET INDEX
+     * - Exact region: index == value
+     * - Log region: shift by (msb - SUB_BUCKET_BITS + 1) and keep the top bits
+     */
+    static int bucketIndex(std::uint64_t value) {
+        if (value < (std::uint64_t)SUB_BUCKET_COUNT) {
+            return (int)value;
+        }
+        int msb = 63 - __builtin_clzll(value);
+        int shift = msb - (SUB_BUCKET_BITS - 1);
+        int subBucket = (int)(value >> shift);  // In [SUB_BUCKET_HALF, SUB_BUCKET_COUNT)
+        return SUB_BUCKET_COUNT + (shift - 1) * SUB_BUCKET_HALF + (subBucket - SUB_BUCKET_HALF);
+    }
+
+    /**
+     * HIGHEST VALUE THAT MAPS TO A BUCKET
+     * - Percentiles report this bound, so they never under-estimate a sample
+     */
+    static std::uint64_t bucketUpperBound(int index) {
+        if (index < SUB_BUCKET_COUNT) {
+            return (std::uint64_t)index;
+        }
+        int shift = (index - SUB_BUCKET_COUNT) / SUB_BUCKET_HALF + 1;
+        std::uint64_t subBucket = (std::uint64_t)((index - SUB_BUCKET_COUNT) % SUB_BUCKET_HALF + SUB_BUCKET_HALF);
+        return ((subBucket + 1) << shift) - 1;
+    }
+
+public:
+    /**
+     * CONSTRUCTOR - Starts with every bucket empty
+     */
+    Histogram() {
+        reset();
+    }
+
+    /**
+     * RESET - Discards all recorded samples
+     */
+    void reset() {
+        std::memset(counts, 0, sizeof(counts));
+        totalCount = 0;
+        minValue = UINT64_MAX;
+        maxValue = 0;
+        sum = 0.0;
+    }
+
+    /**
+     * RECORD ONE SAMPLE
+     * @param value: Non-negative sample (units chosen by the caller)
+     *
+     * TIME COMPLEXITY: O(1)
+     */
+    void record(std::uint64_t value) {
+        counts[bucketIndex(value)]++;
+        totalCount++;
+        sum += (double)value;
+        if (value < minValue) minValue = value;
+        if (value > maxValue) maxValue = value;
+    }
+
+    /**
+     * MERGE ANOTHER HISTOGRAM INTO THIS ONE
+     * @param other: Histogram with the same bucket layout
+     *
+     * USAGE: Combining per-thread or per-replication histograms
+     */
+    void merge(const Histogram& other) {
+        for (int i = 0; i < BUCKET_COUNT; i++) {
+            counts[i] += other.counts[i];
+        }
+        totalCount += other.totalCount;
+        sum += other.sum;
+        if (other.minValue < minValue) minValue = other.minValue;
+        if (other.maxValue > maxValue) maxValue = other.maxValue;
+    }
+
+    /**
+     * VALUE AT A GIVEN PERCENTILE
+     * @param percent: Percentile in [0, 100] (e.g. 99.9)
+     * @return Upper bound of the bucket holding that rank, 0 if empty
+     */
+    std::uint64_t percentile(double percent) const {
+        if (totalCount == 0) {
+            return 0;
+        }
+        if (percent >= 100.0) {
+            return maxValue;
+        }
+        std::uint64_t rank = (std::uint64_t)(percent / 100.0 * (double)totalCount + 0.5);
+        if (rank < 1) rank = 1;
+
+        std::uint64_t seen = 0;
+        for (int i = 0; i < BUCKET_COUNT; i++) {
+            seen += counts[i];
+            if (seen >= rank) {
+                std::uint64_t bound = bucketUpperBound(i);
+                return bound < maxValue ? bound : maxValue;
+            }
+        }
+        return maxValue;
+    }
+
+    std::uint64_t count() const { return totalCount; }
+    std::uint64_t min() const { return totalCount == 0 ? 0 : minValue; }
+    std::uint64_t max() const { return maxValue; }
+    double mean() const { return totalCount == 0 ? 0.0 : sum / (double)totalCount; }
+};
+
+#endif
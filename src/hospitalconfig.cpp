@@ -0,0 +1,223 @@
+#include "hospitalconfig.h"
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+using namespace std;
+
+HospitalConfig::HospitalConfig()
+    : triageLevels(MAX_TRIAGE_LEVELS), fallback(FALLBACK_GENERAL), anyRoomLevel(1), overdue(OVERDUE_FLAG), expectedPatients(200),
+      expectedWaiting(200), expectedHistory(200), expectedSymptomTerms(256) {
+    static const int minutes[MAX_TRIAGE_LEVELS] = {60, 45, 30, 20, 15};
+    for (int level = 0; level < MAX_TRIAGE_LEVELS; level++) {
+        consultationMinutes[level] = minutes[level];
+    }
+    specialties.push_back(SpecialtyConfig("general", 10));
+}
+
+HospitalConfig HospitalConfig::withRooms(int numRooms) {
+    HospitalConfig config;
+    config.specialties[0].rooms = numRooms;
+    return config;
+}
+
+int HospitalConfig::totalRooms() const {
+    int total = 0;
+    for (size_t i = 0; i < specialties.size(); i++) {
+        total += specialties[i].rooms;
+    }
+    return total;
+}
+
+/**
+ * TCP PORT NUMBER, 1-65535 - WHOLE STRING, DIGITS ONLY
+ */
+static bool parsePort(const string& text, int& port) {
+    if (text.empty() || text.size() > 5 || text.find_first_not_of("0123456789") != string::npos) {
+        return false;
+    }
+    port = atoi(text.c_str());
+    return port >= 1 && port <= 65535;
+}
+
+void HospitalConfig::validate() const {
+    if (specialties.empty()) {
+        throw invalid_argument("At least one specialty with rooms is required");
+    }
+    if ((int)specialties.size() > MAX_SPECIALTIES) {
+        throw invalid_argument("At most 64 specialties are supported");
+    }
+    for (size_t i = 0; i < specialties.size(); i++) {
+        if (specialties[i].rooms <= 0) {
+            throw invalid_argument("Specialty " + specialties[i].name + " needs at least one room");
+        }
+    }
+    if (triageLevels < 1 || triageLevels > MAX_TRIAGE_LEVELS) {
+        throw invalid_argument("Triage levels must be between 1 and 5");
+    }
+    if (anyRoomLevel < 0 || anyRoomLevel > triageLevels) {
+        throw invalid_argument("any_room_level must be between 0 and the number of triage levels");
+    }
+    for (int level = 0; level < MAX_TRIAGE_LEVELS; level++) {
+        if (consultationMinutes[level] <= 0 || consultationMinutes[level] > 24 * 60) {
+            throw invalid_argument("Consultation minutes must be between 1 and 1440");
+        }
+    }
+    if (expectedPatients < 0 || expectedWaiting < 0 || expectedHistory < 0 || expectedSymptomTerms < 0) {
+        throw invalid_argument("Capacity hints cannot be negative");
+    }
+    if (!metricsListen.empty()) {
+        size_t colon = metricsListen.rfind(':');
+        int port = 0;
+        if (colon == string::npos || colon == 0 || !parsePort(metricsListen.substr(colon + 1), port)) {
+            throw invalid_argument("Metrics listen address must be HOST:PORT, got " + metricsListen);
+        }
+    }
+}
+
+/**
+ * TEXT WITHOUT LEADING AND TRAILING BLANKS
+ */
+static string trim(const string& text) {
+    size_t start = text.find_first_not_of(" \t\r");
+    if (start == string::npos) {
+        return "";
+    }
+    size_t end = text.find_last_not_of(" \t\r");
+    return text.substr(start, end - start + 1);
+}
+
+/**
+ * WHOLE-STRING DECIMAL INTEGER
+ * @return false for anything else (empty, trailing text, out of int range)
+ */
+static bool parseInt(const string& text, int& value) {
+    if (text.empty()) {
+        return false;
+    }
+    errno = 0;
+    char* end = NULL;
+    long parsed = strtol(text.c_str(), &end, 10);
+    if (*end != '\0' || errno == ERANGE || parsed < INT_MIN || parsed > INT_MAX) {
+        return false;
+    }
+    value = (int)parsed;
+    return true;
+}
+
+HospitalConfig HospitalConfig::load(const string& path) {
+    ifstream file(path.c_str());
+    if (!file) {
+        throw runtime_error("Cannot open configuration file " + path);
+    }
+    return parse(file, path);
+}
+
+/**
+ * PARSE IMPLEMENTATION
+ * - A [rooms] section replaces the default specialty list; every other
+ *   value keeps its default unless set
+ * - Errors carry "source:line" so the operator can fix the file
+ */
+HospitalConfig HospitalConfig::parse(istream& in, const string& source) {
+    HospitalConfig config;
+    bool roomsSeen = false;
+    string section;
+    string line;
+    int lineNumber = 0;
+
+    while (getline(in, line)) {
+        lineNumber++;
+        ostringstream where;
+        where << source << ":" << lineNumber << ": ";
+
+        size_t comment = line.find_first_of("#;");
+        if (comment != string::npos) {
+            line.erase(comment);
+        }
+        line = trim(line);
+        if (line.empty()) {
+            continue;
+        }
+        if (line[0] == '[') {
+            if (line[line.size() - 1] != ']') {
+                throw runtime_error(where.str() + "unterminated section header");
+            }
+            section = trim(line.substr(1, line.size() - 2));
+            if (section != "rooms" && section != "triage" && section != "scheduler" && section != "consultation" &&
+                section != "capacity" && section != "metrics") {
+                throw runtime_error(where.str() + "unknown section [" + section + "]");
+            }
+            continue;
+        }
+
+        size_t equals = line.find('=');
+        if (equals == string::npos) {
+            throw runtime_error(where.str() + "expected key = value");
+        }
+        string key = trim(line.substr(0, equals));
+        string text = trim(line.substr(equals + 1));
+        int value = 0;
+        if (key.empty()) {
+            throw runtime_error(where.str() + "missing key");
+        }
+        bool textual = (section == "scheduler" && key == "fallback") || (section == "consultation" && key == "overdue") ||
+                       (section == "metrics" && key == "listen");
+        if (!textual && !parseInt(text, value)) {
+            throw runtime_error(where.str() + "value of " + key + " must be an integer");
+        }
+
+        if (section == "rooms") {
+            if (!roomsSeen) {
+                config.specialties.clear();
+                roomsSeen = true;
+            }
+            for (size_t i = 0; i < config.specialties.size(); i++) {
+                if (config.specialties[i].name == key) {
+                    throw runtime_error(where.str() + "specialty " + key + " listed twice");
+                }
+            }
+            config.specialties.push_back(SpecialtyConfig(key, value));
+        } else if (section == "triage" && key == "levels") {
+            config.triageLevels = value;
+        } else if (textual && key == "listen") {
+            config.metricsListen = text;
+        } else if (textual && key == "overdue") {
+            if (text == "flag") config.overdue = OVERDUE_FLAG;
+            else if (text == "release") config.overdue = OVERDUE_RELEASE;
+            else throw runtime_error(where.str() + "overdue must be flag or release");
+        } else if (textual) {
+            if (text == "none") config.fallback = FALLBACK_NONE;
+            else if (text == "general") config.fallback = FALLBACK_GENERAL;
+            else if (text == "any") config.fallback = FALLBACK_ANY;
+            else throw runtime_error(where.str() + "fallback must be none, general or any");
+        } else if (section == "scheduler" && key == "any_room_level") {
+            config.anyRoomLevel = value;
+        } else if (section == "consultation" && key.size() == 8 && key.compare(0, 7, "triage_") == 0 &&
+                   key[7] >= '1' && key[7] <= '5') {
+            config.consultationMinutes[key[7] - '1'] = value;
+        } else if (section == "capacity" && key == "patients") {
+            config.expectedPatients = value;
+        } else if (section == "capacity" && key == "waiting") {
+            config.expectedWaiting = value;
+        } else if (section == "capacity" && key == "history") {
+            config.expectedHistory = value;
+        } else if (section == "capacity" && key == "symptom_terms") {
+            config.expectedSymptomTerms = value;
+        } else if (section.empty()) {
+            throw runtime_error(where.str() + key + " appears before any section");
+        } else {
+            throw runtime_error(where.str() + "unknown key " + key + " in [" + section + "]");
+        }
+    }
+
+    try {
+        config.validate();
+    } catch (const invalid_argument& e) {
+        throw runtime_error(source + ": " + e.what());
+    }
+    return config;
+}
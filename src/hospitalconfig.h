@@ -0,0 +1,118 @@
+#ifndef HOSPITALCONFIG_H
+#define HOSPITALCONFIG_H
+
+#include <istream>
+#include <string>
+#include <vector>
+
+/**
+ * CONSULTATION ROOMS OF ONE SPECIALTY
+ */
+struct SpecialtyConfig {
+    std::string name;
+    int rooms;
+
+    SpecialtyConfig(const std::string& _name, int _rooms) : name(_name), rooms(_rooms) {}
+};
+
+/**
+ * ROOM FALLBACK ACROSS SPECIALTIES (RoomScheduler)
+ * - FALLBACK_NONE: a patient only ever gets a room of its own specialty
+ * - FALLBACK_GENERAL: when its own pool is full, a patient may take a room
+ *   of the first specialty listed (the general pool)
+ * - FALLBACK_ANY: when its own pool is full, any free room will do
+ */
+enum FallbackPolicy { FALLBACK_NONE, FALLBACK_GENERAL, FALLBACK_ANY };
+
+/**
+ * WHAT HAPPENS WHEN A CONSULTATION RUNS PAST ITS EXPECTED END (RoomTimers)
+ * - OVERDUE_FLAG: the room is marked overdue and stays occupied until the
+ *   consultation is completed
+ * - OVERDUE_RELEASE: the consultation is completed and the room freed
+ *   automatically at its expected end
+ */
+enum OverduePolicy { OVERDUE_FLAG, OVERDUE_RELEASE };
+
+/**
+ * HOSPITAL CONFIGURATION - READ ONCE AT STARTUP
+ *
+ * FILE FORMAT (INI style, '#' or ';' starts a comment):
+ *
+ *   [rooms]              # one line per specialty: name = rooms
+ *   general = 6
+ *   trauma = 2
+ *   pediatrics = 2
+ *
+ *   [triage]
+ *   levels = 5           # 1-5, TRIAGE I first (Colombian scheme)
+ *
+ *   [scheduler]          # room matching across specialties, optional
+ *   fallback = general   # none | general | any
+ *   any_room_level = 1   # TRIAGE I..this level may take any free room (0: off)
+ *
+ *   [consultation]       # expected minutes per triage level, optional
+ *   triage_1 = 60
+ *   triage_5 = 15
+ *   overdue = flag       # flag | release
+ *
+ *   [capacity]           # pre-sizing hints, all optional
+ *   patients = 5000      # patient database slots and name index entries
+ *   waiting = 500        # triage nodes reserved per level
+ *   history = 5000       # history stack nodes reserved
+ *   symptom_terms = 1000 # distinct symptom terms
+ *
+ *   [metrics]            # Prometheus endpoint, optional
+ *   listen = 127.0.0.1:9400  # HOST:PORT serving GET /metrics (empty: off)
+ *
+ * Every container of HospitalSystem is pre-allocated from these values,
+ * so a day that stays within them runs without reallocating. Going past
+ * a hint is allowed: the container grows as before.
+ *
+ * DEFAULTS: one "general" specialty with 10 rooms, 5 levels, 200 patients,
+ * 200 waiting per level, 200 history entries, 256 symptom terms - the
+ * values that used to be hard-coded. Scheduler: general fallback, TRIAGE I
+ * may take any room. Consultations: 60/45/30/20/15 minutes (the simulator's
+ * means), overdue rooms flagged. No metrics endpoint.
+ */
+struct HospitalConfig {
+    std::vector<SpecialtyConfig> specialties;
+    int triageLevels;
+    FallbackPolicy fallback;
+    int anyRoomLevel;        ///< Levels 1..anyRoomLevel ignore specialty when rooms run out
+    int consultationMinutes[5]; ///< Expected consultation length per triage level
+    OverduePolicy overdue;
+    int expectedPatients;
+    int expectedWaiting;     ///< Per triage level
+    int expectedHistory;
+    int expectedSymptomTerms;
+    std::string metricsListen; ///< "HOST:PORT" of the /metrics endpoint, empty when off
+
+    static const int MAX_TRIAGE_LEVELS = 5;
+    static const int MAX_SPECIALTIES = 64;  ///< One bit per specialty in the scheduler masks
+
+    HospitalConfig();
+
+    /**
+     * DEFAULTS WITH A SINGLE "general" SPECIALTY OF numRooms ROOMS
+     */
+    static HospitalConfig withRooms(int numRooms);
+
+    /**
+     * READ AND VALIDATE A CONFIGURATION FILE
+     * EXCEPTION: Throws runtime_error naming the file and line of the
+     *            first problem (unreadable file, unknown section or key,
+     *            bad number, invalid value)
+     */
+    static HospitalConfig load(const std::string& path);
+    static HospitalConfig parse(std::istream& in, const std::string& source);
+
+    /**
+     * CHECK EVERY VALUE
+     * EXCEPTION: Throws invalid_argument describing the first invalid value
+     */
+    void validate() const;
+
+    int totalRooms() const;
+};
+
+#endif
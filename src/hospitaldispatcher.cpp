@@ -0,0 +1,100 @@
+#include "hospitaldispatcher.h"
+
+using namespace std;
+
+HospitalDispatcher::HospitalDispatcher(int numRooms) : HospitalDispatcher(HospitalConfig::withRooms(numRooms)) {}
+
+HospitalDispatcher::HospitalDispatcher(const HospitalConfig& config) : system(config, false), closed(false) {
+    stats.blockedWaits = 0;
+    stats.futileWakeups = 0;
+    stats.timeouts = 0;
+}
+
+/**
+ * TRIAGE NON-EMPTY AND A ROOM FREE (lock held)
+ */
+bool HospitalDispatcher::canDispatch() {
+    SystemStatus current = system.status();
+    return current.waiting > 0 && current.inConsultation < current.rooms;
+}
+
+int HospitalDispatcher::registerPatient(const string& name, int age, int priority, const string& symptom) {
+    int id;
+    {
+        lock_guard<mutex> guard(lock);
+        id = system.registerPatient(name, age, priority, symptom);
+    }
+    dispatchPossible.notify_one();
+    return id;
+}
+
+PatientSnapshot HospitalDispatcher::freeConsultationRoom() {
+    PatientSnapshot completed;
+    {
+        lock_guard<mutex> guard(lock);
+        completed = PatientSnapshot(system.freeConsultationRoom());
+    }
+    if (completed.found) {
+        dispatchPossible.notify_one();
+    }
+    return completed;
+}
+
+PatientSnapshot HospitalDispatcher::searchPatient(int patientId) {
+    lock_guard<mutex> guard(lock);
+    return PatientSnapshot(system.searchPatient(patientId));
+}
+
+PatientSnapshot HospitalDispatcher::tryAttend() {
+    lock_guard<mutex> guard(lock);
+    return PatientSnapshot(system.attendNextPatient());
+}
+
+PatientSnapshot HospitalDispatcher::waitAndAttend(chrono::nanoseconds timeout) {
+    chrono::steady_clock::time_point deadline = chrono::steady_clock::now() + timeout;
+    unique_lock<mutex> guard(lock);
+    bool slept = false;
+    while (!closed && !canDispatch()) {
+        if (slept) {
+            stats.futileWakeups++;
+        }
+        stats.blockedWaits++;
+        if (dispatchPossible.wait_until(guard, deadline) == cv_status::timeout) {
+            if (closed || !canDispatch()) {
+                stats.timeouts++;
+                return PatientSnapshot();
+            }
+            break;
+        }
+        slept = true;
+    }
+    if (closed) {
+        return PatientSnapshot();
+    }
+
+    PatientSnapshot attended(system.attendNextPatient());
+    bool passOn = canDispatch();
+    guard.unlock();
+    if (passOn) {
+        dispatchPossible.notify_one();
+    }
+    return attended;
+}
+
+void HospitalDispatcher::close() {
+    {
+        lock_guard<mutex> guard(lock);
+        closed = true;
+    }
+    dispatchPossible.notify_all();
+}
+
+SystemStatus HospitalDispatcher::status() {
+    lock_guard<mutex> guard(lock);
+    return system.status();
+}
+
+DispatchStats HospitalDispatcher::waitStats() {
+    lock_guard<mutex> guard(lock);
+    return stats;
+}
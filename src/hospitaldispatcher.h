@@ -0,0 +1,111 @@
+#ifndef HOSPITALDISPATCHER_H
+#define HOSPITALDISPATCHER_H
+
+#include "hospitalengine.h"
+#include "hospitalsystem.h"
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+
+/**
+ * WAIT COUNTERS OF A DISPATCHER
+ */
+struct DispatchStats {
+    long long blockedWaits;   ///< Times a dispatcher went to sleep
+    long long futileWakeups;  ///< Wake-ups that found nothing to dispatch
+    long long timeouts;       ///< waitAndAttend calls that gave up
+};
+
+/**
+ * HOSPITAL DISPATCHER - THREAD-SAFE HospitalSystem WITH BLOCKING ATTEND
+ *
+ * HospitalSystem::attendNextPatient() returns NULL at once when triage is
+ * empty or every room is occupied, so automated dispatch had to poll.
+ * Here dispatcher threads block in waitAndAttend() instead.
+ *
+ * WAKE-UP RULES:
+ * - A dispatch is possible while triage is non-empty AND a room is free
+ * - Dispatchers sleep on one condition variable; registerPatient() and
+ *   freeConsultationRoom() (completes the consultation most likely over:
+ *   the longest-overdue room, else the first expected to end) each make at
+ *   most one more dispatch possible, so each calls notify_one() and wakes
+ *   exactly one dispatcher (no herd)
+ * - A dispatcher that attends and still sees a possible dispatch passes
+ *   the signal on, so bursts that arrived while nobody was waiting are
+ *   not stranded
+ * - close() wakes everyone; waiting dispatchers then return empty-handed
+ *
+ * No busy loops: the only spinning is inside the mutex and condition
+ * variable implementation (a futex on Linux).
+ *
+ * USAGE:
+ *   HospitalDispatcher hospital(10);
+ *   // dispatcher thread
+ *   PatientSnapshot next = hospital.waitAndAttend(std::chrono::milliseconds(500));
+ *   // registration desk thread
+ *   hospital.registerPatient("Ana", 30, 2, "Fever");
+ */
+class HospitalDispatcher {
+private:
+    HospitalSystem system;           ///< Guarded by lock
+    std::mutex lock;
+    std::condition_variable dispatchPossible;
+    bool closed;
+    DispatchStats stats;
+
+    bool canDispatch();
+
+public:
+    /**
+     * @param numRooms: Consultation rooms of the owned HospitalSystem
+     */
+    explicit HospitalDispatcher(int numRooms = 10);
+
+    /**
+     * @param config: Topology of the owned HospitalSystem (specialties,
+     *                triage levels, consultation times, pre-sizing)
+     * EXCEPTION: Throws invalid_argument for an invalid configuration
+     */
+    explicit HospitalDispatcher(const HospitalConfig& config);
+
+    /**
+     * REGISTER A PATIENT AND WAKE ONE WAITING DISPATCHER
+     * EXCEPTION: Throws invalid_argument for invalid patient data
+     */
+    int registerPatient(const std::string& name, int age, int priority, const std::string& symptom);
+
+    /**
+     * FREE THE ROOM MOST LIKELY TO BE OVER AND WAKE ONE WAITING DISPATCHER
+     * - The room overdue the longest, else the one whose consultation is
+     *   expected to end first (HospitalSystem::freeConsultationRoom)
+     */
+    PatientSnapshot freeConsultationRoom();
+
+    PatientSnapshot searchPatient(int patientId);
+
+    /**
+     * NON-BLOCKING ATTEND - HospitalSystem::attendNextPatient() under the lock
+     */
+    PatientSnapshot tryAttend();
+
+    /**
+     * BLOCK UNTIL A PATIENT AND A ROOM ARE BOTH AVAILABLE, THEN ATTEND
+     * @param timeout: Longest time to wait
+     * @return The attended patient; found == false on timeout or close()
+     */
+    PatientSnapshot waitAndAttend(std::chrono::nanoseconds timeout);
+
+    /**
+     * RELEASE EVERY WAITING DISPATCHER (shutdown)
+     */
+    void close();
+
+    SystemStatus status();
+    DispatchStats waitStats();
+
+    HospitalDispatcher(const HospitalDispatcher&) = delete;
+    HospitalDispatcher& operator=(const HospitalDispatcher&) = delete;
+};
+
+#endif
@@ -0,0 +1,392 @@
+#include "hospitalengine.h"
+#include <chrono>
+#include <stdexcept>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace std;
+
+/**
+ * ENGINE CONSTRUCTOR - Starts the owner thread
+ * @param numRooms: Consultation rooms of the owned HospitalSystem
+ * @param _cpu: Core for the owner thread, -1 to leave it unpinned
+ */
+HospitalEngine::HospitalEngine(int numRooms, int _cpu) : HospitalEngine(HospitalConfig::withRooms(numRooms), _cpu) {}
+
+/**
+ * CONFIGURED ENGINE - The owned HospitalSystem is built (and pre-sized)
+ * from config before the owner thread starts
+ */
+HospitalEngine::HospitalEngine(const HospitalConfig& config, int _cpu)
+    : system(config, false), ownerSleeping(false), accepting(true), processed(0), pinned(false), cpu(_cpu) {
+    publishStatus();
+    owner = thread(&HospitalEngine::ownerLoop, this);
+}
+
+HospitalEngine::~HospitalEngine() {
+    shutdown();
+}
+
+void HospitalEngine::shutdown() {
+    if (!accepting.exchange(false)) {
+        return;
+    }
+    // The stop command queues behind everything already submitted
+    commands.push(new EngineCommand(ENGINE_STOP));
+    if (ownerSleeping.load(memory_order_seq_cst)) {
+        lock_guard<mutex> lock(sleepMutex);
+        wakeUp.notify_one();
+    }
+    owner.join();
+}
+
+/**
+ * HAND A COMMAND TO THE OWNER THREAD
+ * - Lock-free on the fast path; the mutex is taken only to wake a sleeping
+ *   owner (the seq_cst push and flag load pair with the owner's seq_cst
+ *   flag store and emptiness check, so a wake-up cannot be lost)
+ */
+void HospitalEngine::submit(EngineCommand* command) {
+    if (!accepting.load(memory_order_acquire)) {
+        delete command;
+        throw runtime_error("Hospital engine is shut down");
+    }
+    commands.push(command);
+    if (ownerSleeping.load(memory_order_seq_cst)) {
+        lock_guard<mutex> lock(sleepMutex);
+        wakeUp.notify_one();
+    }
+}
+
+future<int> HospitalEngine::registerPatient(const string& name, int age, int priority, const string& symptom) {
+    RegisterCommand* command = new RegisterCommand(name, age, priority, symptom);
+    future<int> result = command->result.get_future();
+    submit(command);
+    return result;
+}
+
+future<PatientSnapshot> HospitalEngine::attendNextPatient() {
+    PatientCommand* command = new PatientCommand(ENGINE_ATTEND);
+    future<PatientSnapshot> result = command->result.get_future();
+    submit(command);
+    return result;
+}
+
+future<PatientSnapshot> HospitalEngine::freeConsultationRoom() {
+    PatientCommand* command = new PatientCommand(ENGINE_FREE);
+    future<PatientSnapshot> result = command->result.get_future();
+    submit(command);
+    return result;
+}
+
+future<PatientSnapshot> HospitalEngine::completeConsultation(int room) {
+    PatientCommand* command = new PatientCommand(ENGINE_COMPLETE, room);
+    future<PatientSnapshot> result = command->result.get_future();
+    submit(command);
+    return result;
+}
+
+future<PatientSnapshot> HospitalEngine::searchPatient(int patientId) {
+    PatientCommand* command = new PatientCommand(ENGINE_SEARCH, patientId);
+    future<PatientSnapshot> result = command->result.get_future();
+    submit(command);
+    return result;
+}
+
+future<vector<WaitingSnapshot> > HospitalEngine::longestWaiting(int k) {
+    WaitingCommand* command = new WaitingCommand(k);
+    future<vector<WaitingSnapshot> > result = command->result.get_future();
+    submit(command);
+    return result;
+}
+
+future<TransferResult> HospitalEngine::transferTo(HospitalEngine& destination, TransferChannel& channel,
+                                                int maxPatients, int minPriority, int maxPriority) {
+    if (&destination == this) {
+        throw invalid_argument("A hospital engine cannot transfer patients to itself");
+    }
+    TransferCommand* command =
+        new TransferCommand(ENGINE_TRANSFER_OUT, &destination, &channel, maxPatients, minPriority, maxPriority);
+    future<TransferResult> result = command->result.get_future();
+    channel.inFlight.fetch_add(1, memory_order_relaxed);
+    try {
+        submit(command);
+    } catch (...) {
+        channel.inFlight.fetch_sub(1, memory_order_release);
+        throw;
+    }
+    return result;
+}
+
+/**
+ * OWNER THREAD MAIN LOOP
+ * - Applies commands in queue order until the stop command arrives
+ * - Empty queue: spin SPIN_ROUNDS polls (yielding), then sleep until a
+ *   producer signals or the next consultation is expected to end
+ * - Room timers are brought up to date after every sleep
+ */
+void HospitalEngine::ownerLoop() {
+#ifdef __linux__
+    if (cpu >= 0) {
+        unsigned cores = thread::hardware_concurrency();
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cores > 0 ? cpu % (int)cores : cpu, &set);
+        pinned.store(pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0, memory_order_relaxed);
+    }
+#endif
+    int idleRounds = 0;
+    while (true) {
+        EngineCommand* command = commands.pop();
+        if (command != NULL) {
+            idleRounds = 0;
+            if (command->type == ENGINE_STOP) {
+                delete command;
+                return;
+            }
+            processed.fetch_add(1, memory_order_relaxed);  // Counted before the client can see the result
+            apply(command);
+            publishStatus();
+            delete command;
+            continue;
+        }
+
+        if (++idleRounds < SPIN_ROUNDS || !commands.isEmpty()) {
+            this_thread::yield();  // Empty, or a producer is mid-push
+            continue;
+        }
+
+        unique_lock<mutex> lock(sleepMutex);
+        ownerSleeping.store(true, memory_order_seq_cst);
+        while (commands.isEmpty()) {
+            long long deadline = system.nextRoomDeadline();
+            if (deadline < 0) {
+                wakeUp.wait(lock);
+            } else if (wakeUp.wait_until(lock, chrono::steady_clock::time_point(chrono::nanoseconds(deadline))) ==
+                       cv_status::timeout) {
+                break;
+            }
+        }
+        ownerSleeping.store(false, memory_order_relaxed);
+        lock.unlock();
+        idleRounds = 0;
+
+        long long now = (long long)chrono::duration_cast<chrono::nanoseconds>(
+            chrono::steady_clock::now().time_since_epoch()).count();
+        if (system.processRoomTimers(now) > 0) {
+            publishStatus();
+        }
+    }
+}
+
+/**
+ * COPY THE OWNED SYSTEM'S COUNTERS TO THE PUBLISHED ATOMICS (owner thread)
+ */
+void HospitalEngine::publishStatus() {
+    SystemStatus current = system.status();
+    published.registered.store(current.registered, memory_order_relaxed);
+    published.waiting.store(current.waiting, memory_order_relaxed);
+    published.inConsultation.store(current.inConsultation, memory_order_relaxed);
+    published.rooms.store(current.rooms, memory_order_relaxed);
+    published.completed.store(current.completed, memory_order_relaxed);
+    published.overdue.store(current.overdue, memory_order_relaxed);
+}
+
+SystemStatus HospitalEngine::publishedStatus() const {
+    SystemStatus current;
+    current.registered = published.registered.load(memory_order_relaxed);
+    current.waiting = published.waiting.load(memory_order_relaxed);
+    current.inConsultation = published.inConsultation.load(memory_order_relaxed);
+    current.rooms = published.rooms.load(memory_order_relaxed);
+    current.completed = published.completed.load(memory_order_relaxed);
+    current.overdue = published.overdue.load(memory_order_relaxed);
+    return current;
+}
+
+/**
+ * APPLY ONE COMMAND TO THE OWNED SYSTEM (owner thread only)
+ * - Exceptions are forwarded to the client's future
+ */
+void HospitalEngine::apply(EngineCommand* command) {
+    if (command->type == ENGINE_REGISTER) {
+        RegisterCommand* registration = static_cast<RegisterCommand*>(command);
+        published.registrations.fetch_add(1, memory_order_relaxed);
+        try {
+            registration->result.set_value(system.registerPatient(
+                registration->name, registration->age, registration->priority, registration->symptom));
+        } catch (...) {
+            registration->result.set_exception(current_exception());
+        }
+        return;
+    }
+    if (command->type == ENGINE_LONGEST_WAITING) {
+        WaitingCommand* query = static_cast<WaitingCommand*>(command);
+        try {
+            vector<WaitingPatient> waiting = system.longestWaiting(query->count);
+            query->result.set_value(vector<WaitingSnapshot>(waiting.begin(), waiting.end()));
+        } catch (...) {
+            query->result.set_exception(current_exception());
+        }
+        return;
+    }
+
+    if (command->type == ENGINE_TRANSFER_OUT) {
+        sendTransfer(static_cast<TransferCommand*>(command));
+        return;
+    }
+    if (command->type == ENGINE_TRANSFER_IN) {
+        receiveTransfer(static_cast<TransferCommand*>(command));
+        return;
+    }
+    if (command->type == ENGINE_TRANSFER_RETURN) {
+        returnTransfer(static_cast<TransferCommand*>(command));
+        return;
+    }
+
+    PatientCommand* request = static_cast<PatientCommand*>(command);
+    try {
+        Patient* patient = NULL;
+        switch (request->type) {
+            case ENGINE_ATTEND: patient = system.attendNextPatient(); break;
+            case ENGINE_FREE: patient = system.freeConsultationRoom(); break;
+            case ENGINE_COMPLETE: patient = system.completeConsultation(request->patientId); break;
+            case ENGINE_SEARCH: patient = system.searchPatient(request->patientId); break;
+            default: break;
+        }
+        request->result.set_value(PatientSnapshot(patient));
+    } catch (...) {
+        request->result.set_exception(current_exception());
+    }
+}
+
+/**
+ * SENDING SIDE OF A TRANSFER (this engine's owner thread)
+ * - The batch is capped by the channel's free slots, which only grow until
+ *   this thread pushes, so the whole batch fits in one pushBatch()
+ * - Levels the destination does not have are never taken out of triage
+ *   (its configuration is fixed at construction, so reading it is safe)
+ * - The client's promise travels to the destination inside a new admission
+ *   command, queued after the records are published in the channel
+ */
+void HospitalEngine::sendTransfer(TransferCommand* request) {
+    TransferChannel* channel = request->channel;
+    TransferCommand* handoff = NULL;
+    try {
+        handoff = new TransferCommand(ENGINE_TRANSFER_IN, request->destination, channel);
+        handoff->source = this;
+        size_t room = channel->queue.freeSlots();
+        int limit = request->maxPatients < (int)room ? request->maxPatients : (int)room;
+        int levels = request->destination->system.configuration().triageLevels;
+        int maxPriority = request->maxPriority < levels ? request->maxPriority : levels;
+        transferBuffer.resize(limit > 0 ? (size_t)limit : 0);
+        handoff->transfer.sourceIds.reserve(transferBuffer.size());
+        vector<Patient*> batch = system.transferOut(limit, request->minPriority, maxPriority);
+        for (size_t i = 0; i < batch.size(); i++) {
+            transferBuffer[i].patient = *batch[i];
+            transferBuffer[i].specialty = system.specialtyName(batch[i]->specialty);
+            handoff->transfer.sourceIds.push_back(batch[i]->id);
+        }
+        channel->queue.pushBatch(transferBuffer.data(), batch.size());
+    } catch (...) {
+        delete handoff;
+        request->result.set_exception(current_exception());
+        channel->inFlight.fetch_sub(1, memory_order_release);
+        return;
+    }
+
+    handoff->result = move(request->result);
+    if (handoff->transfer.sourceIds.empty()) {
+        handoff->result.set_value(TransferResult());  // Nothing eligible: no need to involve the destination
+        delete handoff;
+        channel->inFlight.fetch_sub(1, memory_order_release);
+        return;
+    }
+    try {
+        request->destination->submit(handoff);
+    } catch (...) {
+        channel->inFlight.fetch_sub(1, memory_order_release);  // Destination shut down: the batch is lost
+    }
+}
+
+/**
+ * RECEIVING SIDE OF A TRANSFER (this engine's owner thread)
+ * - Every record of the batch was published before this command was
+ *   queued, so the channel holds exactly the batch, in order; every record
+ *   is popped whatever happens to the others
+ * - Each record is admitted on its own: one that throws (invalid for this
+ *   site, out of memory) is listed in rejectedSourceIds and the outcome
+ *   goes back to the sender, which admits those patients again
+ */
+void HospitalEngine::receiveTransfer(TransferCommand* request) {
+    TransferChannel* channel = request->channel;
+    TransferResult& transfer = request->transfer;
+    size_t count = transfer.sourceIds.size();
+    TransferRecord record;
+    try {
+        transfer.destinationIds.reserve(count);
+        transfer.rejectedSourceIds.reserve(count);
+    } catch (...) {
+        for (size_t i = 0; i < count; i++) {
+            channel->queue.popBatch(&record, 1);  // No room to list outcomes: the whole batch goes back
+        }
+        transfer.rejectedSourceIds.swap(transfer.sourceIds);
+        count = 0;
+    }
+    size_t admitted = 0;
+    for (size_t i = 0; i < count; i++) {
+        channel->queue.popBatch(&record, 1);
+        try {
+            transfer.destinationIds.push_back(system.admitTransferredPatient(record.patient, record.specialty));
+            transfer.sourceIds[admitted++] = transfer.sourceIds[i];
+        } catch (...) {
+            transfer.rejectedSourceIds.push_back(transfer.sourceIds[i]);
+        }
+    }
+    transfer.sourceIds.resize(admitted);
+
+    if (transfer.rejectedSourceIds.empty()) {
+        request->result.set_value(move(transfer));
+        channel->inFlight.fetch_sub(1, memory_order_release);
+        return;
+    }
+    TransferCommand* back = NULL;
+    try {
+        back = new TransferCommand(ENGINE_TRANSFER_RETURN, request->source, channel);
+    } catch (...) {
+        request->result.set_value(move(transfer));  // returnedIds stays empty: the patients are not taken back
+        channel->inFlight.fetch_sub(1, memory_order_release);
+        return;
+    }
+    back->transfer = move(transfer);
+    back->result = move(request->result);
+    try {
+        request->source->submit(back);
+    } catch (...) {
+        channel->inFlight.fetch_sub(1, memory_order_release);  // Sender shut down: the refused records are lost
+    }
+}
+
+/**
+ * REFUSED RECORDS BACK AT THE SENDING SIDE (this engine's owner thread)
+ * - Each refused patient is admitted again here; returnedIds[i] is 0 for
+ *   one that fails as well, so the future always completes
+ */
+void HospitalEngine::returnTransfer(TransferCommand* request) {
+    TransferResult& transfer = request->transfer;
+    try {
+        transfer.returnedIds.assign(transfer.rejectedSourceIds.size(), 0);
+        for (size_t i = 0; i < transfer.rejectedSourceIds.size(); i++) {
+            try {
+                transfer.returnedIds[i] = system.readmitTransferredPatient(transfer.rejectedSourceIds[i]);
+            } catch (...) {
+                // Listed with ID 0
+            }
+        }
+    } catch (...) {
+        // returnedIds could not be sized: left empty
+    }
+    request->result.set_value(move(transfer));
+    request->channel->inFlight.fetch_sub(1, memory_order_release);
+}
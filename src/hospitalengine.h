@@ -0,0 +1,302 @@
+#ifndef HOSPITALENGINE_H
+#define HOSPITALENGINE_H
+
+#include "hospitalsystem.h"
+#include "mpscqueue.h"
+#include "patient.h"
+#include "spscqueue.h"
+#include <atomic>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * PATIENT SNAPSHOT - Copy of a patient handed across threads
+ * - Clients never see the engine's Patient pointers, so the owner thread
+ *   stays the only one touching live state
+ */
+struct PatientSnapshot {
+    bool found;       ///< false when the operation had no patient to return
+    Patient patient;  ///< Copy taken by the owner thread (valid if found)
+
+    PatientSnapshot() : found(false), patient(0, "", 0, 0, "") {}
+    explicit PatientSnapshot(const Patient* p)
+        : found(p != NULL), patient(p != NULL ? *p : Patient(0, "", 0, 0, "")) {}
+};
+
+/**
+ * WAITING PATIENT SNAPSHOT - Copy of a triage patient and its wait so far
+ */
+struct WaitingSnapshot {
+    Patient patient;
+    long long waitNanos;
+
+    explicit WaitingSnapshot(const WaitingPatient& waiting)
+        : patient(*waiting.patient), waitNanos(waiting.waitNanos) {}
+};
+
+/**
+ * COMMAND KINDS APPLIED BY THE OWNER THREAD
+ */
+enum EngineCommandType {
+    ENGINE_REGISTER,
+    ENGINE_ATTEND,
+    ENGINE_FREE,
+    ENGINE_COMPLETE,
+    ENGINE_SEARCH,
+    ENGINE_LONGEST_WAITING,
+    ENGINE_TRANSFER_OUT,
+    ENGINE_TRANSFER_IN,
+    ENGINE_TRANSFER_RETURN,
+    ENGINE_STOP
+};
+
+/**
+ * PATIENT RECORD IN A TRANSFER CHANNEL SLOT
+ */
+struct TransferRecord {
+    Patient patient;        ///< Copy of the sending site's record
+    std::string specialty;  ///< Sending site's name of patient.specialty (pool order differs between sites)
+
+    TransferRecord() : patient(0, "", 0, 0, "") {}
+};
+
+/**
+ * HANDOFF CHANNEL FROM ONE ENGINE TO ANOTHER
+ * - The sending engine's owner is the only producer and the receiving
+ *   engine's owner the only consumer, so one channel must carry transfers
+ *   in a single direction between a single pair of engines
+ * - inFlight counts transfers submitted but not yet admitted (or
+ *   abandoned); wait for zero before shutting either engine down
+ */
+struct TransferChannel {
+    SpscQueue<TransferRecord> queue;
+    std::atomic<int> inFlight;
+
+    explicit TransferChannel(size_t capacity = 512) : queue(capacity), inFlight(0) {}
+};
+
+/**
+ * OUTCOME OF ONE BATCH TRANSFER
+ * - sourceIds[i] (sending site) was admitted as destinationIds[i]
+ *   (receiving site); patients are listed level by level, oldest first
+ * - rejectedSourceIds: records the receiving site could not admit; the
+ *   sending site admitted each again as returnedIds[i] (its original
+ *   record stays marked as transferred), 0 when that failed as well;
+ *   returnedIds is left empty if the outcome could not be sent back
+ */
+struct TransferResult {
+    std::vector<int> sourceIds;
+    std::vector<int> destinationIds;
+    std::vector<int> rejectedSourceIds;
+    std::vector<int> returnedIds;
+
+    int count() const { return (int)destinationIds.size(); }
+};
+
+/**
+ * COMMAND MESSAGE - Linked into the MPSC queue, owned by the engine once
+ * submitted; subclasses carry the promise matching the result type
+ */
+struct EngineCommand : MpscNode {
+    EngineCommandType type;
+
+    explicit EngineCommand(EngineCommandType t) : type(t) {}
+    virtual ~EngineCommand() {}
+};
+
+struct RegisterCommand : EngineCommand {
+    std::string name;
+    int age;
+    int priority;
+    std::string symptom;
+    std::promise<int> result;
+
+    RegisterCommand(const std::string& n, int a, int p, const std::string& s)
+        : EngineCommand(ENGINE_REGISTER), name(n), age(a), priority(p), symptom(s) {}
+};
+
+struct PatientCommand : EngineCommand {
+    int patientId;  ///< ENGINE_SEARCH: patient ID; ENGINE_COMPLETE: room (0-based)
+    std::promise<PatientSnapshot> result;
+
+    PatientCommand(EngineCommandType t, int id = 0) : EngineCommand(t), patientId(id) {}
+};
+
+struct WaitingCommand : EngineCommand {
+    int count;
+    std::promise<std::vector<WaitingSnapshot> > result;
+
+    explicit WaitingCommand(int k) : EngineCommand(ENGINE_LONGEST_WAITING), count(k) {}
+};
+
+class HospitalEngine;
+
+struct TransferCommand : EngineCommand {
+    HospitalEngine* source;  ///< Sending engine (set on the admission command)
+    HospitalEngine* destination;
+    TransferChannel* channel;
+    int maxPatients;
+    int minPriority;
+    int maxPriority;
+    TransferResult transfer;  ///< sourceIds filled by the sender, destinationIds by the receiver,
+                              ///< returnedIds by the sender again
+    std::promise<TransferResult> result;
+
+    TransferCommand(EngineCommandType t, HospitalEngine* to, TransferChannel* through, int k = 0, int minP = 4,
+                    int maxP = 5)
+        : EngineCommand(t), source(NULL), destination(to), channel(through), maxPatients(k), minPriority(minP), maxPriority(maxP) {}
+};
+
+/**
+ * STATUS PUBLISHED BY THE OWNER THREAD AFTER EVERY COMMAND
+ * - Single writer, any number of lock-free readers (relaxed atomics): a
+ *   reader never sees a torn value, but fields may come from different
+ *   commands. Own cache line, so readers do not slow the owner's queue
+ */
+struct alignas(64) EngineCounters {
+    std::atomic<int> registered;
+    std::atomic<int> waiting;
+    std::atomic<int> inConsultation;
+    std::atomic<int> rooms;
+    std::atomic<int> completed;
+    std::atomic<int> overdue;
+    std::atomic<long long> registrations;  ///< Registration commands applied, failed ones included
+
+    EngineCounters()
+        : registered(0), waiting(0), inConsultation(0), rooms(0), completed(0), overdue(0), registrations(0) {}
+};
+
+/**
+ * HOSPITAL ENGINE - ACTOR MODEL FRONT END FOR HospitalSystem
+ *
+ * THREADING MODEL:
+ * - One owner thread holds a silent HospitalSystem and is the only thread
+ *   that ever touches it, so every mutation runs without locks
+ * - Any number of client threads (registration desks, room terminals)
+ *   submit commands through a lock-free MPSC queue and receive futures
+ * - Commands from one client are applied in submission order
+ *
+ * IDLE BEHAVIOUR: The owner spins briefly on an empty queue, then sleeps on
+ * a condition variable; producers only take the mutex to wake it when the
+ * owner has announced that it is going to sleep. While rooms are occupied
+ * the sleep ends at the next expected consultation end, so overdue rooms
+ * are flagged (or released, config overdue = release) on time even when
+ * no command arrives.
+ *
+ * PINNING: With cpu >= 0 the owner thread binds itself to that core
+ * (modulo the hardware threads; Linux only, best effort) so each engine
+ * keeps its containers in one core's caches.
+ *
+ * TRANSFERS: transferTo() moves a batch of waiting patients to another
+ * engine without a client round trip per patient: the sender's owner
+ * removes the batch from its triage, copies it into the SPSC channel with
+ * one publish and queues a single admission command on the receiver,
+ * whose owner drains the channel in one pass. The future completes once
+ * the receiver has admitted the batch. Only levels the receiver has are
+ * taken; a record it still refuses (or cannot store) goes back to the
+ * sender, which admits it again before completing the future.
+ *
+ * ERRORS: Exceptions thrown by HospitalSystem (e.g. invalid registration
+ * data) are delivered through the future. Submitting after shutdown()
+ * throws std::runtime_error.
+ *
+ * USAGE:
+ *   HospitalEngine engine(10);
+ *   std::future<int> id = engine.registerPatient("Ana", 30, 2, "Fever");
+ *   PatientSnapshot attended = engine.attendNextPatient().get();
+ */
+class HospitalEngine {
+private:
+    HospitalSystem system;                 ///< Owned exclusively by the owner thread
+    MpscQueue<EngineCommand> commands;     ///< Pending commands from all clients
+    std::atomic<bool> ownerSleeping;       ///< Owner is (about to be) blocked on wakeUp
+    std::atomic<bool> accepting;           ///< false once shutdown() starts
+    std::atomic<long long> processed;      ///< Commands applied so far
+    std::atomic<bool> pinned;              ///< Owner thread bound to its core
+    int cpu;                               ///< Requested core, -1 for none
+    EngineCounters published;
+    std::vector<TransferRecord> transferBuffer;  ///< Owner-only scratch for channel batches
+    std::mutex sleepMutex;
+    std::condition_variable wakeUp;
+    std::thread owner;
+
+    static const int SPIN_ROUNDS = 64;     ///< Empty polls before the owner sleeps
+
+    void submit(EngineCommand* command);
+    void ownerLoop();
+    void apply(EngineCommand* command);
+    void sendTransfer(TransferCommand* request);
+    void receiveTransfer(TransferCommand* request);
+    void returnTransfer(TransferCommand* request);
+    void publishStatus();
+
+public:
+    explicit HospitalEngine(int numRooms = 10, int cpu = -1);
+    explicit HospitalEngine(const HospitalConfig& config, int cpu = -1);
+
+    /**
+     * DESTRUCTOR - Drains outstanding commands and joins the owner thread
+     */
+    ~HospitalEngine();
+
+    std::future<int> registerPatient(const std::string& name, int age, int priority, const std::string& symptom);
+    std::future<PatientSnapshot> attendNextPatient();
+    std::future<PatientSnapshot> freeConsultationRoom();
+
+    /**
+     * THE CONSULTATION IN room (0-based) HAS ENDED
+     * @return The completed patient; not found when the room was free
+     *         (out_of_range through the future for a bad room number)
+     */
+    std::future<PatientSnapshot> completeConsultation(int room);
+    std::future<PatientSnapshot> searchPatient(int patientId);
+
+    /**
+     * UP TO k LONGEST-WAITING TRIAGE PATIENTS (oldest first) WITH WAIT TIMES
+     */
+    std::future<std::vector<WaitingSnapshot> > longestWaiting(int k = 20);
+
+    /**
+     * MOVE UP TO maxPatients WAITING PATIENTS TO ANOTHER ENGINE
+     * @param destination: Receiving engine (must not be this one)
+     * @param channel: Used only for transfers from this engine to destination
+     * @param minPriority, maxPriority: Eligible triage levels (default IV-V)
+     * @return Source and new IDs once the destination has admitted them;
+     *         fewer than maxPatients when triage or the channel runs short
+     *         (maxPriority is capped at the destination's triage levels);
+     *         refused records are listed with the IDs they got back here
+     * NOTE: If the destination (or, with refused records, this engine) is
+     *       shut down meanwhile, the future reports broken_promise and the
+     *       batch is lost
+     */
+    std::future<TransferResult> transferTo(HospitalEngine& destination, TransferChannel& channel, int maxPatients,
+                                           int minPriority = 4, int maxPriority = 5);
+
+    /**
+     * STOP ACCEPTING COMMANDS, APPLY EVERYTHING ALREADY QUEUED, JOIN
+     * - Idempotent; must not race with clients still submitting
+     */
+    void shutdown();
+
+    long long processedCommands() const { return processed.load(std::memory_order_relaxed); }
+
+    /**
+     * LATEST STATUS PUBLISHED BY THE OWNER (lock-free, any thread)
+     */
+    SystemStatus publishedStatus() const;
+    long long registrationsApplied() const { return published.registrations.load(std::memory_order_relaxed); }
+
+    /**
+     * OWNER THREAD BOUND TO THE REQUESTED CORE (false until it has started)
+     */
+    bool isPinned() const { return pinned.load(std::memory_order_relaxed); }
+
+    HospitalEngine(const HospitalEngine&) = delete;
+    HospitalEngine& operator=(const HospitalEngine&) = delete;
+};
+
+#endif
@@ -0,0 +1,193 @@
+#include "hospitalnetwork.h"
+#include <stdexcept>
+#include <thread>
+
+using namespace std;
+
+/**
+ * LOAD ORDER - a strictly less loaded than b, per room:
+ * (waiting + pending) / rooms compared by cross-multiplication
+ */
+static bool lessLoaded(const ShardLoad& a, const ShardLoad& b) {
+    return (a.waiting + a.pending) * (long long)b.rooms < (b.waiting + b.pending) * (long long)a.rooms;
+}
+
+int LeastLoadedPolicy::route(const RoutingRequest& request, const HospitalNetwork& network) {
+    (void)request;
+    int best = 0;
+    ShardLoad bestLoad = network.load(0);
+    for (int s = 1; s < network.shardCount(); s++) {
+        ShardLoad candidate = network.load(s);
+        if (lessLoaded(candidate, bestLoad)) {
+            best = s;
+            bestLoad = candidate;
+        }
+    }
+    return best;
+}
+
+int NearestPolicy::route(const RoutingRequest& request, const HospitalNetwork& network) {
+    int best = -1;
+    double bestDistance = 0.0;
+    ShardLoad bestLoad = ShardLoad();
+    for (int s = 0; s < network.shardCount(); s++) {
+        double dx = network.site(s).x - request.x;
+        double dy = network.site(s).y - request.y;
+        double distance = dx * dx + dy * dy;
+        if (best != -1 && distance > bestDistance) {
+            continue;
+        }
+        ShardLoad candidate = network.load(s);
+        if (best == -1 || distance < bestDistance || lessLoaded(candidate, bestLoad)) {
+            best = s;
+            bestDistance = distance;
+            bestLoad = candidate;
+        }
+    }
+    return best;
+}
+
+int RoundRobinPolicy::route(const RoutingRequest& request, const HospitalNetwork& network) {
+    (void)request;
+    return (int)(next.fetch_add(1, memory_order_relaxed) % (unsigned)network.shardCount());
+}
+
+HospitalNetwork::HospitalNetwork(const vector<SiteConfig>& siteList, RoutingPolicy* routingPolicy, bool pinShards)
+    : sites(siteList), routed(NULL), policy(routingPolicy) {
+    if (siteList.empty()) {
+        delete routingPolicy;
+        throw invalid_argument("A hospital network needs at least one site");
+    }
+    if (routingPolicy == NULL) {
+        throw invalid_argument("A hospital network needs a routing policy");
+    }
+    try {
+        routed = new RoutedCounter[siteList.size()];
+        for (size_t s = 0; s < siteList.size(); s++) {
+            routed[s].value.store(0, memory_order_relaxed);
+            shards.push_back(NULL);
+            shards[s] = new HospitalEngine(siteList[s].hospital, pinShards ? (int)s : -1);
+        }
+        channels.assign(siteList.size() * siteList.size(), NULL);
+        for (size_t from = 0; from < siteList.size(); from++) {
+            for (size_t to = 0; to < siteList.size(); to++) {
+                if (from != to) {
+                    channels[from * siteList.size() + to] = new TransferChannel(TRANSFER_CAPACITY);
+                }
+            }
+        }
+    } catch (...) {
+        for (size_t s = 0; s < shards.size(); s++) {
+            delete shards[s];
+        }
+        for (size_t c = 0; c < channels.size(); c++) {
+            delete channels[c];
+        }
+        delete[] routed;
+        delete routingPolicy;
+        throw;
+    }
+}
+
+HospitalNetwork::~HospitalNetwork() {
+    shutdown();
+    for (size_t s = 0; s < shards.size(); s++) {
+        delete shards[s];
+    }
+    for (size_t c = 0; c < channels.size(); c++) {
+        delete channels[c];
+    }
+    delete[] routed;
+    delete policy;
+}
+
+void HospitalNetwork::shutdown() {
+    // A batch in flight needs both of its shards running
+    for (size_t c = 0; c < channels.size(); c++) {
+        while (channels[c] != NULL && channels[c]->inFlight.load(memory_order_acquire) > 0) {
+            this_thread::yield();
+        }
+    }
+    for (size_t s = 0; s < shards.size(); s++) {
+        shards[s]->shutdown();
+    }
+}
+
+HospitalEngine& HospitalNetwork::engine(int shard) {
+    if (shard < 0 || shard >= (int)shards.size()) {
+        throw out_of_range("Unknown hospital shard");
+    }
+    return *shards[(size_t)shard];
+}
+
+NetworkTicket HospitalNetwork::registerPatient(const string& name, int age, int priority, const string& symptom,
+                                               double x, double y) {
+    RoutingRequest request;
+    request.age = age;
+    request.priority = priority;
+    request.x = x;
+    request.y = y;
+
+    NetworkTicket ticket;
+    ticket.shard = policy->route(request, *this);
+    HospitalEngine& target = engine(ticket.shard);
+    routed[ticket.shard].value.fetch_add(1, memory_order_relaxed);
+    try {
+        ticket.patientId = target.registerPatient(name, age, priority, symptom);
+    } catch (...) {
+        routed[ticket.shard].value.fetch_sub(1, memory_order_relaxed);
+        throw;
+    }
+    return ticket;
+}
+
+future<PatientSnapshot> HospitalNetwork::attendNextPatient(int shard) {
+    return engine(shard).attendNextPatient();
+}
+
+future<PatientSnapshot> HospitalNetwork::freeConsultationRoom(int shard) {
+    return engine(shard).freeConsultationRoom();
+}
+
+future<PatientSnapshot> HospitalNetwork::searchPatient(int shard, int patientId) {
+    return engine(shard).searchPatient(patientId);
+}
+
+future<TransferResult> HospitalNetwork::transferPatients(int from, int to, int maxPatients, int minPriority,
+                                                         int maxPriority) {
+    HospitalEngine& sender = engine(from);
+    HospitalEngine& receiver = engine(to);
+    if (from == to) {
+        throw invalid_argument("Cannot transfer patients within the same site");
+    }
+    TransferChannel& channel = *channels[(size_t)from * shards.size() + (size_t)to];
+    return sender.transferTo(receiver, channel, maxPatients, minPriority, maxPriority);
+}
+
+ShardLoad HospitalNetwork::load(int shard) const {
+    const HospitalEngine& target = *shards[(size_t)shard];
+    SystemStatus current = target.publishedStatus();
+    ShardLoad result;
+    result.waiting = current.waiting;
+    result.inConsultation = current.inConsultation;
+    result.rooms = current.rooms;
+    result.pending = routed[shard].value.load(memory_order_relaxed) - target.registrationsApplied();
+    if (result.pending < 0) {
+        result.pending = 0;  // Counters read at slightly different moments
+    }
+    return result;
+}
+
+SystemStatus HospitalNetwork::aggregateStatus() const {
+    SystemStatus total = SystemStatus();
+    for (size_t s = 0; s < shards.size(); s++) {
+        SystemStatus current = shards[s]->publishedStatus();
+        total.registered += current.registered;
+        total.waiting += current.waiting;
+        total.inConsultation += current.inConsultation;
+        total.rooms += current.rooms;
+        total.completed += current.completed;
+        total.overdue += current.overdue;
+    }
+    return total;
+}
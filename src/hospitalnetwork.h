@@ -0,0 +1,220 @@
+#ifndef HOSPITALNETWORK_H
+#define HOSPITALNETWORK_H
+
+#include "hospitalengine.h"
+#include <atomic>
+#include <future>
+#include <string>
+#include <vector>
+
+/**
+ * ONE EMERGENCY DEPARTMENT OF THE NETWORK
+ * - hospital: the site's own topology (specialties, triage levels,
+ *   consultation times, pre-sizing), e.g. HospitalConfig::load(path);
+ *   a room count alone gives the single "general" specialty defaults
+ */
+struct SiteConfig {
+    std::string name;
+    HospitalConfig hospital;
+    int rooms;   ///< Consultation rooms of the site (all specialties)
+    double x;    ///< Site location (any planar unit, used by NearestPolicy)
+    double y;
+
+    SiteConfig(const std::string& _name, int _rooms, double _x = 0.0, double _y = 0.0)
+        : name(_name), hospital(HospitalConfig::withRooms(_rooms)), rooms(_rooms), x(_x), y(_y) {}
+    SiteConfig(const std::string& _name, const HospitalConfig& _hospital, double _x = 0.0, double _y = 0.0)
+        : name(_name), hospital(_hospital), rooms(_hospital.totalRooms()), x(_x), y(_y) {}
+};
+
+/**
+ * WHAT A ROUTING POLICY KNOWS ABOUT AN ARRIVING PATIENT
+ */
+struct RoutingRequest {
+    int age;
+    int priority;
+    double x;  ///< Where the patient is (same unit as SiteConfig)
+    double y;
+};
+
+/**
+ * LOAD OF ONE SHARD - Lock-free read of its published counters
+ */
+struct ShardLoad {
+    int waiting;         ///< Patients in triage (published by the shard)
+    int inConsultation;
+    int rooms;
+    long long pending;   ///< Registrations routed but not yet applied
+};
+
+class HospitalNetwork;
+
+/**
+ * ROUTING POLICY - Chooses the shard of every registration
+ * - route() is called concurrently from every client thread and must be
+ *   thread-safe; it reads loads through HospitalNetwork::load()
+ */
+class RoutingPolicy {
+public:
+    virtual ~RoutingPolicy() {}
+    virtual const char* name() const = 0;
+    virtual int route(const RoutingRequest& request, const HospitalNetwork& network) = 0;
+};
+
+/**
+ * LEAST-LOADED TRIAGE - Fewest waiting (plus in-flight) patients per room
+ */
+class LeastLoadedPolicy : public RoutingPolicy {
+public:
+    const char* name() const { return "least-loaded"; }
+    int route(const RoutingRequest& request, const HospitalNetwork& network);
+};
+
+/**
+ * NEAREST SITE - Shortest distance to the patient; ties go to the less
+ * loaded site
+ */
+class NearestPolicy : public RoutingPolicy {
+public:
+    const char* name() const { return "nearest"; }
+    int route(const RoutingRequest& request, const HospitalNetwork& network);
+};
+
+/**
+ * ROUND ROBIN - Ignores load and location (baseline)
+ */
+class RoundRobinPolicy : public RoutingPolicy {
+private:
+    std::atomic<unsigned> next;
+
+public:
+    RoundRobinPolicy() : next(0) {}
+    const char* name() const { return "round-robin"; }
+    int route(const RoutingRequest& request, const HospitalNetwork& network);
+};
+
+/**
+ * REGISTRATION RESULT - Shard chosen by the policy and the future patient ID
+ * (IDs are per shard: the pair (shard, patientId) identifies a patient)
+ */
+struct NetworkTicket {
+    int shard;
+    std::future<int> patientId;
+};
+
+/**
+ * HOSPITAL NETWORK - N HOSPITAL SHARDS BEHIND ONE ROUTING FRONT END
+ *
+ * SHARDING:
+ * - Every site is a HospitalEngine: its own HospitalSystem and containers,
+ *   mutated only by its owner thread, which is pinned to core
+ *   (shard index mod hardware threads). Shards share no mutable state
+ * - Registrations are routed by the pluggable RoutingPolicy; attend, free
+ *   and search address a shard explicitly (the site's own terminals)
+ *
+ * TRANSFERS:
+ * - transferPatients() moves a batch of waiting patients (TRIAGE IV-V by
+ *   default) from a saturated site to a sister site. Every ordered pair of
+ *   shards has its own SPSC channel, written only by the sender's owner
+ *   thread and read only by the receiver's, so the handoff takes no lock
+ * - Arrival order within each level is kept; the receiver assigns new IDs
+ *
+ * AGGREGATES (lock-free):
+ * - Each shard publishes its counters in atomics after every command;
+ *   load() and aggregateStatus() only read those, so status queries
+ *   never enter a shard's queue. Totals are a sum of per-shard values,
+ *   each exact for some recent moment (not one global snapshot)
+ * - Routed-registration counters (one cache line per shard) let policies
+ *   count patients that are still in a shard's queue
+ *
+ * USAGE:
+ *   std::vector<SiteConfig> sites;
+ *   sites.push_back(SiteConfig("Norte", 10, 0, 5));
+ *   sites.push_back(SiteConfig("Sur", 8, 0, -5));
+ *   sites.push_back(SiteConfig("Centro", HospitalConfig::load("centro.conf"), 0, 0));
+ *   HospitalNetwork network(sites, new LeastLoadedPolicy());
+ *   NetworkTicket ticket = network.registerPatient("Ana", 30, 2, "Fever");
+ *   network.attendNextPatient(ticket.shard).get();
+ */
+class HospitalNetwork {
+private:
+    /**
+     * ROUTED REGISTRATIONS OF ONE SHARD - Own cache line (written by clients)
+     */
+    struct alignas(64) RoutedCounter {
+        std::atomic<long long> value;
+    };
+
+    std::vector<SiteConfig> sites;
+    std::vector<HospitalEngine*> shards;
+    std::vector<TransferChannel*> channels;  ///< from * shards + to (NULL on the diagonal)
+    RoutedCounter* routed;
+    RoutingPolicy* policy;
+
+public:
+    /**
+     * START ONE ENGINE PER SITE
+     * @param siteList: Sites in shard order (at least one)
+     * @param routingPolicy: Owned by the network (deleted with it)
+     * @param pinShards: Pin shard i's owner thread to core i mod cores
+     * EXCEPTION: Throws invalid_argument for an empty site list or a NULL policy
+     */
+    HospitalNetwork(const std::vector<SiteConfig>& siteList, RoutingPolicy* routingPolicy, bool pinShards = true);
+
+    /**
+     * DESTRUCTOR - Drains and stops every shard (see shutdown())
+     */
+    ~HospitalNetwork();
+
+    /**
+     * ROUTE A REGISTRATION TO A SHARD CHOSEN BY THE POLICY
+     * @param x, y: Patient location (only NearestPolicy uses it)
+     */
+    NetworkTicket registerPatient(const std::string& name, int age, int priority, const std::string& symptom,
+                                  double x = 0.0, double y = 0.0);
+
+    /**
+     * SHARD-ADDRESSED OPERATIONS
+     * EXCEPTION: Throws out_of_range for an unknown shard
+     */
+    std::future<PatientSnapshot> attendNextPatient(int shard);
+    std::future<PatientSnapshot> freeConsultationRoom(int shard);
+    std::future<PatientSnapshot> searchPatient(int shard, int patientId);
+
+    /**
+     * MOVE UP TO maxPatients WAITING PATIENTS FROM ONE SHARD TO ANOTHER
+     * @param minPriority, maxPriority: Eligible levels, least urgent taken first
+     * @return Source and destination IDs once the batch is admitted (at most
+     *         TRANSFER_CAPACITY patients per batch)
+     * EXCEPTION: Throws out_of_range for an unknown shard, invalid_argument
+     *            when from == to
+     */
+    std::future<TransferResult> transferPatients(int from, int to, int maxPatients, int minPriority = 4,
+                                                 int maxPriority = 5);
+
+    static const int TRANSFER_CAPACITY = 512;  ///< Slots of each shard-to-shard channel
+
+    /**
+     * LOCK-FREE STATUS
+     * - load(shard): what routing policies see
+     * - aggregateStatus(): sum of every shard's published counters
+     */
+    ShardLoad load(int shard) const;
+    SystemStatus aggregateStatus() const;
+
+    int shardCount() const { return (int)shards.size(); }
+    const SiteConfig& site(int shard) const { return sites[(size_t)shard]; }
+    HospitalEngine& engine(int shard);
+    const char* policyName() const { return policy->name(); }
+
+    /**
+     * STOP EVERY SHARD (applies everything already queued)
+     * - Waits for in-flight transfers first, so no batch is left between
+     *   a stopped sender and a stopped receiver
+     */
+    void shutdown();
+
+    HospitalNetwork(const HospitalNetwork&) = delete;
+    HospitalNetwork& operator=(const HospitalNetwork&) = delete;
+};
+
+#endif
@@ -0,0 +1,473 @@
+#include "hospitalserver.h"
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#ifdef __linux__
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+void ServerConfig::parseArguments(int argc, char* argv[]) {
+    string metricsListen;
+    bool metricsGiven = false;
+    for (int i = 0; i < argc; i++) {
+        string option = argv[i];
+        if (i + 1 >= argc) {
+            throw invalid_argument("Missing value for option " + option);
+        }
+        string value = argv[++i];
+        if (option == "--listen") {
+            endpoint = value;
+        } else if (option == "--rooms") {
+            hospital = HospitalConfig::withRooms(atoi(value.c_str()));
+        } else if (option == "--config") {
+            hospital = HospitalConfig::load(value);
+        } else if (option == "--metrics") {
+            metricsListen = value;
+            metricsGiven = true;
+        } else {
+            throw invalid_argument("Unknown server option: " + option);
+        }
+    }
+    if (metricsGiven) {
+        hospital.metricsListen = metricsListen;
+    }
+    hospital.validate();
+}
+
+#ifdef __linux__
+
+/**
+ * SYSTEM CALL FAILURE AS AN EXCEPTION
+ */
+static runtime_error socketError(const string& what) {
+    return runtime_error(what + ": " + strerror(errno));
+}
+
+/**
+ * STEADY-CLOCK NANOSECONDS - the clock the room timers run on
+ */
+static long long steadyNow() {
+    return (long long)chrono::duration_cast<chrono::nanoseconds>(
+        chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void setNonBlocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    if (flags < 0 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0) {
+        throw socketError("fcntl(O_NONBLOCK)");
+    }
+}
+
+HospitalServer::HospitalServer(const ServerConfig& serverConfig)
+    : config(serverConfig), endpoint(protocol::Endpoint::parse(serverConfig.endpoint)),
+      system(serverConfig.hospital, false), listenFd(-1), epollFd(-1), wakeFd(-1), requestsServed(0),
+      metrics(registry, serverConfig.hospital), metricsServer(NULL) {
+    wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (wakeFd < 0 || epollFd < 0) {
+        throw socketError("eventfd/epoll_create1");
+    }
+    epoll_event event;
+    event.events = EPOLLIN;
+    event.data.fd = wakeFd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &event);
+
+    if (!config.hospital.metricsListen.empty()) {
+        metricsServer = new MetricsServer(registry, config.hospital.metricsListen);
+        system.attachMetrics(&metrics);
+    }
+}
+
+HospitalServer::~HospitalServer() {
+    delete metricsServer;  // Joins the scrape thread before the metrics go away
+    for (unordered_map<int, Connection*>::iterator it = connections.begin(); it != connections.end(); ++it) {
+        close(it->first);
+        delete it->second;
+    }
+    if (listenFd >= 0) {
+        close(listenFd);
+        if (endpoint.unixSocket) {
+            unlink(endpoint.path.c_str());
+        }
+    }
+    if (epollFd >= 0) close(epollFd);
+    if (wakeFd >= 0) close(wakeFd);
+}
+
+void HospitalServer::stop() {
+    uint64_t one = 1;
+    ssize_t written = write(wakeFd, &one, sizeof(one));
+    (void)written;
+}
+
+/**
+ * BIND AND LISTEN ON THE CONFIGURED ENDPOINT
+ */
+void HospitalServer::openListener() {
+    if (endpoint.unixSocket) {
+        sockaddr_un address;
+        memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        if (endpoint.path.size() >= sizeof(address.sun_path)) {
+            throw invalid_argument("Unix socket path too long: " + endpoint.path);
+        }
+        strcpy(address.sun_path, endpoint.path.c_str());
+        unlink(endpoint.path.c_str());  // Stale socket from a previous run
+        listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (listenFd < 0 || ::bind(listenFd, (sockaddr*)&address, sizeof(address)) < 0) {
+            throw socketError("bind " + endpoint.describe());
+        }
+    } else {
+        sockaddr_in address;
+        memset(&address, 0, sizeof(address));
+        address.sin_family = AF_INET;
+        address.sin_port = htons((uint16_t)endpoint.port);
+        if (inet_pton(AF_INET, endpoint.host.c_str(), &address.sin_addr) != 1) {
+            throw invalid_argument("Invalid IPv4 address: " + endpoint.host);
+        }
+        listenFd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        int reuse = 1;
+        if (listenFd < 0 || setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) < 0
+            || ::bind(listenFd, (sockaddr*)&address, sizeof(address)) < 0) {
+            throw socketError("bind " + endpoint.describe());
+        }
+    }
+    if (listen(listenFd, SOMAXCONN) < 0) {
+        throw socketError("listen");
+    }
+    setNonBlocking(listenFd);
+
+    epoll_event event;
+    event.events = EPOLLIN;
+    event.data.fd = listenFd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &event);
+}
+
+void HospitalServer::run() {
+    openListener();
+    if (metricsServer != NULL) {
+        metricsServer->start();
+    }
+    const int MAX_EVENTS = 256;
+    epoll_event events[MAX_EVENTS];
+
+    while (true) {
+        // Sleep no later than the next expected consultation end, so overdue
+        // rooms are flagged (or released) even when no client is talking
+        int timeout = -1;
+        long long deadline = system.nextRoomDeadline();
+        if (deadline >= 0) {
+            long long wait = deadline - steadyNow();
+            timeout = wait <= 0 ? 0 : (int)min(wait / 1000000 + 1, (long long)INT_MAX);
+        }
+        int ready = epoll_wait(epollFd, events, MAX_EVENTS, timeout);
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            throw socketError("epoll_wait");
+        }
+        if (ready == 0) {
+            system.processRoomTimers(steadyNow());
+            continue;
+        }
+        for (int i = 0; i < ready; i++) {
+            int fd = events[i].data.fd;
+            if (fd == wakeFd) {
+                return;
+            }
+            if (fd == listenFd) {
+                acceptConnections();
+                continue;
+            }
+            unordered_map<int, Connection*>::iterator it = connections.find(fd);
+            if (it == connections.end()) {
+                continue;  // Closed earlier in this batch
+            }
+            Connection* connection = it->second;
+            if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+                closeConnection(connection);
+                continue;
+            }
+            if ((events[i].events & EPOLLOUT) && !flush(connection)) {
+                continue;
+            }
+            if (events[i].events & EPOLLIN) {
+                handleReadable(connection);
+            } else {
+                updateInterest(connection);
+            }
+        }
+    }
+}
+
+void HospitalServer::acceptConnections() {
+    while (true) {
+        int fd = accept4(listenFd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) return;
+            if (errno == ECONNABORTED) continue;
+            cerr << "[ERROR!] accept: " << strerror(errno) << endl;
+            return;
+        }
+        if (!endpoint.unixSocket) {
+            int noDelay = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+        }
+        Connection* connection = new Connection(fd);
+        connections[fd] = connection;
+        epoll_event event;
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+    }
+}
+
+/**
+ * READ EVERYTHING AVAILABLE, APPLY COMPLETE FRAMES, FLUSH RESPONSES
+ */
+void HospitalServer::handleReadable(Connection* connection) {
+    char chunk[READ_CHUNK];
+    bool peerClosed = false;
+    while (true) {
+        ssize_t received = recv(connection->fd, chunk, sizeof(chunk), 0);
+        if (received > 0) {
+            connection->input.append(chunk, (size_t)received);
+            if (connection->input.size() > OUTPUT_LIMIT) break;  // Parse before buffering more
+            continue;
+        }
+        if (received == 0) {
+            peerClosed = true;
+        } else if (errno == EINTR) {
+            continue;
+        } else if (errno != EAGAIN && errno != EWOULDBLOCK) {
+            peerClosed = true;
+        }
+        break;
+    }
+
+    size_t consumed = 0;
+    try {
+        while (true) {
+            long long length = protocol::completeFrame(connection->input.data() + consumed,
+                                                       connection->input.size() - consumed);
+            if (length < 0) break;
+            protocol::Reader request(connection->input.data() + consumed + protocol::HEADER_BYTES, (size_t)length);
+            handleRequest(request, connection->output);
+            consumed += protocol::HEADER_BYTES + (size_t)length;
+            requestsServed++;
+        }
+    } catch (const exception& e) {
+        cerr << "[ERROR!] Closing connection: " << e.what() << endl;
+        closeConnection(connection);
+        return;
+    }
+    connection->input.erase(0, consumed);
+
+    if (!flush(connection)) {
+        return;
+    }
+    if (peerClosed) {
+        closeConnection(connection);
+        return;
+    }
+    updateInterest(connection);
+}
+
+/**
+ * WRITE PENDING OUTPUT UNTIL THE SOCKET WOULD BLOCK
+ * @return false if the connection was closed
+ */
+bool HospitalServer::flush(Connection* connection) {
+    while (connection->outputOffset < connection->output.size()) {
+        ssize_t sent = send(connection->fd, connection->output.data() + connection->outputOffset,
+                            connection->output.size() - connection->outputOffset, MSG_NOSIGNAL);
+        if (sent > 0) {
+            connection->outputOffset += (size_t)sent;
+        } else if (sent < 0 && errno == EINTR) {
+            continue;
+        } else if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        } else {
+            closeConnection(connection);
+            return false;
+        }
+    }
+    if (connection->outputOffset == connection->output.size()) {
+        connection->output.clear();
+        connection->outputOffset = 0;
+    }
+    return true;
+}
+
+/**
+ * ARM EPOLLOUT WHILE OUTPUT IS PENDING; STOP READING ABOVE OUTPUT_LIMIT
+ */
+void HospitalServer::updateInterest(Connection* connection) {
+    size_t pending = connection->output.size() - connection->outputOffset;
+    bool wantWrite = pending > 0;
+    bool wantRead = pending <= OUTPUT_LIMIT;
+    if (wantWrite == connection->writeArmed && wantRead) {
+        return;  // Common case: nothing changed
+    }
+    epoll_event event;
+    event.events = (wantRead ? EPOLLIN : 0) | (wantWrite ? EPOLLOUT : 0);
+    event.data.fd = connection->fd;
+    epoll_ctl(epollFd, EPOLL_CTL_MOD, connection->fd, &event);
+    connection->writeArmed = wantWrite;
+}
+
+void HospitalServer::closeConnection(Connection* connection) {
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, connection->fd, NULL);
+    close(connection->fd);
+    connections.erase(connection->fd);
+    delete connection;
+}
+
+static protocol::WirePatient toWire(const Patient* patient) {
+    protocol::WirePatient wire;
+    wire.id = (uint64_t)patient->id;
+    wire.age = patient->age;
+    wire.priority = patient->priority;
+    wire.name = patient->name;
+    wire.symptom = patient->symptom;
+    return wire;
+}
+
+/**
+ * DECODE ONE REQUEST, APPLY IT AND ENCODE THE RESPONSE
+ * - Validation errors from HospitalSystem become STATUS_ERROR responses;
+ *   only malformed frames propagate (and close the connection)
+ */
+void HospitalServer::handleRequest(protocol::Reader& request, string& response) {
+    int opcode = request.byte();
+    uint64_t tag = request.varint();
+
+    int status = protocol::STATUS_OK;
+    string error;
+    const Patient* patient = NULL;
+    int registeredId = 0;
+
+    switch (opcode) {
+        case protocol::OP_REGISTER: {
+            int priority = request.byte();
+            int age = request.byte();
+            string name = request.text();
+            string symptom = request.text();
+            try {
+                registeredId = system.registerPatient(name, age, priority, symptom);
+            } catch (const invalid_argument& e) {
+                status = protocol::STATUS_ERROR;
+                error = e.what();
+            }
+            break;
+        }
+        case protocol::OP_ATTEND:
+            patient = system.attendNextPatient();
+            break;
+        case protocol::OP_FREE:
+            patient = system.freeConsultationRoom();
+            break;
+        case protocol::OP_SEARCH:
+            patient = system.searchPatient((int)request.varint());
+            break;
+        case protocol::OP_STATUS:
+            break;
+        default:
+            status = protocol::STATUS_ERROR;
+            error = "Unknown opcode " + to_string(opcode);
+            break;
+    }
+    bool returnsPatient = opcode == protocol::OP_ATTEND || opcode == protocol::OP_FREE || opcode == protocol::OP_SEARCH;
+    if (returnsPatient && patient == NULL) {
+        status = protocol::STATUS_NOT_FOUND;
+    }
+
+    protocol::Writer writer(response);
+    writer.byte(opcode);
+    writer.byte(status);
+    writer.varint(tag);
+    if (status == protocol::STATUS_ERROR) {
+        writer.text(error);
+    } else if (status == protocol::STATUS_OK) {
+        if (opcode == protocol::OP_REGISTER) {
+            writer.varint((uint64_t)registeredId);
+        } else if (returnsPatient) {
+            writer.patient(toWire(patient));
+        } else if (opcode == protocol::OP_STATUS) {
+            SystemStatus current = system.status();
+            writer.varint((uint64_t)current.registered);
+            writer.varint((uint64_t)current.waiting);
+            writer.varint((uint64_t)current.inConsultation);
+            writer.varint((uint64_t)current.rooms);
+            writer.varint((uint64_t)current.completed);
+        }
+    }
+    writer.finish();
+}
+
+#else
+
+/**
+ * NON-LINUX BUILDS - epoll is unavailable; the server mode reports it
+ */
+HospitalServer::HospitalServer(const ServerConfig& serverConfig)
+    : config(serverConfig), endpoint(protocol::Endpoint::parse(serverConfig.endpoint)),
+      system(serverConfig.hospital, false), listenFd(-1), epollFd(-1), wakeFd(-1), requestsServed(0),
+      metrics(registry, serverConfig.hospital), metricsServer(NULL) {
+    throw runtime_error("Server mode requires Linux (epoll)");
+}
+
+HospitalServer::~HospitalServer() {}
+void HospitalServer::run() {}
+void HospitalServer::stop() {}
+
+#endif
+
+static HospitalServer* signalledServer = NULL;
+
+static void handleStopSignal(int) {
+    if (signalledServer != NULL) {
+        signalledServer->stop();
+    }
+}
+
+int HospitalServer::runFromCommandLine(int argc, char* argv[]) {
+    try {
+        ServerConfig config;
+        config.parseArguments(argc, argv);
+        HospitalServer server(config);
+
+        signalledServer = &server;
+        signal(SIGINT, handleStopSignal);
+        signal(SIGTERM, handleStopSignal);
+
+        cout << "[DONE] Hospital server listening on " << server.endpoint.describe()
+             << " (" << config.hospital.totalRooms() << " rooms). Ctrl+C to stop." << endl;
+        if (server.metricsEndpoint() != NULL) {
+            cout << "[DONE] Metrics at " << server.metricsEndpoint()->describe() << endl;
+        }
+        server.run();
+        signalledServer = NULL;
+        cout << "\n[DONE] Server stopped after " << server.requests() << " requests" << endl;
+        return 0;
+    }
+    catch (const exception& e) {
+        signalledServer = NULL;
+        cout << "\n[ERROR!] Server failed: " << e.what() << endl;
+        return 1;
+    }
+}
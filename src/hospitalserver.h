@@ -0,0 +1,131 @@
+#ifndef HOSPITALSERVER_H
+#define HOSPITALSERVER_H
+
+#include "hospitalsystem.h"
+#include "metricsserver.h"
+#include "protocol.h"
+#include <string>
+#include <unordered_map>
+
+/**
+ * SERVER CONFIGURATION
+ */
+struct ServerConfig {
+    std::string endpoint;     ///< "tcp:HOST:PORT" or "unix:PATH"
+    HospitalConfig hospital;  ///< Configuration of the served system
+
+    ServerConfig() : endpoint("tcp:127.0.0.1:7400") {}
+
+    /**
+     * PARSE --listen ENDPOINT, --rooms N, --config FILE and --metrics HOST:PORT
+     * - --rooms N: default configuration with N general rooms
+     * - --config FILE: full configuration read from FILE
+     * - --metrics HOST:PORT: Prometheus endpoint, overrides [metrics] listen
+     *   whatever the order of the options
+     * EXCEPTION: Throws invalid_argument on unknown options or bad values,
+     *            runtime_error for an unreadable or invalid FILE
+     */
+    void parseArguments(int argc, char* argv[]);
+};
+
+/**
+ * HOSPITAL NETWORK SERVER - NON-BLOCKING EPOLL EVENT LOOP
+ *
+ * THREADING MODEL:
+ * - One thread runs the event loop and owns the HospitalSystem, the same
+ *   single-owner rule as HospitalEngine: requests are applied in arrival
+ *   order without locks, and a request never waits on another thread
+ *
+ * I/O:
+ * - Listening and client sockets are non-blocking, level-triggered epoll
+ * - Every readable event drains the socket, applies all complete frames
+ *   (pipelining) and appends their responses to the connection's output
+ *   buffer, which is flushed immediately; EPOLLOUT is armed only while
+ *   output is pending
+ * - A connection whose pending output exceeds OUTPUT_LIMIT stops being
+ *   read until it drains (back-pressure against clients that never read)
+ * - Malformed or oversized frames close the offending connection only
+ *
+ * ROOM TIMERS: epoll_wait sleeps no later than the next expected
+ * consultation end; a timeout moves the system's room timers on, so an
+ * idle server still flags (or releases) overdue rooms on time.
+ *
+ * METRICS: with a metrics address configured, a MetricsServer serves
+ * GET /metrics from its own thread; the event loop only stores relaxed
+ * atomics into the HospitalMetrics attached to the system.
+ *
+ * SHUTDOWN: stop() (async-signal-safe, any thread) wakes the loop through
+ * an eventfd; run() then closes every connection and returns.
+ */
+class HospitalServer {
+private:
+    /**
+     * PER-CONNECTION BUFFERS
+     */
+    struct Connection {
+        int fd;
+        std::string input;         ///< Received bytes not yet parsed
+        std::string output;        ///< Encoded responses not yet written
+        std::size_t outputOffset;  ///< Bytes of output already written
+        bool writeArmed;           ///< EPOLLOUT currently registered
+
+        explicit Connection(int socket) : fd(socket), outputOffset(0), writeArmed(false) {}
+    };
+
+    static const std::size_t READ_CHUNK = 64 * 1024;
+    static const std::size_t OUTPUT_LIMIT = 4 * 1024 * 1024;
+
+    ServerConfig config;
+    protocol::Endpoint endpoint;
+    HospitalSystem system;
+    int listenFd;
+    int epollFd;
+    int wakeFd;
+    std::unordered_map<int, Connection*> connections;
+    long long requestsServed;
+    MetricsRegistry registry;
+    HospitalMetrics metrics;
+    MetricsServer* metricsServer;  ///< NULL when no metrics address is configured
+
+    void openListener();
+    void acceptConnections();
+    void handleReadable(Connection* connection);
+    bool flush(Connection* connection);
+    void updateInterest(Connection* connection);
+    void closeConnection(Connection* connection);
+    void handleRequest(protocol::Reader& request, std::string& response);
+
+public:
+    explicit HospitalServer(const ServerConfig& serverConfig);
+
+    /**
+     * DESTRUCTOR - Closes sockets and removes a Unix socket file
+     */
+    ~HospitalServer();
+
+    /**
+     * SERVE UNTIL stop() IS CALLED
+     * EXCEPTION: Throws runtime_error if the endpoint cannot be opened
+     */
+    void run();
+
+    /**
+     * REQUEST SHUTDOWN (async-signal-safe)
+     */
+    void stop();
+
+    long long requests() const { return requestsServed; }
+    const MetricsServer* metricsEndpoint() const { return metricsServer; }
+
+    /**
+     * ENTRY POINT FOR main() - --serve [options]
+     * - SIGINT / SIGTERM stop the server gracefully
+     * @return Process exit code
+     */
+    static int runFromCommandLine(int argc, char* argv[]);
+
+    HospitalServer(const HospitalServer&) = delete;
+    HospitalServer& operator=(const HospitalServer&) = delete;
+};
+
+#endif
@@ -1,38 +1,118 @@
 #include "hospitalsystem.h"
+#include "metricsserver.h"
+#include "trace.h"
+#include <chrono>
 #include <iostream>
 #include <limits>
 
 using namespace std;
 
+/**
+ * CURRENT STEADY-CLOCK TIME IN NANOSECONDS (patient arrival stamps)
+ */
+static long long steadyNanos() {
+    return (long long)chrono::duration_cast<chrono::nanoseconds>(
+        chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * SILENT OUTPUT STREAM
+ * - Stream without a buffer: every insertion fails fast and prints nothing
+ * - Used when the system is driven programmatically (replay, benchmarks)
+ */
+static ostream silentConsole(NULL);
+
+/**
+ * OPERATION LATENCY FOR THE ATTACHED METRICS
+ * - Reads the clock only when metrics are attached; the destructor also
+ *   runs when the operation throws, so rejected registrations are timed
+ */
+class HospitalSystem::MetricsScope {
+private:
+    HospitalSystem& system;
+    HospitalMetrics::Operation operation;
+    long long start;
+
+public:
+    MetricsScope(HospitalSystem& owner, HospitalMetrics::Operation timed)
+        : system(owner), operation(timed), start(owner.metrics != NULL ? steadyNanos() : 0) {}
+
+    ~MetricsScope() {
+        if (system.metrics != NULL) {
+            system.metrics->latency[operation]->observe((uint64_t)(steadyNanos() - start));
+            system.publishGauges();
+        }
+    }
+
+    MetricsScope(const MetricsScope&) = delete;
+    MetricsScope& operator=(const MetricsScope&) = delete;
+};
+
 /**
  * HOSPITAL SYSTEM CONSTRUCTOR IMPLEMENTATION
  * @param numRooms: Number of consultation rooms to create
+ * @param consoleOutput: false to suppress all operation messages
  * 
- * MEMORY ALLOCATION BREAKDOWN:
- * - registeredPatients: Array of Patient pointers (capacity 200)
- * - triage: PriorityQueue with 5 levels for Colombian triage
- * - consultationRooms: CircularQueue for room management  
- * - history: Stack for patient history (LIFO order)
+ * Default configuration with a single "general" specialty of numRooms rooms
+ */
+HospitalSystem::HospitalSystem(int numRooms, bool consoleOutput)
+    : HospitalSystem(HospitalConfig::withRooms(numRooms), consoleOutput) {}
+
+/**
+ * HOSPITAL SYSTEM CONFIGURED CONSTRUCTOR IMPLEMENTATION
+ * @param hospitalConfig: Rooms per specialty, triage scheme, pre-sizing hints
+ * @param consoleOutput: false to suppress all operation messages
+ * 
+ * MEMORY ALLOCATION BREAKDOWN (all sized from the configuration):
+ * - registeredPatients: Array of Patient pointers (expectedPatients slots)
+ * - scheduler: one triage PriorityQueue per specialty (triageLevels
+ *   levels, expectedWaiting nodes reserved per level) and its room pool
+ * - roomTimers: timing wheel with one timer node per room, reserved
+ * - history: Stack for patient history (LIFO order), expectedHistory nodes
+ * - nameIndex: Radix tree over patient names (expectedPatients entries)
+ * - symptomIndex: Inverted index over symptom terms (expectedSymptomTerms)
+ * - census: Patient counts by status, age and triage level
+ * - journey: Event log columns for 4 events per expected patient
+ * - rolling: Bucket rings for 24 hours of minutes, 7 days of hours and
+ *   90 days of days (fixed size)
  * 
  * INITIALIZATION:
  * - Patient ID counter starts at 1
  * - All data structures start empty
- * - Consultation rooms configured with specified capacity
+ * - Consultation rooms: the sum of every specialty's rooms
  */
-HospitalSystem::HospitalSystem(int numRooms) 
-    : nextPatientID(1), numberOfConsultationRooms(numRooms) {
-    
+HospitalSystem::HospitalSystem(const HospitalConfig& hospitalConfig, bool consoleOutput)
+    : metrics(NULL), config(hospitalConfig), nextPatientID(1), numberOfConsultationRooms(hospitalConfig.totalRooms()),
+      console(consoleOutput ? &cout : &silentConsole) {
+    config.validate();
+
     // Initialize all data structures with dynamic allocation
-    registeredPatients = new Array<Patient*>(200);  // Capacity for 200 patients
-    triage = new PriorityQueue<Patient*>();         // Default 5 priority levels
-    consultationRooms = new CircularQueue<Patient*>(numberOfConsultationRooms);
+    registeredPatients = new Array<Patient*>(config.expectedPatients);
+    scheduler = new RoomScheduler(config);
+    roomTimers = new RoomTimers(numberOfConsultationRooms, steadyNanos() / 1000000000LL);
     history = new Stack<Patient*>();
+    nameIndex = new NameIndex();
+    symptomIndex = new SymptomIndex();
+    census = new PatientCensus();
+    journey = new JourneyLog();
+    rolling = new RollingMetrics(steadyNanos());
+
+    // Pre-allocate so operation within the hints never reallocates
+    scheduler->reserve(config.expectedWaiting);
+    dueRooms.reserve((size_t)numberOfConsultationRooms);
+    history->reserve(config.expectedHistory);
+    nameIndex->reserve(config.expectedPatients);
+    symptomIndex->reserve(config.expectedSymptomTerms);
+    journey->reserve(config.expectedPatients * 4, config.expectedPatients);
     
-    cout << "=== HOSPITAL MANAGEMENT SYSTEM INITIALIZED ===" << endl;
-    cout << "Consultation rooms: " << numberOfConsultationRooms << endl;
-    cout << "Triage system: Colombian 5-level priority" << endl;
-    cout << "Patient database capacity: 200" << endl;
-    cout << "=============================================" << endl;
+    *console << "=== HOSPITAL MANAGEMENT SYSTEM INITIALIZED ===" << endl;
+    *console << "Consultation rooms: " << numberOfConsultationRooms << endl;
+    for (size_t i = 0; i < config.specialties.size(); i++) {
+        *console << "  " << config.specialties[i].name << ": " << config.specialties[i].rooms << endl;
+    }
+    *console << "Triage system: Colombian " << config.triageLevels << "-level priority" << endl;
+    *console << "Patient database capacity: " << config.expectedPatients << endl;
+    *console << "=============================================" << endl;
 }
 
 /**
@@ -49,23 +129,29 @@ HospitalSystem::HospitalSystem(int numRooms)
  */
 HospitalSystem::~HospitalSystem() {
     // STEP 1: Delete all Patient objects to prevent memory leaks
-    cout << "\n=== SYSTEM SHUTDOWN INITIATED ===" << endl;
-    cout << "Cleaning up patient records..." << endl;
+    *console << "\n=== SYSTEM SHUTDOWN INITIATED ===" << endl;
+    *console << "Cleaning up patient records..." << endl;
     
     int patientCount = registeredPatients->len();
     for (int i = 0; i < patientCount; i++) {
+        MEMORY_ACCOUNT_RELEASE((*registeredPatients)[i]->memoryFootprint());
         delete (*registeredPatients)[i];  // Delete each Patient object
     }
-    cout << "Deleted " << patientCount << " patient records" << endl;
+    *console << "Deleted " << patientCount << " patient records" << endl;
 
     // STEP 2: Delete the data structure containers
     delete registeredPatients;  // Delete Array object
-    delete triage;              // Delete PriorityQueue object  
-    delete consultationRooms;   // Delete CircularQueue object
+    delete scheduler;           // Delete RoomScheduler object
+    delete roomTimers;          // Delete RoomTimers object
     delete history;             // Delete Stack object
+    delete nameIndex;           // Delete NameIndex object
+    delete symptomIndex;        // Delete SymptomIndex object
+    delete census;              // Delete PatientCensus object
+    delete journey;             // Delete JourneyLog object
+    delete rolling;             // Delete RollingMetrics object
     
-    cout << "Memory cleanup completed successfully" << endl;
-    cout << "=== SYSTEM SHUTDOWN COMPLETE ===" << endl;
+    *console << "Memory cleanup completed successfully" << endl;
+    *console << "=== SYSTEM SHUTDOWN COMPLETE ===" << endl;
 }
 
 /**
@@ -74,152 +160,532 @@ HospitalSystem::~HospitalSystem() {
  * @param age: Patient's age in years
  * @param priority: Triage priority level (1-5 according to Colombian system)
  * @param symptom: Medical symptom description
+ * @param specialty: Room pool the patient needs ("" = first specialty)
  * 
  * PATIENT LIFECYCLE - REGISTRATION PHASE:
  * 1. Input validation for all parameters
  * 2. Patient object creation in heap memory
  * 3. Addition to registeredPatients array for permanent storage
- * 4. Addition to triage queue for medical attention prioritization
+ * 4. Addition to its specialty's triage queue for medical attention prioritization
  * 5. Same pointer used in both structures - no object copying
  * 
  * EXCEPTION SAFETY:
- * - Strong exception guarantee: if registration fails, system state unchanged
- * - Patient object deleted if any operation fails to prevent memory leak
- * - Patient ID counter rolled back on failure
+ * - Strong exception guarantee for invalid input: every field is checked
+ *   before the patient is created, so a rejected registration leaves the
+ *   system unchanged and the ID unused
+ * - Allocation failures are handled as described in admit()
+ * 
+ * @return ID assigned to the new patient
  */
-void HospitalSystem::registerPatient(string name, int age, int priority, string symptom) {
-    // Validate input parameters
+int HospitalSystem::registerPatient(string name, int age, int priority, string symptom, const string& specialty) {
+    MetricsScope metricsScope(*this, HospitalMetrics::OP_REGISTER);
+    TRACE_SCOPE("registerPatient");
+    validateRegistration(name, age, priority, symptom);
+    int pool = specialtyIndex(specialty);
+
+    // Create new Patient object in heap memory
+    Patient* newPatient = new Patient(nextPatientID++, name, age, priority, symptom);
+    newPatient->arrivalTime = steadyNanos();
+    newPatient->specialty = pool;
+    return admit(newPatient, "PATIENT REGISTERED SUCCESSFULLY");
+}
+
+/**
+ * REGISTRATION DATA VALIDATION
+ * EXCEPTION: Throws invalid_argument describing the first invalid field
+ */
+void HospitalSystem::validateRegistration(const string& name, int age, int priority, const string& symptom) {
     if (name.empty()) {
         throw invalid_argument("Patient name cannot be empty");
     }
+    if (name.size() > (size_t)MAX_NAME_LENGTH) {
+        throw invalid_argument("Patient name too long. Maximum " + to_string(MAX_NAME_LENGTH) + " characters");
+    }
     if (age <= 0 || age > 150) {
         throw invalid_argument("Invalid age. Must be between 1 and 150");
     }
-    if (priority < 1 || priority > 5) {
-        throw invalid_argument("Invalid priority. Must be 1 (TRIAGE I) to 5 (TRIAGE V)");
+    if (priority < 1 || priority > config.triageLevels) {
+        throw invalid_argument("Invalid priority. Must be 1 (TRIAGE I) to " + to_string(config.triageLevels));
     }
     if (symptom.empty()) {
         throw invalid_argument("Symptom description cannot be empty");
     }
+}
 
-    // Create new Patient object in heap memory
-    Patient* newPatient = new Patient(nextPatientID++, name, age, priority, symptom);
+/**
+ * ROOM POOL OF A SPECIALTY NAME
+ * @return Pool index; the first specialty for an empty name
+ * EXCEPTION: Throws invalid_argument for a specialty that is not configured
+ */
+int HospitalSystem::specialtyIndex(const string& specialty) const {
+    if (specialty.empty()) {
+        return 0;
+    }
+    int pool = scheduler->findPool(specialty);
+    if (pool < 0) {
+        throw invalid_argument("Unknown specialty " + specialty);
+    }
+    return pool;
+}
+
+/**
+ * ADD A NEW PATIENT RECORD TO EVERY STRUCTURE
+ * @param newPatient: Freshly allocated, validated patient holding the next ID
+ * @param headline: Success message printed to the console
+ * 
+ * STEP ORDER:
+ * - Input was validated by the caller and the ID is new, so no step can
+ *   reject the patient; only allocations can still fail, and each step
+ *   either completes or throws before changing its structure
+ * - The database comes first: it is the only step that can be undone
+ * - Then the ID-keyed logs and indexes, and the triage queue last, so a
+ *   patient is never waiting without being findable; the census update
+ *   and the messages after it cannot throw
+ * 
+ * EXCEPTION SAFETY:
+ * - Failure before the journey log took the ID: the database entry is
+ *   removed, the patient deleted and the ID counter rolled back (strong)
+ * - Failure after: the ID is already recorded, and IDs are database
+ *   positions, so the record stays registered but not waiting (basic)
+ * 
+ * @return ID of the admitted patient
+ */
+int HospitalSystem::admit(Patient* newPatient, const char* headline) {
+    MEMORY_ACCOUNT_ALLOCATE(newPatient->memoryFootprint());
+    bool stored = false;   // In registeredPatients
+    bool idTaken = false;  // Recorded by a structure that cannot undo it
     
     try {
         // Add patient to database (registeredPatients array)
         registeredPatients->append(newPatient);
-        
-        // Add patient to triage system (priority queue)
-        triage->add(newPatient);
+        stored = true;
+
+        // Journey: registered and placed in triage in the same operation
+        long long now = steadyNanos();
+        journey->append(JOURNEY_REGISTERED, newPatient->id, newPatient->specialty, now);
+        idTaken = true;
+        journey->append(JOURNEY_TRIAGED, newPatient->id, newPatient->priority, now);
+
+        // Make the patient findable by symptom terms and by partial name
+        symptomIndex->insert(newPatient->id, newPatient->symptom);
+        nameIndex->insert(newPatient);
+
+        // Add patient to its specialty's triage queue
+        scheduler->add(newPatient);
+
+        // Count the patient as waiting for the range reports
+        census->add(STATUS_WAITING, newPatient->age, newPatient->priority);
+        recordMetrics(ROLLING_ARRIVALS, 1, now);
         
         // Success notification with detailed information
-        cout << "\n[DONE] PATIENT REGISTERED SUCCESSFULLY" << endl;
-        cout << "Patient ID: " << newPatient->id << endl;
-        cout << "Name: " << newPatient->name << endl;
-        cout << "Age: " << newPatient->age << endl;
-        cout << "Priority: " << newPatient->getPriorityDescription() << endl;
-        cout << "Symptom: " << newPatient->symptom << endl;
-        cout << "Added to triage queue. Waiting patients: " << triage->len() << endl;
+        *console << "\n[DONE] " << headline << endl;
+        *console << "Patient ID: " << newPatient->id << endl;
+        *console << "Name: " << newPatient->name << endl;
+        *console << "Age: " << newPatient->age << endl;
+        *console << "Priority: " << newPatient->getPriorityDescription() << endl;
+        *console << "Specialty: " << scheduler->poolName(newPatient->specialty) << endl;
+        *console << "Symptom: " << newPatient->symptom << endl;
+        *console << "Added to triage queue. Waiting patients: " << scheduler->waiting() << endl;
+        return newPatient->id;
     }
     catch (...) {
-        // Exception safety: if anything fails, delete the patient to prevent memory leak
-        delete newPatient;
-        nextPatientID--;  // Rollback ID counter
+        if (!idTaken) {
+            // Exception safety: nothing kept the patient, undo the database entry
+            if (stored) {
+                registeredPatients->del();
+            }
+            MEMORY_ACCOUNT_RELEASE(newPatient->memoryFootprint());
+            delete newPatient;
+            nextPatientID--;  // Rollback ID counter
+        }
         throw;  // Re-throw the exception to be handled by caller
     }
 }
 
+/**
+ * TRANSFER WAITING PATIENTS OUT TO ANOTHER SITE
+ * @param maxPatients: Maximum number of patients to remove from triage
+ * @param minPriority, maxPriority: Triage levels eligible (default IV-V)
+ * 
+ * SELECTION:
+ * - Least urgent level first (maxPriority down to minPriority)
+ * - Oldest patients first within a level, so each level's arrival order
+ *   is kept in the returned batch
+ * 
+ * STATE CHANGES:
+ * - Patients leave the triage queue and are counted as STATUS_TRANSFERRED
+ * - Records stay in the database (and the name / symptom indexes) marked
+ *   as transferred; the receiving site registers its own copy
+ * 
+ * @return Transferred patients, level by level, oldest first
+ */
+vector<Patient*> HospitalSystem::transferOut(int maxPatients, int minPriority, int maxPriority) {
+    TRACE_SCOPE("transferOut");
+    MetricsScope metricsScope(*this, HospitalMetrics::OP_TRANSFER);
+    vector<Patient*> batch;
+    if (maxPatients <= 0) {
+        return batch;
+    }
+    minPriority = max(minPriority, 1);
+    maxPriority = min(maxPriority, scheduler->levels());
+    batch.resize((size_t)min(maxPatients, scheduler->waiting()));
+
+    int taken = 0;
+    for (int level = maxPriority; level >= minPriority && taken < (int)batch.size(); level--) {
+        taken += scheduler->takeOldest(level, (int)batch.size() - taken, batch.data() + taken);
+    }
+    batch.resize((size_t)taken);
+    long long now = steadyNanos();
+    for (size_t i = 0; i < batch.size(); i++) {
+        batch[i]->transferred = true;
+        census->move(STATUS_WAITING, STATUS_TRANSFERRED, batch[i]->age, batch[i]->priority);
+        journey->append(JOURNEY_TRANSFERRED, batch[i]->id, 0, now);
+    }
+    if (taken > 0) {
+        recordMetrics(ROLLING_TRANSFERS, taken, now);
+    }
+    *console << "\n[DONE] " << taken << " PATIENT(S) TRANSFERRED TO ANOTHER SITE" << endl;
+    *console << "Patients remaining in triage: " << scheduler->waiting() << endl;
+    return batch;
+}
+
+/**
+ * ADMIT A PATIENT TRANSFERRED FROM ANOTHER SITE
+ * @param record: The sending site's record (its ID is not reused)
+ * @param specialty: The sending site's name of the record's specialty
+ * 
+ * BEHAVIOR:
+ * - Registered with a new local ID, placed in its triage level after
+ *   the patients that arrived before it (not at the back)
+ * - The original arrival time is kept, so reported waits include the
+ *   time spent at the sending site
+ * - The specialty is matched by name, since sites may list their pools in
+ *   a different order; without a match the patient waits for the general
+ *   pool
+ * 
+ * EXCEPTION HANDLING: Same validation and rollback as registerPatient
+ * 
+ * @return Local ID of the admitted patient
+ */
+int HospitalSystem::admitTransferredPatient(const Patient& record, const string& specialty) {
+    TRACE_SCOPE("admitTransferredPatient");
+    MetricsScope metricsScope(*this, HospitalMetrics::OP_REGISTER);
+    validateRegistration(record.name, record.age, record.priority, record.symptom);
+
+    Patient* newPatient = new Patient(nextPatientID++, record.name, record.age, record.priority, record.symptom);
+    newPatient->arrivalTime = record.arrivalTime;
+    int pool = scheduler->findPool(specialty);
+    newPatient->specialty = pool < 0 ? 0 : pool;
+    return admit(newPatient, "TRANSFERRED PATIENT ADMITTED");
+}
+
+/**
+ * TAKE BACK A PATIENT THE RECEIVING SITE REFUSED
+ * @param patientId: ID of a record this site transferred out
+ * 
+ * BEHAVIOR:
+ * - Admitted like any transferred patient, so it waits again from its
+ *   original arrival time under a new local ID
+ * - The old record keeps its transferred status and journey
+ * 
+ * @return New local ID
+ */
+int HospitalSystem::readmitTransferredPatient(int patientId) {
+    Patient* record = NULL;
+    if (patientId >= 1 && patientId <= registeredPatients->len()) {
+        record = (*registeredPatients)[patientId - 1];
+    }
+    if (record == NULL || record->id != patientId || !record->transferred) {
+        throw invalid_argument("Patient " + to_string(patientId) + " was not transferred out");
+    }
+    return admitTransferredPatient(*record, specialtyName(record->specialty));
+}
+
 /**
  * ATTEND NEXT PATIENT - TRIAGE TO CONSULTATION TRANSITION
  * 
  * PATIENT FLOW - CONSULTATION PHASE:
- * 1. Remove highest priority patient from triage queue
- * 2. Assign to available consultation room
- * 3. Patient moves from waiting state to active consultation
- * 4. Update system statistics and notifications
+ * 1. RoomScheduler picks the most urgent patient with a free room of its
+ *    specialty or of a fallback pool, and that room
+ * 2. Patient moves from waiting state to active consultation
+ * 3. Update system statistics and notifications
  * 
  * PRECONDITIONS:
  * - Triage queue must not be empty
- * - At least one consultation room must be available
+ * - At least one eligible consultation room must be available
  * 
  * EXCEPTION SCENARIOS:
  * - No patients in triage queue
- * - All consultation rooms occupied
+ * - All consultation rooms occupied, or only rooms of other specialties
+ *   that the fallback policy does not allow
  * - Memory allocation failures (handled by exception mechanism)
+ * 
+ * @return Patient now in consultation, NULL if nobody could be attended
  */
-void HospitalSystem::attendNextPatient() {
+Patient* HospitalSystem::attendNextPatient() {
+    TRACE_SCOPE("attendNextPatient");
+    MetricsScope metricsScope(*this, HospitalMetrics::OP_ATTEND);
+    checkRoomTimers();
     // Check if there are patients waiting in triage
-    if (triage->isEmpty()) {
-        cout << "\n[ERROR!] No patients waiting in triage" << endl;
-        return;
+    if (scheduler->waiting() == 0) {
+        *console << "\n[ERROR!] No patients waiting in triage" << endl;
+        return NULL;
     }
 
     // Check if consultation rooms are available
-    if (consultationRooms->isFull()) {
-        cout << "\n[ERROR!] All consultation rooms are occupied" << endl;
-        cout << "Please free a room before attending next patient" << endl;
-        return;
+    if (scheduler->freeRooms() == 0) {
+        *console << "\n[ERROR!] All consultation rooms are occupied" << endl;
+        *console << "Please free a room before attending next patient" << endl;
+        return NULL;
     }
 
     try {
-        // Get next patient from triage (highest priority according to Colombian system)
-        Patient* nextPatient = triage->pop();
+        // Most urgent patient that has an eligible free room (Colombian triage order)
+        RoomAssignment assignment = scheduler->dispatch();
+        if (assignment.patient == NULL) {
+            *console << "\n[ERROR!] No free room of a specialty the waiting patients can use" << endl;
+            *console << "Please free a room before attending next patient" << endl;
+            return NULL;
+        }
+        Patient* nextPatient = assignment.patient;
         
-        // Assign patient to consultation room
-        consultationRooms->enqueue(nextPatient);
+        // Expected end from the triage level (ticks are seconds)
+        roomTimers->start(assignment.room,
+                          roomTimers->now() + config.consultationMinutes[nextPatient->priority - 1] * 60LL);
+        census->move(STATUS_WAITING, STATUS_IN_CONSULTATION, nextPatient->age, nextPatient->priority);
+        long long now = steadyNanos();
+        journey->append(JOURNEY_ROOMED, nextPatient->id, assignment.room, now);
+        recordMetrics(ROLLING_ATTENDED, 1, now);
         
         // Success notification with system status update
-        cout << "\n[DONE] PATIENT ASSIGNED TO CONSULTATION ROOM" << endl;
-        cout << "Patient: " << *nextPatient << endl;
-        cout << "Consultation rooms occupied: " << consultationRooms->size() 
-             << "/" << consultationRooms->getCapacity() << endl;
-        cout << "Patients remaining in triage: " << triage->len() << endl;
+        *console << "\n[DONE] PATIENT ASSIGNED TO CONSULTATION ROOM " << assignment.room + 1
+                 << " (" << scheduler->poolName(assignment.pool) << ")" << endl;
+        *console << "Patient: " << *nextPatient << endl;
+        *console << "Expected to end in " << config.consultationMinutes[nextPatient->priority - 1] << " min" << endl;
+        *console << "Consultation rooms occupied: " << scheduler->rooms() - scheduler->freeRooms()
+             << "/" << scheduler->rooms() << endl;
+        *console << "Patients remaining in triage: " << scheduler->waiting() << endl;
+        return nextPatient;
     }
     catch (const exception& e) {
-        cout << "\n!! Error attending patient: " << e.what() << endl;
+        *console << "\n!! Error attending patient: " << e.what() << endl;
+        return NULL;
     }
 }
 
 /**
- * FREE CONSULTATION ROOM - COMPLETE PATIENT CONSULTATION
+ * COMPLETE THE CONSULTATION IN ONE ROOM
  * 
  * PATIENT FLOW - COMPLETION PHASE:
- * 1. Remove patient from consultation room
- * 2. Add patient to history stack (most recent first)
- * 3. Room becomes available for next patient
+ * 1. Remove patient from consultation room (RoomScheduler.release)
+ * 2. Stop its timer, or take it off the overdue list (RoomTimers.finish)
+ * 3. Add patient to history stack (most recent first)
  * 4. Update system statistics and notifications
  * 
- * DATA STRUCTURE INTERACTION:
- * - CircularQueue.dequeue(): removes patient from room (FIFO)
- * - Stack.add(): adds patient to history (LIFO order)
- * - Memory: Patient object persists in registeredPatients array
+ * @return Patient whose consultation completed, NULL if the room was free
+ * EXCEPTION: Throws out_of_range for a room that does not exist
  */
-void HospitalSystem::freeConsultationRoom() {
-    // Check if there are occupied consultation rooms
-    if (consultationRooms->isEmpty()) {
-        cout << "\n[ERROR!] No consultation rooms are currently occupied" << endl;
-        return;
+Patient* HospitalSystem::complete(int room, const char* headline) {
+    Patient* completedPatient = scheduler->release(room);
+    if (completedPatient == NULL) {
+        return NULL;
+    }
+    bool late = roomTimers->finish(room);
+
+    // Add patient to history stack (LIFO order - most recent first)
+    history->add(completedPatient);
+    census->move(STATUS_IN_CONSULTATION, STATUS_COMPLETED, completedPatient->age, completedPatient->priority);
+    long long now = steadyNanos();
+    journey->append(JOURNEY_DISCHARGED, completedPatient->id, room, now);
+    recordMetrics(ROLLING_DISCHARGES, 1, now);
+
+    // Success notification with system status
+    *console << "\n" << headline << " CONSULTATION ROOM " << room + 1 << " FREED"
+             << (late ? " (past its expected end)" : "") << endl;
+    *console << "Patient consultation completed: " << *completedPatient << endl;
+    *console << "Patient added to history stack" << endl;
+    *console << "Available rooms: " << scheduler->freeRooms() << "/" << scheduler->rooms() << endl;
+    return completedPatient;
+}
+
+/**
+ * FREE CONSULTATION ROOM - COMPLETE THE CONSULTATION MOST LIKELY OVER
+ * 
+ * ROOM CHOICE (RoomTimers.nextToFinish):
+ * - The room that has been overdue the longest, if any
+ * - Otherwise the room whose expected end comes first
+ * 
+ * @return Patient whose consultation completed, NULL if no room was occupied
+ */
+Patient* HospitalSystem::freeConsultationRoom() {
+    TRACE_SCOPE("freeConsultationRoom");
+    MetricsScope metricsScope(*this, HospitalMetrics::OP_COMPLETE);
+    checkRoomTimers();
+    int room = roomTimers->nextToFinish();
+    if (room < 0) {
+        *console << "\n[ERROR!] No consultation rooms are currently occupied" << endl;
+        return NULL;
     }
 
     try {
-        // Remove patient from consultation room (FIFO order)
-        Patient* completedPatient = consultationRooms->dequeue();
-        
-        // Add patient to history stack (LIFO order - most recent first)
-        history->add(completedPatient);
-        
-        // Success notification with system status
-        cout << "\n[DONE] CONSULTATION ROOM FREED" << endl;
-        cout << "Patient consultation completed: " << *completedPatient << endl;
-        cout << "Patient added to history stack" << endl;
-        cout << "Available rooms: " << consultationRooms->getCapacity() - consultationRooms->size() 
-             << "/" << consultationRooms->getCapacity() << endl;
+        return complete(room, "[DONE]");
     }
     catch (const exception& e) {
-        cout << "\n!! Error freeing consultation room: " << e.what() << endl;
+        *console << "\n!! Error freeing consultation room: " << e.what() << endl;
+        return NULL;
     }
 }
 
+/**
+ * COMPLETE CONSULTATION - A ROOM REPORTS ITS CONSULTATION OVER
+ * @param room: Room number, 0-based (shown to users as room + 1)
+ * 
+ * @return Patient whose consultation completed, NULL if the room was free
+ * EXCEPTION: Throws out_of_range for a room that does not exist
+ */
+Patient* HospitalSystem::completeConsultation(int room) {
+    TRACE_SCOPE("completeConsultation");
+    MetricsScope metricsScope(*this, HospitalMetrics::OP_COMPLETE);
+    checkRoomTimers();
+    Patient* completedPatient = complete(room, "[DONE]");
+    if (completedPatient == NULL) {
+        *console << "\n[ERROR!] Consultation room " << room + 1 << " is not occupied" << endl;
+    }
+    return completedPatient;
+}
+
+/**
+ * ROOM TIMERS AGAINST THE STEADY CLOCK
+ */
+void HospitalSystem::checkRoomTimers() {
+    processRoomTimers(steadyNanos());
+}
+
+/**
+ * PROCESS ROOM TIMERS IMPLEMENTATION
+ * - The wheel hands back the rooms whose expected end has passed, earliest
+ *   first; they are already on the overdue list, so release mode only has
+ *   to complete them
+ */
+int HospitalSystem::processRoomTimers(long long nowNanos) {
+    dueRooms.clear();
+    int due = roomTimers->advance(nowNanos / 1000000000LL, dueRooms);
+    if (due > 0) {
+        rolling->count(ROLLING_OVERDUE, nowNanos, due);
+        if (metrics != NULL) {
+            metrics->events[ROLLING_OVERDUE]->add((uint64_t)due);
+        }
+    }
+    for (size_t i = 0; i < dueRooms.size(); i++) {
+        int room = dueRooms[i];
+        if (config.overdue == OVERDUE_RELEASE) {
+            complete(room, "[AUTO-RELEASED]");
+        } else {
+            *console << "\n[OVERDUE] Consultation room " << room + 1 << " is past its expected end: "
+                     << *scheduler->occupant(room) << endl;
+        }
+    }
+    if (due > 0 && metrics != NULL) {
+        publishGauges();  // No operation scope around an idle driver's call
+    }
+    return due;
+}
+
+/**
+ * ROLLING METRICS UPDATE - one counter event plus both gauges, O(1)
+ */
+void HospitalSystem::recordMetrics(RollingCounter counter, long long amount, long long now) {
+    rolling->count(counter, now, amount);
+    rolling->set(ROLLING_OCCUPIED_ROOMS, scheduler->rooms() - scheduler->freeRooms(), now);
+    rolling->set(ROLLING_WAITING, scheduler->waiting(), now);
+    if (metrics != NULL) {
+        metrics->events[counter]->add((uint64_t)amount);
+    }
+}
+
+/**
+ * HOSPITAL METRICS REGISTRATION
+ * - Event names follow RollingCounter, operation names HospitalMetrics::Operation
+ */
+HospitalMetrics::HospitalMetrics(MetricsRegistry& registry, const HospitalConfig& config) {
+    static const char* EVENTS[RollingMetrics::COUNTERS] = {"arrival", "attended", "discharge", "transfer", "overdue"};
+    static const char* OPERATION_NAMES[OPERATIONS] = {"register", "attend", "complete", "search", "transfer"};
+    static const char* STRUCTURE_NAMES[STRUCTURES] = {"database", "triage", "rooms", "history", "names",
+                                                      "symptoms", "census", "journey", "rolling", "patients"};
+
+    for (int level = 1; level <= HospitalConfig::MAX_TRIAGE_LEVELS; level++) {
+        triageWaiting[level - 1] = level > config.triageLevels ? NULL :
+            &registry.gauge("hospital_triage_waiting", "Patients waiting in triage per level (1 = TRIAGE I)",
+                            MetricsRegistry::label("level", to_string(level)));
+    }
+    roomsOccupied = &registry.gauge("hospital_rooms_occupied", "Consultation rooms in use");
+    roomsTotal = &registry.gauge("hospital_rooms", "Consultation rooms configured");
+    roomsOverdue = &registry.gauge("hospital_rooms_overdue", "Occupied rooms past their expected end");
+    historySize = &registry.gauge("hospital_history_size", "Completed consultations in the history stack");
+    registered = &registry.counter("hospital_patients_registered_total", "Patients ever registered");
+    for (int i = 0; i < RollingMetrics::COUNTERS; i++) {
+        events[i] = &registry.counter("hospital_events_total", "Patient flow events by type",
+                                      MetricsRegistry::label("event", EVENTS[i]));
+    }
+    for (int i = 0; i < OPERATIONS; i++) {
+        latency[i] = &registry.histogram("hospital_operation_duration_seconds", "Duration of engine operations",
+                                         MetricsRegistry::label("operation", OPERATION_NAMES[i]));
+    }
+    for (int i = 0; i < STRUCTURES; i++) {
+        memoryBytes[i] = NULL;
+        allocations[i] = NULL;
+        if (MEMORY_STATS_ENABLED) {
+            string structure = MetricsRegistry::label("structure", STRUCTURE_NAMES[i]);
+            memoryBytes[i] = &registry.gauge("hospital_memory_live_bytes", "Bytes allocated per structure", structure);
+            allocations[i] = &registry.counter("hospital_memory_allocations_total", "Allocations per structure",
+                                               structure);
+        }
+    }
+}
+
+void HospitalSystem::attachMetrics(HospitalMetrics* published) {
+    metrics = published;
+    if (metrics != NULL) {
+        metrics->roomsTotal->set(scheduler->rooms());
+        publishGauges();
+    }
+}
+
+/**
+ * STORE THE CURRENT SIZES - relaxed stores of values every structure
+ * already keeps, O(levels x specialties)
+ */
+void HospitalSystem::publishGauges() {
+    for (int level = 1; level <= config.triageLevels; level++) {
+        metrics->triageWaiting[level - 1]->set(scheduler->waiting(level));
+    }
+    metrics->roomsOccupied->set(scheduler->rooms() - scheduler->freeRooms());
+    metrics->roomsOverdue->set(roomTimers->overdueCount());
+    metrics->historySize->set(history->len());
+    metrics->registered->set((uint64_t)registeredPatients->len());
+    if (MEMORY_STATS_ENABLED) {
+        SystemMemoryStats stats = memoryStats();
+        const MemoryStats* parts[HospitalMetrics::STRUCTURES] = {&stats.database, &stats.triage, &stats.rooms,
+                                                                 &stats.history, &stats.names, &stats.symptoms,
+                                                                 &stats.census, &stats.journey, &stats.rolling,
+                                                                 &stats.patients};
+        for (int i = 0; i < HospitalMetrics::STRUCTURES; i++) {
+            metrics->memoryBytes[i]->set(parts[i]->liveBytes);
+            metrics->allocations[i]->set((uint64_t)parts[i]->allocations);
+        }
+    }
+}
+
+const RollingMetrics& HospitalSystem::rollingMetrics() {
+    rolling->advance(steadyNanos());
+    return *rolling;
+}
+
+long long HospitalSystem::nextRoomDeadline() const {
+    long long tick = roomTimers->nextDeadline();
+    return tick < 0 ? -1 : tick * 1000000000LL;
+}
+
 /**
  * DISPLAY COMPLETE SYSTEM STATE
  * 
@@ -235,39 +701,218 @@ void HospitalSystem::freeConsultationRoom() {
  * - Debugging and system maintenance
  */
 void HospitalSystem::displaySystemState() {
-    cout << "\n==================================================" << endl;
-    cout << "         HOSPITAL SYSTEM COMPLETE STATUS" << endl;
-    cout << "==================================================" << endl;
+    checkRoomTimers();
+    *console << "\n==================================================" << endl;
+    *console << "         HOSPITAL SYSTEM COMPLETE STATUS" << endl;
+    *console << "==================================================" << endl;
     
-    // Display triage system state with Colombian priority levels
-    triage->displayState();
+    // Display rooms and triage per specialty with Colombian priority levels
+    scheduler->displayState(*console);
     
-    // Display consultation rooms state and occupancy
-    consultationRooms->displayState();
+    // Display occupied consultation rooms with their expected end
+    *console << "\n=== CONSULTATION ROOMS ===" << endl;
+    *console << "Occupied: " << scheduler->rooms() - scheduler->freeRooms() << "/" << scheduler->rooms()
+             << " | overdue: " << roomTimers->overdueCount() << endl;
+    for (int room = 0; room < scheduler->rooms(); room++) {
+        Patient* patient = scheduler->occupant(room);
+        if (patient == NULL) {
+            continue;
+        }
+        *console << "Room " << room + 1 << " (" << scheduler->poolName(scheduler->poolOf(room)) << "): "
+                 << *patient << " | ";
+        if (roomTimers->isOverdue(room)) {
+            *console << "OVERDUE" << endl;
+        } else {
+            long long left = roomTimers->expectedEnd(room) - roomTimers->now();
+            *console << "ends in " << (left + 59) / 60 << " min" << endl;
+        }
+    }
     
     // Display patient history information (LIFO order)
-    cout << "\n=== RECENT PATIENT HISTORY (STACK - LIFO) ===" << endl;
+    *console << "\n=== RECENT PATIENT HISTORY (STACK - LIFO) ===" << endl;
     if (history->isEmpty()) {
-        cout << "No patients in history - no consultations completed yet" << endl;
+        *console << "No patients in history - no consultations completed yet" << endl;
     } else {
-        cout << "Most recent patient: " << *(history->peek()) << endl;
-        cout << "Total patients in history: " << history->len() << endl;
+        *console << "Most recent patient: " << *(history->peek()) << endl;
+        *console << "Total patients in history: " << history->len() << endl;
         
         // History depth information for context
         if (history->len() > 1) {
-            cout << "History tracks last " << history->len() << " completed consultations" << endl;
-            cout << "Displayed in reverse chronological order (most recent first)" << endl;
+            *console << "History tracks last " << history->len() << " completed consultations" << endl;
+            *console << "Displayed in reverse chronological order (most recent first)" << endl;
         }
     }
     
     // Comprehensive system summary
-    cout << "\n=== SYSTEM SUMMARY ===" << endl;
-    cout << "Total registered patients: " << registeredPatients->len() << endl;
-    cout << "Patients waiting in triage: " << triage->len() << endl;
-    cout << "Patients in consultation: " << consultationRooms->size() << endl;
-    cout << "Patients in history: " << history->len() << endl;
-    cout << "Next available patient ID: " << nextPatientID << endl;
-    cout << "Consultation room capacity: " << consultationRooms->getCapacity() << endl;
+    *console << "\n=== SYSTEM SUMMARY ===" << endl;
+    *console << "Total registered patients: " << registeredPatients->len() << endl;
+    *console << "Patients waiting in triage: " << scheduler->waiting() << endl;
+    *console << "Patients in consultation: " << scheduler->rooms() - scheduler->freeRooms() << endl;
+    *console << "Patients in history: " << history->len() << endl;
+    *console << "Next available patient ID: " << nextPatientID << endl;
+    *console << "Consultation room capacity: " << scheduler->rooms() << endl;
+
+    // Charge nurse view: oldest waiting patients across every level
+    *console << "\n=== LONGEST WAITING PATIENTS ===" << endl;
+    vector<WaitingPatient> oldest = longestWaiting(5);
+    if (oldest.empty()) {
+        *console << "No patients waiting" << endl;
+    }
+    for (size_t i = 0; i < oldest.size(); i++) {
+        *console << "  " << i + 1 << ". " << *oldest[i].patient << " | Waiting "
+                 << oldest[i].waitNanos / 1000000000LL << " s" << endl;
+    }
+
+    // Range-count report from the census (no container scans)
+    *console << "\n=== WAITING PATIENTS BY AGE GROUP ===" << endl;
+    const char* levelNames[] = {"    I", "   II", "  III", "   IV", "    V"};
+    *console << "Age group";
+    for (int level = 1; level <= config.triageLevels; level++) {
+        *console << levelNames[level - 1];
+    }
+    *console << endl;
+    const char* groups[] = {"0-17     ", "18-64    ", "65+      "};
+    int groupStart[] = {0, 18, 65};
+    int groupEnd[] = {17, 64, PatientCensus::MAX_AGE};
+    for (int g = 0; g < 3; g++) {
+        *console << groups[g];
+        for (int level = 1; level <= config.triageLevels; level++) {
+            int waiting = countPatients(STATUS_WAITING, groupStart[g], groupEnd[g], level, level);
+            *console << (waiting < 10 ? "    " : waiting < 100 ? "   " : "  ") << waiting;
+        }
+        *console << endl;
+    }
+
+    // Stage durations and throughput from the journey log projections
+    *console << "\n=== PATIENT FLOW (JOURNEY LOG) ===" << endl;
+    *console << "Events recorded: " << journey->size() << endl;
+    const char* stageNames[] = {"Intake      ", "Triage wait ", "Consultation"};
+    for (int stage = 0; stage < JourneyLog::STAGES; stage++) {
+        const Histogram& durations = journey->stageDurations((JourneyStage)stage);
+        *console << stageNames[stage] << ": " << durations.count() << " completed";
+        if (durations.count() > 0) {
+            *console << " | median " << durations.percentile(50.0) / 60000000000ULL << " min | p90 "
+                     << durations.percentile(90.0) / 60000000000ULL << " min";
+        }
+        *console << endl;
+    }
+    if (journey->hours() > 0) {
+        int hour = journey->hours() - 1;
+        *console << "Latest hour: " << journey->throughput(hour, JOURNEY_REGISTERED) << " registered | "
+                 << journey->throughput(hour, JOURNEY_DISCHARGED) << " discharged" << endl;
+    }
+
+    // Throughput and occupancy over time from the rolling metric rings
+    const RollingMetrics& rollingView = rollingMetrics();
+    *console << "\n=== ROLLING METRICS ===" << endl;
+    const char* counterNames[] = {"Arrivals  ", "Discharges"};
+    RollingCounter counters[] = {ROLLING_ARRIVALS, ROLLING_DISCHARGES};
+    for (int c = 0; c < 2; c++) {
+        vector<RollingPoint> perFive = rollingView.counterSeries(counters[c], ROLLING_MINUTE, 12, 5);
+        vector<RollingPoint> perHour = rollingView.counterSeries(counters[c], ROLLING_HOUR, 24);
+        long long day = 0;
+        for (size_t i = 0; i < perHour.size(); i++) {
+            day += perHour[i].count;
+        }
+        *console << counterNames[c] << " per 5 min, last hour:";
+        for (size_t i = 0; i < perFive.size(); i++) {
+            *console << " " << perFive[i].count;
+        }
+        *console << " | last 24 h: " << day << endl;
+    }
+    vector<RollingPoint> occupancy = rollingView.gaugeSeries(ROLLING_OCCUPIED_ROOMS, ROLLING_HOUR, 6);
+    *console << "Occupied rooms per hour, last 6 h (mean/max):";
+    for (size_t i = 0; i < occupancy.size(); i++) {
+        *console << " " << (int)(occupancy[i].mean * 10 + 0.5) / 10.0 << "/" << occupancy[i].max;
+    }
+    *console << endl;
+
+    // Allocation accounting per structure (opt-in build flag)
+    *console << "\n=== MEMORY USAGE ===" << endl;
+    if (!MEMORY_STATS_ENABLED) {
+        *console << "Memory instrumentation disabled (build with MEMORY_STATS=1)" << endl;
+        return;
+    }
+    SystemMemoryStats memory = memoryStats();
+    const char* names[] = {"Patient database", "Triage queue", "Consultation rooms", "History stack",
+                           "Name index", "Symptom index", "Patient census", "Journey log",
+                           "Rolling metrics", "Patient records", "TOTAL"};
+    MemoryStats rows[] = {memory.database, memory.triage, memory.rooms, memory.history,
+                          memory.names, memory.symptoms, memory.census, memory.journey,
+                          memory.rolling, memory.patients, memory.total()};
+    for (int i = 0; i < 11; i++) {
+        *console << names[i] << ": " << rows[i].liveBytes << " bytes live | "
+                 << rows[i].allocations << " allocations | "
+                 << rows[i].deallocations << " frees | peak "
+                 << rows[i].peakBytes << " bytes" << endl;
+    }
+}
+
+/**
+ * CURRENT OCCUPANCY COUNTERS
+ */
+SystemStatus HospitalSystem::status() {
+    SystemStatus current;
+    current.registered = registeredPatients->len();
+    current.waiting = scheduler->waiting();
+    current.inConsultation = scheduler->rooms() - scheduler->freeRooms();
+    current.rooms = scheduler->rooms();
+    current.overdue = roomTimers->overdueCount();
+    current.completed = history->len();
+    return current;
+}
+
+/**
+ * RANGE COUNT REPORT
+ * - Answered by the census Fenwick tree of that state: four prefix sums,
+ *   each O(log ages * log levels)
+ */
+int HospitalSystem::countPatients(PatientStatus state, int minAge, int maxAge, int minPriority, int maxPriority) {
+    return census->count(state, minAge, maxAge, minPriority, maxPriority);
+}
+
+/**
+ * LONGEST-WAITING PATIENTS
+ * - RoomScheduler::oldest() merges the bucket heads of every specialty
+ *   without copying the queues; wait times are measured against a single "now"
+ */
+vector<WaitingPatient> HospitalSystem::longestWaiting(int k) {
+    TRACE_SCOPE("longestWaiting");
+    vector<WaitingPatient> result;
+    if (k <= 0) {
+        return result;
+    }
+    vector<Patient*> patients((size_t)min(k, scheduler->waiting()));
+    int found = scheduler->oldest((int)patients.size(), patients.data());
+    long long now = steadyNanos();
+    result.reserve((size_t)found);
+    for (int i = 0; i < found; i++) {
+        WaitingPatient waiting;
+        waiting.patient = patients[(size_t)i];
+        waiting.waitNanos = now - patients[(size_t)i]->arrivalTime;
+        result.push_back(waiting);
+    }
+    return result;
+}
+
+/**
+ * MEMORY USAGE PER STRUCTURE
+ * - Each container reports its own counters; patient records are counted
+ *   by the system itself at registration and shutdown
+ */
+SystemMemoryStats HospitalSystem::memoryStats() {
+    SystemMemoryStats stats;
+    stats.database = registeredPatients->memoryStats();
+    stats.triage = scheduler->memoryStats();
+    stats.rooms = roomTimers->memoryStats();
+    stats.history = history->memoryStats();
+    stats.names = nameIndex->memoryStats();
+    stats.symptoms = symptomIndex->memoryStats();
+    stats.census = census->memoryStats();
+    stats.journey = journey->memoryStats();
+    stats.rolling = rolling->memoryStats();
+    stats.patients = MEMORY_ACCOUNT_SNAPSHOT();
+    return stats;
 }
 
 /**
@@ -282,33 +927,38 @@ void HospitalSystem::displaySystemState() {
  * STATUS INDICATORS:
  * - [STATUS: Waiting in triage]: Patient in priority queue
  * - [STATUS: In consultation room X]: Patient currently in consultation
+ * - [STATUS: Transferred to another site]: Sent away while waiting
  * - [STATUS: Consultation completed]: Patient in history stack
  */
 void HospitalSystem::displayPatientDatabase() {
-    cout << "\n=== COMPLETE PATIENT DATABASE ===" << endl;
-    cout << "Total patients: " << registeredPatients->len() << endl;
-    cout << "=================================" << endl;
+    checkRoomTimers();
+    *console << "\n=== COMPLETE PATIENT DATABASE ===" << endl;
+    *console << "Total patients: " << registeredPatients->len() << endl;
+    *console << "=================================" << endl;
     
     if (registeredPatients->len() == 0) {
-        cout << "No patients in database" << endl;
+        *console << "No patients in database" << endl;
         return;
     }
 
     // Iterate through all registered patients
     for (int i = 0; i < registeredPatients->len(); i++) {
         Patient* patient = (*registeredPatients)[i];
-        cout << (i + 1) << ". " << *patient;
+        *console << (i + 1) << ". " << *patient;
         
         // Determine and display current patient status
-        if (triage->contains(patient->id)) {
-            cout << " [STATUS: Waiting in triage]";
-        } else if (consultationRooms->isPatientInConsultation(patient->id)) {
-            int room = consultationRooms->findPatientRoom(patient->id);
-            cout << " [STATUS: In consultation room " << room << "]";
+        if (patient->room >= 0) {
+            *console << " [STATUS: In consultation room " << patient->room + 1 << " ("
+                     << scheduler->poolName(scheduler->poolOf(patient->room)) << ")"
+                     << (roomTimers->isOverdue(patient->room) ? ", overdue" : "") << "]";
+        } else if (scheduler->contains(patient->id)) {
+            *console << " [STATUS: Waiting in triage]";
+        } else if (patient->transferred) {
+            *console << " [STATUS: Transferred to another site]";
         } else {
-            cout << " [STATUS: Consultation completed]";
+            *console << " [STATUS: Consultation completed]";
         }
-        cout << endl;
+        *console << endl;
     }
 }
 
@@ -322,43 +972,144 @@ void HospitalSystem::displayPatientDatabase() {
  * - Useful for patient tracking, inquiries, and administrative tasks
  * 
  * SEARCH ALGORITHM:
- * - Linear search through registeredPatients array (primary storage)
+ * - Direct O(1) lookup: IDs are assigned sequentially from 1 and the
+ *   database is append-only, so patient ID k lives at position k - 1
+ * - Linear search through registeredPatients array as a fallback
  * - Status determination through contains() methods of other structures
- * - Early termination when patient is found
+ * 
+ * @return Matching patient, NULL if the ID is not registered
  */
-void HospitalSystem::searchPatient(int patientId) {
-    cout << "\n=== PATIENT SEARCH ===" << endl;
-    cout << "Searching for patient ID: " << patientId << endl;
+Patient* HospitalSystem::searchPatient(int patientId) {
+    TRACE_SCOPE("searchPatient");
+    MetricsScope metricsScope(*this, HospitalMetrics::OP_SEARCH);
+    *console << "\n=== PATIENT SEARCH ===" << endl;
+    *console << "Searching for patient ID: " << patientId << endl;
     
-    bool found = false;
+    Patient* found = NULL;
     
-    // Search in registered patients database (primary storage)
-    for (int i = 0; i < registeredPatients->len(); i++) {
+    // Direct position lookup, then linear search in the database (primary storage)
+    int start = 0;
+    if (patientId >= 1 && patientId <= registeredPatients->len()
+        && (*registeredPatients)[patientId - 1]->id == patientId) {
+        start = patientId - 1;
+    }
+    for (int i = start; i < registeredPatients->len(); i++) {
         Patient* patient = (*registeredPatients)[i];
         if (patient->id == patientId) {
-            found = true;
-            cout << "! PATIENT FOUND IN DATABASE" << endl;
-            cout << "Details: " << *patient << endl;
+            found = patient;
+            *console << "! PATIENT FOUND IN DATABASE" << endl;
+            *console << "Details: " << *patient << endl;
             
             // Determine and display current patient status
-            if (triage->contains(patientId)) {
-                cout << "[WAITING] CURRENT STATUS: Waiting in triage queue" << endl;
-                cout << "   Priority: " << patient->getPriorityDescription() << endl;
-            } else if (consultationRooms->isPatientInConsultation(patientId)) {
-                int room = consultationRooms->findPatientRoom(patientId);
-                cout << "[ACTIVE] CURRENT STATUS: In consultation room " << room << endl;
+            if (patient->room >= 0) {
+                *console << "[ACTIVE] CURRENT STATUS: In consultation room " << patient->room + 1 << " ("
+                         << scheduler->poolName(scheduler->poolOf(patient->room)) << ")" << endl;
+            } else if (scheduler->contains(patientId)) {
+                *console << "[WAITING] CURRENT STATUS: Waiting in triage queue" << endl;
+                *console << "   Priority: " << patient->getPriorityDescription() << endl;
+                *console << "   Specialty: " << scheduler->poolName(patient->specialty) << endl;
+            } else if (patient->transferred) {
+                *console << "[MOVED] CURRENT STATUS: Transferred to another site" << endl;
             } else {
-                cout << "[DONE] CURRENT STATUS: Consultation completed" << endl;
-                cout << "   Patient is in system history" << endl;
+                *console << "[DONE] CURRENT STATUS: Consultation completed" << endl;
+                *console << "   Patient is in system history" << endl;
+            }
+
+            // Time spent in each stage, from the journey log
+            if (journey->contains(patientId)) {
+                PatientJourney stages = journey->patient(patientId);
+                const char* stageNames[] = {"intake", "triage wait", "consultation"};
+                for (int stage = 0; stage < JourneyLog::STAGES; stage++) {
+                    if (stages.stageNanos[stage] >= 0) {
+                        *console << "   Time in " << stageNames[stage] << ": "
+                                 << stages.stageNanos[stage] / 1000000000LL << " s" << endl;
+                    }
+                }
             }
             break;
         }
     }
     
     if (!found) {
-        cout << "[ERROR!] Patient ID " << patientId << " not found in system" << endl;
-        cout << "Please verify the patient ID and try again" << endl;
+        *console << "[ERROR!] Patient ID " << patientId << " not found in system" << endl;
+        *console << "Please verify the patient ID and try again" << endl;
+    }
+    return found;
+}
+
+/**
+ * SEARCH PATIENTS BY PARTIAL NAME
+ * @param prefix: Beginning of the name (case and accents are ignored)
+ * @param maxResults: Maximum number of patients returned
+ * 
+ * IMPLEMENTATION:
+ * - Radix tree lookup, O(prefix + results) regardless of database size
+ * - Results come in alphabetical order, same names by registration order
+ * 
+ * @return Matching patients (empty if none)
+ */
+vector<Patient*> HospitalSystem::searchPatientsByName(const string& prefix, int maxResults) {
+    TRACE_SCOPE("searchPatientsByName");
+    *console << "\n=== PATIENT NAME SEARCH ===" << endl;
+    *console << "Searching for names starting with: \"" << prefix << "\"" << endl;
+
+    vector<Patient*> matches;
+    if (maxResults > 0) {
+        nameIndex->prefixSearch(prefix, maxResults, matches);
     }
+    if (matches.empty()) {
+        *console << "[ERROR!] No patient names start with \"" << prefix << "\"" << endl;
+        return matches;
+    }
+    for (size_t i = 0; i < matches.size(); i++) {
+        *console << "  " << *matches[i] << endl;
+    }
+    *console << "! " << matches.size() << " PATIENT(S) FOUND";
+    if ((int)matches.size() == maxResults) {
+        *console << " (first " << maxResults << " shown, type more letters to narrow)";
+    }
+    *console << endl;
+    return matches;
+}
+
+/**
+ * SEARCH PATIENTS BY SYMPTOM TERMS
+ * @param expression: Terms joined by AND / OR ("fever AND cough OR rash");
+ *                    AND binds tighter and adjacent terms are ANDed
+ * @param maxResults: Maximum number of patients printed
+ * 
+ * IMPLEMENTATION:
+ * - Inverted index lookup; the rarest term drives every intersection,
+ *   so the cost follows the smallest matching list, not the database
+ * - IDs map back to records by position (IDs are sequential from 1)
+ * 
+ * @return Every matching patient in ID order (empty if none)
+ */
+vector<Patient*> HospitalSystem::searchPatientsBySymptom(const string& expression, int maxResults) {
+    TRACE_SCOPE("searchPatientsBySymptom");
+    *console << "\n=== PATIENT SYMPTOM SEARCH ===" << endl;
+    *console << "Query: " << expression << endl;
+
+    vector<int> ids;
+    symptomIndex->query(expression, ids);
+    vector<Patient*> matches;
+    matches.reserve(ids.size());
+    for (size_t i = 0; i < ids.size(); i++) {
+        matches.push_back((*registeredPatients)[ids[i] - 1]);
+    }
+    if (matches.empty()) {
+        *console << "[ERROR!] No patients match \"" << expression << "\"" << endl;
+        return matches;
+    }
+    for (size_t i = 0; i < matches.size() && (int)i < maxResults; i++) {
+        *console << "  " << *matches[i] << endl;
+    }
+    *console << "! " << matches.size() << " PATIENT(S) FOUND";
+    if ((int)matches.size() > maxResults) {
+        *console << " (first " << maxResults << " shown)";
+    }
+    *console << endl;
+    return matches;
 }
 
 /**
@@ -377,7 +1128,9 @@ void HospitalSystem::searchPatient(int patientId) {
  * 4. Comprehensive system status display
  * 5. Complete patient database view
  * 6. Patient search by ID across all structures
- * 7. Graceful system exit and cleanup
+ * 7. Patient search by partial name
+ * 8. Patient search by symptoms (AND / OR)
+ * 9. Graceful system exit and cleanup
  */
 void HospitalSystem::mainMenu() {
     int choice;
@@ -388,13 +1141,15 @@ void HospitalSystem::mainMenu() {
         cout << "=========================================" << endl;
         cout << "1. Register New Patient" << endl;
         cout << "2. Attend Next Patient (Triage -> Consultation)" << endl;
-        cout << "3. Free Consultation Room (Consultation -> History)" << endl;
+        cout << "3. Complete Consultation (Consultation -> History)" << endl;
         cout << "4. Display Complete System State" << endl;
         cout << "5. View Patient Database" << endl;
         cout << "6. Search Patient by ID" << endl;
-        cout << "7. Exit System" << endl;
+        cout << "7. Search Patients by Name" << endl;
+        cout << "8. Search Patients by Symptom" << endl;
+        cout << "9. Exit System" << endl;
         cout << "==========================================" << endl;
-        cout << "Select an option (1-7): ";
+        cout << "Select an option (1-9): ";
         
         cin >> choice;
         
@@ -414,14 +1169,29 @@ void HospitalSystem::mainMenu() {
                     cout << "Enter patient age: ";
                     cin >> age;
                     
-                    cout << "Enter priority (1=TRIAGE I, 2=TRIAGE II, 3=TRIAGE III, 4=TRIAGE IV, 5=TRIAGE V): ";
+                    const char* levelNames[] = {"I", "II", "III", "IV", "V"};
+                    cout << "Enter priority (";
+                    for (int level = 1; level <= config.triageLevels; level++) {
+                        cout << (level > 1 ? ", " : "") << level << "=TRIAGE " << levelNames[level - 1];
+                    }
+                    cout << "): ";
                     cin >> priority;
                     
                     cin.ignore(); // Clear newline from input buffer
                     cout << "Enter symptoms: ";
                     getline(cin, symptom);
+
+                    string specialty;
+                    if (scheduler->poolCount() > 1) {
+                        cout << "Enter specialty (";
+                        for (int pool = 0; pool < scheduler->poolCount(); pool++) {
+                            cout << (pool > 0 ? ", " : "") << scheduler->poolName(pool);
+                        }
+                        cout << "; empty = " << scheduler->poolName(0) << "): ";
+                        getline(cin, specialty);
+                    }
                     
-                    registerPatient(name, age, priority, symptom);
+                    registerPatient(name, age, priority, symptom, specialty);
                     break;
                 }
                 
@@ -429,9 +1199,17 @@ void HospitalSystem::mainMenu() {
                     attendNextPatient();
                     break;
                     
-                case 3:
-                    freeConsultationRoom();
+                case 3: {
+                    int room;
+                    cout << "Enter room number (1-" << scheduler->rooms() << ", 0 = next expected to finish): ";
+                    cin >> room;
+                    if (room == 0) {
+                        freeConsultationRoom();
+                    } else {
+                        completeConsultation(room - 1);
+                    }
                     break;
+                }
                     
                 case 4:
                     displaySystemState();
@@ -449,13 +1227,29 @@ void HospitalSystem::mainMenu() {
                     break;
                 }
                     
-                case 7:
+                case 7: {
+                    string prefix;
+                    cout << "Enter the beginning of the patient name: ";
+                    getline(cin, prefix);
+                    searchPatientsByName(prefix);
+                    break;
+                }
+
+                case 8: {
+                    string expression;
+                    cout << "Enter symptoms (e.g. fever AND cough OR rash): ";
+                    getline(cin, expression);
+                    searchPatientsBySymptom(expression);
+                    break;
+                }
+
+                case 9:
                     cout << "\nThank you for using Hospital Management System!" << endl;
                     cout << "System developed with Colombian triage standards" << endl;
                     break;
                     
                 default:
-                    cout << "\n!! Invalid option. Please select a number between 1 and 7." << endl;
+                    cout << "\n!! Invalid option. Please select a number between 1 and 9." << endl;
             }
         }
         catch (const exception& e) {
@@ -463,7 +1257,7 @@ void HospitalSystem::mainMenu() {
             cout << "Please try again with valid input." << endl;
         }
         
-    } while (choice != 7);
+    } while (choice != 9);
 }
 
 /**
@@ -480,17 +1274,35 @@ void HospitalSystem::mainMenu() {
  * - Provides user-friendly error messages
  * - Ensures proper system shutdown on critical errors
  */
-void HospitalSystem::runApplication() {
+void HospitalSystem::runApplication(const HospitalConfig& hospitalConfig) {
     cout << "[STARTING] INITIALIZING HOSPITAL MANAGEMENT SYSTEM" << endl;
-    cout << "Version: 2.0 | Colombian Triage System (5 levels)" << endl;
-    cout << "Data Structures: Array, PriorityQueue, CircularQueue, Stack" << endl;
+    cout << "Version: 2.0 | Colombian Triage System (" << hospitalConfig.triageLevels << " levels)" << endl;
+    cout << "Data Structures: Array, PriorityQueue, RoomScheduler, TimingWheel, Stack" << endl;
     
     try {
-        // Create hospital system instance with default consultation rooms
-        HospitalSystem hospital(10);
-        
-        // Run the main menu - blocking call until user exits
-        hospital.mainMenu();
+        // Create hospital system instance from the startup configuration
+        HospitalSystem hospital(hospitalConfig);
+
+        // Optional Prometheus endpoint; scrapes run on the server's thread
+        MetricsRegistry registry;
+        HospitalMetrics metrics(registry, hospitalConfig);
+        MetricsServer* metricsServer = NULL;
+        try {
+            if (!hospitalConfig.metricsListen.empty()) {
+                metricsServer = new MetricsServer(registry, hospitalConfig.metricsListen);
+                metricsServer->start();
+                hospital.attachMetrics(&metrics);
+                cout << "[DONE] Metrics at " << metricsServer->describe() << endl;
+            }
+
+            // Run the main menu - blocking call until user exits
+            hospital.mainMenu();
+        }
+        catch (...) {
+            delete metricsServer;
+            throw;
+        }
+        delete metricsServer;
     }
     catch (const exception& e) {
         // Handle any critical system initialization errors
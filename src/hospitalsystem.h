@@ -1,60 +1,202 @@
 #ifndef HOSPITALSYSTEM_H
 #define HOSPITALSYSTEM_H
 
-#include "priorityqueue.h"
-#include "circularqueue.h"
+#include "roomscheduler.h"
+#include "roomtimers.h"
 #include "stack.h"
 #include "array.h"
 #include "patient.h"
+#include "memorystats.h"
+#include "hospitalconfig.h"
+#include "nameindex.h"
+#include "symptomindex.h"
+#include "patientcensus.h"
+#include "journeylog.h"
+#include "rollingmetrics.h"
+#include "metricsregistry.h"
 #include <iostream>
 #include <string>
+#include <vector>
+
+/**
+ * OCCUPANCY COUNTERS OF THE SYSTEM
+ */
+struct SystemStatus {
+    int registered;      ///< Patients ever registered
+    int waiting;         ///< Patients in triage
+    int inConsultation;  ///< Occupied consultation rooms
+    int rooms;           ///< Consultation room capacity
+    int overdue;         ///< Occupied rooms past their expected end
+    int completed;       ///< Patients in the history stack
+};
+
+/**
+ * PATIENT IN TRIAGE WITH ITS CURRENT WAIT
+ */
+struct WaitingPatient {
+    Patient* patient;
+    long long waitNanos;  ///< Time since registration (steady clock)
+};
+
+/**
+ * MEMORY USAGE OF EVERY STRUCTURE IN THE SYSTEM
+ * - Populated only when compiled with HOSPITAL_MEMORY_STATS
+ */
+struct SystemMemoryStats {
+    MemoryStats database;  ///< registeredPatients buffer
+    MemoryStats triage;    ///< Bucket arrays and triage list nodes of every specialty
+    MemoryStats rooms;     ///< Consultation room timer nodes
+    MemoryStats history;   ///< History stack nodes
+    MemoryStats names;     ///< Name index nodes, entries and label pool
+    MemoryStats symptoms;  ///< Symptom posting lists
+    MemoryStats census;    ///< Census Fenwick grids (fixed at construction)
+    MemoryStats journey;   ///< Journey log columns and projections
+    MemoryStats rolling;   ///< Rolling metric rings (fixed at construction)
+    MemoryStats patients;  ///< Patient objects including string buffers
+
+    MemoryStats total() const {
+        MemoryStats sum;
+        sum += database;
+        sum += triage;
+        sum += rooms;
+        sum += history;
+        sum += names;
+        sum += symptoms;
+        sum += census;
+        sum += journey;
+        sum += rolling;
+        sum += patients;
+        return sum;
+    }
+};
+
+/**
+ * PROMETHEUS METRICS PUBLISHED BY THE SYSTEM
+ * - Registered once into a MetricsRegistry; after every operation the
+ *   system only stores into them (relaxed atomics), so a scrape thread
+ *   can render them at any time
+ * - triageWaiting has one gauge per configured level (NULL above it)
+ * - memoryBytes / allocations exist only when built with
+ *   HOSPITAL_MEMORY_STATS (NULL otherwise), one series per structure of
+ *   SystemMemoryStats
+ */
+struct HospitalMetrics {
+    enum Operation { OP_REGISTER, OP_ATTEND, OP_COMPLETE, OP_SEARCH, OP_TRANSFER };
+    static const int OPERATIONS = 5;
+    static const int STRUCTURES = 10;
+
+    MetricGauge* triageWaiting[HospitalConfig::MAX_TRIAGE_LEVELS];  ///< hospital_triage_waiting{level}
+    MetricGauge* roomsOccupied;                                      ///< hospital_rooms_occupied
+    MetricGauge* roomsTotal;                                         ///< hospital_rooms
+    MetricGauge* roomsOverdue;                                       ///< hospital_rooms_overdue
+    MetricGauge* historySize;                                        ///< hospital_history_size
+    MetricCounter* registered;                                       ///< hospital_patients_registered_total
+    MetricCounter* events[RollingMetrics::COUNTERS];                 ///< hospital_events_total{event}, by RollingCounter
+    MetricHistogram* latency[OPERATIONS];                            ///< hospital_operation_duration_seconds{operation}
+    MetricGauge* memoryBytes[STRUCTURES];                            ///< hospital_memory_live_bytes{structure}
+    MetricCounter* allocations[STRUCTURES];                          ///< hospital_memory_allocations_total{structure}
+
+    /**
+     * REGISTER EVERY SERIES
+     * EXCEPTION: Throws invalid_argument if the registry already holds them
+     */
+    HospitalMetrics(MetricsRegistry& registry, const HospitalConfig& config);
+};
 
 /**
  * HOSPITAL SYSTEM MAIN CLASS
  * 
  * INTEGRATES ALL DATA STRUCTURES:
  * - Array: Patient database for permanent storage
- * - PriorityQueue: Triage system with 5 priority levels
- * - CircularQueue: Consultation rooms management
+ * - RoomScheduler: Triage queues (5 priority levels) and room pools per
+ *   specialty, matched through free-room bitmaps
+ * - RoomTimers: Expected end of every active consultation (timing wheel)
  * - Stack: Patient consultation history (LIFO)
+ * - NameIndex: Radix tree for partial-name lookups at the front desk
+ * - SymptomIndex: Inverted index for boolean symptom queries
+ * - PatientCensus: Fenwick trees counting patients by status, age and triage
+ * - JourneyLog: Append-only event log of every transition, with projections
+ *   (status, stage durations, hourly throughput) updated on each append
+ * - RollingMetrics: Fixed-size rings of per-minute, per-hour and per-day
+ *   counters and occupancy, updated by every operation
+ * - HospitalMetrics (optional): atomic counters, gauges and latency
+ *   histograms scraped by Prometheus from a MetricsServer
  * 
  * PATIENT FLOW:
- * 1. Registration → Array + PriorityQueue
- * 2. Triage waiting → PriorityQueue  
- * 3. Consultation → CircularQueue
- * 4. Completion → Stack (history)
+ * 1. Registration → Array + RoomScheduler (specialty triage queue)
+ * 2. Triage waiting → RoomScheduler
+ * 3. Consultation → room of an eligible specialty + RoomTimers
+ * 4. Completion → Stack (history); a consultation past its expected end is
+ *    flagged overdue, or completed automatically (config overdue = release)
  */
 class HospitalSystem {
 private:
     // DATA STRUCTURES USING PATIENT POINTERS
     Array<Patient*>* registeredPatients;  ///< Dynamic array - all patients database
-    PriorityQueue<Patient*>* triage;      ///< Priority queue - waiting patients by urgency
-    CircularQueue<Patient*>* consultationRooms; ///< Circular queue - active consultations
+    RoomScheduler* scheduler;             ///< Specialty triage queues and room pools
+    RoomTimers* roomTimers;               ///< Timing wheel - expected end of each occupied room
     Stack<Patient*>* history;             ///< Stack - recently completed patients
+    NameIndex* nameIndex;                 ///< Radix tree - name prefix lookups
+    SymptomIndex* symptomIndex;           ///< Inverted index - symptom term lookups
+    PatientCensus* census;                ///< Fenwick trees - status x age x triage counts
+    JourneyLog* journey;                  ///< Event log - every patient transition, timestamped
+    RollingMetrics* rolling;              ///< Bucket rings - throughput and occupancy over time
+    HospitalMetrics* metrics;             ///< Exported metrics, NULL unless attached (not owned)
 
+    HospitalConfig config;         ///< Startup configuration (rooms, triage, pre-sizing)
     int nextPatientID;           ///< Auto-incrementing patient ID generator
-    int numberOfConsultationRooms; ///< Fixed number of consultation rooms
+    int numberOfConsultationRooms; ///< Fixed number of consultation rooms (all specialties)
+    std::ostream* console;         ///< Destination of operation messages (cout or silent)
+    std::vector<int> dueRooms;     ///< Scratch for rooms that just went overdue
+    MEMORY_ACCOUNT                 ///< Patient record counters (only with HOSPITAL_MEMORY_STATS)
 
     // PRIVATE METHODS - Implementation details
-    void registerPatient(std::string name, int age, int priority, std::string symptom);
-    void attendNextPatient();
-    void freeConsultationRoom();
+    void validateRegistration(const std::string& name, int age, int priority, const std::string& symptom);
+    int specialtyIndex(const std::string& specialty) const;
+    int admit(Patient* newPatient, const char* headline);
+    Patient* complete(int room, const char* headline);
+    void checkRoomTimers();
+    void recordMetrics(RollingCounter counter, long long amount, long long now);
+    void publishGauges();
+    class MetricsScope;
     void displaySystemState();
     void displayPatientDatabase();
-    void searchPatient(int patientId);
     void mainMenu();
 
 public:
+    static const int MAX_NAME_LENGTH = 256;  ///< Bytes; longer names are rejected at registration
+
     /**
      * HOSPITAL SYSTEM CONSTRUCTOR
-     * @param numRooms: Number of consultation rooms (default: 8)
+     * @param numRooms: Number of consultation rooms (default: 10)
+     * @param consoleOutput: false to run silently (replay, benchmarks)
      * 
      * MEMORY ALLOCATION:
      * - Dynamically allocates all data structures
      * - Initializes patient ID counter starting from 1
      * - Sets up Colombian triage system with 5 priority levels
      */
-    HospitalSystem(int numRooms = 10);
+    HospitalSystem(int numRooms = 10, bool consoleOutput = true);
+
+    /**
+     * HOSPITAL SYSTEM FROM A CONFIGURATION
+     * @param hospitalConfig: Rooms per specialty, triage levels and the
+     *                        pre-sizing hints every container is reserved with
+     * @param consoleOutput: false to run silently
+     * 
+     * EXCEPTION: Throws invalid_argument for an invalid configuration
+     */
+    explicit HospitalSystem(const HospitalConfig& hospitalConfig, bool consoleOutput = true);
+
+    /**
+     * CONFIGURATION THE SYSTEM WAS BUILT WITH
+     */
+    const HospitalConfig& configuration() const { return config; }
+
+    /**
+     * NAME OF A ROOM POOL (0 = first specialty configured)
+     */
+    const std::string& specialtyName(int pool) const { return scheduler->poolName(pool); }
     
     /**
      * HOSPITAL SYSTEM DESTRUCTOR
@@ -65,9 +207,157 @@ public:
      * - Called automatically when object goes out of scope
      */
     ~HospitalSystem();
+
+    /**
+     * ENGINE OPERATIONS
+     * 
+     * Used by the interactive menu and by programmatic drivers
+     * (workload replay, benchmarks). Messages go to the console stream,
+     * which is silent when constructed with consoleOutput = false.
+     * 
+     * - registerPatient: returns the new patient ID (throws on invalid input);
+     *   specialty names a configured room pool, empty for the first one
+     * - attendNextPatient: returns the patient moved to a room, or NULL;
+     *   the RoomScheduler picks the most urgent patient that has a free
+     *   room of its specialty (or of a fallback pool)
+     * - freeConsultationRoom: completes the consultation most likely to be
+     *   over (the oldest overdue room, else the first expected to end) and
+     *   frees its room; returns the patient moved to history, or NULL
+     * - completeConsultation: the consultation in room (0-based) has ended;
+     *   frees that room and returns the patient, or NULL if it was free
+     * - searchPatient: returns the patient with that ID, or NULL
+     * - searchPatientsByName: up to maxResults patients whose name starts
+     *   with the prefix (case and accents ignored), in name order
+     * - searchPatientsBySymptom: patients matching a boolean symptom query
+     *   ("fever AND cough OR rash"), in ID order; all matches are returned,
+     *   maxResults only limits how many are printed
+     */
+    int registerPatient(std::string name, int age, int priority, std::string symptom,
+                        const std::string& specialty = "");
+    Patient* attendNextPatient();
+    Patient* freeConsultationRoom();
+    Patient* completeConsultation(int room);
+    Patient* searchPatient(int patientId);
+    std::vector<Patient*> searchPatientsByName(const std::string& prefix, int maxResults = 10);
+    std::vector<Patient*> searchPatientsBySymptom(const std::string& expression, int maxResults = 20);
+
+    /**
+     * TRANSFERS BETWEEN SITES
+     * 
+     * - transferOut: removes up to maxPatients waiting patients of levels
+     *   [minPriority, maxPriority] (least urgent level first, oldest first
+     *   within a level); their records stay here marked as transferred.
+     *   O(batch) - only the eligible bucket heads are touched
+     * - admitTransferredPatient: registers a copy of another site's record
+     *   under a new local ID, keeping its arrival time; specialty is the
+     *   sending site's name for it, matched by name here (the general pool
+     *   when this site has no specialty of that name); throws like
+     *   registerPatient on invalid data
+     * - readmitTransferredPatient: takes back a patient this site transferred
+     *   out and the other site refused, as a new admission (the old record
+     *   stays marked as transferred); throws invalid_argument for an ID
+     *   that was not transferred out
+     */
+    std::vector<Patient*> transferOut(int maxPatients, int minPriority = 4, int maxPriority = 5);
+    int admitTransferredPatient(const Patient& record, const std::string& specialty);
+    int readmitTransferredPatient(int patientId);
+
+    /**
+     * CONSULTATION TIMERS
+     * 
+     * Every occupied room expects its consultation to end after the
+     * configured minutes for the patient's triage level. Operations check
+     * the timers against the steady clock themselves; an idle driver (the
+     * engine's owner thread, the server's event loop) sleeps until
+     * nextRoomDeadline and calls processRoomTimers to move time on.
+     * 
+     * - processRoomTimers: rooms whose expected end is at or before
+     *   nowNanos (steady clock) become overdue; with overdue = release
+     *   they are completed and freed instead; attached metrics gauges are
+     *   refreshed. Returns how many rooms went overdue. O(1) per second
+     *   crossed that holds a deadline
+     * - nextRoomDeadline: steady-clock nanoseconds of the first expected
+     *   end still pending, -1 when none
+     */
+    int processRoomTimers(long long nowNanos);
+    long long nextRoomDeadline() const;
+
+    /**
+     * CURRENT OCCUPANCY - O(1) snapshot of every structure's size
+     */
+    SystemStatus status();
+
+    /**
+     * RANGE COUNT REPORT - O(log) regardless of the number of patients
+     * @param state: STATUS_WAITING, STATUS_IN_CONSULTATION, STATUS_COMPLETED or
+     *        STATUS_TRANSFERRED (sent to another site)
+     * @param minAge, maxAge: Inclusive age range
+     * @param minPriority, maxPriority: Inclusive triage range (1 = TRIAGE I)
+     * @return Patients currently in that state within both ranges
+     * 
+     * EXAMPLE: countPatients(STATUS_WAITING, 65, 150, 1, 2) - patients aged
+     * 65+ waiting in TRIAGE I-II
+     */
+    int countPatients(PatientStatus state, int minAge, int maxAge, int minPriority = 1, int maxPriority = 5);
+
+    /**
+     * PATIENT JOURNEY LOG
+     * 
+     * Every transition (registered, triaged, roomed, discharged,
+     * transferred) is appended with its steady-clock time. Queries such as
+     * "how long did patient 4711 wait for a room" or "discharges per hour"
+     * are answered from the log's projections in O(1).
+     */
+    const JourneyLog& journeyLog() const { return *journey; }
+
+    /**
+     * ROLLING THROUGHPUT AND OCCUPANCY
+     * 
+     * Arrivals, attended patients, discharges, transfers and overdue rooms
+     * per minute / hour / day, and the time-weighted occupied rooms and
+     * triage depth, for the last 24 hours / 7 days / 90 days. Brought up
+     * to the current time before it is returned; queries read only the
+     * bucket rings.
+     * 
+     * EXAMPLE: rollingMetrics().counterSeries(ROLLING_ARRIVALS, ROLLING_MINUTE, 288, 5)
+     * - arrivals per 5 minutes over the last 24 hours
+     */
+    const RollingMetrics& rollingMetrics();
+
+    /**
+     * PROMETHEUS METRICS
+     * @param published: Series to update, NULL to stop publishing; must
+     *                   outlive the system or be detached first
+     * 
+     * Once attached, every operation stores its latency, the triage depth
+     * per level, room occupancy, history size, event totals and (with
+     * MEMORY_STATS) per-structure memory into the series - relaxed atomic
+     * stores only, nothing else on the hot path. Attach before the first
+     * operation: event totals count from here. Unattached, an operation
+     * pays one pointer test.
+     */
+    void attachMetrics(HospitalMetrics* published);
+
+    /**
+     * LONGEST-WAITING PATIENTS IN TRIAGE, ACROSS ALL LEVELS
+     * @param k: Maximum number of patients (charge nurse view: 20)
+     * @return Up to k waiting patients, oldest first, with their waits
+     * 
+     * EFFICIENCY: O(k log 5) per specialty - k-way merge of the FIFO bucket heads
+     */
+    std::vector<WaitingPatient> longestWaiting(int k = 20);
+
+    /**
+     * MEMORY USAGE PER STRUCTURE
+     * @return Live bytes, allocation counts and peaks of every container
+     *         and of the patient records (zero unless built with
+     *         MEMORY_STATS=1, in which case the instrumentation is free)
+     */
+    SystemMemoryStats memoryStats();
     
     /**
      * STATIC APPLICATION ENTRY POINT
+     * @param hospitalConfig: Configuration read at startup (defaults: 10 rooms)
      * 
      * DESIGN:
      * - Static method doesn't require object instance
@@ -75,7 +365,7 @@ public:
      * - Handles exceptions at application level
      * - Ensures proper cleanup through RAII
      */
-    static void runApplication();
+    static void runApplication(const HospitalConfig& hospitalConfig = HospitalConfig());
 
     // Delete copy constructor and assignment operator to prevent copying
     HospitalSystem(const HospitalSystem&) = delete;
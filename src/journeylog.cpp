@@ -0,0 +1,246 @@
+#include "journeylog.h"
+#include <stdexcept>
+#include <string>
+
+using namespace std;
+
+/**
+ * STATUS A TRANSITION MUST COME FROM (-1: the patient must be new)
+ */
+static const int REQUIRED_STATUS[JourneyLog::EVENT_TYPES] = {
+    -1,                  // REGISTERED
+    JOURNEY_REGISTERED,  // TRIAGED
+    JOURNEY_TRIAGED,     // ROOMED
+    JOURNEY_ROOMED,      // DISCHARGED
+    JOURNEY_TRIAGED      // TRANSFERRED
+};
+
+/**
+ * STAGE A TRANSITION CLOSES (-1: none)
+ */
+static const int CLOSED_STAGE[JourneyLog::EVENT_TYPES] = {
+    -1, STAGE_INTAKE, STAGE_WAITING, STAGE_CONSULTATION, -1
+};
+
+JourneyLog::JourneyLog() {
+    for (int i = 0; i < EVENT_TYPES; i++) {
+        statusCounts[i] = 0;
+    }
+}
+
+JourneyLog::~JourneyLog() {
+    MEMORY_ACCOUNT_RELEASE(times.capacity() * sizeof(long long) + patients.capacity() * sizeof(int) +
+                           types.capacity() + details.capacity() * sizeof(int) +
+                           previous.capacity() * sizeof(int) + lastEvent.capacity() * sizeof(int) +
+                           stageNanos.capacity() * sizeof(long long) + hourly.capacity() * sizeof(int));
+}
+
+/**
+ * COLUMN GROWTH - capacity for size elements, doubling like push_back;
+ * every buffer change is reported to the memory account
+ */
+template <typename T>
+void JourneyLog::ensure(vector<T>& column, size_t size) {
+    size_t capacity = column.capacity();
+    if (size > capacity) {
+        column.reserve(size > 2 * capacity ? size : 2 * capacity);
+        MEMORY_ACCOUNT_RELEASE(capacity * sizeof(T));
+        MEMORY_ACCOUNT_ALLOCATE(column.capacity() * sizeof(T));
+    }
+}
+
+template <typename T>
+void JourneyLog::grow(vector<T>& column, size_t size, const T& value) {
+    ensure(column, size);
+    column.resize(size, value);
+}
+
+void JourneyLog::reserve(int events, int patientIds) {
+    size_t capacity = times.capacity();
+    if (events > 0 && (size_t)events > capacity) {
+        MEMORY_ACCOUNT_RELEASE(times.capacity() * sizeof(long long) + patients.capacity() * sizeof(int) +
+                               types.capacity() + details.capacity() * sizeof(int) +
+                               previous.capacity() * sizeof(int));
+        times.reserve((size_t)events);
+        patients.reserve((size_t)events);
+        types.reserve((size_t)events);
+        details.reserve((size_t)events);
+        previous.reserve((size_t)events);
+        MEMORY_ACCOUNT_ALLOCATE(times.capacity() * sizeof(long long) + patients.capacity() * sizeof(int) +
+                                types.capacity() + details.capacity() * sizeof(int) +
+                                previous.capacity() * sizeof(int));
+    }
+    if (patientIds > 0 && (size_t)patientIds + 1 > lastEvent.capacity()) {
+        MEMORY_ACCOUNT_RELEASE(lastEvent.capacity() * sizeof(int) + stageNanos.capacity() * sizeof(long long));
+        lastEvent.reserve((size_t)patientIds + 1);
+        stageNanos.reserve(((size_t)patientIds + 1) * STAGES);
+        MEMORY_ACCOUNT_ALLOCATE(lastEvent.capacity() * sizeof(int) + stageNanos.capacity() * sizeof(long long));
+    }
+}
+
+/**
+ * APPEND IMPLEMENTATION
+ * - The transition is checked against the status projection before the
+ *   columns are touched, so a rejected event leaves the log unchanged
+ * - Every column and projection buffer the event needs is reserved next;
+ *   the pushes and project() then cannot allocate, so an out-of-memory
+ *   failure also leaves the log unchanged (never columns of different
+ *   lengths or projections out of step)
+ */
+void JourneyLog::append(JourneyEventType type, int patientId, int detail, long long timeNanos) {
+    if (patientId <= 0) {
+        throw invalid_argument("Journey events need a positive patient ID");
+    }
+    if ((int)type < 0 || (int)type >= EVENT_TYPES) {
+        throw invalid_argument("Unknown journey event type");
+    }
+    if (!times.empty() && timeNanos < times.back()) {
+        throw invalid_argument("Journey events must be appended in time order");
+    }
+    int latest = (size_t)patientId < lastEvent.size() ? lastEvent[(size_t)patientId] : -1;
+    int current = latest < 0 ? -1 : (int)types[(size_t)latest];
+    if (current != REQUIRED_STATUS[type]) {
+        throw logic_error(string("Patient ") + to_string(patientId) + " cannot be " + typeName(type) +
+                          (current < 0 ? " before being registered" :
+                           string(" while ") + typeName((JourneyEventType)current)));
+    }
+
+    size_t events = times.size() + 1;
+    ensure(times, events);
+    ensure(patients, events);
+    ensure(types, events);
+    ensure(details, events);
+    ensure(previous, events);
+    ensure(lastEvent, (size_t)patientId + 1);
+    ensure(stageNanos, ((size_t)patientId + 1) * STAGES);
+    size_t hour = times.empty() ? 0 : (size_t)((timeNanos - times[0]) / HOUR_NANOS);
+    ensure(hourly, (hour + 1) * EVENT_TYPES);
+
+    times.push_back(timeNanos);
+    patients.push_back(patientId);
+    types.push_back((unsigned char)type);
+    details.push_back(detail);
+    previous.push_back(latest);
+    project(times.size() - 1);
+}
+
+/**
+ * APPLY ONE EVENT TO THE PROJECTIONS - shared by append and replay
+ * - O(1): the previous event of the patient is one index away
+ */
+void JourneyLog::project(size_t index) {
+    int patientId = patients[index];
+    JourneyEventType type = (JourneyEventType)types[index];
+    long long time = times[index];
+
+    if ((size_t)patientId >= lastEvent.size()) {
+        grow(lastEvent, (size_t)patientId + 1, -1);
+        grow(stageNanos, ((size_t)patientId + 1) * STAGES, -1LL);
+    }
+    int before = previous[index];
+    if (before >= 0) {
+        statusCounts[types[(size_t)before]]--;
+        if (CLOSED_STAGE[type] >= 0) {
+            long long duration = time - times[(size_t)before];
+            stageNanos[(size_t)patientId * STAGES + (size_t)CLOSED_STAGE[type]] = duration;
+            stageHistograms[CLOSED_STAGE[type]].record((uint64_t)duration);
+        }
+    }
+    statusCounts[type]++;
+    lastEvent[(size_t)patientId] = (int)index;
+
+    size_t hour = (size_t)((time - times[0]) / HOUR_NANOS);
+    if ((hour + 1) * EVENT_TYPES > hourly.size()) {
+        grow(hourly, (hour + 1) * EVENT_TYPES, 0);
+    }
+    hourly[hour * EVENT_TYPES + (size_t)type]++;
+}
+
+void JourneyLog::rebuildProjections() {
+    for (size_t i = 0; i < lastEvent.size(); i++) {
+        lastEvent[i] = -1;
+    }
+    for (size_t i = 0; i < stageNanos.size(); i++) {
+        stageNanos[i] = -1;
+    }
+    for (size_t i = 0; i < hourly.size(); i++) {
+        hourly[i] = 0;
+    }
+    for (int i = 0; i < EVENT_TYPES; i++) {
+        statusCounts[i] = 0;
+    }
+    for (int i = 0; i < STAGES; i++) {
+        stageHistograms[i].reset();
+    }
+    for (size_t i = 0; i < times.size(); i++) {
+        project(i);
+    }
+}
+
+JourneyEvent JourneyLog::event(size_t index) const {
+    if (index >= times.size()) {
+        throw out_of_range("Journey event " + to_string(index) + " does not exist");
+    }
+    JourneyEvent result = {times[index], patients[index], (JourneyEventType)types[index], details[index]};
+    return result;
+}
+
+/**
+ * ONE PATIENT'S EVENTS - follows the previous column back from the latest
+ */
+vector<JourneyEvent> JourneyLog::journey(int patientId) const {
+    vector<JourneyEvent> result;
+    if (!contains(patientId)) {
+        return result;
+    }
+    for (int i = lastEvent[(size_t)patientId]; i >= 0; i = previous[(size_t)i]) {
+        result.push_back(event((size_t)i));
+    }
+    for (size_t i = 0, j = result.size(); i + 1 < j; i++, j--) {
+        JourneyEvent swap = result[i];
+        result[i] = result[j - 1];
+        result[j - 1] = swap;
+    }
+    return result;
+}
+
+bool JourneyLog::contains(int patientId) const {
+    return patientId > 0 && (size_t)patientId < lastEvent.size() && lastEvent[(size_t)patientId] >= 0;
+}
+
+void JourneyLog::checkPatient(int patientId) const {
+    if (!contains(patientId)) {
+        throw out_of_range("Patient " + to_string(patientId) + " has no journey events");
+    }
+}
+
+PatientJourney JourneyLog::patient(int patientId) const {
+    checkPatient(patientId);
+    size_t latest = (size_t)lastEvent[(size_t)patientId];
+    PatientJourney result;
+    result.patientId = patientId;
+    result.status = (JourneyEventType)types[latest];
+    result.since = times[latest];
+    for (int stage = 0; stage < STAGES; stage++) {
+        result.stageNanos[stage] = stageNanos[(size_t)patientId * STAGES + (size_t)stage];
+    }
+    return result;
+}
+
+int JourneyLog::throughput(int hour, JourneyEventType type) const {
+    if (hour < 0 || hour >= hours()) {
+        return 0;
+    }
+    return hourly[(size_t)hour * EVENT_TYPES + (size_t)type];
+}
+
+const char* JourneyLog::typeName(JourneyEventType type) {
+    switch (type) {
+        case JOURNEY_REGISTERED: return "registered";
+        case JOURNEY_TRIAGED: return "triaged";
+        case JOURNEY_ROOMED: return "roomed";
+        case JOURNEY_DISCHARGED: return "discharged";
+        case JOURNEY_TRANSFERRED: return "transferred";
+    }
+    return "unknown";
+}
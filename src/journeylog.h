@@ -0,0 +1,164 @@
+#ifndef JOURNEYLOG_H
+#define JOURNEYLOG_H
+
+#include "histogram.h"
+#include "memorystats.h"
+#include <vector>
+
+/**
+ * TRANSITIONS OF A PATIENT JOURNEY
+ * - REGISTERED: entered at the front desk (detail: specialty pool)
+ * - TRIAGED: placed in a triage queue (detail: triage level)
+ * - ROOMED: moved to a consultation room (detail: room, 0-based)
+ * - DISCHARGED: consultation over (detail: room, 0-based)
+ * - TRANSFERRED: sent from triage to another site (detail: 0)
+ */
+enum JourneyEventType {
+    JOURNEY_REGISTERED,
+    JOURNEY_TRIAGED,
+    JOURNEY_ROOMED,
+    JOURNEY_DISCHARGED,
+    JOURNEY_TRANSFERRED
+};
+
+/**
+ * STAGES TIMED BETWEEN TWO TRANSITIONS
+ * - INTAKE: registered -> triaged
+ * - WAITING: triaged -> roomed
+ * - CONSULTATION: roomed -> discharged
+ */
+enum JourneyStage { STAGE_INTAKE, STAGE_WAITING, STAGE_CONSULTATION };
+
+/**
+ * ONE EVENT READ BACK FROM THE LOG
+ */
+struct JourneyEvent {
+    long long time;          ///< Steady-clock nanoseconds
+    int patientId;
+    JourneyEventType type;
+    int detail;              ///< Meaning depends on the type (see JourneyEventType)
+};
+
+/**
+ * CURRENT PROJECTION OF ONE PATIENT
+ */
+struct PatientJourney {
+    int patientId;
+    JourneyEventType status;           ///< Latest transition
+    long long since;                   ///< Time of that transition
+    long long stageNanos[3];           ///< Duration of each JourneyStage, -1 if not (yet) completed
+};
+
+/**
+ * EVENT-SOURCED LOG OF PATIENT JOURNEYS
+ *
+ * STORAGE (append-only, one column per field):
+ * - times, patients, types, details: the events in append order
+ * - previous: index of the same patient's previous event (-1 for the
+ *   first), so one patient's journey is read without scanning the log
+ *
+ * PROJECTIONS (derived only from the events, updated by every append):
+ * - Current status and stage durations per patient (indexed by ID)
+ * - Number of patients per current status
+ * - Histogram of every stage's durations
+ * - Events of each type per hour since the first event
+ * rebuildProjections() throws them away and replays the columns, which
+ * must give exactly the same answers.
+ *
+ * A transition is accepted only from the status that precedes it
+ * (registered -> triaged -> roomed -> discharged, triaged -> transferred),
+ * so the time since the patient's previous event is the stage duration.
+ *
+ * PERFORMANCE CHARACTERISTICS:
+ * - append: O(1) amortized - five column pushes and the projection updates
+ * - patient / count / throughput: O(1); stage percentiles: O(buckets)
+ * - journey(id): O(events of that patient)
+ * - rebuildProjections: O(events)
+ * - Memory: 21 bytes per event, 36 per patient, 20 per hour elapsed
+ */
+class JourneyLog {
+public:
+    static const int EVENT_TYPES = 5;
+    static const int STAGES = 3;
+    static const long long HOUR_NANOS = 3600LL * 1000000000LL;
+
+private:
+    // COLUMNS
+    std::vector<long long> times;
+    std::vector<int> patients;
+    std::vector<unsigned char> types;
+    std::vector<int> details;
+    std::vector<int> previous;
+
+    // PROJECTIONS
+    std::vector<int> lastEvent;           ///< Per patient ID: index of the latest event, -1 if none
+    std::vector<long long> stageNanos;    ///< STAGES per patient ID, -1 until completed
+    int statusCounts[EVENT_TYPES];
+    Histogram stageHistograms[STAGES];
+    std::vector<int> hourly;              ///< EVENT_TYPES per hour since the first event
+    MEMORY_ACCOUNT
+
+    template <typename T>
+    void ensure(std::vector<T>& column, size_t size);
+    template <typename T>
+    void grow(std::vector<T>& column, size_t size, const T& value);
+    void project(size_t index);
+    void checkPatient(int patientId) const;
+
+public:
+    JourneyLog();
+    ~JourneyLog();
+
+    /**
+     * PRE-SIZE THE COLUMNS AND THE PER-PATIENT PROJECTIONS
+     */
+    void reserve(int events, int patientIds);
+
+    /**
+     * RECORD A TRANSITION AND UPDATE EVERY PROJECTION
+     * @param timeNanos: Steady-clock time, never earlier than the last event
+     * EXCEPTION: Throws invalid_argument for a non-positive ID or a time
+     *            going backwards, logic_error for a transition not allowed
+     *            from the patient's current status
+     */
+    void append(JourneyEventType type, int patientId, int detail, long long timeNanos);
+
+    /**
+     * THE LOG ITSELF
+     */
+    size_t size() const { return times.size(); }
+    JourneyEvent event(size_t index) const;
+    std::vector<JourneyEvent> journey(int patientId) const;  ///< Oldest first, empty if unknown
+
+    /**
+     * PROJECTION QUERIES
+     * - patient: throws out_of_range for an ID without events
+     * - count: patients whose latest transition is that type
+     * - stageDurations: nanoseconds of every completed stage of that kind
+     * - throughput: events of that type during hour (0 = hour of the first event)
+     */
+    bool contains(int patientId) const;
+    PatientJourney patient(int patientId) const;
+    int count(JourneyEventType status) const { return statusCounts[status]; }
+    const Histogram& stageDurations(JourneyStage stage) const { return stageHistograms[stage]; }
+    int hours() const { return (int)(hourly.size() / EVENT_TYPES); }
+    int throughput(int hour, JourneyEventType type) const;
+    long long origin() const { return times.empty() ? 0 : times[0]; }
+
+    /**
+     * DISCARD AND REPLAY - rebuilds every projection from the columns
+     */
+    void rebuildProjections();
+
+    /**
+     * ALLOCATION STATISTICS (zero unless built with HOSPITAL_MEMORY_STATS)
+     */
+    MemoryStats memoryStats() const { return MEMORY_ACCOUNT_SNAPSHOT(); }
+
+    static const char* typeName(JourneyEventType type);
+
+    JourneyLog(const JourneyLog&) = delete;
+    JourneyLog& operator=(const JourneyLog&) = delete;
+};
+
+#endif
@@ -4,6 +4,7 @@
 #include <iostream>
 #include <cstdio>
 #include <functional>
+#include "memorystats.h"
 
 /**
  * NODE TEMPLATE CLASS
@@ -52,6 +53,41 @@ protected:
     Node<T>* head;    ///< Pointer to the first node in the list
     Node<T>* last;    ///< Pointer to the last node in the list  
     int length;       ///< Current number of elements in the list
+    Node<T>* spare;   ///< Free nodes kept for reuse (linked through next)
+    int spareCount;   ///< Nodes in the spare list
+    int spareLimit;   ///< Most nodes kept for reuse (set by reserve, 0 = none)
+    MEMORY_ACCOUNT    ///< Node allocation counters (only with HOSPITAL_MEMORY_STATS)
+
+    /**
+     * NODE ALLOCATION HOOKS
+     * - Every node of the list (and of derived Stack) goes through these,
+     *   so allocation accounting sees all node memory
+     * - Spare nodes are reused before allocating; released nodes go back to
+     *   the spare list while it holds fewer than spareLimit nodes
+     */
+    Node<T>* createNode(T data) {
+        if (spare != NULL) {
+            Node<T>* node = spare;
+            spare = spare->next;
+            spareCount--;
+            node->data = data;
+            node->next = NULL;
+            return node;
+        }
+        MEMORY_ACCOUNT_ALLOCATE(sizeof(Node<T>));
+        return new Node<T>(data);
+    }
+
+    void destroyNode(Node<T>* node) {
+        if (spareCount < spareLimit) {
+            node->next = spare;
+            spare = node;
+            spareCount++;
+            return;
+        }
+        MEMORY_ACCOUNT_RELEASE(sizeof(Node<T>));
+        delete node;
+    }
 
 public:
     /**
@@ -66,6 +102,9 @@ public:
         head = NULL;
         last = NULL;
         length = 0;
+        spare = NULL;
+        spareCount = 0;
+        spareLimit = 0;
     }
 
     /**
@@ -74,10 +113,39 @@ public:
      * CRITICAL FOR POLYMORPHISM:
      * - Ensures proper cleanup of derived classes
      * - Automatically calls clear() to free all nodes
+     * - Frees the reserved spare nodes as well
      * - Prevents memory leaks in inheritance hierarchies
      */
     virtual ~List() {
         clear();
+        while (spare != NULL) {
+            Node<T>* temp = spare;
+            spare = spare->next;
+            MEMORY_ACCOUNT_RELEASE(sizeof(Node<T>));
+            delete temp;
+        }
+    }
+
+    /**
+     * PRE-ALLOCATE NODES FOR n ELEMENTS
+     * @param n: Elements the list should hold without allocating
+     * 
+     * BEHAVIOR:
+     * - Allocates spare nodes up front until length + spares reach n
+     * - Released nodes are kept (up to n spares) instead of freed, so a
+     *   list that stays within n elements never allocates again
+     * 
+     * EXCEPTION HANDLING: bad_alloc leaves the nodes allocated so far as spares
+     */
+    void reserve(int n) {
+        spareLimit = n > 0 ? n : 0;
+        while (length + spareCount < spareLimit) {
+            MEMORY_ACCOUNT_ALLOCATE(sizeof(Node<T>));
+            Node<T>* node = new Node<T>(T());
+            node->next = spare;
+            spare = node;
+            spareCount++;
+        }
     }
 
     /**
@@ -93,7 +161,7 @@ public:
         while (!isEmpty()) {
             Node<T>* temp = head;  // Store current head
             head = head->next;     // Advance head to next node
-            delete temp;           // Free current node memory
+            destroyNode(temp);     // Free current node memory
         }
         head = last = NULL;  // Reset pointers to safe state
         length = 0;          // Reset element count
@@ -116,17 +184,49 @@ public:
     virtual void add(T data) {
         if (isEmpty()) {
             // First element in list - initialize both head and last
-            head = new Node<T>(data);
+            head = createNode(data);
             last = head;
         } else {
             // Append to end of list - maintain FIFO order
-            Node<T>* temp = new Node<T>(data);
+            Node<T>* temp = createNode(data);
             last->next = temp;  // Current last points to new node
             last = temp;        // New node becomes the last
         }
         length++;  // Increment element count
     }
 
+    /**
+     * INSERT KEEPING THE LIST ORDERED
+     * @param data: Element to insert
+     * @param before: before(a, b) is true when a belongs ahead of b
+     * 
+     * BEHAVIOR: data goes ahead of the first element it belongs before, so
+     * equal elements keep FIFO order; the last element is checked first
+     * 
+     * TIME COMPLEXITY: O(1) when data belongs at the end, otherwise
+     * O(position)
+     */
+    template <typename Before>
+    void insertOrdered(T data, Before before) {
+        if (isEmpty() || !before(data, last->data)) {
+            add(data);
+            return;
+        }
+        Node<T>* node = createNode(data);
+        if (before(data, head->data)) {
+            node->next = head;
+            head = node;
+        } else {
+            Node<T>* current = head;
+            while (!before(data, current->next->data)) {
+                current = current->next;
+            }
+            node->next = current->next;
+            current->next = node;
+        }
+        length++;
+    }
+
     /**
      * CHECK IF LIST IS EMPTY
      * @return true if list contains no elements, false otherwise
@@ -147,6 +247,15 @@ public:
         return length;
     }
 
+    /**
+     * NODE ALLOCATION STATISTICS
+     * @return Live bytes, allocation counts and peak usage of the nodes
+     *         (all zero unless compiled with HOSPITAL_MEMORY_STATS)
+     */
+    MemoryStats memoryStats() {
+        return MEMORY_ACCOUNT_SNAPSHOT();
+    }
+
     /**
      * PEEK AT FIRST ELEMENT WITHOUT REMOVAL
      * @return Data from the first node in the list
@@ -164,6 +273,16 @@ public:
         throw std::runtime_error("List is empty - cannot peek");
     }
 
+    /**
+     * FIRST NODE - Read-only cursor for walking the list in order
+     * @return Head node (follow ->next), NULL if the list is empty
+     * 
+     * USAGE: Ordered scans that must not copy or modify the list
+     */
+    const Node<T>* first() const {
+        return head;
+    }
+
     /**
      * CHECK IF ANY ELEMENT SATISFIES CONDITION
      * @param condition: Lambda function that takes T and returns bool
@@ -202,7 +321,7 @@ public:
             T data = head->data;       // Retrieve data before deletion
             head = head->next;         // Advance head to next node
             
-            delete temp;               // Free the old head node
+            destroyNode(temp);         // Free the old head node
             
             // Update last pointer if list becomes empty
             if (isEmpty()) {
@@ -390,11 +509,11 @@ public:
             is >> data;
             if (isEmpty()) {
                 // Create first node
-                head = new Node<T>(data);
+                head = createNode(data);
                 last = head;
             } else {
                 // Append to end of list
-                last->next = new Node<T>(data);
+                last->next = createNode(data);
                 last = last->next;
             }
             length++;
@@ -1,4 +1,12 @@
 #include "hospitalsystem.h"
+#include "simulation.h"
+#include "replication.h"
+#include "workload.h"
+#include "hospitalserver.h"
+#include "trace.h"
+#include <cstdlib>
+#include <iostream>
+#include <string>
 
 /**
  * MAIN FUNCTION - APPLICATION ENTRY POINT
@@ -8,6 +16,21 @@
  * - Maintainability: Easy to understand and modify
  * - Exception Safety: All exceptions handled by HospitalSystem
  * 
+ * EXECUTION MODES:
+ * - (no arguments): Interactive console application
+ * - --rooms N: Interactive console application with N consultation rooms
+ * - --config FILE: Interactive console application configured from FILE
+ *   (rooms per specialty, triage levels, pre-sizing; see hospitalconfig.h)
+ * - --simulate [options]: Discrete-event emergency department simulation
+ * - --replicate [options]: Parallel Monte Carlo capacity planning sweep
+ * - --generate-workload FILE [options]: Seeded synthetic operation trace
+ * - --replay FILE [options]: Push a trace through HospitalSystem
+ * - --serve [--listen tcp:HOST:PORT | unix:PATH] [--rooms N | --config FILE] [--metrics HOST:PORT]:
+ *   Network server, optionally with a Prometheus /metrics endpoint
+ * 
+ * TRACING: Builds with -DHOSPITAL_TRACING write a Chrome trace on exit to
+ * $HOSPITAL_TRACE_FILE (default hospital_trace.json)
+ * 
  * RETURN CODES:
  * - 0: Normal successful execution
  * - 1: Unexpected error occurred (handled by exception mechanism)
@@ -16,11 +39,54 @@
  * - All memory management handled by HospitalSystem class
  * - RAII ensures proper cleanup on normal and exceptional paths
  */
-int main() {
+static int runMode(int argc, char* argv[]) {
+    // Simulation mode: remaining arguments configure the simulator
+    if (argc > 1 && std::string(argv[1]) == "--simulate") {
+        return EmergencySimulation::runFromCommandLine(argc - 2, argv + 2);
+    }
+    if (argc > 1 && std::string(argv[1]) == "--replicate") {
+        return ReplicationRunner::runFromCommandLine(argc - 2, argv + 2);
+    }
+    if (argc > 1 && std::string(argv[1]) == "--generate-workload") {
+        return WorkloadGenerator::runFromCommandLine(argc - 2, argv + 2);
+    }
+    if (argc > 1 && std::string(argv[1]) == "--replay") {
+        return WorkloadReplayer::runFromCommandLine(argc - 2, argv + 2);
+    }
+    if (argc > 1 && std::string(argv[1]) == "--serve") {
+        return HospitalServer::runFromCommandLine(argc - 2, argv + 2);
+    }
+
+    // The configuration is read once here; containers are sized from it
+    HospitalConfig config;
+    try {
+        if (argc > 2 && std::string(argv[1]) == "--rooms") {
+            config = HospitalConfig::withRooms(std::atoi(argv[2]));
+        } else if (argc > 2 && std::string(argv[1]) == "--config") {
+            config = HospitalConfig::load(argv[2]);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Configuration error: " << e.what() << std::endl;
+        return 1;
+    }
+
     // Delegate all application functionality to HospitalSystem class
     // This follows the facade pattern and keeps main() simple
-    HospitalSystem::runApplication();
+    HospitalSystem::runApplication(config);
     
     // Return success code - program executed successfully
     return 0;
 }
+
+int main(int argc, char* argv[]) {
+    int code = runMode(argc, argv);
+
+    // Tracing builds (make TRACING=1) dump the hot-path trace on exit
+    if (TRACING_ENABLED) {
+        const char* path = std::getenv("HOSPITAL_TRACE_FILE");
+        std::string tracePath = path != NULL ? path : "hospital_trace.json";
+        long long events = Tracer::exportChromeTrace(tracePath);
+        std::cout << "[TRACE] " << events << " events written to " << tracePath << std::endl;
+    }
+    return code;
+}
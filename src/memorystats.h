@@ -0,0 +1,94 @@
+#ifndef MEMORYSTATS_H
+#define MEMORYSTATS_H
+
+#include <cstddef>
+
+/**
+ * MEMORY STATISTICS SNAPSHOT
+ *
+ * - liveBytes: bytes currently allocated by the owner
+ * - allocations / deallocations: number of allocation events
+ * - peakBytes: highest liveBytes ever observed
+ */
+struct MemoryStats {
+    long long liveBytes;
+    long long allocations;
+    long long deallocations;
+    long long peakBytes;
+
+    MemoryStats() : liveBytes(0), allocations(0), deallocations(0), peakBytes(0) {}
+
+    /**
+     * COMBINE TWO SNAPSHOTS
+     * - Peaks are summed, which gives an upper bound of the combined peak
+     */
+    MemoryStats& operator+=(const MemoryStats& other) {
+        liveBytes += other.liveBytes;
+        allocations += other.allocations;
+        deallocations += other.deallocations;
+        peakBytes += other.peakBytes;
+        return *this;
+    }
+};
+
+/**
+ * OPT-IN ALLOCATION ACCOUNTING
+ *
+ * ENABLING: Compile with -DHOSPITAL_MEMORY_STATS (make MEMORY_STATS=1)
+ *
+ * USAGE INSIDE A CONTAINER:
+ *   MEMORY_ACCOUNT                          // declares the per-instance counter
+ *   MEMORY_ACCOUNT_ALLOCATE(sizeof(Node));  // next to every new
+ *   MEMORY_ACCOUNT_RELEASE(sizeof(Node));   // next to every delete
+ *   return MEMORY_ACCOUNT_SNAPSHOT();       // public memoryStats() accessor
+ *
+ * ZERO OVERHEAD WHEN DISABLED:
+ * - The member is not declared, so containers keep their original size
+ * - The hooks expand to nothing and the snapshot to an empty MemoryStats
+ */
+#ifdef HOSPITAL_MEMORY_STATS
+
+/**
+ * PER-CONTAINER ALLOCATION COUNTER
+ * - Plain counters: each container is owned by a single thread
+ */
+class MemoryAccount {
+private:
+    MemoryStats stats;
+
+public:
+    void allocate(std::size_t bytes) {
+        stats.liveBytes += (long long)bytes;
+        stats.allocations++;
+        if (stats.liveBytes > stats.peakBytes) {
+            stats.peakBytes = stats.liveBytes;
+        }
+    }
+
+    void release(std::size_t bytes) {
+        stats.liveBytes -= (long long)bytes;
+        stats.deallocations++;
+    }
+
+    MemoryStats snapshot() const {
+        return stats;
+    }
+};
+
+#define MEMORY_STATS_ENABLED 1
+#define MEMORY_ACCOUNT MemoryAccount memoryAccount;
+#define MEMORY_ACCOUNT_ALLOCATE(bytes) memoryAccount.allocate(bytes)
+#define MEMORY_ACCOUNT_RELEASE(bytes) memoryAccount.release(bytes)
+#define MEMORY_ACCOUNT_SNAPSHOT() memoryAccount.snapshot()
+
+#else
+
+#define MEMORY_STATS_ENABLED 0
+#define MEMORY_ACCOUNT
+#define MEMORY_ACCOUNT_ALLOCATE(bytes) ((void)0)
+#define MEMORY_ACCOUNT_RELEASE(bytes) ((void)0)
+#define MEMORY_ACCOUNT_SNAPSHOT() MemoryStats()
+
+#endif
+
+#endif
@@ -0,0 +1,186 @@
+#include "metricsregistry.h"
+#include <cstdio>
+#include <stdexcept>
+
+using namespace std;
+
+const uint64_t MetricHistogram::BOUND_NANOS[MetricHistogram::BOUNDS] = {
+    250, 500,
+    1000, 2500, 5000, 10000, 25000, 50000, 100000, 250000, 500000,
+    1000000, 2500000, 5000000, 10000000, 25000000, 50000000, 100000000
+};
+
+MetricHistogram::MetricHistogram() : sumNanos(0) {
+    for (int i = 0; i <= BOUNDS; i++) {
+        buckets[i].store(0, memory_order_relaxed);
+    }
+}
+
+uint64_t MetricHistogram::count() const {
+    uint64_t total = 0;
+    for (int i = 0; i <= BOUNDS; i++) {
+        total += bucket(i);
+    }
+    return total;
+}
+
+MetricsRegistry::~MetricsRegistry() {
+    for (size_t f = 0; f < families.size(); f++) {
+        for (size_t s = 0; s < families[f].series.size(); s++) {
+            void* metric = families[f].series[s].metric;
+            switch (families[f].type) {
+                case TYPE_COUNTER: delete (MetricCounter*)metric; break;
+                case TYPE_GAUGE: delete (MetricGauge*)metric; break;
+                case TYPE_HISTOGRAM: delete (MetricHistogram*)metric; break;
+            }
+        }
+    }
+}
+
+/**
+ * METRIC NAME RULE OF THE TEXT FORMAT: [a-zA-Z_:][a-zA-Z0-9_:]*
+ */
+static bool validName(const string& name) {
+    if (name.empty() || (name[0] >= '0' && name[0] <= '9')) {
+        return false;
+    }
+    for (size_t i = 0; i < name.size(); i++) {
+        char c = name[i];
+        if (!((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == ':')) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * ADD IMPLEMENTATION
+ * - Families are few (tens), so a linear search at registration is enough
+ */
+void* MetricsRegistry::add(const string& name, const string& help, MetricType type, const string& labels) {
+    if (!validName(name)) {
+        throw invalid_argument("Invalid metric name: " + name);
+    }
+    lock_guard<mutex> lock(registryMutex);
+    Family* family = NULL;
+    for (size_t f = 0; f < families.size(); f++) {
+        if (families[f].name == name) {
+            family = &families[f];
+        }
+    }
+    if (family == NULL) {
+        Family created;
+        created.name = name;
+        created.help = help;
+        created.type = type;
+        families.push_back(created);
+        family = &families.back();
+    } else if (family->type != type) {
+        throw invalid_argument("Metric " + name + " is already registered with another type");
+    }
+    for (size_t s = 0; s < family->series.size(); s++) {
+        if (family->series[s].labels == labels) {
+            throw invalid_argument("Metric " + name + "{" + labels + "} is already registered");
+        }
+    }
+
+    Series series;
+    series.labels = labels;
+    switch (type) {
+        case TYPE_COUNTER: series.metric = new MetricCounter(); break;
+        case TYPE_GAUGE: series.metric = new MetricGauge(); break;
+        default: series.metric = new MetricHistogram(); break;
+    }
+    family->series.push_back(series);
+    return series.metric;
+}
+
+MetricCounter& MetricsRegistry::counter(const string& name, const string& help, const string& labels) {
+    return *(MetricCounter*)add(name, help, TYPE_COUNTER, labels);
+}
+
+MetricGauge& MetricsRegistry::gauge(const string& name, const string& help, const string& labels) {
+    return *(MetricGauge*)add(name, help, TYPE_GAUGE, labels);
+}
+
+MetricHistogram& MetricsRegistry::histogram(const string& name, const string& help, const string& labels) {
+    return *(MetricHistogram*)add(name, help, TYPE_HISTOGRAM, labels);
+}
+
+string MetricsRegistry::label(const string& name, const string& value) {
+    if (!validName(name) || name.find(':') != string::npos) {
+        throw invalid_argument("Invalid label name: " + name);
+    }
+    string pair = name + "=\"";
+    for (size_t i = 0; i < value.size(); i++) {
+        if (value[i] == '\\') pair += "\\\\";
+        else if (value[i] == '"') pair += "\\\"";
+        else if (value[i] == '\n') pair += "\\n";
+        else pair += value[i];
+    }
+    return pair + "\"";
+}
+
+/**
+ * SAMPLE LINE: name{labels,extra} value
+ */
+static void sample(string& out, const string& name, const string& labels, const string& extra, const string& value) {
+    out += name;
+    if (!labels.empty() || !extra.empty()) {
+        out += '{';
+        out += labels;
+        if (!labels.empty() && !extra.empty()) {
+            out += ',';
+        }
+        out += extra;
+        out += '}';
+    }
+    out += ' ';
+    out += value;
+    out += '\n';
+}
+
+static string seconds(uint64_t nanos) {
+    char text[32];
+    snprintf(text, sizeof(text), "%.9g", (double)nanos / 1e9);
+    return text;
+}
+
+/**
+ * RENDER IMPLEMENTATION
+ * - Each value is loaded once; a histogram's buckets are summed as they
+ *   are written, so its +Inf bucket and _count are the same number
+ */
+void MetricsRegistry::render(string& out) const {
+    static const char* TYPE_NAMES[] = {"counter", "gauge", "histogram"};
+    lock_guard<mutex> lock(registryMutex);
+    for (size_t f = 0; f < families.size(); f++) {
+        const Family& family = families[f];
+        out += "# HELP " + family.name + " " + family.help + "\n";
+        out += "# TYPE " + family.name + " " + TYPE_NAMES[family.type] + "\n";
+        for (size_t s = 0; s < family.series.size(); s++) {
+            const Series& series = family.series[s];
+            if (family.type == TYPE_COUNTER) {
+                sample(out, family.name, series.labels, "", to_string(((MetricCounter*)series.metric)->value()));
+            } else if (family.type == TYPE_GAUGE) {
+                sample(out, family.name, series.labels, "", to_string(((MetricGauge*)series.metric)->value()));
+            } else {
+                const MetricHistogram* histogram = (const MetricHistogram*)series.metric;
+                uint64_t cumulative = 0;
+                for (int i = 0; i <= MetricHistogram::BOUNDS; i++) {
+                    cumulative += histogram->bucket(i);
+                    string bound = i < MetricHistogram::BOUNDS ? seconds(MetricHistogram::BOUND_NANOS[i]) : "+Inf";
+                    sample(out, family.name + "_bucket", series.labels, "le=\"" + bound + "\"", to_string(cumulative));
+                }
+                sample(out, family.name + "_sum", series.labels, "", seconds(histogram->sum()));
+                sample(out, family.name + "_count", series.labels, "", to_string(cumulative));
+            }
+        }
+    }
+}
+
+string MetricsRegistry::render() const {
+    string out;
+    render(out);
+    return out;
+}
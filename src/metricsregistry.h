@@ -0,0 +1,170 @@
+#ifndef METRICSREGISTRY_H
+#define METRICSREGISTRY_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * SINGLE-WRITER RULE
+ * - Every series is updated by one thread only, the owner of the data it
+ *   mirrors (same rule as HospitalEngine and HospitalServer), so updates
+ *   are a relaxed load and a relaxed store: no locked instruction, no
+ *   fence, nothing the scraper can make the writer wait for
+ * - Any number of threads may read (render) at the same time
+ */
+
+/**
+ * MONOTONIC COUNTER
+ * - set: mirrors a total kept elsewhere (patients, allocation counts)
+ */
+class MetricCounter {
+private:
+    std::atomic<std::uint64_t> total;
+
+public:
+    MetricCounter() : total(0) {}
+
+    void add(std::uint64_t amount = 1) {
+        total.store(total.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+    void set(std::uint64_t value) { total.store(value, std::memory_order_relaxed); }
+    std::uint64_t value() const { return total.load(std::memory_order_relaxed); }
+};
+
+/**
+ * VALUE THAT GOES UP AND DOWN (queue depth, occupied rooms, live bytes)
+ */
+class MetricGauge {
+private:
+    std::atomic<std::int64_t> current;
+
+public:
+    MetricGauge() : current(0) {}
+
+    void set(std::int64_t value) { current.store(value, std::memory_order_relaxed); }
+    void add(std::int64_t amount) {
+        current.store(current.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+    std::int64_t value() const { return current.load(std::memory_order_relaxed); }
+};
+
+/**
+ * LATENCY HISTOGRAM WITH FIXED BUCKETS
+ *
+ * IMPLEMENTATION:
+ * - BOUNDS cover 250 ns to 100 ms in 1-2.5-5 steps, plus +Inf; an
+ *   operation of this system lands in the first few buckets, a slow disk
+ *   or console write in the last ones
+ * - observe: one relaxed increment of the bucket and one of the sum; the
+ *   count exposed is the sum of the buckets, so the +Inf bucket always
+ *   equals _count even while a scrape races an update (a scrape may see
+ *   the bucket without the sum, never a torn value)
+ * - Buckets are stored per interval and made cumulative when rendered
+ */
+class MetricHistogram {
+public:
+    static const int BOUNDS = 18;
+    static const std::uint64_t BOUND_NANOS[BOUNDS];
+
+private:
+    std::atomic<std::uint64_t> buckets[BOUNDS + 1];  ///< Last one: above every bound
+    std::atomic<std::uint64_t> sumNanos;
+
+public:
+    MetricHistogram();
+
+    void observe(std::uint64_t nanos) {
+        int bucket = 0;
+        while (bucket < BOUNDS && nanos > BOUND_NANOS[bucket]) {
+            bucket++;
+        }
+        buckets[bucket].store(buckets[bucket].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        sumNanos.store(sumNanos.load(std::memory_order_relaxed) + nanos, std::memory_order_relaxed);
+    }
+
+    /**
+     * OBSERVATIONS IN BUCKET i (not cumulative), i = BOUNDS for +Inf
+     */
+    std::uint64_t bucket(int i) const { return buckets[i].load(std::memory_order_relaxed); }
+    std::uint64_t sum() const { return sumNanos.load(std::memory_order_relaxed); }
+    std::uint64_t count() const;
+};
+
+/**
+ * METRICS REGISTRY - PROMETHEUS TEXT EXPOSITION
+ *
+ * USAGE:
+ *   MetricsRegistry registry;
+ *   MetricGauge& depth = registry.gauge("hospital_triage_waiting", "Patients waiting",
+ *                                       MetricsRegistry::label("level", "1"));
+ *   depth.set(12);                     // hot path: one relaxed store
+ *   std::string page = registry.render();
+ *
+ * THREADING:
+ * - Registration and render take a mutex; they happen at startup and
+ *   once per scrape
+ * - Updates go straight to the metric's atomics and never touch the
+ *   registry, so the owner thread of the data never waits on a scrape;
+ *   each series has a single writer (see above)
+ * - Metrics live as long as the registry and never move
+ *
+ * OUTPUT: version 0.0.4 of the text format - one HELP / TYPE header per
+ * family, series in registration order, histograms as cumulative
+ * _bucket{le="..."} lines in seconds followed by _sum and _count
+ */
+class MetricsRegistry {
+private:
+    enum MetricType { TYPE_COUNTER, TYPE_GAUGE, TYPE_HISTOGRAM };
+
+    struct Series {
+        std::string labels;  ///< Rendered label pairs without braces, may be empty
+        void* metric;
+    };
+
+    struct Family {
+        std::string name;
+        std::string help;
+        MetricType type;
+        std::vector<Series> series;
+    };
+
+    mutable std::mutex registryMutex;
+    std::vector<Family> families;
+
+    void* add(const std::string& name, const std::string& help, MetricType type, const std::string& labels);
+
+public:
+    MetricsRegistry() {}
+    ~MetricsRegistry();
+
+    /**
+     * REGISTER A SERIES
+     * - Series of one family share its name; the first registration sets
+     *   the help text
+     * @param labels: Output of label(), joined with ',' for several pairs
+     * EXCEPTION: Throws invalid_argument for an invalid name, a name
+     *            already used by another type, or a duplicate series
+     */
+    MetricCounter& counter(const std::string& name, const std::string& help, const std::string& labels = "");
+    MetricGauge& gauge(const std::string& name, const std::string& help, const std::string& labels = "");
+    MetricHistogram& histogram(const std::string& name, const std::string& help, const std::string& labels = "");
+
+    /**
+     * ONE LABEL PAIR, VALUE ESCAPED: label("level", "1") -> level="1"
+     */
+    static std::string label(const std::string& name, const std::string& value);
+
+    /**
+     * APPEND THE EXPOSITION OF EVERY SERIES TO out
+     */
+    void render(std::string& out) const;
+    std::string render() const;
+
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+};
+
+#endif
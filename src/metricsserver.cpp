@@ -0,0 +1,315 @@
+#include "metricsserver.h"
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+#ifdef __linux__
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+/**
+ * "HOST:PORT" AS A TCP ENDPOINT
+ */
+static protocol::Endpoint metricsEndpoint(const string& address) {
+    if (address.compare(0, 5, "unix:") == 0) {
+        throw invalid_argument("Metrics address must be HOST:PORT, got " + address);
+    }
+    try {
+        return protocol::Endpoint::parse("tcp:" + address);
+    } catch (const invalid_argument&) {
+        throw invalid_argument("Metrics address must be HOST:PORT, got " + address);
+    }
+}
+
+#ifdef __linux__
+
+static runtime_error socketError(const string& what) {
+    return runtime_error(what + ": " + strerror(errno));
+}
+
+static long long steadyMillis() {
+    return chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+MetricsServer::MetricsServer(const MetricsRegistry& metrics, const string& address)
+    : registry(metrics), endpoint(metricsEndpoint(address)), listenFd(-1), epollFd(-1), wakeFd(-1),
+      scrapesServed(0) {
+    wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (wakeFd < 0 || epollFd < 0) {
+        if (wakeFd >= 0) close(wakeFd);
+        if (epollFd >= 0) close(epollFd);
+        throw socketError("eventfd/epoll_create1");
+    }
+    epoll_event event;
+    event.events = EPOLLIN;
+    event.data.fd = wakeFd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &event);
+}
+
+MetricsServer::~MetricsServer() {
+    stop();
+    for (unordered_map<int, HttpConnection*>::iterator it = connections.begin(); it != connections.end(); ++it) {
+        close(it->first);
+        delete it->second;
+    }
+    if (listenFd >= 0) close(listenFd);
+    close(epollFd);
+    close(wakeFd);
+}
+
+void MetricsServer::start() {
+    if (loop.joinable()) {
+        return;
+    }
+    openListener();
+    loop = thread(&MetricsServer::run, this);
+}
+
+void MetricsServer::stop() {
+    if (!loop.joinable()) {
+        return;
+    }
+    uint64_t one = 1;
+    ssize_t written = write(wakeFd, &one, sizeof(one));
+    (void)written;
+    loop.join();
+}
+
+void MetricsServer::openListener() {
+    sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons((uint16_t)endpoint.port);
+    if (inet_pton(AF_INET, endpoint.host.c_str(), &address.sin_addr) != 1) {
+        throw invalid_argument("Invalid IPv4 address: " + endpoint.host);
+    }
+    listenFd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    int reuse = 1;
+    if (listenFd < 0 || setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) < 0
+        || ::bind(listenFd, (sockaddr*)&address, sizeof(address)) < 0 || listen(listenFd, 64) < 0) {
+        throw socketError("metrics bind " + endpoint.host + ":" + to_string(endpoint.port));
+    }
+    epoll_event event;
+    event.events = EPOLLIN;
+    event.data.fd = listenFd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &event);
+}
+
+/**
+ * EVENT LOOP - runs on the server's own thread until stop()
+ * - Sleeps without a timeout while idle; with connections open it wakes
+ *   at least once a second to drop the expired ones
+ */
+void MetricsServer::run() {
+    const int MAX_EVENTS = 32;
+    epoll_event events[MAX_EVENTS];
+
+    while (true) {
+        int ready = epoll_wait(epollFd, events, MAX_EVENTS, connections.empty() ? -1 : 1000);
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            cerr << "[ERROR!] metrics epoll_wait: " << strerror(errno) << endl;
+            return;
+        }
+        for (int i = 0; i < ready; i++) {
+            int fd = events[i].data.fd;
+            if (fd == wakeFd) {
+                return;
+            }
+            if (fd == listenFd) {
+                acceptConnections();
+                continue;
+            }
+            unordered_map<int, HttpConnection*>::iterator it = connections.find(fd);
+            if (it == connections.end()) {
+                continue;
+            }
+            HttpConnection* connection = it->second;
+            if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+                closeConnection(connection);
+            } else if (!connection->response.empty()) {
+                if (flush(connection)) {
+                    closeConnection(connection);
+                }
+            } else {
+                handleReadable(connection);
+            }
+        }
+        closeExpired();
+    }
+}
+
+void MetricsServer::acceptConnections() {
+    while (true) {
+        int fd = accept4(listenFd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == ECONNABORTED || errno == EINTR) continue;
+            return;  // EAGAIN, or out of descriptors until a scrape finishes
+        }
+        if (connections.size() >= MAX_CONNECTIONS) {
+            close(fd);
+            continue;
+        }
+        connections[fd] = new HttpConnection(fd, steadyMillis() + CONNECTION_TIMEOUT_MS);
+        epoll_event event;
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+    }
+}
+
+/**
+ * READ THE REQUEST HEAD; ANSWER ONCE THE BLANK LINE HAS ARRIVED
+ * - End of stream after a complete head is a half-close: still answered
+ */
+void MetricsServer::handleReadable(HttpConnection* connection) {
+    char chunk[4096];
+    bool ended = false;
+    while (true) {
+        ssize_t received = recv(connection->fd, chunk, sizeof(chunk), 0);
+        if (received > 0) {
+            connection->request.append(chunk, (size_t)received);
+            if (connection->request.size() > REQUEST_LIMIT) {
+                closeConnection(connection);
+                return;
+            }
+            continue;
+        }
+        if (received < 0 && errno == EINTR) {
+            continue;
+        }
+        if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        }
+        if (received < 0) {
+            closeConnection(connection);
+            return;
+        }
+        ended = true;
+        break;
+    }
+    if (connection->request.find("\r\n\r\n") != string::npos || connection->request.find("\n\n") != string::npos) {
+        respond(connection);
+    } else if (ended) {
+        closeConnection(connection);  // Peer closed before a full request
+    }
+}
+
+/**
+ * BUILD THE RESPONSE AND START WRITING IT
+ * - What does not fit in the socket buffer is written on EPOLLOUT
+ */
+void MetricsServer::respond(HttpConnection* connection) {
+    const string& request = connection->request;
+    size_t methodEnd = request.find(' ');
+    size_t targetEnd = methodEnd == string::npos ? string::npos : request.find_first_of(" ?\r\n", methodEnd + 1);
+    string method = request.substr(0, methodEnd);
+    string path = targetEnd == string::npos ? "" : request.substr(methodEnd + 1, targetEnd - methodEnd - 1);
+
+    string status = "200 OK";
+    string type = "text/plain; version=0.0.4; charset=utf-8";
+    string body;
+    if (method != "GET" && method != "HEAD") {
+        status = "405 Method Not Allowed";
+        type = "text/plain";
+        body = "Only GET is supported\n";
+    } else if (path != "/metrics") {
+        status = "404 Not Found";
+        type = "text/plain";
+        body = "Metrics are served at /metrics\n";
+    } else {
+        registry.render(body);
+        scrapesServed.fetch_add(1, memory_order_relaxed);
+    }
+
+    string& response = connection->response;
+    response = "HTTP/1.1 " + status + "\r\nContent-Type: " + type + "\r\nContent-Length: " + to_string(body.size())
+               + "\r\nConnection: close\r\n\r\n";
+    if (method != "HEAD") {
+        response += body;
+    }
+    if (flush(connection)) {
+        closeConnection(connection);
+        return;
+    }
+    epoll_event event;
+    event.events = EPOLLOUT;
+    event.data.fd = connection->fd;
+    epoll_ctl(epollFd, EPOLL_CTL_MOD, connection->fd, &event);
+}
+
+/**
+ * WRITE UNTIL DONE OR THE SOCKET WOULD BLOCK
+ * @return true when the whole response is written (or the peer is gone)
+ */
+bool MetricsServer::flush(HttpConnection* connection) {
+    while (connection->responseOffset < connection->response.size()) {
+        ssize_t sent = send(connection->fd, connection->response.data() + connection->responseOffset,
+                            connection->response.size() - connection->responseOffset, MSG_NOSIGNAL);
+        if (sent > 0) {
+            connection->responseOffset += (size_t)sent;
+        } else if (sent < 0 && errno == EINTR) {
+            continue;
+        } else if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return false;
+        } else {
+            return true;
+        }
+    }
+    return true;
+}
+
+void MetricsServer::closeConnection(HttpConnection* connection) {
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, connection->fd, NULL);
+    close(connection->fd);
+    connections.erase(connection->fd);
+    delete connection;
+}
+
+/**
+ * DROP CONNECTIONS PAST THEIR DEADLINE (head never completed, or a
+ * response the client stopped reading)
+ */
+void MetricsServer::closeExpired() {
+    if (connections.empty()) {
+        return;
+    }
+    long long now = steadyMillis();
+    vector<HttpConnection*> expired;
+    for (unordered_map<int, HttpConnection*>::iterator it = connections.begin(); it != connections.end(); ++it) {
+        if (it->second->deadline <= now) {
+            expired.push_back(it->second);
+        }
+    }
+    for (size_t i = 0; i < expired.size(); i++) {
+        closeConnection(expired[i]);
+    }
+}
+
+#else
+
+/**
+ * NON-LINUX BUILDS - epoll is unavailable; asking for metrics reports it
+ */
+MetricsServer::MetricsServer(const MetricsRegistry& metrics, const string& address)
+    : registry(metrics), endpoint(metricsEndpoint(address)), listenFd(-1), epollFd(-1), wakeFd(-1),
+      scrapesServed(0) {
+    throw runtime_error("The metrics endpoint requires Linux (epoll)");
+}
+
+MetricsServer::~MetricsServer() {}
+void MetricsServer::start() {}
+void MetricsServer::stop() {}
+
+#endif
@@ -0,0 +1,107 @@
+#ifndef METRICSSERVER_H
+#define METRICSSERVER_H
+
+#include "metricsregistry.h"
+#include "protocol.h"
+#include <atomic>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+/**
+ * METRICS HTTP ENDPOINT - GET /metrics FOR PROMETHEUS SCRAPES
+ *
+ * THREADING MODEL:
+ * - start() binds the port and runs a single-thread epoll loop of its
+ *   own; every scrape renders the registry there, so the thread that owns
+ *   the HospitalSystem only ever stores relaxed atomics
+ *
+ * HTTP:
+ * - Just enough HTTP/1.1 for a scraper: the request head is read until
+ *   the blank line, GET /metrics (any query string) answers the text
+ *   exposition, other paths 404 and other methods 405
+ * - Every response carries Connection: close and the socket is closed
+ *   once it is written, so no connection outlives one scrape
+ * - Non-blocking sockets, level-triggered epoll; request heads above
+ *   REQUEST_LIMIT close the connection
+ * - A client may half-close after its request (shutdown(SHUT_WR), nc -N):
+ *   a complete head followed by end of stream is still answered
+ *
+ * LIMITS: at most MAX_CONNECTIONS scrapes are open at once (later ones
+ * are accepted and closed at once), and a connection that has not been
+ * answered and written within CONNECTION_TIMEOUT_MS is closed, so a
+ * client that never sends the blank line cannot hold a socket forever.
+ *
+ * SHUTDOWN: stop() wakes the loop through an eventfd and joins the thread;
+ * the destructor calls it.
+ */
+class MetricsServer {
+private:
+    /**
+     * ONE SCRAPE IN PROGRESS
+     */
+    struct HttpConnection {
+        int fd;
+        std::string request;       ///< Bytes of the request head received so far
+        std::string response;      ///< Response not yet written (empty while reading)
+        std::size_t responseOffset;
+        long long deadline;        ///< Steady-clock milliseconds after which it is dropped
+
+        HttpConnection(int socket, long long closeAt) : fd(socket), responseOffset(0), deadline(closeAt) {}
+    };
+
+    static const std::size_t REQUEST_LIMIT = 8 * 1024;
+    static const std::size_t MAX_CONNECTIONS = 64;
+    static const int CONNECTION_TIMEOUT_MS = 5000;
+
+    const MetricsRegistry& registry;
+    protocol::Endpoint endpoint;
+    int listenFd;
+    int epollFd;
+    int wakeFd;
+    std::thread loop;
+    std::unordered_map<int, HttpConnection*> connections;
+    std::atomic<long long> scrapesServed;
+
+    void openListener();
+    void run();
+    void acceptConnections();
+    void handleReadable(HttpConnection* connection);
+    void respond(HttpConnection* connection);
+    bool flush(HttpConnection* connection);
+    void closeConnection(HttpConnection* connection);
+    void closeExpired();
+
+public:
+    /**
+     * CONSTRUCTOR
+     * @param metrics: Registry rendered on every scrape; must outlive the server
+     * @param address: "HOST:PORT" (IPv4), e.g. "127.0.0.1:9400"
+     * EXCEPTION: Throws invalid_argument for a malformed address
+     */
+    MetricsServer(const MetricsRegistry& metrics, const std::string& address);
+
+    /**
+     * DESTRUCTOR - Stops the loop and closes every socket
+     */
+    ~MetricsServer();
+
+    /**
+     * BIND THE PORT AND START SERVING IN THE BACKGROUND
+     * EXCEPTION: Throws runtime_error if the port cannot be opened
+     */
+    void start();
+
+    /**
+     * STOP SERVING AND JOIN THE LOOP THREAD (idempotent)
+     */
+    void stop();
+
+    long long scrapes() const { return scrapesServed.load(std::memory_order_relaxed); }
+    std::string describe() const { return "http://" + endpoint.host + ":" + std::to_string(endpoint.port) + "/metrics"; }
+
+    MetricsServer(const MetricsServer&) = delete;
+    MetricsServer& operator=(const MetricsServer&) = delete;
+};
+
+#endif
@@ -0,0 +1,104 @@
+#ifndef MPSCQUEUE_H
+#define MPSCQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+
+/**
+ * MPSC QUEUE NODE - Embed (inherit) in every message
+ * - The queue links messages through this field, so push() never allocates
+ */
+struct MpscNode {
+    std::atomic<MpscNode*> next;
+
+    MpscNode() : next(NULL) {}
+};
+
+/**
+ * LOCK-FREE MULTI-PRODUCER SINGLE-CONSUMER QUEUE (INTRUSIVE)
+ *
+ * ALGORITHM: Dmitry Vyukov's intrusive MPSC queue
+ * - push(): one atomic exchange on the head plus one store; wait-free for
+ *   producers, any number of threads
+ * - pop(): consumer only; walks from the tail using a stub node so the
+ *   queue is never physically empty
+ *
+ * FIFO: Messages from one producer are popped in push order; messages from
+ * different producers are ordered by their exchange on the head.
+ *
+ * TRANSIENT EMPTINESS: Between a producer's exchange and its link store the
+ * consumer cannot see that message (or any pushed after it); pop() returns
+ * NULL and isEmpty() returns false until the producer finishes.
+ *
+ * OWNERSHIP: The queue never deletes messages; pop() hands the node back.
+ */
+template <typename T>
+class MpscQueue {
+private:
+    std::atomic<MpscNode*> head;  ///< Most recently pushed node (producers)
+    MpscNode* tail;               ///< Next node to consume (consumer only)
+    MpscNode stub;                ///< Placeholder keeping the list non-empty
+
+    void pushNode(MpscNode* node) {
+        node->next.store(NULL, std::memory_order_relaxed);
+        MpscNode* previous = head.exchange(node, std::memory_order_seq_cst);
+        previous->next.store(node, std::memory_order_release);
+    }
+
+public:
+    MpscQueue() : head(&stub), tail(&stub) {}
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    /**
+     * ENQUEUE A MESSAGE (any thread)
+     * - seq_cst exchange so a producer that then checks a "consumer is
+     *   sleeping" flag cannot miss the consumer's emptiness check
+     */
+    void push(T* message) {
+        pushNode(message);
+    }
+
+    /**
+     * DEQUEUE THE OLDEST VISIBLE MESSAGE (consumer thread only)
+     * @return The message, or NULL if none is currently visible
+     */
+    T* pop() {
+        MpscNode* current = tail;
+        MpscNode* next = current->next.load(std::memory_order_acquire);
+
+        if (current == &stub) {
+            if (next == NULL) {
+                return NULL;
+            }
+            tail = next;
+            current = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+        if (next != NULL) {
+            tail = next;
+            return static_cast<T*>(current);
+        }
+        if (current != head.load(std::memory_order_acquire)) {
+            return NULL;  // A producer is between exchange and link
+        }
+        // current is the last node: re-insert the stub behind it
+        pushNode(&stub);
+        next = current->next.load(std::memory_order_acquire);
+        if (next != NULL) {
+            tail = next;
+            return static_cast<T*>(current);
+        }
+        return NULL;
+    }
+
+    /**
+     * TRUE WHEN NO MESSAGE HAS BEEN PUSHED SINCE THE LAST POP (consumer only)
+     */
+    bool isEmpty() {
+        return tail == &stub && head.load(std::memory_order_seq_cst) == &stub;
+    }
+};
+
+#endif
@@ -0,0 +1,305 @@
+#include "nameindex.h"
+#include <stdexcept>
+
+using namespace std;
+
+/**
+ * ACCENT FOLDING TABLE FOR U+00C0..U+00FF (Latin-1 letters)
+ * - 0 keeps the character unchanged
+ */
+static const char LATIN1_FOLD[64] = {
+    'a', 'a', 'a', 'a', 'a', 'a', 0, 'c', 'e', 'e', 'e', 'e', 'i', 'i', 'i', 'i',  // C0-CF
+    0, 'n', 'o', 'o', 'o', 'o', 'o', 0, 0, 'u', 'u', 'u', 'u', 'y', 0, 0,          // D0-DF
+    'a', 'a', 'a', 'a', 'a', 'a', 0, 'c', 'e', 'e', 'e', 'e', 'i', 'i', 'i', 'i',  // E0-EF
+    0, 'n', 'o', 'o', 'o', 'o', 'o', 0, 0, 'u', 'u', 'u', 'u', 'y', 0, 'y'         // F0-FF
+};
+
+string NameIndex::fold(const string& text) {
+    string folded;
+    folded.reserve(text.size());
+    for (size_t i = 0; i < text.size(); i++) {
+        unsigned char c = (unsigned char)text[i];
+        if (c == ' ' || c == '\t') {
+            if (!folded.empty() && folded[folded.size() - 1] != ' ') {
+                folded.push_back(' ');
+            }
+            continue;
+        }
+        if (c < 0x80) {
+            folded.push_back(c >= 'A' && c <= 'Z' ? (char)(c - 'A' + 'a') : (char)c);
+            continue;
+        }
+        // UTF-8 two-byte form of U+00C0..U+00FF, or a raw Latin-1 byte
+        int codePoint = -1;
+        size_t width = 1;
+        if (c == 0xC3 && i + 1 < text.size() && ((unsigned char)text[i + 1] & 0xC0) == 0x80) {
+            codePoint = 0xC0 + ((unsigned char)text[i + 1] & 0x3F);
+            width = 2;
+        } else if (c >= 0xC0 && !(i + 1 < text.size() && ((unsigned char)text[i + 1] & 0xC0) == 0x80)) {
+            codePoint = c;
+        }
+        if (codePoint >= 0xC0 && LATIN1_FOLD[codePoint - 0xC0] != 0) {
+            folded.push_back(LATIN1_FOLD[codePoint - 0xC0]);
+        } else {
+            folded.append(text, i, width);
+        }
+        i += width - 1;
+    }
+    return folded;
+}
+
+NameIndex::NameIndex() : head(-1) {
+    for (int c = 0; c < CHILD_CLASSES; c++) {
+        freeBlocks[c] = -1;
+    }
+    newNode(0, 0);
+    accountGrowth(0);
+}
+
+void NameIndex::reserve(int patients) {
+    if (patients <= 0) {
+        return;
+    }
+    long long bytes = MEMORY_STATS_ENABLED ? memoryBytes() : 0;
+    entries.reserve((size_t)patients);
+    nodes.reserve((size_t)patients * 2 + 1);
+    accountGrowth(bytes);
+}
+
+/**
+ * RECORD A CHANGE OF memoryBytes() AFTER VECTORS WERE RESERVED
+ * - Vectors only grow in reserve calls (insert() reserves its headroom up
+ *   front), so this sees every reallocation
+ */
+void NameIndex::accountGrowth(long long before) {
+    if (!MEMORY_STATS_ENABLED) {
+        return;
+    }
+    long long after = memoryBytes();
+    if (after != before) {
+        if (before > 0) {
+            MEMORY_ACCOUNT_RELEASE((size_t)before);
+        }
+        MEMORY_ACCOUNT_ALLOCATE((size_t)after);
+    }
+}
+
+int NameIndex::newNode(int labelStart, int labelLength) {
+    Node node;
+    node.labelStart = labelStart;
+    node.labelLength = (unsigned)labelLength;
+    node.labelByte = labelLength > 0 ? (unsigned char)pool[labelStart] : 0;
+    node.children = -1;
+    node.childCount = 0;
+    node.childClass = 0;
+    node.first = -1;
+    node.last = -1;
+    node.terminalLast = -1;
+    nodes.push_back(node);
+    return (int)nodes.size() - 1;
+}
+
+/**
+ * CHILD BLOCK OF 1 << sizeClass SLOTS - Recycled block first, else appended
+ * - Never allocates: insert() reserves slot capacity beforehand
+ */
+int NameIndex::allocateBlock(int sizeClass) {
+    int offset = freeBlocks[sizeClass];
+    if (offset != -1) {
+        freeBlocks[sizeClass] = childNodes[offset];
+        return offset;
+    }
+    offset = (int)childNodes.size();
+    childBytes.resize(childBytes.size() + ((size_t)1 << sizeClass));
+    childNodes.resize(childNodes.size() + ((size_t)1 << sizeClass));
+    return offset;
+}
+
+void NameIndex::releaseBlock(int offset, int sizeClass) {
+    childNodes[offset] = freeBlocks[sizeClass];
+    freeBlocks[sizeClass] = offset;
+}
+
+/**
+ * FIRST CHILD SLOT WHOSE BYTE IS >= byte (childCount if none)
+ */
+int NameIndex::findSlot(const Node& node, unsigned char byte) const {
+    const unsigned char* bytes = node.children >= 0 ? &childBytes[(size_t)node.children] : NULL;
+    int slot = 0;
+    while (slot < node.childCount && bytes[slot] < byte) {
+        slot++;
+    }
+    return slot;
+}
+
+/**
+ * PUT A CHILD AT A SLOT, MOVING TO A BLOCK TWICE AS LARGE WHEN FULL
+ */
+void NameIndex::insertChild(int parent, int slot, int child) {
+    Node& node = nodes[parent];
+    int count = node.childCount;
+    unsigned char byte = (unsigned char)nodes[child].labelByte;
+    if (node.children == -1 || count == (1 << node.childClass)) {
+        int sizeClass = node.children == -1 ? 0 : node.childClass + 1;
+        int block = allocateBlock(sizeClass);
+        for (int i = 0; i < count; i++) {
+            int target = block + i + (i >= slot ? 1 : 0);
+            childBytes[(size_t)target] = childBytes[(size_t)(node.children + i)];
+            childNodes[(size_t)target] = childNodes[(size_t)(node.children + i)];
+        }
+        if (node.children != -1) {
+            releaseBlock(node.children, node.childClass);
+        }
+        node.children = block;
+        node.childClass = (unsigned char)sizeClass;
+    } else {
+        for (int i = count; i > slot; i--) {
+            childBytes[(size_t)(node.children + i)] = childBytes[(size_t)(node.children + i - 1)];
+            childNodes[(size_t)(node.children + i)] = childNodes[(size_t)(node.children + i - 1)];
+        }
+    }
+    childBytes[(size_t)(node.children + slot)] = byte;
+    childNodes[(size_t)(node.children + slot)] = child;
+    node.childCount = (unsigned short)(count + 1);
+}
+
+/**
+ * INSERT IMPLEMENTATION
+ * 1. Descend, splitting an edge where the key diverges inside its label
+ *    and adding a leaf for the unmatched suffix
+ * 2. On the way down, track the entry that precedes the new key in key
+ *    order: the last entry ending at an ancestor, or the last entry of the
+ *    nearest smaller sibling's subtree, whichever comes later
+ * 3. Link the entry after that predecessor, then fix the first/last
+ *    bounds of every node on the path in O(1) each
+ */
+void NameIndex::insert(Patient* patient) {
+    string key = fold(patient->name);
+    if (key.size() >= (1u << 24)) {
+        throw length_error("Patient name too long to index");
+    }
+
+    // Reserve everything up front (geometric growth keeps this amortised O(1))
+    const size_t slotHeadroom = 4 << (CHILD_CLASSES - 1);
+    long long bytes = MEMORY_STATS_ENABLED ? memoryBytes() : 0;
+    path.clear();
+    path.reserve(key.size() + 2);
+    if (nodes.capacity() < nodes.size() + 2) nodes.reserve(nodes.capacity() * 2 + 2);
+    if (entries.capacity() < entries.size() + 1) entries.reserve(entries.capacity() * 2 + 1);
+    if (pool.capacity() < pool.size() + key.size()) pool.reserve(pool.capacity() * 2 + key.size());
+    if (childNodes.capacity() < childNodes.size() + slotHeadroom) {
+        childBytes.reserve(childBytes.capacity() * 2 + slotHeadroom);
+        childNodes.reserve(childNodes.capacity() * 2 + slotHeadroom);
+    }
+    accountGrowth(bytes);
+
+    int predecessor = -1;
+    int node = 0;
+    size_t position = 0;
+    path.push_back(node);
+    while (position < key.size()) {
+        if (nodes[node].terminalLast != -1) {
+            predecessor = nodes[node].terminalLast;
+        }
+        unsigned char byte = (unsigned char)key[position];
+        int slot = findSlot(nodes[node], byte);
+        int block = nodes[node].children;
+        if (slot > 0) {
+            predecessor = nodes[childNodes[(size_t)(block + slot - 1)]].last;
+        }
+
+        if (slot == nodes[node].childCount || childBytes[(size_t)(block + slot)] != byte) {
+            pool.append(key, position, string::npos);
+            int leaf = newNode((int)(pool.size() - (key.size() - position)), (int)(key.size() - position));
+            insertChild(node, slot, leaf);
+            path.push_back(leaf);
+            node = leaf;
+            break;
+        }
+
+        int child = childNodes[(size_t)(block + slot)];
+        int start = nodes[child].labelStart;
+        int length = (int)nodes[child].labelLength;
+        int matched = 0;
+        while (matched < length && position + matched < key.size()
+               && pool[start + matched] == key[position + matched]) {
+            matched++;
+        }
+        if (matched < length) {
+            // Split the edge: the middle node takes the shared label prefix
+            int middle = newNode(start, matched);
+            nodes[middle].first = nodes[child].first;
+            nodes[middle].last = nodes[child].last;
+            nodes[child].labelStart += matched;
+            nodes[child].labelLength = (unsigned)(length - matched);
+            nodes[child].labelByte = (unsigned char)pool[start + matched];
+            insertChild(middle, 0, child);
+            childNodes[(size_t)(block + slot)] = middle;  // Same first byte
+            child = middle;
+        }
+        path.push_back(child);
+        node = child;
+        position += matched;
+    }
+
+    if (nodes[node].terminalLast != -1) {
+        predecessor = nodes[node].terminalLast;  // Same key: registration order
+    }
+    int entry = (int)entries.size();
+    Entry created;
+    created.patient = patient;
+    created.next = predecessor == -1 ? head : entries[predecessor].next;
+    entries.push_back(created);
+    int following = created.next;
+    if (predecessor == -1) {
+        head = entry;
+    } else {
+        entries[predecessor].next = entry;
+    }
+    nodes[node].terminalLast = entry;
+
+    for (size_t i = 0; i < path.size(); i++) {
+        Node& onPath = nodes[path[i]];
+        if (onPath.first == -1) {
+            onPath.first = entry;
+            onPath.last = entry;
+            continue;
+        }
+        if (onPath.first == following) onPath.first = entry;
+        if (onPath.last == predecessor) onPath.last = entry;
+    }
+}
+
+int NameIndex::prefixSearch(const string& prefix, int k, vector<Patient*>& out) const {
+    string key = fold(prefix);
+    int node = 0;
+    size_t position = 0;
+    while (position < key.size()) {
+        unsigned char byte = (unsigned char)key[position];
+        int slot = findSlot(nodes[node], byte);
+        int block = nodes[node].children;
+        if (slot == nodes[node].childCount || childBytes[(size_t)(block + slot)] != byte) {
+            return 0;
+        }
+        int child = childNodes[(size_t)(block + slot)];
+        size_t compared = min((size_t)nodes[child].labelLength, key.size() - position);
+        if (pool.compare((size_t)nodes[child].labelStart, compared, key, position, compared) != 0) {
+            return 0;
+        }
+        position += compared;
+        node = child;
+    }
+
+    int found = 0;
+    for (int e = nodes[node].first; e != -1 && found < k; e = entries[e].next) {
+        out.push_back(entries[e].patient);
+        found++;
+        if (e == nodes[node].last) break;
+    }
+    return found;
+}
+
+long long NameIndex::memoryBytes() const {
+    return (long long)(nodes.capacity() * sizeof(Node) + entries.capacity() * sizeof(Entry) + pool.capacity()
+                       + childBytes.capacity() + childNodes.capacity() * sizeof(int));
+}
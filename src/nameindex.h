@@ -0,0 +1,129 @@
+#ifndef NAMEINDEX_H
+#define NAMEINDEX_H
+
+#include "memorystats.h"
+#include "patient.h"
+#include <string>
+#include <vector>
+
+/**
+ * NAME PREFIX INDEX - COMPRESSED TRIE (RADIX TREE) OVER Patient::name
+ *
+ * KEYS:
+ * - Names are folded before indexing and querying: ASCII lowercase,
+ *   Latin accents removed (UTF-8 or Latin-1 input, "Muñoz" == "munoz"),
+ *   leading blanks dropped and blank runs collapsed to one space
+ *
+ * LAYOUT (index-based, no per-node allocations):
+ * - Nodes live in one vector; each edge label is a slice of a shared byte
+ *   pool holding only the key suffixes that created new nodes
+ * - A node's children sit in one block of two parallel slot arrays, sorted
+ *   by first label byte: the bytes are scanned within a cache line and
+ *   only the matching child (plus its left neighbour on insert) is read.
+ *   Blocks have power-of-two capacities and are recycled through
+ *   per-size free lists when a node outgrows them
+ * - Every patient is an entry in ONE singly linked list kept in key order
+ *   (ties in registration order). Each node records the first and last
+ *   entry of its subtree, so a subtree is a contiguous run of that list
+ *
+ * COMPLEXITY:
+ * - insert: O(|name|), incremental, called on registration
+ * - prefixSearch: O(|prefix| + k) - descend to the prefix node, then walk
+ *   k entries from its subtree's first entry
+ * - Memory: at most 2 nodes (28 bytes each, plus 5 bytes per child slot)
+ *   and one 16-byte entry per patient, plus the unique suffix bytes
+ *
+ * Patients are never removed (the database keeps every registration).
+ */
+class NameIndex {
+private:
+    /**
+     * RADIX TREE NODE - Indices into nodes/entries, -1 for none
+     */
+    struct Node {
+        int labelStart;                 ///< Edge label: pool[labelStart, labelStart + labelLength)
+        unsigned labelLength : 24;
+        unsigned labelByte : 8;         ///< First label byte
+        int children;                   ///< Offset of the child block in the slot arrays
+        unsigned short childCount;
+        unsigned char childClass;       ///< Block capacity is 1 << childClass
+        int first;                      ///< First entry of the subtree (key order)
+        int last;                       ///< Last entry of the subtree
+        int terminalLast;               ///< Last entry whose key ends exactly here
+    };
+
+    /**
+     * INDEXED PATIENT - Link in the global key-ordered list
+     */
+    struct Entry {
+        Patient* patient;
+        int next;
+    };
+
+    static const int CHILD_CLASSES = 9;  ///< Up to 256 children (one per byte value)
+
+    std::vector<Node> nodes;                ///< nodes[0] is the root (empty label)
+    std::vector<Entry> entries;
+    std::string pool;                       ///< Edge label bytes
+    std::vector<unsigned char> childBytes;  ///< Child slots: first label byte...
+    std::vector<int> childNodes;            ///< ...and node index (free blocks: next free offset)
+    int freeBlocks[CHILD_CLASSES];          ///< Free list head per block class, -1 if empty
+    std::vector<int> path;                  ///< Scratch: nodes visited by insert()
+    MEMORY_ACCOUNT
+    int head;                               ///< First entry in key order
+
+    int newNode(int labelStart, int labelLength);
+    int allocateBlock(int sizeClass);
+    void releaseBlock(int offset, int sizeClass);
+    int findSlot(const Node& node, unsigned char byte) const;
+    void insertChild(int parent, int slot, int child);
+    void accountGrowth(long long before);
+
+public:
+    NameIndex();
+
+    /**
+     * INDEX A NEWLY REGISTERED PATIENT
+     * - Strong guarantee: storage is reserved before anything is linked
+     * EXCEPTION: Throws length_error for names of 16 MB or more
+     */
+    void insert(Patient* patient);
+
+    /**
+     * PRE-SIZE FOR AN EXPECTED NUMBER OF PATIENTS
+     * - Reserves the entry list and the node ceiling (2 per patient) so
+     *   insertions stay allocation-free up to that size; label bytes and
+     *   child blocks still grow with the distinct names seen
+     */
+    void reserve(int patients);
+
+    /**
+     * PATIENTS WHOSE FOLDED NAME STARTS WITH THE FOLDED PREFIX
+     * @param prefix: Partial name (case and accents are ignored)
+     * @param k: Maximum number of results
+     * @param out: Receives up to k patients in name order
+     * @return Number of patients appended
+     */
+    int prefixSearch(const std::string& prefix, int k, std::vector<Patient*>& out) const;
+
+    /**
+     * NORMALISE A NAME FOR INDEXING (lowercase, no accents, single blanks)
+     */
+    static std::string fold(const std::string& text);
+
+    int size() const { return (int)entries.size(); }
+    int nodeCount() const { return (int)nodes.size(); }
+
+    /**
+     * BYTES HELD BY THE INDEX (vector capacities and label pool)
+     */
+    long long memoryBytes() const;
+
+    /**
+     * ALLOCATION STATISTICS - memoryBytes() tracked across every reserve
+     * (all zero unless compiled with HOSPITAL_MEMORY_STATS)
+     */
+    MemoryStats memoryStats() const { return MEMORY_ACCOUNT_SNAPSHOT(); }
+};
+
+#endif
@@ -28,6 +28,10 @@ public:
     int age;             ///< Patient's age in years
     int priority;        ///< Triage priority level (1-5 according to Colombian system)
     std::string symptom; ///< Medical symptom description
+    long long arrivalTime; ///< Registration time, steady-clock nanoseconds (0 if unknown)
+    bool transferred;      ///< Left triage for another site (the record stays here)
+    int specialty;         ///< Room pool index (0 = first specialty configured)
+    int room;              ///< Consultation room while in consultation, -1 otherwise
 
     /**
      * PATIENT CONSTRUCTOR
@@ -40,9 +44,13 @@ public:
      * MEMBER INITIALIZATION:
      * - Uses member initialization list for efficient construction
      * - Directly initializes all member variables
+     * - arrivalTime starts at 0; HospitalSystem stamps it on registration
+     * - transferred starts false; set when the patient is sent to another site
+     * - specialty starts at the first (general) pool, room at -1 (none)
      */
     Patient(int _id, std::string _name, int _age, int _priority, std::string _symptom)
-        : id(_id), name(_name), age(_age), priority(_priority), symptom(_symptom) {}
+        : id(_id), name(_name), age(_age), priority(_priority), symptom(_symptom), arrivalTime(0), transferred(false),
+          specialty(0), room(-1) {}
 
     /**
      * LESS-THAN OPERATOR OVERLOADING
@@ -79,6 +87,21 @@ public:
         return this->id == other.id;
     }
 
+    /**
+     * WAITING ORDER
+     * @param other: Patient to compare against
+     * @return true if this patient arrived first (the lower ID breaks ties)
+     * 
+     * NOTE: A transferred patient keeps its original arrival time under a
+     * new, higher local ID, so IDs alone do not give the waiting order
+     */
+    bool waitingBefore(const Patient& other) const {
+        if (arrivalTime != other.arrivalTime) {
+            return arrivalTime < other.arrivalTime;
+        }
+        return id < other.id;
+    }
+
     /**
      * GET PRIORITY DESCRIPTION
      * @return String description of the priority level
@@ -101,6 +124,21 @@ public:
         }
     }
 
+    /**
+     * MEMORY FOOTPRINT OF THIS RECORD
+     * @return Object size plus heap buffers of the name and symptom strings
+     * 
+     * NOTE: Strings short enough for the small-string optimisation live
+     * inside the object and add no heap bytes
+     */
+    std::size_t memoryFootprint() const {
+        static const std::size_t inlineCapacity = std::string().capacity();
+        std::size_t bytes = sizeof(Patient);
+        if (name.capacity() > inlineCapacity) bytes += name.capacity() + 1;
+        if (symptom.capacity() > inlineCapacity) bytes += symptom.capacity() + 1;
+        return bytes;
+    }
+
     /**
      * OUTPUT STREAM OPERATOR OVERLOADING
      * @param os: Output stream reference
@@ -0,0 +1,40 @@
+#include "patientcensus.h"
+
+using namespace std;
+
+PatientCensus::PatientCensus() {
+    for (int s = 0; s < STATUSES; s++) {
+        counts[s] = NULL;
+    }
+    try {
+        for (int s = 0; s < STATUSES; s++) {
+            counts[s] = new FenwickTree2D<int>(MAX_AGE + 1, LEVELS);
+            MEMORY_ACCOUNT_ALLOCATE(counts[s]->memoryBytes());
+        }
+    } catch (...) {
+        for (int s = 0; s < STATUSES; s++) {
+            delete counts[s];
+        }
+        throw;
+    }
+}
+
+PatientCensus::~PatientCensus() {
+    for (int s = 0; s < STATUSES; s++) {
+        MEMORY_ACCOUNT_RELEASE(counts[s]->memoryBytes());
+        delete counts[s];
+    }
+}
+
+void PatientCensus::add(PatientStatus status, int age, int priority) {
+    counts[status]->add(age, priority - 1, 1);
+}
+
+void PatientCensus::move(PatientStatus from, PatientStatus to, int age, int priority) {
+    counts[from]->add(age, priority - 1, -1);
+    counts[to]->add(age, priority - 1, 1);
+}
+
+int PatientCensus::count(PatientStatus status, int minAge, int maxAge, int minPriority, int maxPriority) const {
+    return counts[status]->rangeSum(minAge, maxAge, minPriority - 1, maxPriority - 1);
+}
@@ -0,0 +1,64 @@
+#ifndef PATIENTCENSUS_H
+#define PATIENTCENSUS_H
+
+#include "fenwicktree.h"
+#include "memorystats.h"
+
+/**
+ * WHERE A PATIENT IS IN THE HOSPITAL FLOW
+ */
+enum PatientStatus { STATUS_WAITING, STATUS_IN_CONSULTATION, STATUS_COMPLETED, STATUS_TRANSFERRED };
+
+/**
+ * PATIENT CENSUS - COUNTS BY STATUS x AGE x TRIAGE LEVEL
+ *
+ * One FenwickTree2D (age 0-MAX_AGE x triage level 1-5) per status, kept
+ * in step with every transition of HospitalSystem, so questions such as
+ * "patients aged 65+ waiting in TRIAGE I-II" are answered without
+ * scanning the database or the containers.
+ *
+ * COMPLEXITY (A = MAX_AGE + 1, L = 5 levels):
+ * - add / move: O(log A * log L) per transition
+ * - count: O(log A * log L) for any age x level rectangle
+ */
+class PatientCensus {
+public:
+    static const int MAX_AGE = 150;
+    static const int LEVELS = 5;
+    static const int STATUSES = 4;
+
+private:
+    FenwickTree2D<int>* counts[STATUSES];
+    MEMORY_ACCOUNT
+
+public:
+    PatientCensus();
+    ~PatientCensus();
+
+    /**
+     * A NEW PATIENT ENTERS WITH THE GIVEN STATUS
+     */
+    void add(PatientStatus status, int age, int priority);
+
+    /**
+     * A PATIENT CHANGES STATUS (attended, consultation finished, transferred)
+     */
+    void move(PatientStatus from, PatientStatus to, int age, int priority);
+
+    /**
+     * PATIENTS WITH THAT STATUS, AGE IN [minAge, maxAge] AND TRIAGE LEVEL
+     * IN [minPriority, maxPriority] (bounds inclusive, clamped to the grid)
+     */
+    int count(PatientStatus status, int minAge, int maxAge, int minPriority = 1, int maxPriority = LEVELS) const;
+
+    /**
+     * ALLOCATION STATISTICS - one fixed grid per status
+     * (all zero unless compiled with HOSPITAL_MEMORY_STATS)
+     */
+    MemoryStats memoryStats() const { return MEMORY_ACCOUNT_SNAPSHOT(); }
+
+    PatientCensus(const PatientCensus&) = delete;
+    PatientCensus& operator=(const PatientCensus&) = delete;
+};
+
+#endif
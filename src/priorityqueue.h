@@ -4,8 +4,11 @@
 #include "array.h"
 #include "list.h"    
 #include "patient.h"
+#include "trace.h"
+#include <algorithm>
 #include <iostream>
 #include <stdexcept>
+#include <vector>
 
 /**
  * PRIORITY QUEUE TEMPLATE CLASS
@@ -104,6 +107,28 @@ public:
         totalPatients++;  // Update total count
     }
 
+    /**
+     * ENQUEUE AT THE ARRIVAL POSITION
+     * @param data: Patient pointer to add to the queue
+     * 
+     * BEHAVIOR:
+     * - Same bucket as add(), placed after every patient that arrived
+     *   before it (Patient::waitingBefore) instead of at the back
+     * - A patient registered now belongs at the back: O(1), like add()
+     * - A transferred patient that kept an earlier arrival time is placed
+     *   among the patients it has waited longer than: O(position)
+     * 
+     * EXCEPTION HANDLING: Same as add()
+     */
+    void addByArrival(T data) {
+        int bucketIndex = data->priority - 1;
+        if (bucketIndex < 0 || bucketIndex >= numPriorities) {
+            throw std::runtime_error("Invalid patient priority. Must be between 1 (TRIAGE I) and 5 (TRIAGE V)");
+        }
+        (*priorityBuckets)[bucketIndex].insertOrdered(data, [](T a, T b) { return a->waitingBefore(*b); });
+        totalPatients++;
+    }
+
     /**
      * DEQUEUE - Removes and returns highest priority patient
      * @return Patient with highest priority (lowest number)
@@ -127,6 +152,7 @@ public:
      * - Throws runtime_error if queue is empty
      */
     T pop() {
+        TRACE_SCOPE("PriorityQueue::pop");
         if (isEmpty()) {
             throw std::runtime_error("Priority queue is empty - no patients to dequeue");
         }
@@ -206,6 +232,134 @@ public:
         return totalPatients;
     }
 
+    /**
+     * GET NUMBER OF PATIENTS WAITING AT ONE PRIORITY LEVEL
+     * @param priority: Triage level (1 = TRIAGE I ... numPriorities)
+     * @return Patients in that bucket, 0 for an out-of-range level
+     *
+     * EFFICIENCY: O(1) - each List maintains its own length counter
+     */
+    int bucketLen(int priority) {
+        if (priority < 1 || priority > numPriorities) {
+            return 0;
+        }
+        return (*priorityBuckets)[priority - 1].len();
+    }
+
+    /**
+     * HEAD OF ONE LEVEL WITHOUT REMOVAL
+     * @param priority: Triage level (1 = TRIAGE I ... numPriorities)
+     * @param out: Receives the oldest patient of that level
+     * @return false for an empty or out-of-range level (out untouched)
+     *
+     * EFFICIENCY: O(1)
+     */
+    bool peekLevel(int priority, T& out) {
+        if (priority < 1 || priority > numPriorities || (*priorityBuckets)[priority - 1].isEmpty()) {
+            return false;
+        }
+        out = (*priorityBuckets)[priority - 1].peek();
+        return true;
+    }
+
+    /**
+     * OLDEST WAITING PATIENTS ACROSS ALL LEVELS
+     * @param k: Maximum number of patients to return
+     * @param out: Receives up to k patients, longest waiting first
+     * @return Number of patients written to out
+     * 
+     * ALGORITHM (k-way merge of the buckets, nothing is copied):
+     * - Buckets filled through addByArrival are sorted by arrival, so each
+     *   head is its bucket's longest-waiting patient
+     * - A heap holds one cursor per non-empty bucket; the earliest arrival
+     *   (Patient::waitingBefore) is taken and replaced by the next node of
+     *   the same bucket
+     * 
+     * TIME COMPLEXITY: O(L + k log L) for L priority levels
+     */
+    int oldest(int k, T* out) {
+        std::vector<const Node<T>*> heads;
+        heads.reserve((size_t)numPriorities);
+        for (int i = 0; i < numPriorities; i++) {
+            if ((*priorityBuckets)[i].first() != NULL) {
+                heads.push_back((*priorityBuckets)[i].first());
+            }
+        }
+        auto later = [](const Node<T>* a, const Node<T>* b) { return b->data->waitingBefore(*a->data); };
+        std::make_heap(heads.begin(), heads.end(), later);
+
+        int found = 0;
+        while (found < k && !heads.empty()) {
+            std::pop_heap(heads.begin(), heads.end(), later);
+            const Node<T>* oldestNode = heads.back();
+            out[found++] = oldestNode->data;
+            if (oldestNode->next != NULL) {
+                heads.back() = oldestNode->next;
+                std::push_heap(heads.begin(), heads.end(), later);
+            } else {
+                heads.pop_back();
+            }
+        }
+        return found;
+    }
+
+    /**
+     * REMOVE THE OLDEST PATIENTS OF ONE LEVEL
+     * @param priority: Triage level (1 = TRIAGE I ... numPriorities)
+     * @param k: Maximum number of patients to remove
+     * @param out: Receives the removed patients in arrival order
+     * @return Number of patients removed (0 for an out-of-range level)
+     *
+     * USAGE: Batch transfers to another site; the bucket head is its
+     * oldest patient, so the batch keeps the level's FIFO order
+     *
+     * TIME COMPLEXITY: O(k) - no other bucket is visited
+     */
+    int takeOldest(int priority, int k, T* out) {
+        if (priority < 1 || priority > numPriorities) {
+            return 0;
+        }
+        List<T>& bucket = (*priorityBuckets)[priority - 1];
+        int taken = 0;
+        while (taken < k && !bucket.isEmpty()) {
+            out[taken++] = bucket.pop();
+        }
+        totalPatients -= taken;
+        return taken;
+    }
+
+    /**
+     * PRE-ALLOCATE NODES FOR perLevel PATIENTS IN EVERY LEVEL
+     * - Each bucket List keeps its nodes for reuse (List::reserve), so a
+     *   level that stays within perLevel patients never allocates
+     */
+    void reserve(int perLevel) {
+        for (int i = 0; i < numPriorities; i++) {
+            (*priorityBuckets)[i].reserve(perLevel);
+        }
+    }
+
+    /**
+     * GET NUMBER OF PRIORITY LEVELS
+     * @return Number of buckets configured at construction
+     */
+    int levels() {
+        return numPriorities;
+    }
+
+    /**
+     * ALLOCATION STATISTICS OF THE WHOLE TRIAGE STRUCTURE
+     * @return Bucket array buffer plus the nodes of every bucket List
+     *         (all zero unless compiled with HOSPITAL_MEMORY_STATS)
+     */
+    MemoryStats memoryStats() {
+        MemoryStats stats = priorityBuckets->memoryStats();
+        for (int i = 0; i < numPriorities; i++) {
+            stats += (*priorityBuckets)[i].memoryStats();
+        }
+        return stats;
+    }
+
     /**
      * CHECK IF PATIENT EXISTS IN ANY PRIORITY BUCKET
      * @param patientId: Unique identifier of patient to search for
@@ -0,0 +1,244 @@
+#ifndef PROTOCOL_H
+#define PROTOCOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+
+/**
+ * HOSPITAL WIRE PROTOCOL (length-prefixed binary, little-endian)
+ *
+ * FRAME: u32 payload length, then the payload (at most MAX_FRAME bytes)
+ *
+ * REQUEST PAYLOAD:
+ * - u8 opcode, varint tag (echoed back so clients can match responses)
+ * - REGISTER: u8 priority, u8 age, string name, string symptom
+ * - SEARCH:   varint patient ID
+ * - ATTEND / FREE / STATUS: no body
+ *
+ * RESPONSE PAYLOAD:
+ * - u8 opcode, u8 status, varint tag
+ * - STATUS_OK + REGISTER: varint patient ID
+ * - STATUS_OK + ATTEND / FREE / SEARCH: patient
+ * - STATUS_OK + STATUS: varint registered, waiting, in consultation,
+ *   rooms, completed
+ * - STATUS_ERROR: string message; STATUS_NOT_FOUND: no body
+ *
+ * ENCODINGS: varint = LEB128 (7 bits per byte), string = varint length +
+ * bytes, patient = varint id, u8 age, u8 priority, string name, string symptom
+ *
+ * PIPELINING: Clients may send any number of requests without waiting;
+ * responses on one connection come back in request order.
+ */
+namespace protocol {
+
+enum Opcode {
+    OP_REGISTER = 1,
+    OP_ATTEND = 2,
+    OP_FREE = 3,
+    OP_SEARCH = 4,
+    OP_STATUS = 5
+};
+
+enum Status {
+    STATUS_OK = 0,
+    STATUS_NOT_FOUND = 1,
+    STATUS_ERROR = 2
+};
+
+const std::uint32_t MAX_FRAME = 64 * 1024;  ///< Larger frames close the connection
+const std::size_t HEADER_BYTES = 4;
+
+/**
+ * PATIENT AS CARRIED ON THE WIRE
+ */
+struct WirePatient {
+    std::uint64_t id;
+    int age;
+    int priority;
+    std::string name;
+    std::string symptom;
+
+    WirePatient() : id(0), age(0), priority(0) {}
+};
+
+/**
+ * SYSTEM COUNTERS RETURNED BY OP_STATUS
+ */
+struct WireStatus {
+    std::uint64_t registered;
+    std::uint64_t waiting;
+    std::uint64_t inConsultation;
+    std::uint64_t rooms;
+    std::uint64_t completed;
+
+    WireStatus() : registered(0), waiting(0), inConsultation(0), rooms(0), completed(0) {}
+};
+
+/**
+ * PAYLOAD BUILDER - Reserves the length prefix, patched by finish()
+ */
+class Writer {
+private:
+    std::string& out;
+    std::size_t start;
+
+public:
+    explicit Writer(std::string& buffer) : out(buffer), start(buffer.size()) {
+        out.append(HEADER_BYTES, '\0');
+    }
+
+    void byte(int value) {
+        out.push_back((char)(std::uint8_t)value);
+    }
+
+    void varint(std::uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back((char)(std::uint8_t)((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+        out.push_back((char)(std::uint8_t)value);
+    }
+
+    void text(const std::string& value) {
+        varint(value.size());
+        out.append(value);
+    }
+
+    void patient(const WirePatient& p) {
+        varint(p.id);
+        byte(p.age);
+        byte(p.priority);
+        text(p.name);
+        text(p.symptom);
+    }
+
+    /**
+     * WRITE THE PAYLOAD LENGTH INTO THE RESERVED PREFIX
+     */
+    void finish() {
+        std::uint32_t length = (std::uint32_t)(out.size() - start - HEADER_BYTES);
+        for (std::size_t i = 0; i < HEADER_BYTES; i++) {
+            out[start + i] = (char)(std::uint8_t)(length >> (8 * i));
+        }
+    }
+};
+
+/**
+ * PAYLOAD PARSER
+ * EXCEPTION: Throws runtime_error when a field runs past the payload
+ */
+class Reader {
+private:
+    const char* data;
+    std::size_t length;
+    std::size_t position;
+
+    void require(std::size_t bytes) {
+        if (length - position < bytes) {
+            throw std::runtime_error("Truncated protocol frame");
+        }
+    }
+
+public:
+    Reader(const char* payload, std::size_t size) : data(payload), length(size), position(0) {}
+
+    int byte() {
+        require(1);
+        return (std::uint8_t)data[position++];
+    }
+
+    std::uint64_t varint() {
+        std::uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            int b = byte();
+            value |= (std::uint64_t)(b & 0x7F) << shift;
+            if ((b & 0x80) == 0) {
+                return value;
+            }
+        }
+        throw std::runtime_error("Malformed varint in protocol frame");
+    }
+
+    std::string text() {
+        std::uint64_t size = varint();
+        require((std::size_t)size);
+        std::string value(data + position, (std::size_t)size);
+        position += (std::size_t)size;
+        return value;
+    }
+
+    WirePatient patient() {
+        WirePatient p;
+        p.id = varint();
+        p.age = byte();
+        p.priority = byte();
+        p.name = text();
+        p.symptom = text();
+        return p;
+    }
+};
+
+/**
+ * SERVER ENDPOINT - "tcp:HOST:PORT" or "unix:PATH"
+ */
+struct Endpoint {
+    bool unixSocket;
+    std::string host;  ///< TCP: IPv4 address to bind or connect to
+    int port;          ///< TCP: port number
+    std::string path;  ///< Unix: socket file path
+
+    Endpoint() : unixSocket(false), host("127.0.0.1"), port(7400) {}
+
+    /**
+     * PARSE AN ENDPOINT STRING
+     * EXCEPTION: Throws invalid_argument for an unknown scheme or bad port
+     */
+    static Endpoint parse(const std::string& text) {
+        Endpoint endpoint;
+        if (text.compare(0, 5, "unix:") == 0 && text.size() > 5) {
+            endpoint.unixSocket = true;
+            endpoint.path = text.substr(5);
+            return endpoint;
+        }
+        std::size_t colon = text.rfind(':');
+        if (text.compare(0, 4, "tcp:") != 0 || colon <= 4) {
+            throw std::invalid_argument("Endpoint must be tcp:HOST:PORT or unix:PATH, got " + text);
+        }
+        endpoint.host = text.substr(4, colon - 4);
+        endpoint.port = std::atoi(text.c_str() + colon + 1);
+        if (endpoint.port <= 0 || endpoint.port > 65535) {
+            throw std::invalid_argument("Invalid port in endpoint " + text);
+        }
+        return endpoint;
+    }
+
+    std::string describe() const {
+        return unixSocket ? "unix:" + path : "tcp:" + host + ":" + std::to_string(port);
+    }
+};
+
+/**
+ * LENGTH OF THE FIRST COMPLETE FRAME IN A BUFFER
+ * @return Payload length, or -1 if the header or payload is incomplete
+ * EXCEPTION: Throws runtime_error for frames larger than MAX_FRAME
+ */
+inline long long completeFrame(const char* data, std::size_t available) {
+    if (available < HEADER_BYTES) {
+        return -1;
+    }
+    std::uint32_t length = 0;
+    for (std::size_t i = 0; i < HEADER_BYTES; i++) {
+        length |= (std::uint32_t)(std::uint8_t)data[i] << (8 * i);
+    }
+    if (length > MAX_FRAME) {
+        throw std::runtime_error("Protocol frame exceeds maximum size");
+    }
+    return available - HEADER_BYTES >= length ? (long long)length : -1;
+}
+
+}
+
+#endif
@@ -0,0 +1,259 @@
+#include "replication.h"
+#include "threadpool.h"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+ReplicationConfig::ReplicationConfig()
+    : replications(1000), minRooms(4), maxRooms(14), threads(0), slaPercentile(90.0) {
+    const double defaultSla[SimulationConfig::TRIAGE_LEVELS] = {5.0, 30.0, 120.0, 240.0, 720.0};
+    for (int i = 0; i < SimulationConfig::TRIAGE_LEVELS; i++) {
+        slaMinutes[i] = defaultSla[i];
+    }
+}
+
+/**
+ * PARSE A NUMERIC OPTION VALUE
+ * EXCEPTION: Throws invalid_argument if the text is not a number
+ */
+static double parseValue(const string& option, const string& text) {
+    char* end = NULL;
+    double value = strtod(text.c_str(), &end);
+    if (text.empty() || *end != '\0') {
+        throw invalid_argument("Invalid value for " + option + ": " + text);
+    }
+    return value;
+}
+
+void ReplicationConfig::parseArguments(int argc, char* argv[]) {
+    vector<char*> simulationOptions;
+
+    for (int i = 0; i < argc; i++) {
+        string option = argv[i];
+        if (i + 1 >= argc) {
+            throw invalid_argument("Missing value for option " + option);
+        }
+        string value = argv[i + 1];
+
+        if (option == "--replications") {
+            replications = (int)parseValue(option, value);
+        } else if (option == "--min-rooms") {
+            minRooms = (int)parseValue(option, value);
+        } else if (option == "--max-rooms") {
+            maxRooms = (int)parseValue(option, value);
+        } else if (option == "--threads") {
+            threads = (int)parseValue(option, value);
+        } else if (option == "--sla-percentile") {
+            slaPercentile = parseValue(option, value);
+        } else if (option == "--sla") {
+            stringstream fields(value);
+            string field;
+            int level = 0;
+            while (getline(fields, field, ',')) {
+                if (level >= SimulationConfig::TRIAGE_LEVELS) {
+                    throw invalid_argument("--sla expects 5 comma-separated targets");
+                }
+                slaMinutes[level++] = parseValue(option, field);
+            }
+            if (level != SimulationConfig::TRIAGE_LEVELS) {
+                throw invalid_argument("--sla expects 5 comma-separated targets");
+            }
+        } else {
+            // Everything else configures the underlying simulation model
+            simulationOptions.push_back(argv[i]);
+            simulationOptions.push_back(argv[i + 1]);
+        }
+        i++;
+    }
+
+    simulationOptions.push_back(NULL);
+    base.parseArguments((int)simulationOptions.size() - 1, &simulationOptions[0]);
+}
+
+ReplicationRunner::ReplicationRunner(const ReplicationConfig& cfg) : config(cfg) {
+    if (config.replications < 2) {
+        throw invalid_argument("At least 2 replications are needed for a confidence interval");
+    }
+    if (config.minRooms < 1 || config.maxRooms < config.minRooms) {
+        throw invalid_argument("Room sweep must satisfy 1 <= min-rooms <= max-rooms");
+    }
+    if (config.slaPercentile <= 0 || config.slaPercentile > 100) {
+        throw invalid_argument("SLA percentile must be in (0, 100]");
+    }
+}
+
+/**
+ * SPLITMIX64 STREAM DERIVATION
+ * - Mixes the replication index into the base seed with the SplitMix64
+ *   finalizer, producing well-separated seeds for the Mersenne Twister
+ */
+unsigned long long ReplicationRunner::streamSeed(unsigned long long baseSeed, unsigned long long replication) {
+    unsigned long long z = baseSeed + (replication + 1) * 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * MEAN AND STUDENT-T 95% CONFIDENCE INTERVAL
+ * - Two-sided critical values for small samples, normal 1.96 beyond 30
+ */
+ConfidenceInterval ReplicationRunner::summarize(const double* values, int count) {
+    static const double tCritical[31] = {
+        0.0, 12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+    };
+
+    ConfidenceInterval interval = {0.0, 0.0};
+    if (count <= 0) {
+        return interval;
+    }
+    double sum = 0.0;
+    for (int i = 0; i < count; i++) {
+        sum += values[i];
+    }
+    interval.mean = sum / count;
+    if (count < 2) {
+        return interval;
+    }
+
+    double squares = 0.0;
+    for (int i = 0; i < count; i++) {
+        double deviation = values[i] - interval.mean;
+        squares += deviation * deviation;
+    }
+    int degreesOfFreedom = count - 1;
+    double t = degreesOfFreedom <= 30 ? tCritical[degreesOfFreedom] : 1.96;
+    interval.halfWidth = t * sqrt(squares / degreesOfFreedom) / sqrt((double)count);
+    return interval;
+}
+
+/**
+ * RUN THE ROOM-COUNT SWEEP
+ *
+ * DATA LAYOUT: One row of metrics per (room count, replication) task, so
+ * tasks write disjoint slots and the reduction needs no locking:
+ * metric 0 = utilization, metrics 1..5 = SLA-percentile wait per level
+ */
+void ReplicationRunner::run(ostream& os) {
+    const int levels = SimulationConfig::TRIAGE_LEVELS;
+    const int metrics = levels + 1;
+    const int roomCounts = config.maxRooms - config.minRooms + 1;
+    const int reps = config.replications;
+    vector<double> samples((size_t)roomCounts * reps * metrics, 0.0);
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    ThreadPool pool(config.threads);
+
+    for (int r = 0; r < roomCounts; r++) {
+        for (int rep = 0; rep < reps; rep++) {
+            pool.submit([this, r, rep, reps, levels, metrics, &samples]() {
+                SimulationConfig model = config.base;
+                model.numberOfConsultationRooms = config.minRooms + r;
+                model.seed = streamSeed(config.base.seed, (unsigned long long)rep);
+
+                SimulationResult* result = new SimulationResult();
+                EmergencySimulation(model).run(*result);
+
+                double* row = &samples[((size_t)r * reps + rep) * metrics];
+                row[0] = result->utilization;
+                for (int level = 0; level < levels; level++) {
+                    row[level + 1] = result->levels[level].waitSeconds.percentile(config.slaPercentile) / 60.0;
+                }
+                delete result;
+            });
+        }
+    }
+    pool.wait();
+    double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    // Reduce every metric column into a confidence interval
+    vector<double> column(reps);
+    vector<int> minimumRooms(levels, -1);
+
+    os << "\n==================================================" << endl;
+    os << "     MONTE CARLO CAPACITY PLANNING REPORT" << endl;
+    os << "==================================================" << endl;
+    os << "Replications per room count: " << reps << " | Threads: " << pool.size()
+       << " | Horizon: " << fixed << setprecision(1) << config.base.durationHours << " h" << endl;
+    os << "SLA: p" << setprecision(1) << config.slaPercentile << " wait <= ";
+    for (int level = 0; level < levels; level++) {
+        os << setprecision(0) << config.slaMinutes[level] << (level + 1 < levels ? "/" : " minutes (TRIAGE I..V)");
+    }
+    os << endl;
+    os << setprecision(2) << "Total runs: " << (long long)roomCounts * reps << " in " << elapsed << " s" << endl;
+
+    os << "\n=== p" << setprecision(0) << config.slaPercentile
+       << " WAIT (minutes, mean +/- 95% CI; * = SLA met) ===" << endl;
+    os << left << setw(7) << "Rooms" << setw(16) << "Utilization";
+    for (int level = 0; level < levels; level++) {
+        os << setw(18) << ("TRIAGE " + to_string(level + 1));
+    }
+    os << right << endl;
+
+    for (int r = 0; r < roomCounts; r++) {
+        int rooms = config.minRooms + r;
+        os << left << setw(7) << rooms;
+        for (int metric = 0; metric < metrics; metric++) {
+            for (int rep = 0; rep < reps; rep++) {
+                column[rep] = samples[((size_t)r * reps + rep) * metrics + metric];
+            }
+            ConfidenceInterval interval = summarize(&column[0], reps);
+            ostringstream cell;
+            cell << fixed;
+            if (metric == 0) {
+                cell << setprecision(1) << interval.mean * 100.0 << "+/-" << interval.halfWidth * 100.0 << "%";
+                os << setw(16) << cell.str();
+            } else {
+                int level = metric - 1;
+                bool met = interval.upper() <= config.slaMinutes[level];
+                if (met && minimumRooms[level] < 0) {
+                    minimumRooms[level] = rooms;
+                }
+                cell << setprecision(1) << interval.mean << "+/-" << interval.halfWidth << (met ? "*" : "");
+                os << setw(18) << cell.str();
+            }
+        }
+        os << right << endl;
+    }
+
+    os << "\n=== MINIMUM ROOMS MEETING EACH TRIAGE SLA ===" << endl;
+    for (int level = 0; level < levels; level++) {
+        os << "TRIAGE " << (level + 1) << ": ";
+        if (minimumRooms[level] < 0) {
+            os << "not met within " << config.minRooms << "-" << config.maxRooms << " rooms" << endl;
+        } else if (minimumRooms[level] == config.minRooms && config.minRooms > 1) {
+            // Fewer rooms were never simulated, so the minimum may be lower
+            os << "<= " << minimumRooms[level] << " rooms (met at sweep start; lower --min-rooms to find the minimum)"
+               << endl;
+        } else {
+            os << minimumRooms[level] << " rooms" << endl;
+        }
+    }
+    os << "==================================================" << endl;
+}
+
+/**
+ * REPLICATION MODE ENTRY POINT
+ * - Configuration errors are reported and mapped to exit code 1
+ */
+int ReplicationRunner::runFromCommandLine(int argc, char* argv[]) {
+    try {
+        ReplicationConfig config;
+        config.parseArguments(argc, argv);
+        ReplicationRunner(config).run(cout);
+        return 0;
+    }
+    catch (const exception& e) {
+        cout << "\n[ERROR!] Replication run failed: " << e.what() << endl;
+        return 1;
+    }
+}
@@ -0,0 +1,107 @@
+#ifndef REPLICATION_H
+#define REPLICATION_H
+
+#include "simulation.h"
+#include <iostream>
+
+/**
+ * MONTE CARLO REPLICATION CONFIGURATION
+ *
+ * CAPACITY PLANNING QUESTION:
+ * "What is the smallest number of consultation rooms for which the
+ *  SLA-percentile triage wait of each level stays within its target?"
+ *
+ * DEFAULT SLA TARGETS (90th percentile wait, minutes):
+ * - TRIAGE I: 5 | TRIAGE II: 30 | TRIAGE III: 120 | TRIAGE IV: 240 | TRIAGE V: 720
+ */
+struct ReplicationConfig {
+    SimulationConfig base;                                ///< Model shared by every replication
+    int replications;                                     ///< Independent runs per room count
+    int minRooms;                                         ///< First room count of the sweep
+    int maxRooms;                                         ///< Last room count of the sweep
+    int threads;                                          ///< Worker threads (0 = all cores)
+    double slaPercentile;                                 ///< Wait percentile checked against SLA
+    double slaMinutes[SimulationConfig::TRIAGE_LEVELS];   ///< Target wait per level
+
+    ReplicationConfig();
+
+    /**
+     * PARSE COMMAND-LINE OPTIONS
+     * @param argc/argv: Options following "--replicate"
+     *
+     * OPTIONS: --replications N, --min-rooms N, --max-rooms N, --threads N,
+     * --sla m1,m2,m3,m4,m5, --sla-percentile P, plus every simulation option
+     *
+     * EXCEPTION: Throws invalid_argument on malformed options
+     */
+    void parseArguments(int argc, char* argv[]);
+};
+
+/**
+ * SAMPLE SUMMARY WITH A 95% CONFIDENCE INTERVAL
+ */
+struct ConfidenceInterval {
+    double mean;       ///< Sample mean across replications
+    double halfWidth;  ///< Student-t 95% half-width of the mean
+
+    double lower() const { return mean - halfWidth; }
+    double upper() const { return mean + halfWidth; }
+};
+
+/**
+ * PARALLEL MONTE CARLO REPLICATION RUNNER
+ *
+ * EXECUTION MODEL:
+ * - Every (room count, replication) pair is one task on a work-stealing
+ *   ThreadPool spanning all cores
+ * - Each task owns its random stream, derived from the base seed and the
+ *   replication index with SplitMix64, so results do not depend on which
+ *   thread runs the task or in which order (runs are reproducible)
+ * - Replication i uses the same stream for every room count (common random
+ *   numbers), which sharpens comparisons between room counts
+ *
+ * REDUCTION: Per room count, the mean and 95% confidence interval of room
+ * utilization and of each level's SLA-percentile wait. A level meets its SLA
+ * when the upper confidence bound is within the target.
+ */
+class ReplicationRunner {
+private:
+    ReplicationConfig config;
+
+public:
+    /**
+     * CONSTRUCTOR
+     * EXCEPTION: Throws invalid_argument for an empty sweep or no replications
+     */
+    explicit ReplicationRunner(const ReplicationConfig& cfg);
+
+    /**
+     * RUN THE SWEEP AND PRINT THE CAPACITY REPORT
+     * @param os: Destination stream
+     */
+    void run(std::ostream& os);
+
+    /**
+     * SEED OF THE RANDOM STREAM FOR ONE REPLICATION
+     * @param baseSeed: Seed of the experiment
+     * @param replication: Replication index
+     * @return Statistically independent 64-bit seed (SplitMix64)
+     */
+    static unsigned long long streamSeed(unsigned long long baseSeed, unsigned long long replication);
+
+    /**
+     * MEAN AND 95% CONFIDENCE INTERVAL OF A SAMPLE
+     * @param values: Sample array
+     * @param count: Number of samples
+     */
+    static ConfidenceInterval summarize(const double* values, int count);
+
+    /**
+     * REPLICATION MODE ENTRY POINT
+     * @param argc/argv: Options following "--replicate"
+     * @return Process exit code
+     */
+    static int runFromCommandLine(int argc, char* argv[]);
+};
+
+#endif
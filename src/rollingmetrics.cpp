@@ -0,0 +1,203 @@
+#include "rollingmetrics.h"
+#include <stdexcept>
+
+using namespace std;
+
+RollingMetrics::RollingMetrics(long long nowNanos, int minutes, int hours, int days) : lastTime(nowNanos) {
+    if (minutes <= 0 || hours <= 0 || days <= 0) {
+        throw invalid_argument("Rolling metrics need at least one interval per resolution");
+    }
+    for (int i = 0; i < GAUGES; i++) {
+        gauges[i] = 0;
+    }
+    const long long widths[RESOLUTIONS] = {MINUTE_NANOS, HOUR_NANOS, DAY_NANOS};
+    const int sizes[RESOLUTIONS] = {minutes, hours, days};
+    for (int r = 0; r < RESOLUTIONS; r++) {
+        Bucket empty = Bucket();
+        empty.interval = -1;
+        rings[r].width = widths[r];
+        rings[r].buckets.assign((size_t)sizes[r], empty);
+        MEMORY_ACCOUNT_ALLOCATE(rings[r].buckets.capacity() * sizeof(Bucket));
+        rings[r].current = nowNanos / widths[r];
+        open(rings[r], rings[r].current, 0);
+    }
+}
+
+RollingMetrics::~RollingMetrics() {
+    for (int r = 0; r < RESOLUTIONS; r++) {
+        MEMORY_ACCOUNT_RELEASE(rings[r].buckets.capacity() * sizeof(Bucket));
+    }
+}
+
+/**
+ * START A BUCKET FOR interval - the gauges carry their current values in,
+ * as if already observed for covered nanoseconds
+ */
+void RollingMetrics::open(Ring& ring, long long interval, long long covered) {
+    Bucket& bucket = ring.buckets[(size_t)(interval % (long long)ring.buckets.size())];
+    bucket.interval = interval;
+    bucket.covered = covered;
+    for (int i = 0; i < COUNTERS; i++) {
+        bucket.counts[i] = 0;
+    }
+    for (int i = 0; i < GAUGES; i++) {
+        bucket.areas[i] = (GaugeArea)gauges[i] * covered;
+        bucket.maxima[i] = gauges[i];
+    }
+}
+
+/**
+ * BRING ONE RING FROM lastTime TO now
+ * - Same interval: the gauges' area grows by value x elapsed time
+ * - Later interval: the current bucket is closed at its end, skipped
+ *   intervals are opened fully covered (only the last ring-size - 1 of
+ *   them can still be read) and the bucket of now is opened
+ */
+void RollingMetrics::roll(Ring& ring, long long now) {
+    long long interval = now / ring.width;
+    Bucket& bucket = ring.buckets[(size_t)(ring.current % (long long)ring.buckets.size())];
+    long long until = interval == ring.current ? now : (ring.current + 1) * ring.width;
+    long long elapsed = until - lastTime;
+    bucket.covered += elapsed;
+    for (int i = 0; i < GAUGES; i++) {
+        bucket.areas[i] += (GaugeArea)gauges[i] * elapsed;
+    }
+    if (interval == ring.current) {
+        return;
+    }
+
+    long long first = ring.current + 1;
+    if (interval - first >= (long long)ring.buckets.size()) {
+        first = interval - (long long)ring.buckets.size() + 1;
+    }
+    for (long long skipped = first; skipped < interval; skipped++) {
+        open(ring, skipped, ring.width);
+    }
+    open(ring, interval, now - interval * ring.width);
+    ring.current = interval;
+}
+
+void RollingMetrics::advance(long long nowNanos) {
+    if (nowNanos <= lastTime) {
+        return;
+    }
+    for (int r = 0; r < RESOLUTIONS; r++) {
+        roll(rings[r], nowNanos);
+    }
+    lastTime = nowNanos;
+}
+
+void RollingMetrics::count(RollingCounter counter, long long nowNanos, long long amount) {
+    advance(nowNanos);
+    for (int r = 0; r < RESOLUTIONS; r++) {
+        Ring& ring = rings[r];
+        ring.buckets[(size_t)(ring.current % (long long)ring.buckets.size())].counts[counter] += amount;
+    }
+}
+
+void RollingMetrics::set(RollingGauge gauge, int value, long long nowNanos) {
+    advance(nowNanos);
+    gauges[gauge] = value;
+    for (int r = 0; r < RESOLUTIONS; r++) {
+        Ring& ring = rings[r];
+        Bucket& bucket = ring.buckets[(size_t)(ring.current % (long long)ring.buckets.size())];
+        if (value > bucket.maxima[gauge]) {
+            bucket.maxima[gauge] = value;
+        }
+    }
+}
+
+/**
+ * SLOT OF interval IN THE RING - non-negative even for intervals before
+ * the steady clock's epoch, which a long window asks for on a machine
+ * that has been up for less than the window
+ */
+size_t RollingMetrics::slotOf(const Ring& ring, long long interval) {
+    long long size = (long long)ring.buckets.size();
+    long long slot = interval % size;
+    return (size_t)(slot < 0 ? slot + size : slot);
+}
+
+/**
+ * BUCKET OF interval, NULL IF NOT KEPT (or not yet started)
+ * - Intervals before 0 never had a bucket; unused buckets hold -1, so
+ *   intervals before the ring's first one are empty as well
+ * @param slot: slotOf(interval), carried by the caller between
+ *              consecutive intervals to avoid a division per bucket
+ */
+const RollingMetrics::Bucket* RollingMetrics::find(const Ring& ring, long long interval, size_t& slot) const {
+    const Bucket* bucket = &ring.buckets[slot];
+    if (++slot == ring.buckets.size()) {
+        slot = 0;
+    }
+    return interval >= 0 && interval <= ring.current && bucket->interval == interval ? bucket : NULL;
+}
+
+void RollingMetrics::checkQuery(RollingResolution resolution, int groups, int width) const {
+    if (groups <= 0 || width <= 0) {
+        throw invalid_argument("Rolling series need a positive number of points and width");
+    }
+    if ((long long)groups * width > (long long)rings[resolution].buckets.size()) {
+        throw invalid_argument("Rolling series asks for more intervals than are kept");
+    }
+}
+
+/**
+ * SERIES IMPLEMENTATION
+ * - The last point starts at the current interval rounded down to a
+ *   multiple of width; groups x width <= ring size keeps every interval
+ *   read inside the ring
+ * - Early in the clock's life the first points start before interval 0;
+ *   they come back empty
+ */
+vector<RollingPoint> RollingMetrics::counterSeries(RollingCounter counter, RollingResolution resolution, int groups,
+                                                   int width) const {
+    checkQuery(resolution, groups, width);
+    const Ring& ring = rings[resolution];
+    long long start = (ring.current / width - (groups - 1)) * width;
+    size_t slot = slotOf(ring, start);
+    vector<RollingPoint> series((size_t)groups);
+    for (int g = 0; g < groups; g++, start += width) {
+        RollingPoint& point = series[(size_t)g];
+        point.startNanos = start * ring.width;
+        point.count = 0;
+        point.mean = 0.0;
+        point.max = 0;
+        for (long long interval = start; interval < start + width; interval++) {
+            const Bucket* bucket = find(ring, interval, slot);
+            if (bucket != NULL) {
+                point.count += bucket->counts[counter];
+            }
+        }
+    }
+    return series;
+}
+
+vector<RollingPoint> RollingMetrics::gaugeSeries(RollingGauge gauge, RollingResolution resolution, int groups,
+                                                 int width) const {
+    checkQuery(resolution, groups, width);
+    const Ring& ring = rings[resolution];
+    long long start = (ring.current / width - (groups - 1)) * width;
+    size_t slot = slotOf(ring, start);
+    vector<RollingPoint> series((size_t)groups);
+    for (int g = 0; g < groups; g++, start += width) {
+        RollingPoint& point = series[(size_t)g];
+        point.startNanos = start * ring.width;
+        point.count = 0;
+        point.max = 0;
+        GaugeArea area = 0;
+        long long covered = 0;
+        for (long long interval = start; interval < start + width; interval++) {
+            const Bucket* bucket = find(ring, interval, slot);
+            if (bucket != NULL) {
+                area += bucket->areas[gauge];
+                covered += bucket->covered;
+                if (bucket->maxima[gauge] > point.max) {
+                    point.max = bucket->maxima[gauge];
+                }
+            }
+        }
+        point.mean = covered > 0 ? (double)area / (double)covered : 0.0;
+    }
+    return series;
+}
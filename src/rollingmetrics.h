@@ -0,0 +1,172 @@
+#ifndef ROLLINGMETRICS_H
+#define ROLLINGMETRICS_H
+
+#include "memorystats.h"
+#include <vector>
+
+/**
+ * EVENTS COUNTED PER INTERVAL
+ */
+enum RollingCounter {
+    ROLLING_ARRIVALS,     ///< Patients registered (or admitted from another site)
+    ROLLING_ATTENDED,     ///< Patients moved to a consultation room
+    ROLLING_DISCHARGES,   ///< Consultations completed
+    ROLLING_TRANSFERS,    ///< Patients sent to another site
+    ROLLING_OVERDUE       ///< Consultations that passed their expected end
+};
+
+/**
+ * LEVELS SAMPLED CONTINUOUSLY (time-weighted mean and maximum per interval)
+ */
+enum RollingGauge {
+    ROLLING_OCCUPIED_ROOMS,  ///< Consultation rooms in use
+    ROLLING_WAITING          ///< Patients in triage
+};
+
+/**
+ * INTERVAL LENGTHS KEPT, FROM FINEST TO COARSEST
+ */
+enum RollingResolution { ROLLING_MINUTE, ROLLING_HOUR, ROLLING_DAY };
+
+/**
+ * ONE POINT OF A SERIES
+ * - Counter series: count
+ * - Gauge series: mean (over the time observed in the point) and max
+ */
+struct RollingPoint {
+    long long startNanos;  ///< Steady-clock start of the point's first interval
+    long long count;
+    double mean;
+    int max;
+};
+
+/**
+ * ROLLING TIME-BUCKETED METRICS
+ *
+ * IMPLEMENTATION:
+ * - One ring of buckets per resolution (1 minute, 1 hour, 1 day), all
+ *   updated by every event, so each resolution is a rollup kept ready
+ *   instead of being summed from the finer one at query time
+ * - A bucket holds the counters, the gauge areas (value x nanoseconds)
+ *   and the gauge maxima of one interval, stamped with the interval's
+ *   number; a slot still stamped with an older interval reads as empty,
+ *   so wrapping around never needs a sweep
+ * - Gauges hold their value between changes: when time moves into a new
+ *   interval the previous one is closed at the current values, and
+ *   intervals skipped while idle are filled with them (at most the ring
+ *   size, usually none)
+ *
+ * GAUGE AREAS: value x nanoseconds reaches 2^63 after a day at ~107,000
+ * or 90 days at ~1,190, so areas are 128-bit integers (exact, and a sum
+ * over the longest query cannot overflow); doubles where the compiler
+ * has no 128-bit integer.
+ *
+ * Memory is fixed at construction: 112 bytes per bucket, 1698 buckets
+ * (186 KB) with the default 24 hours / 7 days / 90 days of history.
+ *
+ * PERFORMANCE CHARACTERISTICS:
+ * - count / set: O(1) - one bucket per resolution, plus O(1) per interval
+ *   boundary crossed since the previous event
+ * - counterSeries / gaugeSeries: O(groups x width) buckets read, never
+ *   any patient data
+ */
+class RollingMetrics {
+public:
+    static const int COUNTERS = 5;
+    static const int GAUGES = 2;
+    static const int RESOLUTIONS = 3;
+
+#ifdef __SIZEOF_INT128__
+    typedef __int128 GaugeArea;       ///< Gauge value x nanoseconds
+#else
+    typedef double GaugeArea;
+#endif
+
+private:
+    struct Bucket {
+        long long interval;           ///< Interval number (time / width), -1 if never used
+        long long covered;            ///< Nanoseconds of the interval observed so far
+        long long counts[COUNTERS];
+        GaugeArea areas[GAUGES];      ///< Gauge value x nanoseconds
+        int maxima[GAUGES];
+    };
+
+    struct Ring {
+        long long width;              ///< Interval length in nanoseconds
+        long long current;            ///< Interval of the bucket being filled
+        std::vector<Bucket> buckets;
+    };
+
+    Ring rings[RESOLUTIONS];
+    int gauges[GAUGES];               ///< Current gauge values
+    long long lastTime;               ///< Time of the latest event
+    MEMORY_ACCOUNT
+
+    void open(Ring& ring, long long interval, long long covered);
+    void roll(Ring& ring, long long now);
+    static std::size_t slotOf(const Ring& ring, long long interval);
+    const Bucket* find(const Ring& ring, long long interval, size_t& slot) const;
+    void checkQuery(RollingResolution resolution, int groups, int width) const;
+
+public:
+    static const long long MINUTE_NANOS = 60LL * 1000000000LL;
+    static const long long HOUR_NANOS = 60 * MINUTE_NANOS;
+    static const long long DAY_NANOS = 24 * HOUR_NANOS;
+
+    /**
+     * CONSTRUCTOR
+     * @param nowNanos: Steady-clock start time; gauges start at 0
+     * @param minutes, hours, days: Intervals kept per resolution
+     * EXCEPTION: Throws invalid_argument for a non-positive ring size
+     */
+    RollingMetrics(long long nowNanos, int minutes = 1440, int hours = 168, int days = 90);
+    ~RollingMetrics();
+
+    /**
+     * RECORD amount EVENTS AT nowNanos
+     */
+    void count(RollingCounter counter, long long nowNanos, long long amount = 1);
+
+    /**
+     * A GAUGE CHANGES TO value AT nowNanos
+     */
+    void set(RollingGauge gauge, int value, long long nowNanos);
+
+    /**
+     * MOVE TIME TO nowNanos WITHOUT AN EVENT (before a query)
+     * - Earlier times are ignored: events never go back in time
+     */
+    void advance(long long nowNanos);
+
+    /**
+     * LAST groups POINTS OF width INTERVALS EACH, OLDEST FIRST
+     * - Points are aligned to multiples of width intervals, so with
+     *   width 5 at ROLLING_MINUTE every point is a clock 5-minute block;
+     *   the last one holds the current (partial) interval
+     * - Intervals before the first event or already overwritten count as
+     *   empty; a gauge point with no time observed has mean 0
+     * EXCEPTION: Throws invalid_argument when groups x width exceeds the
+     *            ring or either is not positive
+     *
+     * EXAMPLE: counterSeries(ROLLING_ARRIVALS, ROLLING_MINUTE, 288, 5) -
+     * arrivals per 5 minutes over the last 24 hours
+     */
+    std::vector<RollingPoint> counterSeries(RollingCounter counter, RollingResolution resolution, int groups,
+                                            int width = 1) const;
+    std::vector<RollingPoint> gaugeSeries(RollingGauge gauge, RollingResolution resolution, int groups,
+                                          int width = 1) const;
+
+    int capacity(RollingResolution resolution) const { return (int)rings[resolution].buckets.size(); }
+    int value(RollingGauge gauge) const { return gauges[gauge]; }
+    long long now() const { return lastTime; }
+
+    /**
+     * ALLOCATION STATISTICS (zero unless built with HOSPITAL_MEMORY_STATS)
+     */
+    MemoryStats memoryStats() const { return MEMORY_ACCOUNT_SNAPSHOT(); }
+
+    RollingMetrics(const RollingMetrics&) = delete;
+    RollingMetrics& operator=(const RollingMetrics&) = delete;
+};
+
+#endif
@@ -0,0 +1,315 @@
+#include "roomscheduler.h"
+#include "trace.h"
+#include <algorithm>
+#include <iomanip>
+#include <stdexcept>
+
+using namespace std;
+
+/**
+ * INDEX OF THE LOWEST SET BIT (mask must not be zero)
+ */
+static inline int lowestBit(uint64_t mask) {
+    return __builtin_ctzll(mask);
+}
+
+RoomScheduler::RoomScheduler(const HospitalConfig& config)
+    : freePools(0), numLevels(config.triageLevels), totalWaiting(0), totalFree(0),
+      fallback(config.fallback), anyRoomLevel(config.anyRoomLevel) {
+    config.validate();
+    int poolTotal = (int)config.specialties.size();
+    allPools = poolTotal == 64 ? ~0ULL : (1ULL << poolTotal) - 1;
+    waitingPools.assign((size_t)numLevels, 0);
+
+    int firstRoom = 0;
+    pools.resize((size_t)poolTotal);
+    for (int p = 0; p < poolTotal; p++) {
+        RoomPool& pool = pools[(size_t)p];
+        pool.name = config.specialties[(size_t)p].name;
+        pool.firstRoom = firstRoom;
+        pool.rooms = config.specialties[(size_t)p].rooms;
+        pool.freeRooms = pool.rooms;
+
+        // Every room starts free: full words, then the partial last word
+        size_t words = ((size_t)pool.rooms + 63) / 64;
+        pool.freeBits.assign(words, ~0ULL);
+        if (pool.rooms % 64 != 0) {
+            pool.freeBits[words - 1] = (1ULL << (pool.rooms % 64)) - 1;
+        }
+        pool.summary.assign((words + 63) / 64, 0);
+        for (size_t w = 0; w < words; w++) {
+            pool.summary[w / 64] |= 1ULL << (w % 64);
+        }
+        pool.waiting = new PriorityQueue<Patient*>(numLevels);
+
+        roomPool.insert(roomPool.end(), (size_t)pool.rooms, p);
+        firstRoom += pool.rooms;
+        freePools |= 1ULL << p;
+    }
+    occupants.assign((size_t)firstRoom, NULL);
+    totalFree = firstRoom;
+}
+
+RoomScheduler::~RoomScheduler() {
+    for (size_t p = 0; p < pools.size(); p++) {
+        delete pools[p].waiting;
+    }
+}
+
+/**
+ * ROOM POOLS A PATIENT OF pool AT level MAY BE GIVEN
+ * - The first specialty configured is the general pool (bit 0)
+ */
+uint64_t RoomScheduler::eligiblePools(int pool, int level) const {
+    if (level <= anyRoomLevel || fallback == FALLBACK_ANY) {
+        return allPools;
+    }
+    uint64_t own = 1ULL << pool;
+    return fallback == FALLBACK_GENERAL ? own | 1ULL : own;
+}
+
+/**
+ * KEEP waitingPools IN STEP WITH ONE (pool, level) BUCKET
+ */
+void RoomScheduler::levelChanged(int pool, int level) {
+    if (pools[(size_t)pool].waiting->bucketLen(level) > 0) {
+        waitingPools[(size_t)level - 1] |= 1ULL << pool;
+    } else {
+        waitingPools[(size_t)level - 1] &= ~(1ULL << pool);
+    }
+}
+
+/**
+ * CLAIM THE LOWEST FREE ROOM OF A POOL (the pool must have one)
+ * - Summary word first, then the bitmap word it points to: two ctz per
+ *   4096 rooms scanned
+ */
+int RoomScheduler::takeRoom(int pool) {
+    RoomPool& p = pools[(size_t)pool];
+    size_t s = 0;
+    while (p.summary[s] == 0) {
+        s++;
+    }
+    size_t word = s * 64 + (size_t)lowestBit(p.summary[s]);
+    int bit = lowestBit(p.freeBits[word]);
+    p.freeBits[word] &= p.freeBits[word] - 1;
+    if (p.freeBits[word] == 0) {
+        p.summary[s] &= ~(1ULL << (word % 64));
+    }
+    p.freeRooms--;
+    totalFree--;
+    if (p.freeRooms == 0) {
+        freePools &= ~(1ULL << pool);
+    }
+    return p.firstRoom + (int)word * 64 + bit;
+}
+
+void RoomScheduler::add(Patient* patient) {
+    if (patient->specialty < 0 || patient->specialty >= (int)pools.size()) {
+        throw invalid_argument("Unknown specialty for patient " + to_string(patient->id));
+    }
+    pools[(size_t)patient->specialty].waiting->addByArrival(patient);
+    waitingPools[(size_t)patient->priority - 1] |= 1ULL << patient->specialty;
+    totalWaiting++;
+}
+
+/**
+ * DISPATCH IMPLEMENTATION
+ * - Visits at most levels x specialties bucket heads; every test on rooms
+ *   is a mask intersection
+ */
+RoomAssignment RoomScheduler::dispatch() {
+    TRACE_SCOPE("RoomScheduler::dispatch");
+    RoomAssignment assignment;
+    assignment.patient = NULL;
+    assignment.room = -1;
+    assignment.pool = -1;
+    if (totalWaiting == 0 || freePools == 0) {
+        return assignment;
+    }
+
+    for (int level = 1; level <= numLevels; level++) {
+        uint64_t candidates = waitingPools[(size_t)level - 1];
+        int bestPool = -1;
+        int roomFrom = -1;
+        Patient* best = NULL;
+        while (candidates != 0) {
+            int pool = lowestBit(candidates);
+            candidates &= candidates - 1;
+            uint64_t usable = eligiblePools(pool, level) & freePools;
+            if (usable == 0) {
+                continue;
+            }
+            Patient* head = NULL;
+            pools[(size_t)pool].waiting->peekLevel(level, head);
+            if (best == NULL || head->waitingBefore(*best)) {
+                best = head;
+                bestPool = pool;
+                roomFrom = (usable >> pool) & 1ULL ? pool : lowestBit(usable);
+            }
+        }
+        if (bestPool < 0) {
+            continue;
+        }
+
+        Patient* patient = NULL;
+        pools[(size_t)bestPool].waiting->takeOldest(level, 1, &patient);
+        levelChanged(bestPool, level);
+        totalWaiting--;
+
+        int room = takeRoom(roomFrom);
+        occupants[(size_t)room] = patient;
+        patient->room = room;
+        assignment.patient = patient;
+        assignment.room = room;
+        assignment.pool = roomFrom;
+        return assignment;
+    }
+    return assignment;
+}
+
+Patient* RoomScheduler::release(int room) {
+    if (room < 0 || room >= (int)occupants.size()) {
+        throw out_of_range("Room " + to_string(room) + " does not exist");
+    }
+    Patient* patient = occupants[(size_t)room];
+    if (patient == NULL) {
+        return NULL;
+    }
+    occupants[(size_t)room] = NULL;
+    patient->room = -1;
+
+    int pool = roomPool[(size_t)room];
+    RoomPool& p = pools[(size_t)pool];
+    size_t local = (size_t)(room - p.firstRoom);
+    size_t word = local / 64;
+    p.freeBits[word] |= 1ULL << (local % 64);
+    p.summary[word / 64] |= 1ULL << (word % 64);
+    p.freeRooms++;
+    totalFree++;
+    freePools |= 1ULL << pool;
+    return patient;
+}
+
+/**
+ * TAKE OLDEST ACROSS SPECIALTIES
+ * - Merges the level's heads by arrival one patient at a time; once a single
+ *   specialty is left the rest comes from it in one call
+ */
+int RoomScheduler::takeOldest(int priority, int k, Patient** out) {
+    if (priority < 1 || priority > numLevels) {
+        return 0;
+    }
+    int taken = 0;
+    while (taken < k) {
+        uint64_t candidates = waitingPools[(size_t)priority - 1];
+        if (candidates == 0) {
+            break;
+        }
+        int bestPool = lowestBit(candidates);
+        int batch = k - taken;
+        if ((candidates & (candidates - 1)) != 0) {
+            Patient* best = NULL;
+            for (; candidates != 0; candidates &= candidates - 1) {
+                int pool = lowestBit(candidates);
+                Patient* head = NULL;
+                pools[(size_t)pool].waiting->peekLevel(priority, head);
+                if (best == NULL || head->waitingBefore(*best)) {
+                    best = head;
+                    bestPool = pool;
+                }
+            }
+            batch = 1;
+        }
+        taken += pools[(size_t)bestPool].waiting->takeOldest(priority, batch, out + taken);
+        levelChanged(bestPool, priority);
+    }
+    totalWaiting -= taken;
+    return taken;
+}
+
+/**
+ * OLDEST ACROSS SPECIALTIES
+ * - Each queue yields its own k oldest (PriorityQueue::oldest); the union
+ *   is cut down to the k earliest arrivals
+ */
+int RoomScheduler::oldest(int k, Patient** out) {
+    if (k <= 0) {
+        return 0;
+    }
+    if (pools.size() == 1) {
+        return pools[0].waiting->oldest(k, out);
+    }
+    vector<Patient*> merged;
+    for (size_t p = 0; p < pools.size(); p++) {
+        size_t start = merged.size();
+        merged.resize(start + (size_t)min(k, pools[p].waiting->len()));
+        pools[p].waiting->oldest((int)(merged.size() - start), merged.data() + start);
+    }
+    size_t found = min(merged.size(), (size_t)k);
+    partial_sort(merged.begin(), merged.begin() + (ptrdiff_t)found, merged.end(),
+                 [](const Patient* a, const Patient* b) { return a->waitingBefore(*b); });
+    copy(merged.begin(), merged.begin() + (ptrdiff_t)found, out);
+    return (int)found;
+}
+
+bool RoomScheduler::contains(int patientId) {
+    for (size_t p = 0; p < pools.size(); p++) {
+        if (pools[p].waiting->contains(patientId)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int RoomScheduler::waiting(int priority) {
+    int count = 0;
+    for (size_t p = 0; p < pools.size(); p++) {
+        count += pools[p].waiting->bucketLen(priority);
+    }
+    return count;
+}
+
+int RoomScheduler::findPool(const string& name) const {
+    for (size_t p = 0; p < pools.size(); p++) {
+        if (pools[p].name == name) {
+            return (int)p;
+        }
+    }
+    return -1;
+}
+
+void RoomScheduler::reserve(int perLevel) {
+    for (size_t p = 0; p < pools.size(); p++) {
+        pools[p].waiting->reserve(perLevel);
+    }
+}
+
+MemoryStats RoomScheduler::memoryStats() {
+    MemoryStats stats;
+    for (size_t p = 0; p < pools.size(); p++) {
+        stats += pools[p].waiting->memoryStats();
+    }
+    return stats;
+}
+
+void RoomScheduler::displayState(ostream& out) {
+    const char* policies[] = {"none (own specialty only)", "general pool", "any pool"};
+    const char* levelNames[] = {"I", "II", "III", "IV", "V"};
+    out << "\n=== ROOMS AND TRIAGE BY SPECIALTY ===" << endl;
+    out << "Fallback when a specialty is full: " << policies[fallback] << endl;
+    if (anyRoomLevel > 0) {
+        out << "TRIAGE I" << (anyRoomLevel > 1 ? string("-") + levelNames[anyRoomLevel - 1] : string())
+            << " may take any free room" << endl;
+    }
+    for (size_t p = 0; p < pools.size(); p++) {
+        RoomPool& pool = pools[p];
+        out << left << setw(14) << pool.name << right << " rooms " << pool.firstRoom + 1 << "-"
+            << pool.firstRoom + pool.rooms << " | free " << pool.freeRooms << "/" << pool.rooms
+            << " | waiting " << pool.waiting->len() << " (";
+        for (int level = 1; level <= numLevels; level++) {
+            out << (level > 1 ? " " : "") << levelNames[level - 1] << ":" << pool.waiting->bucketLen(level);
+        }
+        out << ")" << endl;
+    }
+}
@@ -0,0 +1,153 @@
+#ifndef ROOMSCHEDULER_H
+#define ROOMSCHEDULER_H
+
+#include "hospitalconfig.h"
+#include "memorystats.h"
+#include "patient.h"
+#include "priorityqueue.h"
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * RESULT OF ONE DISPATCH DECISION
+ * - patient is NULL when no waiting patient has an eligible free room
+ */
+struct RoomAssignment {
+    Patient* patient;
+    int room;  ///< 0-based room number across all pools
+    int pool;  ///< Specialty the room belongs to
+};
+
+/**
+ * SPECIALTY-AWARE ROOM SCHEDULER
+ *
+ * IMPLEMENTATION:
+ * - One triage PriorityQueue per specialty (patients wait for their own
+ *   kind of room) and one room pool per specialty; pool p owns the
+ *   contiguous room numbers [firstRoom, firstRoom + rooms)
+ * - Each pool tracks its free rooms in a two-level bitmap: one bit per
+ *   room, plus a summary word with one bit per non-empty bitmap word
+ * - Two 64-bit masks summarise the whole department: freePools (pools
+ *   with a free room) and waitingPools[level] (pools with a patient
+ *   waiting at that level)
+ *
+ * DISPATCH (most urgent level first):
+ * - For each pool with patients at the level, the eligible room pools are
+ *   its own plus the fallback ones (FallbackPolicy; levels up to
+ *   anyRoomLevel may use any pool); intersected with freePools
+ * - Among the pools that can be served, the oldest head (earliest
+ *   arrival) wins, so arrival order holds across specialties within a
+ *   level; each level keeps its patients in arrival order, transferred
+ *   ones included (PriorityQueue::addByArrival)
+ * - The patient gets a room of its own pool when one is free, otherwise
+ *   of the lowest-numbered eligible pool (the general pool first)
+ *
+ * A patient whose pools are all busy does not block the others: a less
+ * urgent patient with a free eligible room is dispatched instead.
+ *
+ * TIME COMPLEXITY: dispatch and release are O(levels * specialties) bit
+ * operations plus one bitmap word scan per 4096 rooms of a pool - constant
+ * for a configured department, independent of the patients waiting.
+ */
+class RoomScheduler {
+private:
+    struct RoomPool {
+        std::string name;
+        int firstRoom;
+        int rooms;
+        int freeRooms;
+        std::vector<std::uint64_t> freeBits;  ///< Bit i set: room firstRoom + i is free
+        std::vector<std::uint64_t> summary;   ///< Bit w set: freeBits[w] != 0
+        PriorityQueue<Patient*>* waiting;
+    };
+
+    std::vector<RoomPool> pools;
+    std::vector<Patient*> occupants;      ///< Patient in each room, NULL when free
+    std::vector<int> roomPool;            ///< Pool of each room
+    std::uint64_t freePools;              ///< Bit p set: pool p has a free room
+    std::vector<std::uint64_t> waitingPools;  ///< [level - 1]: bit p set when pool p has patients at that level
+    std::uint64_t allPools;
+    int numLevels;
+    int totalWaiting;
+    int totalFree;
+    FallbackPolicy fallback;
+    int anyRoomLevel;
+
+    std::uint64_t eligiblePools(int pool, int level) const;
+    int takeRoom(int pool);
+    void levelChanged(int pool, int level);
+
+public:
+    /**
+     * CONSTRUCTOR - Pools and triage levels from the configuration
+     * EXCEPTION: Throws invalid_argument for an invalid configuration
+     */
+    explicit RoomScheduler(const HospitalConfig& config);
+    ~RoomScheduler();
+
+    /**
+     * TRIAGE SIDE
+     * - add: queue a patient at its level in its specialty's queue
+     *   (throws invalid_argument for an unknown specialty index and
+     *   runtime_error for an invalid priority, like PriorityQueue::add)
+     * - takeOldest: remove up to k patients of one level, oldest first
+     *   across specialties (transfers)
+     * - oldest: up to k waiting patients across every level and specialty,
+     *   longest waiting first
+     */
+    void add(Patient* patient);
+    int takeOldest(int priority, int k, Patient** out);
+    int oldest(int k, Patient** out);
+    bool contains(int patientId);
+    int waiting() const { return totalWaiting; }
+    int waiting(int priority);
+
+    /**
+     * ROOM SIDE
+     * - dispatch: pick the next patient and room (see class comment); the
+     *   patient leaves triage and its room field is set
+     * - release: free a room, returning its patient (room field reset to
+     *   -1) or NULL when it was free; throws out_of_range for a bad room
+     * - occupant: patient in a room, NULL when free (room must exist)
+     */
+    RoomAssignment dispatch();
+    Patient* release(int room);
+    int rooms() const { return (int)occupants.size(); }
+    Patient* occupant(int room) const { return occupants[(size_t)room]; }
+    int freeRooms() const { return totalFree; }
+
+    /**
+     * SPECIALTY POOLS
+     * - findPool: index of the specialty with that name, -1 if none
+     */
+    int poolCount() const { return (int)pools.size(); }
+    int findPool(const std::string& name) const;
+    const std::string& poolName(int pool) const { return pools[(size_t)pool].name; }
+    int poolRooms(int pool) const { return pools[(size_t)pool].rooms; }
+    int poolFreeRooms(int pool) const { return pools[(size_t)pool].freeRooms; }
+    int poolWaiting(int pool) { return pools[(size_t)pool].waiting->len(); }
+    int poolOf(int room) const { return roomPool[(size_t)room]; }
+    int levels() const { return numLevels; }
+
+    /**
+     * PRE-ALLOCATE perLevel TRIAGE NODES PER LEVEL IN EVERY SPECIALTY
+     */
+    void reserve(int perLevel);
+
+    /**
+     * ALLOCATION STATISTICS OF EVERY SPECIALTY TRIAGE QUEUE
+     */
+    MemoryStats memoryStats();
+
+    /**
+     * ROOMS AND WAITING PATIENTS PER SPECIALTY
+     */
+    void displayState(std::ostream& out);
+
+    RoomScheduler(const RoomScheduler&) = delete;
+    RoomScheduler& operator=(const RoomScheduler&) = delete;
+};
+
+#endif
@@ -0,0 +1,91 @@
+#include "roomtimers.h"
+#include <stdexcept>
+#include <string>
+
+using namespace std;
+
+RoomTimers::RoomTimers(int rooms, long long startTick)
+    : wheel(startTick), overdueHead(-1), overdueTail(-1), overdueRooms(0) {
+    if (rooms <= 0) {
+        throw invalid_argument("Room timers need at least one room");
+    }
+    handles.assign((size_t)rooms, -1);
+    expectedEnds.assign((size_t)rooms, -1);
+    overduePrev.assign((size_t)rooms, -1);
+    overdueNext.assign((size_t)rooms, -1);
+    overdue.assign((size_t)rooms, 0);
+    wheel.reserve(rooms);
+    fired.reserve((size_t)rooms);
+}
+
+void RoomTimers::checkRoom(int room) const {
+    if (room < 0 || room >= (int)handles.size()) {
+        throw out_of_range("Room " + to_string(room) + " does not exist");
+    }
+}
+
+void RoomTimers::start(int room, long long endTick) {
+    checkRoom(room);
+    if (expectedEnds[(size_t)room] >= 0) {
+        throw logic_error("Room " + to_string(room) + " already has a consultation running");
+    }
+    handles[(size_t)room] = wheel.schedule(endTick, room);
+    expectedEnds[(size_t)room] = wheel.expiryOf(handles[(size_t)room]);
+}
+
+bool RoomTimers::finish(int room) {
+    checkRoom(room);
+    if (expectedEnds[(size_t)room] < 0) {
+        throw logic_error("Room " + to_string(room) + " has no consultation running");
+    }
+    expectedEnds[(size_t)room] = -1;
+    if (!overdue[(size_t)room]) {
+        wheel.cancel(handles[(size_t)room]);
+        handles[(size_t)room] = -1;
+        return false;
+    }
+
+    // Unlink from the overdue FIFO
+    int prev = overduePrev[(size_t)room];
+    int next = overdueNext[(size_t)room];
+    if (prev >= 0) overdueNext[(size_t)prev] = next; else overdueHead = next;
+    if (next >= 0) overduePrev[(size_t)next] = prev; else overdueTail = prev;
+    overdue[(size_t)room] = 0;
+    overdueRooms--;
+    return true;
+}
+
+/**
+ * ADVANCE IMPLEMENTATION
+ * - Fired timers are appended to the overdue FIFO in expiry order, so the
+ *   list stays sorted by expected end
+ */
+int RoomTimers::advance(long long nowTick, vector<int>& due) {
+    fired.clear();
+    int count = wheel.advance(nowTick, fired);
+    for (size_t i = 0; i < fired.size(); i++) {
+        int room = fired[i];
+        handles[(size_t)room] = -1;
+        overdue[(size_t)room] = 1;
+        overduePrev[(size_t)room] = overdueTail;
+        overdueNext[(size_t)room] = -1;
+        if (overdueTail >= 0) overdueNext[(size_t)overdueTail] = room; else overdueHead = room;
+        overdueTail = room;
+        overdueRooms++;
+        due.push_back(room);
+    }
+    return count;
+}
+
+int RoomTimers::nextToFinish() const {
+    if (overdueHead >= 0) {
+        return overdueHead;
+    }
+    int handle = wheel.earliest();
+    return handle < 0 ? -1 : wheel.valueOf(handle);
+}
+
+long long RoomTimers::nextDeadline() const {
+    int handle = wheel.earliest();
+    return handle < 0 ? -1 : wheel.expiryOf(handle);
+}
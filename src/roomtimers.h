@@ -0,0 +1,98 @@
+#ifndef ROOMTIMERS_H
+#define ROOMTIMERS_H
+
+#include "memorystats.h"
+#include "timingwheel.h"
+#include <vector>
+
+/**
+ * EXPECTED-END TIMERS OF THE CONSULTATION ROOMS
+ *
+ * IMPLEMENTATION:
+ * - Every occupied room has an expected end (tick) in a TimingWheel
+ * - When the wheel passes that tick without the consultation having
+ *   finished, the room becomes overdue and joins an intrusive FIFO list
+ *   (one prev / next slot per room), oldest overdue first
+ * - finish() takes the room out of whichever of the two it is in
+ *
+ * Ticks are whatever unit the owner chooses (HospitalSystem and the
+ * simulator use seconds); the wheel only needs them to be integers that
+ * never go backwards.
+ *
+ * PERFORMANCE CHARACTERISTICS:
+ * - start / finish / oldestOverdue: O(1)
+ * - advance: O(1) per tick crossed that holds a timer, plus O(1) per
+ *   room that becomes overdue (see TimingWheel::advance)
+ * - nextToFinish: TimingWheel::earliest
+ */
+class RoomTimers {
+private:
+    TimingWheel<int> wheel;
+    std::vector<int> handles;              ///< Wheel handle per room, -1 when not timed
+    std::vector<long long> expectedEnds;   ///< Expected end tick per room, -1 when free
+    std::vector<int> overduePrev;
+    std::vector<int> overdueNext;
+    std::vector<char> overdue;
+    int overdueHead;
+    int overdueTail;
+    int overdueRooms;
+    std::vector<int> fired;                ///< Scratch for wheel expiries
+
+    void checkRoom(int room) const;
+
+public:
+    /**
+     * CONSTRUCTOR
+     * @param rooms: Number of rooms, numbered 0 .. rooms - 1
+     * @param startTick: Current tick
+     * EXCEPTION: Throws invalid_argument for a non-positive room count
+     */
+    RoomTimers(int rooms, long long startTick = 0);
+
+    /**
+     * A CONSULTATION STARTS IN room, EXPECTED TO END AT endTick
+     * EXCEPTION: Throws logic_error if the room is already timed
+     */
+    void start(int room, long long endTick);
+
+    /**
+     * THE CONSULTATION IN room HAS ENDED
+     * @return true if it had been flagged overdue
+     * EXCEPTION: Throws logic_error for a room that was not started
+     */
+    bool finish(int room);
+
+    /**
+     * MOVE TIME TO nowTick
+     * @param due: Receives the rooms that became overdue, earliest first
+     *        (appended); they stay occupied until finish()
+     * @return Number of rooms that became overdue
+     */
+    int advance(long long nowTick, std::vector<int>& due);
+
+    /**
+     * ROOM MOST LIKELY TO BE FREE: oldest overdue, else the first expected
+     * to end; -1 when no room is timed
+     */
+    int nextToFinish() const;
+
+    /**
+     * FIRST PENDING EXPECTED END (-1 when none is pending)
+     */
+    long long nextDeadline() const;
+
+    int oldestOverdue() const { return overdueHead; }
+    int overdueCount() const { return overdueRooms; }
+    bool isOverdue(int room) const { return overdue[(size_t)room] != 0; }
+    bool isRunning(int room) const { return expectedEnds[(size_t)room] >= 0; }
+    long long expectedEnd(int room) const { return expectedEnds[(size_t)room]; }
+    int rooms() const { return (int)handles.size(); }
+    long long now() const { return wheel.now(); }
+
+    MemoryStats memoryStats() const { return wheel.memoryStats(); }
+
+    RoomTimers(const RoomTimers&) = delete;
+    RoomTimers& operator=(const RoomTimers&) = delete;
+};
+
+#endif
@@ -0,0 +1,462 @@
+#include "simulation.h"
+#include "eventcalendar.h"
+#include "priorityqueue.h"
+#include "circularqueue.h"
+#include "stack.h"
+#include "array.h"
+#include "patient.h"
+#include "roomtimers.h"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+
+/**
+ * SIMULATION CONFIGURATION DEFAULTS
+ * - Arrival mix: 0.5 / 2 / 5 / 4 / 2.5 patients per hour (TRIAGE I..V)
+ * - Consultation means: 60 / 45 / 30 / 20 / 15 minutes (lognormal)
+ * - Offered load is about 6.5 busy rooms out of 10
+ */
+SimulationConfig::SimulationConfig()
+    : numberOfConsultationRooms(10), durationHours(24.0), seed(42), overdue(OVERDUE_FLAG) {
+    const double defaultRates[TRIAGE_LEVELS] = {0.5, 2.0, 5.0, 4.0, 2.5};
+    const double defaultMeans[TRIAGE_LEVELS] = {60.0, 45.0, 30.0, 20.0, 15.0};
+
+    for (int i = 0; i < TRIAGE_LEVELS; i++) {
+        arrivalsPerHour[i] = defaultRates[i];
+        service[i].distribution = SERVICE_LOGNORMAL;
+        service[i].meanMinutes = defaultMeans[i];
+        service[i].spreadMinutes = defaultMeans[i] / 2.0;
+    }
+}
+
+/**
+ * PARSE A NUMERIC OPTION VALUE
+ * EXCEPTION: Throws invalid_argument if the text is not a number
+ */
+static double parseNumber(const string& option, const string& text) {
+    char* end = NULL;
+    double value = strtod(text.c_str(), &end);
+    if (text.empty() || *end != '\0') {
+        throw invalid_argument("Invalid value for " + option + ": " + text);
+    }
+    return value;
+}
+
+/**
+ * PARSE "exp|lognormal|uniform|fixed" INTO A DISTRIBUTION
+ */
+static ServiceDistribution parseDistribution(const string& text) {
+    if (text == "exp" || text == "exponential") return SERVICE_EXPONENTIAL;
+    if (text == "lognormal") return SERVICE_LOGNORMAL;
+    if (text == "uniform") return SERVICE_UNIFORM;
+    if (text == "fixed") return SERVICE_FIXED;
+    throw invalid_argument("Unknown consultation-time distribution: " + text);
+}
+
+/**
+ * SPLIT "a<sep>b<sep>c" INTO AT MOST maxParts FIELDS
+ * @return Number of fields written to parts
+ */
+static int splitFields(const string& text, char separator, string parts[], int maxParts) {
+    int count = 0;
+    size_t start = 0;
+    while (count < maxParts) {
+        size_t position = text.find(separator, start);
+        parts[count++] = text.substr(start, position == string::npos ? string::npos : position - start);
+        if (position == string::npos) {
+            return count;
+        }
+        start = position + 1;
+    }
+    throw invalid_argument("Too many fields in: " + text);
+}
+
+void SimulationConfig::parseArguments(int argc, char* argv[]) {
+    for (int i = 0; i < argc; i++) {
+        string option = argv[i];
+        if (i + 1 >= argc) {
+            throw invalid_argument("Missing value for option " + option);
+        }
+        string value = argv[++i];
+
+        if (option == "--rooms") {
+            numberOfConsultationRooms = (int)parseNumber(option, value);
+        } else if (option == "--hours") {
+            durationHours = parseNumber(option, value);
+        } else if (option == "--seed") {
+            seed = (unsigned long long)parseNumber(option, value);
+        } else if (option == "--arrivals") {
+            string parts[TRIAGE_LEVELS];
+            if (splitFields(value, ',', parts, TRIAGE_LEVELS) != TRIAGE_LEVELS) {
+                throw invalid_argument("--arrivals expects 5 comma-separated rates (TRIAGE I..V)");
+            }
+            for (int level = 0; level < TRIAGE_LEVELS; level++) {
+                arrivalsPerHour[level] = parseNumber(option, parts[level]);
+                if (arrivalsPerHour[level] < 0) {
+                    throw invalid_argument("Arrival rates cannot be negative");
+                }
+            }
+        } else if (option == "--service") {
+            string parts[4];
+            int fields = splitFields(value, ':', parts, 4);
+            if (fields < 3) {
+                throw invalid_argument("--service expects LEVEL:DIST:MEAN[:SPREAD]");
+            }
+            int level = (int)parseNumber(option, parts[0]);
+            if (level < 1 || level > TRIAGE_LEVELS) {
+                throw invalid_argument("--service level must be between 1 and 5");
+            }
+            ServiceTimeModel& model = service[level - 1];
+            model.distribution = parseDistribution(parts[1]);
+            model.meanMinutes = parseNumber(option, parts[2]);
+            model.spreadMinutes = fields == 4 ? parseNumber(option, parts[3]) : 0.0;
+            if (model.meanMinutes <= 0 || model.spreadMinutes < 0) {
+                throw invalid_argument("--service mean must be positive and spread non-negative");
+            }
+        } else if (option == "--overdue") {
+            if (value == "flag") overdue = OVERDUE_FLAG;
+            else if (value == "release") overdue = OVERDUE_RELEASE;
+            else throw invalid_argument("--overdue expects flag or release");
+        } else {
+            throw invalid_argument("Unknown simulation option: " + option);
+        }
+    }
+}
+
+/**
+ * EVENT PAYLOAD STORED IN THE CALENDAR
+ * - ARRIVAL: a new patient arrives at 'level'
+ * - COMPLETION: 'patient' leaves consultation room 'room'; ignored when
+ *   'serial' no longer matches the room (it was released at its expected end)
+ */
+enum SimulationEventType { EVENT_ARRIVAL, EVENT_COMPLETION };
+
+struct SimulationEvent {
+    int type;          ///< SimulationEventType
+    int level;         ///< Triage level (1-5) for arrivals
+    int room;          ///< Room number for completions
+    Patient* patient;  ///< Patient finishing consultation
+    int serial;        ///< Room assignment the completion belongs to
+};
+
+/**
+ * CONSULTATION-TIME SAMPLER FOR ONE LEVEL
+ * - Distribution objects are built once, so sampling is allocation-free
+ * - Lognormal parameters are derived from the requested mean and spread
+ */
+class ServiceSampler {
+private:
+    ServiceTimeModel model;
+    exponential_distribution<double> exponential;
+    lognormal_distribution<double> lognormal;
+    uniform_real_distribution<double> uniform;
+
+    static double lognormalSigma(const ServiceTimeModel& m) {
+        return sqrt(log(1.0 + (m.spreadMinutes * m.spreadMinutes) / (m.meanMinutes * m.meanMinutes)));
+    }
+
+public:
+    ServiceSampler() : model(), exponential(1.0), lognormal(0.0, 1.0), uniform(0.0, 1.0) {}
+
+    explicit ServiceSampler(const ServiceTimeModel& m)
+        : model(m),
+          exponential(1.0 / m.meanMinutes),
+          lognormal(log(m.meanMinutes) - lognormalSigma(m) * lognormalSigma(m) / 2.0, lognormalSigma(m)),
+          uniform(m.meanMinutes - m.spreadMinutes, m.meanMinutes + m.spreadMinutes) {}
+
+    double sample(mt19937_64& rng) {
+        double minutes;
+        switch (model.distribution) {
+            case SERVICE_EXPONENTIAL: minutes = exponential(rng); break;
+            case SERVICE_LOGNORMAL: minutes = lognormal(rng); break;
+            case SERVICE_UNIFORM: minutes = uniform(rng); break;
+            default: minutes = model.meanMinutes;
+        }
+        return minutes > 0.0 ? minutes : 0.0;
+    }
+};
+
+EmergencySimulation::EmergencySimulation(const SimulationConfig& cfg) : config(cfg) {
+    if (config.numberOfConsultationRooms <= 0) {
+        throw invalid_argument("Simulation needs at least one consultation room");
+    }
+    if (config.durationHours <= 0) {
+        throw invalid_argument("Simulation horizon must be positive");
+    }
+}
+
+/**
+ * RUN THE DISCRETE-EVENT LOOP
+ *
+ * EVENT FLOW:
+ * 1. ARRIVAL: recycle a Patient record from the Stack (or create one),
+ *    stamp its arrival time, add it to triage, schedule the next arrival
+ * 2. COMPLETION: return the room to the free-room CircularQueue, stop its
+ *    timer and push the Patient record back onto the recycling Stack
+ * 3. EXPECTED END (RoomTimers): when the first pending expected end comes
+ *    before the next calendar event, the wheel is advanced to it; the due
+ *    rooms are counted overdue and, with the release policy, freed there
+ * 4. After every step, pair waiting patients with free rooms (highest
+ *    triage level first), schedule their completions and start their timers
+ *
+ * Timer ticks are simulated seconds; an expected end is rounded up to the
+ * next whole second, and a completion in that same second wins.
+ *
+ * STATISTICS: Queue lengths and busy rooms are integrated over time up to
+ * the horizon; wait times go into per-level HDR histograms.
+ */
+void EmergencySimulation::run(SimulationResult& result) {
+    const int levels = SimulationConfig::TRIAGE_LEVELS;
+    const double horizon = config.durationHours * 60.0;
+    const int rooms = config.numberOfConsultationRooms;
+    chrono::steady_clock::time_point wallStart = chrono::steady_clock::now();
+
+    mt19937_64 rng(config.seed);
+    exponential_distribution<double> interArrival[levels];
+    ServiceSampler service[levels];
+    for (int i = 0; i < levels; i++) {
+        if (config.arrivalsPerHour[i] > 0) {
+            interArrival[i] = exponential_distribution<double>(config.arrivalsPerHour[i] / 60.0);
+        }
+        service[i] = ServiceSampler(config.service[i]);
+    }
+
+    // Engine data structures
+    PriorityQueue<Patient*> triage(levels);
+    CircularQueue<int> freeRooms(rooms);
+    Stack<Patient*> recycledPatients;
+    Array<Patient*> allPatients(64);     // Owns every Patient record created
+    Array<double> arrivalTimes(64);      // Indexed by Patient::id
+    EventCalendar<SimulationEvent> calendar(rooms + levels + 16);
+    RoomTimers timers(rooms);            // Indexed by room - 1
+    vector<Patient*> occupants((size_t)rooms, NULL);
+    vector<int> serials((size_t)rooms, 0);
+    vector<int> due;
+    due.reserve((size_t)rooms);
+
+    for (int room = 1; room <= rooms; room++) {
+        freeRooms.enqueue(room);
+    }
+
+    // Reset statistics
+    for (int i = 0; i < levels; i++) {
+        result.levels[i].arrivals = 0;
+        result.levels[i].served = 0;
+        result.levels[i].waitSeconds.reset();
+        result.levels[i].averageQueueLength = 0.0;
+        result.levels[i].maxQueueLength = 0;
+    }
+    result.overdue = config.overdue;
+    result.overdueConsultations = 0;
+    result.autoReleased = 0;
+    result.overrunSeconds.reset();
+    double queueArea[levels] = {0.0, 0.0, 0.0, 0.0, 0.0};
+    double busyArea = 0.0;
+    double integratedUntil = 0.0;
+    int busyRooms = 0;
+    long long events = 0;
+
+    // Seed one pending arrival per active level
+    for (int i = 0; i < levels; i++) {
+        if (config.arrivalsPerHour[i] > 0) {
+            SimulationEvent arrival = {EVENT_ARRIVAL, i + 1, 0, NULL, 0};
+            calendar.schedule(interArrival[i](rng), arrival);
+        }
+    }
+
+    while (!calendar.isEmpty()) {
+        // Expected ends due before the next event are handled first
+        long long deadline = timers.nextDeadline();
+        bool timerStep = deadline >= 0 && (double)deadline < calendar.nextTime() * 60.0;
+        double now = timerStep ? deadline / 60.0 : 0.0;
+        SimulationEvent event = {EVENT_ARRIVAL, 0, 0, NULL, 0};
+        if (!timerStep) {
+            event = calendar.pop(now);
+            events++;
+        }
+
+        // Integrate time-weighted statistics up to min(now, horizon)
+        double until = now < horizon ? now : horizon;
+        if (until > integratedUntil) {
+            double elapsed = until - integratedUntil;
+            for (int i = 0; i < levels; i++) {
+                queueArea[i] += triage.bucketLen(i + 1) * elapsed;
+            }
+            busyArea += busyRooms * elapsed;
+            integratedUntil = until;
+        }
+
+        if (timerStep) {
+            due.clear();
+            result.overdueConsultations += timers.advance(deadline, due);
+            for (size_t i = 0; i < due.size() && config.overdue == OVERDUE_RELEASE; i++) {
+                int index = due[i];
+                timers.finish(index);
+                serials[(size_t)index]++;  // Its completion event is now stale
+                recycledPatients.add(occupants[(size_t)index]);
+                occupants[(size_t)index] = NULL;
+                freeRooms.enqueue(index + 1);
+                busyRooms--;
+                result.autoReleased++;
+            }
+        } else if (event.type == EVENT_ARRIVAL) {
+            int index = event.level - 1;
+            Patient* patient;
+            if (!recycledPatients.isEmpty()) {
+                patient = recycledPatients.pop();
+                patient->priority = event.level;
+                arrivalTimes[patient->id] = now;
+            } else {
+                patient = new Patient(allPatients.len(), "", 0, event.level, "");
+                allPatients.append(patient);
+                arrivalTimes.append(now);
+            }
+            triage.add(patient);
+            result.levels[index].arrivals++;
+            if (triage.bucketLen(event.level) > result.levels[index].maxQueueLength) {
+                result.levels[index].maxQueueLength = triage.bucketLen(event.level);
+            }
+
+            double next = now + interArrival[index](rng);
+            if (next < horizon) {
+                calendar.schedule(next, event);
+            }
+        } else if (event.serial == serials[(size_t)event.room - 1]) {
+            int index = event.room - 1;
+            long long expectedEnd = timers.expectedEnd(index);
+            if (timers.finish(index)) {
+                result.overrunSeconds.record((std::uint64_t)(now * 60.0 - (double)expectedEnd + 0.5));
+            }
+            occupants[(size_t)index] = NULL;
+            freeRooms.enqueue(event.room);
+            recycledPatients.add(event.patient);
+            busyRooms--;
+        }
+
+        // Dispatch: highest-priority waiting patients take the free rooms
+        while (!triage.isEmpty() && !freeRooms.isEmpty()) {
+            Patient* patient = triage.pop();
+            int room = freeRooms.dequeue();
+            busyRooms++;
+
+            LevelStatistics& stats = result.levels[patient->priority - 1];
+            double waitMinutes = now - arrivalTimes[patient->id];
+            stats.waitSeconds.record((std::uint64_t)(waitMinutes * 60.0 + 0.5));
+            stats.served++;
+
+            occupants[(size_t)room - 1] = patient;
+            timers.start(room - 1, (long long)ceil((now + config.service[patient->priority - 1].meanMinutes) * 60.0));
+            SimulationEvent completion = {EVENT_COMPLETION, patient->priority, room, patient, serials[(size_t)room - 1]};
+            calendar.schedule(now + service[patient->priority - 1].sample(rng), completion);
+        }
+    }
+
+    // Derive time averages and release Patient records
+    long long patients = 0;
+    for (int i = 0; i < levels; i++) {
+        result.levels[i].averageQueueLength = queueArea[i] / horizon;
+        patients += result.levels[i].arrivals;
+    }
+    for (int i = 0; i < allPatients.len(); i++) {
+        delete allPatients[i];
+    }
+
+    result.numberOfConsultationRooms = rooms;
+    result.horizonMinutes = horizon;
+    result.averageBusyRooms = busyArea / horizon;
+    result.utilization = result.averageBusyRooms / rooms;
+    result.patientsSimulated = patients;
+    result.eventsProcessed = events;
+    result.wallSeconds = chrono::duration<double>(chrono::steady_clock::now() - wallStart).count();
+}
+
+/**
+ * PRINT SIMULATION REPORT
+ * FORMAT: Run summary, then one row per triage level with wait-time
+ * percentiles expressed in minutes
+ */
+void SimulationResult::print(ostream& os) const {
+    const char* levelNames[SimulationConfig::TRIAGE_LEVELS] = {
+        "TRIAGE I", "TRIAGE II", "TRIAGE III", "TRIAGE IV", "TRIAGE V"
+    };
+
+    os << "\n==================================================" << endl;
+    os << "      EMERGENCY DEPARTMENT SIMULATION REPORT" << endl;
+    os << "==================================================" << endl;
+    os << fixed << setprecision(1);
+    os << "Consultation rooms: " << numberOfConsultationRooms
+       << " | Horizon: " << horizonMinutes / 60.0 << " h" << endl;
+    os << "Patients simulated: " << patientsSimulated
+       << " | Events processed: " << eventsProcessed << endl;
+    os << setprecision(3) << "Wall time: " << wallSeconds << " s";
+    if (wallSeconds > 0) {
+        os << " (" << setprecision(0) << patientsSimulated / wallSeconds << " patients/s)";
+    }
+    os << endl;
+    os << setprecision(1) << "Room utilization: " << utilization * 100.0 << "% (average busy rooms "
+       << setprecision(2) << averageBusyRooms << "/" << numberOfConsultationRooms << ")" << endl;
+
+    long long consultations = 0;
+    for (int i = 0; i < SimulationConfig::TRIAGE_LEVELS; i++) {
+        consultations += levels[i].served;
+    }
+    os << "Consultations past their expected end: " << overdueConsultations;
+    if (consultations > 0) {
+        os << setprecision(1) << " (" << 100.0 * overdueConsultations / consultations << "%)";
+    }
+    if (overdue == OVERDUE_RELEASE) {
+        os << " | rooms auto-released: " << autoReleased << endl;
+    } else {
+        os << setprecision(1) << " | overrun p50 " << overrunSeconds.percentile(50.0) / 60.0 << " min, p90 "
+           << overrunSeconds.percentile(90.0) / 60.0 << " min, max " << overrunSeconds.max() / 60.0 << " min" << endl;
+    }
+
+    os << "\n=== PER-LEVEL QUEUES AND WAITS (minutes) ===" << endl;
+    os << left << setw(12) << "Level" << right
+       << setw(10) << "Arrivals" << setw(10) << "AvgQueue" << setw(10) << "MaxQueue"
+       << setw(10) << "MeanWait" << setw(9) << "p50" << setw(9) << "p90"
+       << setw(9) << "p99" << setw(9) << "Max" << endl;
+
+    for (int i = 0; i < SimulationConfig::TRIAGE_LEVELS; i++) {
+        const LevelStatistics& stats = levels[i];
+        os << left << setw(12) << levelNames[i] << right
+           << setw(10) << stats.arrivals
+           << setw(10) << setprecision(2) << stats.averageQueueLength
+           << setw(10) << stats.maxQueueLength
+           << setw(10) << setprecision(1) << stats.waitSeconds.mean() / 60.0
+           << setw(9) << stats.waitSeconds.percentile(50.0) / 60.0
+           << setw(9) << stats.waitSeconds.percentile(90.0) / 60.0
+           << setw(9) << stats.waitSeconds.percentile(99.0) / 60.0
+           << setw(9) << stats.waitSeconds.max() / 60.0 << endl;
+    }
+    os << "==================================================" << endl;
+}
+
+/**
+ * SIMULATION MODE ENTRY POINT
+ * - Parses options, runs one simulation and prints the report
+ * - Configuration errors are reported and mapped to exit code 1
+ */
+int EmergencySimulation::runFromCommandLine(int argc, char* argv[]) {
+    try {
+        SimulationConfig config;
+        config.parseArguments(argc, argv);
+
+        EmergencySimulation simulation(config);
+        SimulationResult* result = new SimulationResult();
+        simulation.run(*result);
+        result->print(cout);
+        delete result;
+        return 0;
+    }
+    catch (const exception& e) {
+        cout << "\n[ERROR!] Simulation failed: " << e.what() << endl;
+        return 1;
+    }
+}
@@ -0,0 +1,151 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include "histogram.h"
+#include "hospitalconfig.h"
+#include <iostream>
+#include <string>
+
+/**
+ * CONSULTATION-TIME DISTRIBUTIONS
+ * - EXPONENTIAL: memoryless, only the mean is used
+ * - LOGNORMAL: right-skewed, mean and standard deviation (spread)
+ * - UNIFORM: mean +/- spread
+ * - FIXED: every consultation takes exactly the mean
+ */
+enum ServiceDistribution {
+    SERVICE_EXPONENTIAL,
+    SERVICE_LOGNORMAL,
+    SERVICE_UNIFORM,
+    SERVICE_FIXED
+};
+
+/**
+ * CONSULTATION-TIME MODEL FOR ONE TRIAGE LEVEL
+ */
+struct ServiceTimeModel {
+    ServiceDistribution distribution;  ///< Shape of the distribution
+    double meanMinutes;                ///< Mean consultation time
+    double spreadMinutes;              ///< Standard deviation (lognormal) or half-width (uniform)
+};
+
+/**
+ * SIMULATION CONFIGURATION
+ *
+ * DEFAULTS: A mid-sized Colombian emergency department
+ * - 10 consultation rooms (same as HospitalSystem::runApplication)
+ * - 14 arrivals per hour, skewed toward TRIAGE III-IV
+ * - Lognormal consultation times, longer for the most urgent levels
+ */
+struct SimulationConfig {
+    static const int TRIAGE_LEVELS = 5;  ///< Colombian triage system
+
+    int numberOfConsultationRooms;              ///< Rooms serving the triage queue
+    double durationHours;                       ///< Arrival horizon (queue is drained afterwards)
+    unsigned long long seed;                    ///< Random stream seed
+    double arrivalsPerHour[TRIAGE_LEVELS];      ///< Poisson arrival rate per level
+    ServiceTimeModel service[TRIAGE_LEVELS];    ///< Consultation time per level
+    OverduePolicy overdue;                      ///< Rooms past their expected end: flag or release
+
+    SimulationConfig();
+
+    /**
+     * PARSE COMMAND-LINE OPTIONS INTO THIS CONFIGURATION
+     * @param argc/argv: Options following "--simulate"
+     *
+     * OPTIONS:
+     * --rooms N, --hours H, --seed S, --arrivals r1,r2,r3,r4,r5,
+     * --service LEVEL:DIST:MEAN[:SPREAD] (DIST = exp|lognormal|uniform|fixed),
+     * --overdue flag|release
+     *
+     * EXCEPTION: Throws invalid_argument on unknown or malformed options
+     */
+    void parseArguments(int argc, char* argv[]);
+};
+
+/**
+ * PER-LEVEL SIMULATION STATISTICS
+ */
+struct LevelStatistics {
+    long long arrivals;          ///< Patients that arrived at this level
+    long long served;            ///< Patients that reached a consultation room
+    Histogram waitSeconds;       ///< Triage wait (arrival -> room) in seconds
+    double averageQueueLength;   ///< Time-averaged triage length over the horizon
+    int maxQueueLength;          ///< Largest triage length observed
+};
+
+/**
+ * RESULT OF ONE SIMULATION RUN
+ */
+struct SimulationResult {
+    LevelStatistics levels[SimulationConfig::TRIAGE_LEVELS];
+    int numberOfConsultationRooms;  ///< Rooms used in the run
+    double horizonMinutes;          ///< Arrival horizon in simulated minutes
+    double utilization;             ///< Busy room-time / available room-time over the horizon
+    double averageBusyRooms;        ///< Time-averaged occupied rooms over the horizon
+    long long patientsSimulated;    ///< Total arrivals
+    long long eventsProcessed;      ///< Events popped from the calendar
+    OverduePolicy overdue;          ///< Policy the run used
+    long long overdueConsultations; ///< Consultations still running at their expected end
+    long long autoReleased;         ///< Rooms freed at their expected end (release policy)
+    Histogram overrunSeconds;       ///< Actual end minus expected end of overdue consultations (flag policy)
+    double wallSeconds;             ///< Real time spent in run()
+
+    /**
+     * PRINT A HUMAN-READABLE REPORT
+     * @param os: Destination stream (std::cout in simulation mode)
+     */
+    void print(std::ostream& os) const;
+};
+
+/**
+ * DISCRETE-EVENT EMERGENCY DEPARTMENT SIMULATOR
+ *
+ * MODEL:
+ * - Poisson arrivals per triage level (exponential inter-arrival times)
+ * - Waiting patients are held in the engine's PriorityQueue (TRIAGE I first,
+ *   FIFO within a level) exactly like HospitalSystem's triage
+ * - Free consultation rooms are held in a CircularQueue, so rooms are
+ *   reused in the same circular order as the live system
+ * - Every occupied room has an expected end (the mean consultation time of
+ *   its patient's level) in RoomTimers, the live system's timing wheel;
+ *   a room still busy at that point is flagged overdue, or freed at once
+ *   with --overdue release (its real completion event is then ignored)
+ * - Discharged patient records are pushed onto a Stack and recycled by the
+ *   next arrival, so steady state performs no Patient allocations
+ * - A binary-heap EventCalendar orders arrivals and completions
+ *
+ * OUTPUT: Room utilization, time-averaged and peak queue lengths, and
+ * wait-time percentiles for every triage level
+ */
+class EmergencySimulation {
+private:
+    SimulationConfig config;
+
+public:
+    /**
+     * CONSTRUCTOR
+     * @param cfg: Model parameters (validated here)
+     * EXCEPTION: Throws invalid_argument for non-positive rooms or horizon
+     */
+    explicit EmergencySimulation(const SimulationConfig& cfg);
+
+    /**
+     * RUN THE SIMULATION TO COMPLETION
+     * @param result: Receives statistics (passed by reference - the
+     *                histograms make the struct too large to return by value)
+     *
+     * Arrivals stop at the horizon; patients still waiting are then drained
+     * so every arrival contributes a wait-time sample.
+     */
+    void run(SimulationResult& result);
+
+    /**
+     * SIMULATION MODE ENTRY POINT
+     * @param argc/argv: Options following "--simulate"
+     * @return Process exit code
+     */
+    static int runFromCommandLine(int argc, char* argv[]);
+};
+
+#endif
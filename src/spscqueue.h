@@ -0,0 +1,116 @@
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+/**
+ * LOCK-FREE SINGLE-PRODUCER SINGLE-CONSUMER RING (BOUNDED, BATCHED)
+ *
+ * ALGORITHM: Lamport ring with free-running indices
+ * - The producer owns tail, the consumer owns head; each only reads the
+ *   other's index (acquire) and publishes its own (release)
+ * - Each side caches the last index it read from the other, so a batch
+ *   touches the other side's cache line at most once
+ *
+ * BATCHING: pushBatch() moves up to n items into the slots and publishes
+ * them with one store; popBatch() drains up to n items the same way.
+ *
+ * FIFO: Items are popped in push order.
+ *
+ * STORAGE: capacity (rounded up to a power of two) slots of T allocated
+ * once; T must be default-constructible and move-assignable. Popped slots
+ * keep their moved-from objects until reused.
+ */
+template <typename T>
+class SpscQueue {
+private:
+    T* slots;
+    size_t mask;
+
+    alignas(64) std::atomic<size_t> head;  ///< Next slot to read (consumer)
+    size_t cachedTail;                     ///< Consumer's last view of tail
+
+    alignas(64) std::atomic<size_t> tail;  ///< Next slot to write (producer)
+    size_t cachedHead;                     ///< Producer's last view of head
+
+public:
+    /**
+     * CONSTRUCTOR
+     * @param minCapacity: Slots wanted, rounded up to a power of two
+     * EXCEPTION: Throws invalid_argument for a zero capacity
+     */
+    explicit SpscQueue(size_t minCapacity) : head(0), cachedTail(0), tail(0), cachedHead(0) {
+        if (minCapacity == 0) {
+            throw std::invalid_argument("SPSC queue capacity must be positive");
+        }
+        size_t size = 1;
+        while (size < minCapacity) {
+            size <<= 1;
+        }
+        slots = new T[size];
+        mask = size - 1;
+    }
+
+    ~SpscQueue() {
+        delete[] slots;
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    size_t capacity() const { return mask + 1; }
+
+    /**
+     * SLOTS THE PRODUCER CAN FILL RIGHT NOW (producer thread only)
+     * - Never shrinks until the producer pushes
+     */
+    size_t freeSlots() {
+        cachedHead = head.load(std::memory_order_acquire);
+        return capacity() - (tail.load(std::memory_order_relaxed) - cachedHead);
+    }
+
+    /**
+     * ENQUEUE UP TO count ITEMS (producer thread only)
+     * @param items: Moved from, in order
+     * @return Items enqueued (fewer than count when the ring fills up)
+     */
+    size_t pushBatch(T* items, size_t count) {
+        size_t position = tail.load(std::memory_order_relaxed);
+        size_t available = capacity() - (position - cachedHead);
+        if (available < count) {
+            cachedHead = head.load(std::memory_order_acquire);
+            available = capacity() - (position - cachedHead);
+        }
+        size_t n = count < available ? count : available;
+        for (size_t i = 0; i < n; i++) {
+            slots[(position + i) & mask] = std::move(items[i]);
+        }
+        tail.store(position + n, std::memory_order_release);
+        return n;
+    }
+
+    /**
+     * DEQUEUE UP TO count ITEMS, OLDEST FIRST (consumer thread only)
+     * @param out: Receives the items (move-assigned)
+     * @return Items dequeued (0 when nothing is visible)
+     */
+    size_t popBatch(T* out, size_t count) {
+        size_t position = head.load(std::memory_order_relaxed);
+        size_t available = cachedTail - position;
+        if (available < count) {
+            cachedTail = tail.load(std::memory_order_acquire);
+            available = cachedTail - position;
+        }
+        size_t n = count < available ? count : available;
+        for (size_t i = 0; i < n; i++) {
+            out[i] = std::move(slots[(position + i) & mask]);
+        }
+        head.store(position + n, std::memory_order_release);
+        return n;
+    }
+};
+
+#endif
@@ -34,11 +34,11 @@ public:
     void add(T data) {
         if (this->isEmpty()) {
             // First element in stack
-            this->head = new Node<T>(data);
+            this->head = this->createNode(data);
             this->last = this->head;
         } else {
             // Add to front (top of stack)
-            Node<T>* temp = new Node<T>(data);
+            Node<T>* temp = this->createNode(data);
             temp->next = this->head;  // New node points to old head
             this->head = temp;        // New node becomes head
         }
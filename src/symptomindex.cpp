@@ -0,0 +1,337 @@
+#include "symptomindex.h"
+#include "nameindex.h"
+#include <algorithm>
+#include <stdexcept>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+using namespace std;
+
+/**
+ * SPLIT FOLDED TEXT INTO TERMS
+ * - Term bytes: a-z, 0-9 and non-ASCII (letters outside Latin-1 stay whole)
+ * - unique = true drops repeated terms, keeping first occurrences
+ */
+static void splitTerms(const string& text, vector<string>& out, bool unique) {
+    out.clear();
+    string folded = NameIndex::fold(text);
+    size_t i = 0;
+    while (i < folded.size()) {
+        size_t start = i;
+        while (i < folded.size()) {
+            unsigned char c = (unsigned char)folded[i];
+            if (!((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c >= 0x80)) break;
+            i++;
+        }
+        if (i > start) {
+            string term = folded.substr(start, i - start);
+            if (!unique || find(out.begin(), out.end(), term) == out.end()) {
+                out.push_back(term);
+            }
+        } else {
+            i++;
+        }
+    }
+}
+
+void SymptomIndex::tokenize(const string& text, vector<string>& out) {
+    splitTerms(text, out, true);
+}
+
+SymptomIndex::SymptomIndex() : postingTotal(0), lastPatientId(0) {}
+
+void SymptomIndex::reserve(int terms) {
+    if (terms <= 0) {
+        return;
+    }
+    termIds.reserve((size_t)terms);
+    size_t capacity = postings.capacity();
+    postings.reserve((size_t)terms);
+    accountGrowth(capacity * sizeof(PostingList), postings.capacity() * sizeof(PostingList));
+}
+
+/**
+ * RECORD A VECTOR THAT MOVED FROM before TO after BYTES
+ */
+void SymptomIndex::accountGrowth(size_t before, size_t after) {
+    if (after != before) {
+        if (before > 0) {
+            MEMORY_ACCOUNT_RELEASE(before);
+        }
+        MEMORY_ACCOUNT_ALLOCATE(after);
+    }
+}
+
+const SymptomIndex::PostingList* SymptomIndex::find(const string& term) const {
+    unordered_map<string, int>::const_iterator it = termIds.find(term);
+    return it == termIds.end() ? NULL : &postings[(size_t)it->second];
+}
+
+/**
+ * INSERT IMPLEMENTATION
+ * 1. Look up (or create, empty) the list of every term of the symptom
+ * 2. Reserve room for one more block header and one 5-byte varint in each
+ * 3. Append: a new block when the last one is full, else the gap to the
+ *    block's last ID
+ * Nothing can throw after step 2, so either every term gets the ID or
+ * none does (a failed insert may leave new, empty terms behind)
+ */
+void SymptomIndex::insert(int patientId, const string& symptom) {
+    if (patientId <= lastPatientId) {
+        throw invalid_argument("Patient IDs must be indexed in increasing order");
+    }
+    splitTerms(symptom, tokens, true);
+
+    vector<int> lists;
+    lists.reserve(tokens.size());
+    for (size_t t = 0; t < tokens.size(); t++) {
+        unordered_map<string, int>::iterator it = termIds.find(tokens[t]);
+        if (it == termIds.end()) {
+            size_t capacity = postings.capacity();
+            postings.push_back(PostingList());
+            accountGrowth(capacity * sizeof(PostingList), postings.capacity() * sizeof(PostingList));
+            postings.back().size = 0;
+            try {
+                it = termIds.insert(make_pair(tokens[t], (int)postings.size() - 1)).first;
+            } catch (...) {
+                postings.pop_back();
+                throw;
+            }
+        }
+        lists.push_back(it->second);
+    }
+    for (size_t l = 0; l < lists.size(); l++) {
+        PostingList& list = postings[(size_t)lists[l]];
+        if (list.blocks.capacity() < list.blocks.size() + 1) {
+            size_t capacity = list.blocks.capacity();
+            list.blocks.reserve(capacity * 2 + 1);
+            accountGrowth(capacity * sizeof(Block), list.blocks.capacity() * sizeof(Block));
+        }
+        if (list.bytes.capacity() < list.bytes.size() + 5) {
+            size_t capacity = list.bytes.capacity();
+            list.bytes.reserve(capacity * 2 + 5);
+            accountGrowth(capacity, list.bytes.capacity());
+        }
+    }
+
+    for (size_t l = 0; l < lists.size(); l++) {
+        PostingList& list = postings[(size_t)lists[l]];
+        if (list.blocks.empty() || list.blocks.back().count == BLOCK_SIZE) {
+            Block block;
+            block.firstId = patientId;
+            block.lastId = patientId;
+            block.offset = (int)list.bytes.size();
+            block.count = 1;
+            list.blocks.push_back(block);
+        } else {
+            Block& block = list.blocks.back();
+            unsigned gap = (unsigned)(patientId - block.lastId);
+            while (gap >= 0x80) {
+                list.bytes.push_back((unsigned char)((gap & 0x7F) | 0x80));
+                gap >>= 7;
+            }
+            list.bytes.push_back((unsigned char)gap);
+            block.lastId = patientId;
+            block.count++;
+        }
+        list.size++;
+    }
+    postingTotal += (long long)lists.size();
+    lastPatientId = patientId;
+}
+
+/**
+ * DECODE A BLOCK, STOPPING AFTER THE FIRST ID >= untilId
+ * @return Number of IDs written to out
+ */
+int SymptomIndex::decodeBlock(const PostingList& list, int block, int* out, int untilId) {
+    const Block& header = list.blocks[(size_t)block];
+    const unsigned char* bytes = list.bytes.data() + header.offset;
+    int id = header.firstId;
+    out[0] = id;
+    int i = 1;
+    for (; i < header.count && id < untilId; i++) {
+        unsigned gap = 0;
+        int shift = 0;
+        unsigned char byte;
+        do {
+            byte = *bytes++;
+            gap |= (unsigned)(byte & 0x7F) << shift;
+            shift += 7;
+        } while (byte & 0x80);
+        id += (int)gap;
+        out[i] = id;
+    }
+    return i;
+}
+
+void SymptomIndex::decodeAll(const PostingList& list, vector<int>& out) {
+    out.resize((size_t)list.size);
+    int written = 0;
+    for (size_t b = 0; b < list.blocks.size(); b++) {
+        written += decodeBlock(list, (int)b, out.data() + written, list.blocks[b].lastId);
+    }
+}
+
+int SymptomIndex::intersectScalar(const int* a, int na, const int* b, int nb, int* out) {
+    int i = 0, j = 0, found = 0;
+    while (i < na && j < nb) {
+        if (a[i] < b[j]) {
+            i++;
+        } else if (b[j] < a[i]) {
+            j++;
+        } else {
+            out[found++] = a[i];
+            i++;
+            j++;
+        }
+    }
+    return found;
+}
+
+/**
+ * SSE2 INTERSECTION - Compare 4 IDs of a against all 4 rotations of 4 IDs
+ * of b (16 comparisons in 4 instructions), emit the matching IDs of a,
+ * then advance whichever block has the smaller maximum (both on a tie).
+ * The scalar merge finishes the tails.
+ */
+int SymptomIndex::intersect(const int* a, int na, const int* b, int nb, int* out) {
+#if defined(__SSE2__)
+    int i = 0, j = 0, found = 0;
+    int aEnd = na & ~3, bEnd = nb & ~3;
+    while (i < aEnd && j < bEnd) {
+        __m128i va = _mm_loadu_si128((const __m128i*)(a + i));
+        __m128i vb = _mm_loadu_si128((const __m128i*)(b + j));
+        __m128i equal = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi32(va, vb),
+                         _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1)))),
+            _mm_or_si128(_mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))),
+                         _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3)))));
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(equal));
+        while (mask != 0) {
+            out[found++] = a[i + __builtin_ctz((unsigned)mask)];
+            mask &= mask - 1;
+        }
+        int aMax = a[i + 3], bMax = b[j + 3];
+        if (aMax <= bMax) i += 4;
+        if (bMax <= aMax) j += 4;
+    }
+    return found + intersectScalar(a + i, na - i, b + j, nb - j, out + found);
+#else
+    return intersectScalar(a, na, b, nb, out);
+#endif
+}
+
+/**
+ * CANDIDATES ∩ LIST - Decode only the blocks whose [firstId, lastId]
+ * range holds at least one candidate
+ */
+void SymptomIndex::intersectWith(const vector<int>& candidates, const PostingList& list, vector<int>& out) {
+    out.clear();
+    int buffer[BLOCK_SIZE];
+    size_t next = 0;
+    vector<Block>::const_iterator block = list.blocks.begin();
+    while (next < candidates.size()) {
+        block = lower_bound(block, list.blocks.end(), candidates[next],
+                            [](const Block& header, int id) { return header.lastId < id; });
+        if (block == list.blocks.end()) break;
+        size_t end = (size_t)(upper_bound(candidates.begin() + (long)next, candidates.end(), block->lastId)
+                              - candidates.begin());
+        if (candidates[end - 1] >= block->firstId) {
+            int count = decodeBlock(list, (int)(block - list.blocks.begin()), buffer, candidates[end - 1]);
+            size_t before = out.size();
+            out.resize(before + min((size_t)count, end - next));
+            int found = intersect(candidates.data() + next, (int)(end - next), buffer, count, out.data() + before);
+            out.resize(before + (size_t)found);
+        }
+        next = end;
+        ++block;
+    }
+}
+
+void SymptomIndex::unite(vector<int>& result, const vector<int>& other) {
+    vector<int> merged;
+    merged.reserve(result.size() + other.size());
+    set_union(result.begin(), result.end(), other.begin(), other.end(), back_inserter(merged));
+    result.swap(merged);
+}
+
+int SymptomIndex::matchAll(const vector<string>& terms, vector<int>& out) const {
+    out.clear();
+    vector<const PostingList*> lists;
+    vector<string> parts;
+    for (size_t t = 0; t < terms.size(); t++) {
+        splitTerms(terms[t], parts, true);
+        for (size_t p = 0; p < parts.size(); p++) {
+            const PostingList* list = find(parts[p]);
+            if (list == NULL) return 0;
+            if (std::find(lists.begin(), lists.end(), list) == lists.end()) lists.push_back(list);
+        }
+    }
+    if (lists.empty()) return 0;
+
+    // Rarest term first: every later step is bounded by the candidates left
+    sort(lists.begin(), lists.end(), [](const PostingList* x, const PostingList* y) { return x->size < y->size; });
+    decodeAll(*lists[0], out);
+    vector<int> narrowed;
+    for (size_t l = 1; l < lists.size() && !out.empty(); l++) {
+        intersectWith(out, *lists[l], narrowed);
+        out.swap(narrowed);
+    }
+    return (int)out.size();
+}
+
+int SymptomIndex::matchAny(const vector<string>& terms, vector<int>& out) const {
+    out.clear();
+    vector<string> parts;
+    vector<int> decoded;
+    for (size_t t = 0; t < terms.size(); t++) {
+        splitTerms(terms[t], parts, true);
+        for (size_t p = 0; p < parts.size(); p++) {
+            const PostingList* list = find(parts[p]);
+            if (list == NULL) continue;
+            decodeAll(*list, decoded);
+            unite(out, decoded);
+        }
+    }
+    return (int)out.size();
+}
+
+int SymptomIndex::query(const string& expression, vector<int>& out) const {
+    out.clear();
+    vector<string> words;
+    splitTerms(expression, words, false);
+
+    vector<string> group;
+    vector<int> matched;
+    for (size_t w = 0; w <= words.size(); w++) {
+        if (w < words.size() && words[w] == "and") continue;
+        if (w < words.size() && words[w] != "or") {
+            group.push_back(words[w]);
+            continue;
+        }
+        if (!group.empty()) {
+            matchAll(group, matched);
+            unite(out, matched);
+            group.clear();
+        }
+    }
+    return (int)out.size();
+}
+
+int SymptomIndex::documentFrequency(const string& term) const {
+    vector<string> parts;
+    splitTerms(term, parts, true);
+    if (parts.size() != 1) return 0;
+    const PostingList* list = find(parts[0]);
+    return list == NULL ? 0 : list->size;
+}
+
+long long SymptomIndex::postingBytes() const {
+    long long bytes = 0;
+    for (size_t l = 0; l < postings.size(); l++) {
+        bytes += (long long)(postings[l].blocks.capacity() * sizeof(Block) + postings[l].bytes.capacity());
+    }
+    return bytes;
+}
@@ -0,0 +1,134 @@
+#ifndef SYMPTOMINDEX_H
+#define SYMPTOMINDEX_H
+
+#include "memorystats.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * SYMPTOM INVERTED INDEX - TERM -> COMPRESSED LIST OF PATIENT IDs
+ *
+ * TERMS:
+ * - Patient::symptom is free text; it is folded like names (lowercase,
+ *   no accents) and split on anything that is not a letter or a digit,
+ *   so "Fever, Cough" and "fever and cough" both yield fever and cough
+ *
+ * POSTING LISTS (delta + varint, in blocks):
+ * - Patient IDs are assigned in increasing order, so every list is
+ *   append-only and sorted. IDs are grouped in blocks of BLOCK_SIZE: the
+ *   block header keeps the first and last ID (uncompressed, for skipping)
+ *   and the remaining IDs are stored as LEB128 varint gaps, usually one
+ *   byte per posting instead of four
+ *
+ * QUERIES:
+ * - AND: the rarest term's list is decoded and intersected with the next
+ *   rarest; block headers of the longer list are binary searched so only
+ *   blocks that can contain a candidate are decoded. Decoded runs are
+ *   intersected 4x4 IDs at a time with SSE2 (scalar merge without SSE2)
+ * - OR: sorted merge of the decoded lists
+ * - query("fever AND cough OR rash"): AND binds tighter than OR and
+ *   adjacent terms are ANDed ("fever cough" == "fever AND cough")
+ *
+ * COMPLEXITY (n = IDs in the shortest AND list, B = BLOCK_SIZE):
+ * - insert: O(|symptom|), called on registration
+ * - AND of two terms: O(n * B) worst case, O(n + skipped headers) when
+ *   the lists share few blocks; independent of the longer list's length
+ */
+class SymptomIndex {
+public:
+    static const int BLOCK_SIZE = 128;
+
+private:
+    /**
+     * BLOCK HEADER - IDs [firstId, lastId], gaps at bytes[offset...]
+     */
+    struct Block {
+        int firstId;
+        int lastId;
+        int offset;  ///< First varint gap in PostingList::bytes
+        int count;   ///< IDs in the block, including firstId
+    };
+
+    struct PostingList {
+        std::vector<Block> blocks;
+        std::vector<unsigned char> bytes;
+        int size;
+    };
+
+    std::unordered_map<std::string, int> termIds;
+    std::vector<PostingList> postings;
+    std::vector<std::string> tokens;  ///< Scratch: terms of the symptom being indexed
+    long long postingTotal;
+    int lastPatientId;
+    MEMORY_ACCOUNT
+
+    const PostingList* find(const std::string& term) const;
+    static int decodeBlock(const PostingList& list, int block, int* out, int untilId);
+    static void decodeAll(const PostingList& list, std::vector<int>& out);
+    static void intersectWith(const std::vector<int>& candidates, const PostingList& list, std::vector<int>& out);
+    static void unite(std::vector<int>& result, const std::vector<int>& other);
+    void accountGrowth(std::size_t before, std::size_t after);
+
+public:
+    SymptomIndex();
+
+    /**
+     * INDEX A NEWLY REGISTERED PATIENT
+     * - Strong guarantee: storage is reserved before any list changes
+     * EXCEPTION: Throws invalid_argument if patientId does not increase
+     */
+    void insert(int patientId, const std::string& symptom);
+
+    /**
+     * PRE-SIZE FOR AN EXPECTED NUMBER OF DISTINCT TERMS
+     * - Reserves the term table and the list of posting lists; each posting
+     *   list still grows with its own term's patients
+     */
+    void reserve(int terms);
+
+    /**
+     * PATIENT IDs (ascending) HAVING EVERY / ANY OF THE TERMS
+     * - Terms are folded, so callers may pass raw words
+     * @return Number of IDs written to out (out is replaced)
+     */
+    int matchAll(const std::vector<std::string>& terms, std::vector<int>& out) const;
+    int matchAny(const std::vector<std::string>& terms, std::vector<int>& out) const;
+
+    /**
+     * BOOLEAN QUERY - "term term AND term OR term ..." (see class comment)
+     * @return Number of IDs written to out; 0 for an empty query
+     */
+    int query(const std::string& expression, std::vector<int>& out) const;
+
+    /**
+     * SPLIT TEXT INTO FOLDED TERMS, DUPLICATES REMOVED (first occurrence kept)
+     */
+    static void tokenize(const std::string& text, std::vector<std::string>& out);
+
+    /**
+     * SORTED-ARRAY INTERSECTION KERNELS (arrays strictly increasing)
+     * - intersect uses SSE2 when available; out needs min(na, nb) slots
+     * @return Number of common IDs written to out
+     */
+    static int intersect(const int* a, int na, const int* b, int nb, int* out);
+    static int intersectScalar(const int* a, int na, const int* b, int nb, int* out);
+
+    int documentFrequency(const std::string& term) const;
+    int termCount() const { return (int)postings.size(); }
+    long long postingCount() const { return postingTotal; }
+
+    /**
+     * BYTES HELD BY THE POSTING LISTS (headers and varint gaps, by capacity)
+     */
+    long long postingBytes() const;
+
+    /**
+     * ALLOCATION STATISTICS - the posting table and every list's blocks
+     * and gaps, by capacity; the term hash map is not counted
+     * (all zero unless compiled with HOSPITAL_MEMORY_STATS)
+     */
+    MemoryStats memoryStats() const { return MEMORY_ACCOUNT_SNAPSHOT(); }
+};
+
+#endif
@@ -0,0 +1,213 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * WORK-STEALING THREAD POOL
+ *
+ * IMPLEMENTATION:
+ * - One task deque per worker thread, each guarded by its own mutex
+ * - A worker pops from the BACK of its own deque (LIFO - cache-warm work)
+ * - An idle worker steals from the FRONT of another worker's deque (FIFO -
+ *   the oldest, usually largest, pieces of work)
+ * - Tasks submitted from outside the pool (another pool's workers
+ *   included) are spread round-robin; tasks submitted by one of this
+ *   pool's workers go to that worker's own deque
+ *
+ * SYNCHRONIZATION:
+ * - Idle workers sleep on a condition variable instead of spinning
+ * - wait() blocks until every submitted task has finished and rethrows the
+ *   first exception raised by a task
+ *
+ * USAGE: Monte Carlo replications and any other batch of independent jobs
+ */
+class ThreadPool {
+private:
+    /**
+     * PER-WORKER TASK DEQUE
+     */
+    struct WorkQueue {
+        std::mutex lock;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::thread> workers;       ///< Worker threads
+    std::vector<WorkQueue*> queues;         ///< One deque per worker
+    std::atomic<int> queuedTasks;           ///< Tasks sitting in any deque
+    std::atomic<int> pendingTasks;          ///< Tasks submitted but not finished
+    std::atomic<unsigned> nextQueue;        ///< Round-robin cursor for external submits
+    bool stopping;                          ///< Set under sleepLock at shutdown
+
+    std::mutex sleepLock;                   ///< Guards idle-worker sleeping
+    std::condition_variable workAvailable;  ///< Signalled on submit and shutdown
+    std::mutex doneLock;                    ///< Guards completion waiting
+    std::condition_variable allDone;        ///< Signalled when pendingTasks hits 0
+    std::exception_ptr firstError;          ///< First exception thrown by a task
+
+    /**
+     * POOL AND INDEX OF THE CALLING WORKER (NULL / -1 OUTSIDE ANY POOL)
+     * - Shared by every ThreadPool in the process: a task of one pool may
+     *   submit to another, so the index is only valid for its own pool
+     */
+    struct WorkerIdentity {
+        const ThreadPool* pool;
+        int index;
+    };
+
+    static WorkerIdentity& currentWorker() {
+        static thread_local WorkerIdentity identity = {NULL, -1};
+        return identity;
+    }
+
+    /**
+     * TRY TO TAKE ONE TASK: OWN DEQUE FIRST, THEN STEAL
+     * @return true if 'task' was filled
+     */
+    bool takeTask(int self, std::function<void()>& task) {
+        {
+            WorkQueue& own = *queues[self];
+            std::lock_guard<std::mutex> guard(own.lock);
+            if (!own.tasks.empty()) {
+                task = std::move(own.tasks.back());
+                own.tasks.pop_back();
+                queuedTasks--;
+                return true;
+            }
+        }
+        int count = (int)queues.size();
+        for (int offset = 1; offset < count; offset++) {
+            WorkQueue& victim = *queues[(self + offset) % count];
+            std::lock_guard<std::mutex> guard(victim.lock);
+            if (!victim.tasks.empty()) {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                queuedTasks--;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * WORKER LOOP - Run tasks until the pool shuts down
+     */
+    void workerLoop(int self) {
+        currentWorker().pool = this;
+        currentWorker().index = self;
+        std::function<void()> task;
+        while (true) {
+            if (takeTask(self, task)) {
+                try {
+                    task();
+                }
+                catch (...) {
+                    std::lock_guard<std::mutex> guard(doneLock);
+                    if (!firstError) {
+                        firstError = std::current_exception();
+                    }
+                }
+                task = nullptr;
+                if (--pendingTasks == 0) {
+                    std::lock_guard<std::mutex> guard(doneLock);
+                    allDone.notify_all();
+                }
+                continue;
+            }
+
+            std::unique_lock<std::mutex> guard(sleepLock);
+            workAvailable.wait(guard, [this] { return stopping || queuedTasks.load() > 0; });
+            if (stopping && queuedTasks.load() == 0) {
+                return;
+            }
+        }
+    }
+
+public:
+    /**
+     * CONSTRUCTOR - Starts the worker threads
+     * @param threads: Number of workers (0 = one per hardware thread)
+     */
+    explicit ThreadPool(int threads = 0)
+        : queuedTasks(0), pendingTasks(0), nextQueue(0), stopping(false) {
+        if (threads <= 0) {
+            threads = (int)std::thread::hardware_concurrency();
+            if (threads <= 0) threads = 1;
+        }
+        for (int i = 0; i < threads; i++) {
+            queues.push_back(new WorkQueue());
+        }
+        for (int i = 0; i < threads; i++) {
+            workers.push_back(std::thread(&ThreadPool::workerLoop, this, i));
+        }
+    }
+
+    /**
+     * DESTRUCTOR - Finishes queued work, then joins every worker
+     */
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> guard(sleepLock);
+            stopping = true;
+        }
+        workAvailable.notify_all();
+        for (size_t i = 0; i < workers.size(); i++) {
+            workers[i].join();
+        }
+        for (size_t i = 0; i < queues.size(); i++) {
+            delete queues[i];
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * SUBMIT A TASK
+     * @param task: Callable run exactly once on some worker
+     */
+    void submit(std::function<void()> task) {
+        const WorkerIdentity& caller = currentWorker();
+        int target = caller.pool == this ? caller.index : (int)(nextQueue++ % queues.size());
+        pendingTasks++;
+        {
+            std::lock_guard<std::mutex> guard(queues[target]->lock);
+            queues[target]->tasks.push_back(std::move(task));
+        }
+        {
+            std::lock_guard<std::mutex> guard(sleepLock);
+            queuedTasks++;
+        }
+        workAvailable.notify_one();
+    }
+
+    /**
+     * WAIT FOR ALL SUBMITTED TASKS
+     * EXCEPTION: Rethrows the first exception raised by any task
+     */
+    void wait() {
+        std::unique_lock<std::mutex> guard(doneLock);
+        allDone.wait(guard, [this] { return pendingTasks.load() == 0; });
+        if (firstError) {
+            std::exception_ptr error = firstError;
+            firstError = nullptr;
+            std::rethrow_exception(error);
+        }
+    }
+
+    /**
+     * NUMBER OF WORKER THREADS
+     */
+    int size() {
+        return (int)workers.size();
+    }
+};
+
+#endif
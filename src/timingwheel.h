@@ -0,0 +1,299 @@
+#ifndef TIMINGWHEEL_H
+#define TIMINGWHEEL_H
+
+#include "memorystats.h"
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * HIERARCHICAL TIMING WHEEL TEMPLATE CLASS
+ *
+ * IMPLEMENTATION: LEVELS wheels of 64 slots; level L slot s holds the
+ * timers whose expiry tick shares every digit above L with the current
+ * tick and has digit s at L (digits are 6 bits). A timer therefore sits in
+ * level 0 when it expires within the current 64-tick block, in level 1
+ * within the current 4096-tick block, and so on.
+ * - When the current tick enters a new block, the matching higher-level
+ *   slot is cascaded: its timers move down to the level their expiry now
+ *   needs, at most once per level over a timer's life
+ * - Timers are nodes of a pooled array linked into their slot, so
+ *   schedule and cancel are O(1) and a cancelled or expired node is reused
+ * - One occupancy bitmap per level lets advance() jump straight to the
+ *   next occupied level-0 slot or block boundary
+ *
+ * HOSPITAL APPLICATION: Expected end of every consultation room
+ *
+ * PERFORMANCE CHARACTERISTICS:
+ * - schedule / cancel: O(1)
+ * - advance: O(1) per occupied slot or 64-tick block crossed, plus O(1)
+ *   per expired or cascaded timer; nothing is done for an empty wheel
+ * - earliest: O(1) below 64 ticks ahead, otherwise one scan of the first
+ *   occupied slot of levels 1-2, or of the whole top level
+ * - Range: 64^LEVELS ticks ahead (2^24); further timers are parked in the
+ *   top level and re-cascaded until they come within range
+ */
+template <typename T>
+class TimingWheel {
+public:
+    static const int LEVELS = 4;
+    static const int SLOT_BITS = 6;
+    static const int SLOTS = 1 << SLOT_BITS;
+
+private:
+    struct Node {
+        T value;
+        long long expiry;
+        int prev;
+        int next;
+        int slot;  ///< level * SLOTS + slot index, -1 when free
+    };
+
+    std::vector<Node> nodes;
+    int heads[LEVELS * SLOTS];
+    std::uint64_t occupied[LEVELS];  ///< Bit s set: slot s of that level is non-empty
+    int freeList;
+    int active;
+    long long current;
+    MEMORY_ACCOUNT
+
+    void link(int index) {
+        Node& node = nodes[(size_t)index];
+        std::uint64_t diff = (std::uint64_t)(node.expiry ^ current);
+        int level = 0;
+        while (level < LEVELS - 1 && (diff >> (SLOT_BITS * (level + 1))) != 0) {
+            level++;
+        }
+        int slot = (int)((node.expiry >> (SLOT_BITS * level)) & (SLOTS - 1));
+        node.slot = level * SLOTS + slot;
+        node.prev = -1;
+        node.next = heads[node.slot];
+        if (node.next >= 0) {
+            nodes[(size_t)node.next].prev = index;
+        }
+        heads[node.slot] = index;
+        occupied[level] |= 1ULL << slot;
+    }
+
+    void unlink(int index) {
+        Node& node = nodes[(size_t)index];
+        if (node.prev >= 0) {
+            nodes[(size_t)node.prev].next = node.next;
+        } else {
+            heads[node.slot] = node.next;
+        }
+        if (node.next >= 0) {
+            nodes[(size_t)node.next].prev = node.prev;
+        }
+        if (heads[node.slot] < 0) {
+            occupied[node.slot / SLOTS] &= ~(1ULL << (node.slot % SLOTS));
+        }
+        node.slot = -1;
+    }
+
+    void release(int index) {
+        nodes[(size_t)index].next = freeList;
+        freeList = index;
+        active--;
+    }
+
+    /**
+     * MOVE EVERY TIMER OF ONE SLOT DOWN TO THE LEVEL IT NOW BELONGS TO
+     */
+    void cascade(int level, int slot) {
+        int index = heads[level * SLOTS + slot];
+        heads[level * SLOTS + slot] = -1;
+        occupied[level] &= ~(1ULL << slot);
+        while (index >= 0) {
+            int next = nodes[(size_t)index].next;
+            link(index);
+            index = next;
+        }
+    }
+
+public:
+    /**
+     * CONSTRUCTOR
+     * @param startTick: Current tick; timers may only expire after it
+     */
+    explicit TimingWheel(long long startTick = 0) : freeList(-1), active(0), current(startTick) {
+        for (int i = 0; i < LEVELS * SLOTS; i++) {
+            heads[i] = -1;
+        }
+        for (int level = 0; level < LEVELS; level++) {
+            occupied[level] = 0;
+        }
+    }
+
+    ~TimingWheel() {
+        if (nodes.capacity() > 0) {
+            MEMORY_ACCOUNT_RELEASE(nodes.capacity() * sizeof(Node));
+        }
+    }
+
+    /**
+     * ADD A TIMER
+     * @param expiryTick: Tick at which it fires; a tick not after the
+     *        current one fires at the next tick
+     * @param value: Payload handed back on expiry
+     * @return Handle for cancel() (reused once the timer fires or is cancelled)
+     */
+    int schedule(long long expiryTick, const T& value) {
+        int index = freeList;
+        if (index >= 0) {
+            freeList = nodes[(size_t)index].next;
+        } else {
+            size_t capacity = nodes.capacity();
+            nodes.push_back(Node());
+            if (nodes.capacity() != capacity) {
+                MEMORY_ACCOUNT_RELEASE(capacity * sizeof(Node));
+                MEMORY_ACCOUNT_ALLOCATE(nodes.capacity() * sizeof(Node));
+            }
+            index = (int)nodes.size() - 1;
+        }
+        nodes[(size_t)index].value = value;
+        nodes[(size_t)index].expiry = expiryTick > current ? expiryTick : current + 1;
+        link(index);
+        active++;
+        return index;
+    }
+
+    /**
+     * REMOVE A PENDING TIMER
+     * @return false when the handle is not a pending timer
+     */
+    bool cancel(int handle) {
+        if (handle < 0 || handle >= (int)nodes.size() || nodes[(size_t)handle].slot < 0) {
+            return false;
+        }
+        unlink(handle);
+        release(handle);
+        return true;
+    }
+
+    /**
+     * MOVE TIME FORWARD TO nowTick
+     * @param expired: Receives the payload of every timer with expiry <=
+     *        nowTick, earliest first (appended)
+     * @return Number of timers that fired
+     */
+    int advance(long long nowTick, std::vector<T>& expired) {
+        int fired = 0;
+        while (current < nowTick) {
+            if (active == 0) {
+                current = nowTick;
+                break;
+            }
+            // Next occupied level-0 slot in this block, else the next block
+            int position = (int)(current & (SLOTS - 1));
+            std::uint64_t ahead = position == SLOTS - 1 ? 0 : occupied[0] & (~0ULL << (position + 1));
+            long long next = ahead != 0 ? (current & ~(long long)(SLOTS - 1)) + __builtin_ctzll(ahead)
+                                        : (current | (SLOTS - 1)) + 1;
+            if (next > nowTick) {
+                current = nowTick;
+                break;
+            }
+            current = next;
+
+            if ((current & (SLOTS - 1)) == 0) {
+                // New block: cascade from the highest level whose digits below rolled over
+                int top = 1;
+                while (top < LEVELS - 1 && ((current >> (SLOT_BITS * top)) & (SLOTS - 1)) == 0) {
+                    top++;
+                }
+                for (int level = top; level >= 1; level--) {
+                    cascade(level, (int)((current >> (SLOT_BITS * level)) & (SLOTS - 1)));
+                }
+            }
+
+            int slot = (int)(current & (SLOTS - 1));
+            int index = heads[slot];
+            while (index >= 0) {
+                int following = nodes[(size_t)index].next;
+                unlink(index);
+                expired.push_back(nodes[(size_t)index].value);
+                release(index);
+                fired++;
+                index = following;
+            }
+        }
+        return fired;
+    }
+
+    /**
+     * PENDING TIMER THAT FIRES FIRST
+     * @return Its handle, -1 for an empty wheel
+     *
+     * Lower levels always fire before higher ones, and within levels 0-2
+     * the slots ahead of the current digit fire in index order
+     */
+    int earliest() const {
+        for (int level = 0; level < LEVELS - 1; level++) {
+            int digit = (int)((current >> (SLOT_BITS * level)) & (SLOTS - 1));
+            std::uint64_t ahead = digit == SLOTS - 1 ? 0 : occupied[level] & (~0ULL << (digit + 1));
+            if (ahead == 0) {
+                continue;
+            }
+            int best = heads[level * SLOTS + __builtin_ctzll(ahead)];
+            for (int index = nodes[(size_t)best].next; level > 0 && index >= 0; index = nodes[(size_t)index].next) {
+                if (nodes[(size_t)index].expiry < nodes[(size_t)best].expiry) {
+                    best = index;
+                }
+            }
+            return best;
+        }
+
+        // Top level: timers parked beyond the range share its slots, so every one is compared
+        int best = -1;
+        for (std::uint64_t slots = occupied[LEVELS - 1]; slots != 0; slots &= slots - 1) {
+            int index = heads[(LEVELS - 1) * SLOTS + __builtin_ctzll(slots)];
+            for (; index >= 0; index = nodes[(size_t)index].next) {
+                if (best < 0 || nodes[(size_t)index].expiry < nodes[(size_t)best].expiry) {
+                    best = index;
+                }
+            }
+        }
+        return best;
+    }
+
+    /**
+     * PAYLOAD AND EXPIRY OF A PENDING TIMER
+     * EXCEPTION: Throws out_of_range for a handle that is not pending
+     */
+    const T& valueOf(int handle) const {
+        if (handle < 0 || handle >= (int)nodes.size() || nodes[(size_t)handle].slot < 0) {
+            throw std::out_of_range("Timer handle is not pending");
+        }
+        return nodes[(size_t)handle].value;
+    }
+
+    long long expiryOf(int handle) const {
+        valueOf(handle);
+        return nodes[(size_t)handle].expiry;
+    }
+
+    /**
+     * PRE-ALLOCATE n TIMER NODES
+     */
+    void reserve(int n) {
+        size_t capacity = nodes.capacity();
+        nodes.reserve((size_t)n);
+        if (nodes.capacity() != capacity) {
+            MEMORY_ACCOUNT_RELEASE(capacity * sizeof(Node));
+            MEMORY_ACCOUNT_ALLOCATE(nodes.capacity() * sizeof(Node));
+        }
+    }
+
+    int size() const { return active; }
+    bool isEmpty() const { return active == 0; }
+    long long now() const { return current; }
+
+    /**
+     * ALLOCATION STATISTICS (zero unless built with HOSPITAL_MEMORY_STATS)
+     */
+    MemoryStats memoryStats() const {
+        return MEMORY_ACCOUNT_SNAPSHOT();
+    }
+};
+
+#endif
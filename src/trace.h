@@ -0,0 +1,234 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+/**
+ * HOT-PATH TRACING WITH SCOPED TIMERS
+ *
+ * ENABLING: Compile with -DHOSPITAL_TRACING (make TRACING=1)
+ *
+ * USAGE:
+ *   void HospitalSystem::attendNextPatient() {
+ *       TRACE_SCOPE("attendNextPatient");   // records [enter, exit) of this scope
+ *       ...
+ *   }
+ *   Tracer::exportChromeTrace("trace.json"); // open in chrome://tracing or Perfetto
+ *
+ * DESIGN:
+ * - Each thread writes into its own fixed-size ring buffer (no locks, no
+ *   allocation on the hot path; the oldest events are overwritten)
+ * - Timestamps come from rdtsc on x86-64 (steady_clock elsewhere) and are
+ *   converted to microseconds only at export time
+ * - Buffers are linked into a lock-free global list when a thread records
+ *   its first event, so the exporter can find every thread's events
+ *
+ * COST:
+ * - Compiled out: TRACE_SCOPE expands to nothing (zero cost)
+ * - Enabled: two timestamp reads and three stores per event (bench/trace_bench)
+ */
+#ifdef HOSPITAL_TRACING
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <thread>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/**
+ * ONE COMPLETED SCOPE
+ */
+struct TraceEvent {
+    const char* name;     ///< Static string literal naming the trace point
+    std::uint64_t start;  ///< Timestamp at scope entry (ticks)
+    std::uint64_t end;    ///< Timestamp at scope exit (ticks)
+};
+
+/**
+ * PER-THREAD RING BUFFER
+ * - Single writer (the owning thread); the exporter only reads
+ * - writeIndex is published with release ordering after each event
+ */
+struct TraceBuffer {
+    static const std::uint64_t CAPACITY = 1 << 16;  ///< Events kept per thread (power of two)
+
+    TraceEvent events[CAPACITY];
+    std::atomic<std::uint64_t> writeIndex;
+    int threadNumber;
+    TraceBuffer* next;
+
+    TraceBuffer() : writeIndex(0), threadNumber(0), next(NULL) {}
+};
+
+/**
+ * GLOBAL TRACER STATE AND EXPORT
+ */
+class Tracer {
+public:
+    /**
+     * CURRENT TIMESTAMP IN TICKS
+     */
+    static inline std::uint64_t now() {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return (std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+    }
+
+    /**
+     * BUFFER OF THE CALLING THREAD (registered on first use)
+     */
+    static inline TraceBuffer* threadBuffer() {
+        static thread_local TraceBuffer* buffer = NULL;
+        if (buffer == NULL) {
+            buffer = registerThread();
+        }
+        return buffer;
+    }
+
+    /**
+     * APPEND ONE EVENT TO THE CALLING THREAD'S RING
+     */
+    static inline void record(const char* name, std::uint64_t start, std::uint64_t end) {
+        TraceBuffer* buffer = threadBuffer();
+        std::uint64_t index = buffer->writeIndex.load(std::memory_order_relaxed);
+        TraceEvent& event = buffer->events[index & (TraceBuffer::CAPACITY - 1)];
+        event.name = name;
+        event.start = start;
+        event.end = end;
+        buffer->writeIndex.store(index + 1, std::memory_order_release);
+    }
+
+    /**
+     * WRITE EVERY BUFFERED EVENT AS CHROME TRACE JSON
+     * @param path: Output file (open with chrome://tracing or ui.perfetto.dev)
+     * @return Number of events written
+     *
+     * CONSISTENCY: Events overwritten by their thread while being copied are
+     * detected by re-reading the write index and skipped
+     */
+    static long long exportChromeTrace(const std::string& path) {
+        double ticksPerMicro = ticksPerMicrosecond();
+        std::uint64_t origin = clockOrigin().ticks;
+        std::ofstream file(path.c_str());
+        file << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+        long long written = 0;
+        for (TraceBuffer* buffer = registry().load(std::memory_order_acquire); buffer != NULL; buffer = buffer->next) {
+            std::uint64_t end = buffer->writeIndex.load(std::memory_order_acquire);
+            std::uint64_t begin = end > TraceBuffer::CAPACITY ? end - TraceBuffer::CAPACITY : 0;
+            for (std::uint64_t i = begin; i < end; i++) {
+                TraceEvent event = buffer->events[i & (TraceBuffer::CAPACITY - 1)];
+                std::uint64_t latest = buffer->writeIndex.load(std::memory_order_acquire);
+                if (latest > TraceBuffer::CAPACITY && i < latest - TraceBuffer::CAPACITY) {
+                    continue;  // Slot was recycled while we copied it
+                }
+                double ts = (double)(event.start - origin) / ticksPerMicro;
+                double dur = (double)(event.end - event.start) / ticksPerMicro;
+                file << (written > 0 ? "," : "") << "\n{\"name\":\"" << event.name
+                     << "\",\"cat\":\"hospital\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->threadNumber
+                     << ",\"ts\":" << ts << ",\"dur\":" << dur << "}";
+                written++;
+            }
+        }
+        file << "\n]}\n";
+        return written;
+    }
+
+private:
+    /**
+     * CLOCK ORIGIN - Paired tick and steady_clock readings for calibration
+     */
+    struct ClockOrigin {
+        std::uint64_t ticks;
+        std::chrono::steady_clock::time_point wall;
+    };
+
+    static ClockOrigin& clockOrigin() {
+        static ClockOrigin origin = {now(), std::chrono::steady_clock::now()};
+        return origin;
+    }
+
+    static std::atomic<TraceBuffer*>& registry() {
+        static std::atomic<TraceBuffer*> head(NULL);
+        return head;
+    }
+
+    /**
+     * ALLOCATE AND PUBLISH A BUFFER (lock-free push onto the registry)
+     * - Buffers are never freed so events survive thread exit until export
+     */
+    static TraceBuffer* registerThread() {
+        static std::atomic<int> threadCounter(0);
+        clockOrigin();
+        TraceBuffer* buffer = new TraceBuffer();
+        buffer->threadNumber = ++threadCounter;
+        TraceBuffer* head = registry().load(std::memory_order_relaxed);
+        do {
+            buffer->next = head;
+        } while (!registry().compare_exchange_weak(head, buffer, std::memory_order_release, std::memory_order_relaxed));
+        return buffer;
+    }
+
+    /**
+     * TICK RATE CALIBRATED AGAINST steady_clock SINCE THE ORIGIN
+     */
+    static double ticksPerMicrosecond() {
+        ClockOrigin& origin = clockOrigin();
+        if (std::chrono::steady_clock::now() - origin.wall < std::chrono::milliseconds(10)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        std::uint64_t ticks = now();
+        double micros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - origin.wall).count();
+        return (double)(ticks - origin.ticks) / micros;
+    }
+};
+
+/**
+ * SCOPED TIMER - Records one event when the scope exits
+ */
+class ScopedTrace {
+private:
+    const char* name;
+    std::uint64_t start;
+
+public:
+    explicit ScopedTrace(const char* traceName) : name(traceName), start(Tracer::now()) {}
+
+    ~ScopedTrace() {
+        Tracer::record(name, start, Tracer::now());
+    }
+
+    ScopedTrace(const ScopedTrace&) = delete;
+    ScopedTrace& operator=(const ScopedTrace&) = delete;
+};
+
+#define TRACING_ENABLED 1
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(name) ScopedTrace TRACE_CONCAT(traceScope_, __LINE__)(name)
+
+#else
+
+#include <string>
+
+/**
+ * DISABLED TRACER - Keeps call sites compiling; nothing is recorded
+ */
+class Tracer {
+public:
+    static long long exportChromeTrace(const std::string&) {
+        return 0;
+    }
+};
+
+#define TRACING_ENABLED 0
+#define TRACE_SCOPE(name) ((void)0)
+
+#endif
+
+#endif
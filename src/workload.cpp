@@ -0,0 +1,468 @@
+#include "workload.h"
+#include "eventcalendar.h"
+#include "hospitalsystem.h"
+#include "histogram.h"
+#include "list.h"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <thread>
+
+using namespace std;
+
+/**
+ * SYNTHETIC DATA TABLES
+ * - Common Colombian given names and surnames, frequent ED complaints
+ */
+static const char* const FIRST_NAMES[] = {
+    "Juan", "Maria", "Carlos", "Ana", "Luis", "Laura", "Andres", "Camila",
+    "Jorge", "Valentina", "Diego", "Daniela", "Santiago", "Sofia", "Felipe", "Paula",
+    "Alejandro", "Natalia", "Sebastian", "Carolina", "Mateo", "Isabella", "Nicolas", "Mariana",
+    "Jose", "Gabriela", "Miguel", "Juliana", "David", "Catalina", "Esteban", "Lucia"
+};
+
+static const char* const LAST_NAMES[] = {
+    "Rodriguez", "Gomez", "Gonzalez", "Martinez", "Garcia", "Lopez", "Hernandez", "Sanchez",
+    "Ramirez", "Perez", "Diaz", "Munoz", "Rojas", "Moreno", "Jimenez", "Vargas",
+    "Castro", "Gutierrez", "Alvarez", "Romero", "Ortiz", "Suarez", "Torres", "Ruiz",
+    "Mejia", "Restrepo", "Cardenas", "Ospina", "Salazar", "Quintero", "Castillo", "Rincon"
+};
+
+static const char* const SYMPTOMS[] = {
+    "Chest pain", "Shortness of breath", "Fever", "Cough", "Abdominal pain",
+    "Headache", "Dizziness", "Vomiting", "Diarrhea", "Back pain",
+    "Laceration", "Fracture suspicion", "Burn", "Allergic reaction", "Fever and cough",
+    "Sore throat"
+};
+
+static const int FIRST_NAME_COUNT = sizeof(FIRST_NAMES) / sizeof(FIRST_NAMES[0]);
+static const int LAST_NAME_COUNT = sizeof(LAST_NAMES) / sizeof(LAST_NAMES[0]);
+static const int SYMPTOM_COUNT = sizeof(SYMPTOMS) / sizeof(SYMPTOMS[0]);
+
+string WorkloadTrace::firstNameAt(int index) { return FIRST_NAMES[index % FIRST_NAME_COUNT]; }
+string WorkloadTrace::lastNameAt(int index) { return LAST_NAMES[index % LAST_NAME_COUNT]; }
+string WorkloadTrace::symptomAt(int index) { return SYMPTOMS[index % SYMPTOM_COUNT]; }
+int WorkloadTrace::firstNameCount() { return FIRST_NAME_COUNT; }
+int WorkloadTrace::lastNameCount() { return LAST_NAME_COUNT; }
+int WorkloadTrace::symptomCount() { return SYMPTOM_COUNT; }
+
+/**
+ * LITTLE-ENDIAN AND VARINT ENCODING HELPERS
+ */
+static void writeFixed64(string& out, uint64_t value) {
+    for (int i = 0; i < 8; i++) {
+        out.push_back((char)((value >> (8 * i)) & 0xFF));
+    }
+}
+
+static void writeVarint(string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back((char)((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back((char)value);
+}
+
+static uint64_t readFixed64(const string& in, size_t& position) {
+    if (position + 8 > in.size()) {
+        throw runtime_error("Truncated workload trace header");
+    }
+    uint64_t value = 0;
+    for (int i = 0; i < 8; i++) {
+        value |= (uint64_t)(unsigned char)in[position++] << (8 * i);
+    }
+    return value;
+}
+
+static uint64_t readVarint(const string& in, size_t& position) {
+    uint64_t value = 0;
+    int shift = 0;
+    while (true) {
+        if (position >= in.size() || shift > 63) {
+            throw runtime_error("Truncated or malformed varint in workload trace");
+        }
+        unsigned char byte = (unsigned char)in[position++];
+        value |= (uint64_t)(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return value;
+        }
+        shift += 7;
+    }
+}
+
+static int readByte(const string& in, size_t& position) {
+    if (position >= in.size()) {
+        throw runtime_error("Truncated workload trace record");
+    }
+    return (unsigned char)in[position++];
+}
+
+void WorkloadTrace::save(const string& path) const {
+    string out;
+    out.reserve(24 + records.size() * 6);
+    out.append("HWTR", 4);
+    out.push_back((char)VERSION);
+    out.append(3, '\0');
+    writeFixed64(out, seed);
+    writeFixed64(out, (uint64_t)records.size());
+
+    uint64_t previous = 0;
+    for (size_t i = 0; i < records.size(); i++) {
+        const TraceRecord& record = records[i];
+        out.push_back((char)record.operation);
+        writeVarint(out, record.timeMicros - previous);
+        previous = record.timeMicros;
+
+        if (record.operation == TRACE_REGISTER) {
+            out.push_back((char)record.priority);
+            out.push_back((char)record.age);
+            out.push_back((char)record.firstName);
+            out.push_back((char)record.lastName);
+            out.push_back((char)record.symptom);
+            writeVarint(out, (uint64_t)record.consultationSeconds);
+        } else if (record.operation == TRACE_SEARCH) {
+            writeVarint(out, (uint64_t)record.patientId);
+        }
+    }
+
+    ofstream file(path.c_str(), ios::binary);
+    if (!file || !file.write(out.data(), (streamsize)out.size())) {
+        throw runtime_error("Cannot write workload trace: " + path);
+    }
+}
+
+void WorkloadTrace::load(const string& path) {
+    ifstream file(path.c_str(), ios::binary);
+    if (!file) {
+        throw runtime_error("Cannot open workload trace: " + path);
+    }
+    string in((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+
+    if (in.size() < 24 || in.compare(0, 4, "HWTR") != 0) {
+        throw runtime_error("Not a workload trace (bad magic): " + path);
+    }
+    if ((unsigned char)in[4] != VERSION) {
+        throw runtime_error("Unsupported workload trace version");
+    }
+    size_t position = 8;
+    seed = readFixed64(in, position);
+    uint64_t count = readFixed64(in, position);
+
+    records.clear();
+    records.reserve((size_t)count);
+    uint64_t time = 0;
+    for (uint64_t i = 0; i < count; i++) {
+        TraceRecord record = TraceRecord();
+        record.operation = readByte(in, position);
+        time += readVarint(in, position);
+        record.timeMicros = time;
+
+        if (record.operation == TRACE_REGISTER) {
+            record.priority = readByte(in, position);
+            record.age = readByte(in, position);
+            record.firstName = readByte(in, position);
+            record.lastName = readByte(in, position);
+            record.symptom = readByte(in, position);
+            record.consultationSeconds = (int)readVarint(in, position);
+        } else if (record.operation == TRACE_SEARCH) {
+            record.patientId = (int)readVarint(in, position);
+        } else if (record.operation != TRACE_ATTEND && record.operation != TRACE_FREE) {
+            throw runtime_error("Unknown operation in workload trace");
+        }
+        records.push_back(record);
+    }
+}
+
+WorkloadConfig::WorkloadConfig()
+    : seed(2024), patients(100000), rooms(10), arrivalsPerHour(14.0),
+      burstProbability(0.02), maxBurstSize(8), searchesPerRegistration(0.25) {
+    const double mix[5] = {0.03, 0.12, 0.35, 0.30, 0.20};
+    for (int i = 0; i < 5; i++) {
+        triageMix[i] = mix[i];
+    }
+}
+
+/**
+ * GENERATOR EVENTS
+ * - BASE_ARRIVAL continues the Poisson stream, BURST_ARRIVAL does not
+ */
+enum GeneratorEventType { BASE_ARRIVAL, BURST_ARRIVAL, CONSULTATION_END };
+
+struct GeneratorEvent {
+    int type;
+};
+
+void WorkloadGenerator::generate(const WorkloadConfig& config, WorkloadTrace& trace) {
+    if (config.patients <= 0 || config.rooms <= 0 || config.arrivalsPerHour <= 0) {
+        throw invalid_argument("Workload needs positive patients, rooms and arrival rate");
+    }
+
+    mt19937_64 rng(config.seed);
+    exponential_distribution<double> interArrival(config.arrivalsPerHour / 3600.0);
+    discrete_distribution<int> triageLevel(config.triageMix, config.triageMix + 5);
+    uniform_real_distribution<double> unit(0.0, 1.0);
+    uniform_int_distribution<int> age(1, 95);
+    uniform_int_distribution<int> burstSize(1, config.maxBurstSize > 0 ? config.maxBurstSize : 1);
+    const double consultationMeans[5] = {60.0, 45.0, 30.0, 20.0, 15.0};
+    const double sigma = sqrt(log(1.25));  // Standard deviation = half the mean
+
+    EventCalendar<GeneratorEvent> calendar(config.rooms + 64);
+    List<int> waiting[5];  // Consultation seconds of waiting patients, FIFO per level
+    int waitingTotal = 0;
+    int occupied = 0;
+    int scheduled = 0;
+    int registered = 0;
+
+    trace.seed = config.seed;
+    trace.records.clear();
+    trace.records.reserve((size_t)config.patients * 3 + 16);
+
+    GeneratorEvent first = {BASE_ARRIVAL};
+    calendar.schedule(interArrival(rng), first);
+    scheduled++;
+
+    while (!calendar.isEmpty()) {
+        double now;
+        GeneratorEvent event = calendar.pop(now);
+        TraceRecord record = TraceRecord();
+        record.timeMicros = (uint64_t)llround(now * 1e6);
+
+        if (event.type == CONSULTATION_END) {
+            record.operation = TRACE_FREE;
+            trace.records.push_back(record);
+            occupied--;
+        } else {
+            int level = triageLevel(rng);
+            lognormal_distribution<double> consultation(log(consultationMeans[level] * 60.0) - sigma * sigma / 2.0, sigma);
+
+            record.operation = TRACE_REGISTER;
+            record.priority = level + 1;
+            record.age = age(rng);
+            record.firstName = (int)(rng() % FIRST_NAME_COUNT);
+            record.lastName = (int)(rng() % LAST_NAME_COUNT);
+            record.symptom = (int)(rng() % SYMPTOM_COUNT);
+            record.consultationSeconds = (int)consultation(rng) + 1;
+            trace.records.push_back(record);
+            registered++;
+
+            waiting[level].add(record.consultationSeconds);
+            waitingTotal++;
+
+            // Front-desk lookups of already registered patients
+            double searches = config.searchesPerRegistration;
+            while (searches > 0 && unit(rng) < searches) {
+                TraceRecord search = TraceRecord();
+                search.timeMicros = record.timeMicros;
+                search.operation = TRACE_SEARCH;
+                search.patientId = 1 + (int)(rng() % (uint64_t)registered);
+                trace.records.push_back(search);
+                searches -= 1.0;
+            }
+
+            if (event.type == BASE_ARRIVAL) {
+                // Registration burst: extra arrivals within the next 5 minutes
+                if (unit(rng) < config.burstProbability) {
+                    int extra = burstSize(rng);
+                    for (int i = 0; i < extra && scheduled < config.patients; i++) {
+                        GeneratorEvent burst = {BURST_ARRIVAL};
+                        calendar.schedule(now + unit(rng) * 300.0, burst);
+                        scheduled++;
+                    }
+                }
+                if (scheduled < config.patients) {
+                    GeneratorEvent next = {BASE_ARRIVAL};
+                    calendar.schedule(now + interArrival(rng), next);
+                    scheduled++;
+                }
+            }
+        }
+
+        // Attend whenever a room is free and a patient is waiting
+        while (occupied < config.rooms && waitingTotal > 0) {
+            int level = 0;
+            while (waiting[level].isEmpty()) {
+                level++;
+            }
+            int seconds = waiting[level].pop();
+            waitingTotal--;
+            occupied++;
+
+            TraceRecord attend = TraceRecord();
+            attend.timeMicros = record.timeMicros;
+            attend.operation = TRACE_ATTEND;
+            trace.records.push_back(attend);
+
+            GeneratorEvent end = {CONSULTATION_END};
+            calendar.schedule(now + seconds, end);
+        }
+    }
+}
+
+/**
+ * PARSE A NUMERIC OPTION VALUE
+ * EXCEPTION: Throws invalid_argument if the text is not a number
+ */
+static double parseOption(const string& option, const char* text) {
+    char* end = NULL;
+    double value = strtod(text, &end);
+    if (*text == '\0' || *end != '\0') {
+        throw invalid_argument("Invalid value for " + option + ": " + text);
+    }
+    return value;
+}
+
+int WorkloadGenerator::runFromCommandLine(int argc, char* argv[]) {
+    try {
+        if (argc < 1) {
+            throw invalid_argument("Usage: --generate-workload <output file> [options]");
+        }
+        string path = argv[0];
+        WorkloadConfig config;
+        for (int i = 1; i < argc; i += 2) {
+            string option = argv[i];
+            if (i + 1 >= argc) {
+                throw invalid_argument("Missing value for option " + option);
+            }
+            double value = parseOption(option, argv[i + 1]);
+            if (option == "--patients") config.patients = (int)value;
+            else if (option == "--seed") config.seed = (uint64_t)value;
+            else if (option == "--rooms") config.rooms = (int)value;
+            else if (option == "--rate") config.arrivalsPerHour = value;
+            else if (option == "--burst-probability") config.burstProbability = value;
+            else if (option == "--burst-size") config.maxBurstSize = (int)value;
+            else if (option == "--search-ratio") config.searchesPerRegistration = value;
+            else throw invalid_argument("Unknown workload option: " + option);
+        }
+
+        WorkloadTrace trace;
+        WorkloadGenerator::generate(config, trace);
+        trace.save(path);
+
+        ifstream written(path.c_str(), ios::binary | ios::ate);
+        cout << "[DONE] Workload trace written: " << path << endl;
+        cout << "Records: " << trace.records.size() << " | Registrations: " << config.patients
+             << " | Seed: " << config.seed << " | Size: " << written.tellg() << " bytes" << endl;
+        return 0;
+    }
+    catch (const exception& e) {
+        cout << "\n[ERROR!] Workload generation failed: " << e.what() << endl;
+        return 1;
+    }
+}
+
+void WorkloadReplayer::replay(const WorkloadTrace& trace, int rooms, double speed, ostream& os) {
+    const char* operationNames[TRACE_OPERATION_COUNT] = {"register", "attend", "free", "search"};
+    unique_ptr<Histogram[]> latency(new Histogram[TRACE_OPERATION_COUNT]);  // Too large for the stack
+    long long misses[TRACE_OPERATION_COUNT] = {0, 0, 0, 0};
+
+    unique_ptr<HospitalSystem> hospital(new HospitalSystem(rooms, false));  // Freed on a malformed record too
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    for (size_t i = 0; i < trace.records.size(); i++) {
+        const TraceRecord& record = trace.records[i];
+        if (speed > 0) {
+            chrono::nanoseconds offset((long long)((double)record.timeMicros * 1000.0 / speed));
+            this_thread::sleep_until(start + offset);
+        }
+
+        // Arguments are prepared outside the timed region
+        string name, symptom;
+        if (record.operation == TRACE_REGISTER) {
+            name = WorkloadTrace::firstNameAt(record.firstName) + " " + WorkloadTrace::lastNameAt(record.lastName);
+            symptom = WorkloadTrace::symptomAt(record.symptom);
+        }
+
+        chrono::steady_clock::time_point before = chrono::steady_clock::now();
+        bool hit = true;
+        switch (record.operation) {
+            case TRACE_REGISTER:
+                hospital->registerPatient(name, record.age, record.priority, symptom);
+                break;
+            case TRACE_ATTEND:
+                hit = hospital->attendNextPatient() != NULL;
+                break;
+            case TRACE_FREE:
+                hit = hospital->freeConsultationRoom() != NULL;
+                break;
+            case TRACE_SEARCH:
+                hit = hospital->searchPatient(record.patientId) != NULL;
+                break;
+        }
+        chrono::steady_clock::time_point after = chrono::steady_clock::now();
+
+        latency[record.operation - 1].record((uint64_t)chrono::duration_cast<chrono::nanoseconds>(after - before).count());
+        if (!hit) {
+            misses[record.operation - 1]++;
+        }
+    }
+
+    double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    hospital.reset();
+
+    os << "\n==================================================" << endl;
+    os << "          WORKLOAD REPLAY REPORT" << endl;
+    os << "==================================================" << endl;
+    os << "Operations: " << trace.records.size() << " | Rooms: " << rooms << " | Pace: ";
+    if (speed > 0) {
+        os << "wall-clock x" << speed << endl;
+    } else {
+        os << "maximum speed" << endl;
+    }
+    os << fixed << setprecision(3) << "Elapsed: " << elapsed << " s";
+    if (elapsed > 0) {
+        os << setprecision(0) << " (" << trace.records.size() / elapsed << " ops/s)";
+    }
+    os << endl;
+
+    os << "\n=== PER-OPERATION LATENCY (microseconds) ===" << endl;
+    os << left << setw(10) << "Operation" << right << setw(10) << "Count" << setw(8) << "Misses"
+       << setw(10) << "Mean" << setw(10) << "p50" << setw(10) << "p99"
+       << setw(10) << "p99.9" << setw(10) << "Max" << endl;
+    os << setprecision(2);
+    for (int op = 0; op < TRACE_OPERATION_COUNT; op++) {
+        const Histogram& h = latency[op];
+        os << left << setw(10) << operationNames[op] << right
+           << setw(10) << h.count() << setw(8) << misses[op]
+           << setw(10) << h.mean() / 1000.0
+           << setw(10) << h.percentile(50.0) / 1000.0
+           << setw(10) << h.percentile(99.0) / 1000.0
+           << setw(10) << h.percentile(99.9) / 1000.0
+           << setw(10) << h.max() / 1000.0 << endl;
+    }
+    os << "==================================================" << endl;
+}
+
+int WorkloadReplayer::runFromCommandLine(int argc, char* argv[]) {
+    try {
+        if (argc < 1) {
+            throw invalid_argument("Usage: --replay <trace file> [--rooms N] [--speed X]");
+        }
+        string path = argv[0];
+        int rooms = 10;
+        double speed = 0.0;
+        for (int i = 1; i < argc; i += 2) {
+            string option = argv[i];
+            if (i + 1 >= argc) {
+                throw invalid_argument("Missing value for option " + option);
+            }
+            double value = parseOption(option, argv[i + 1]);
+            if (option == "--rooms") rooms = (int)value;
+            else if (option == "--speed") speed = value;
+            else throw invalid_argument("Unknown replay option: " + option);
+        }
+
+        WorkloadTrace trace;
+        trace.load(path);
+        replay(trace, rooms, speed, cout);
+        return 0;
+    }
+    catch (const exception& e) {
+        cout << "\n[ERROR!] Replay failed: " << e.what() << endl;
+        return 1;
+    }
+}
@@ -0,0 +1,154 @@
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * WORKLOAD TRACE OPERATIONS
+ * - One opcode per HospitalSystem engine operation
+ */
+enum TraceOperation {
+    TRACE_REGISTER = 1,  ///< registerPatient(name, age, priority, symptom)
+    TRACE_ATTEND = 2,    ///< attendNextPatient()
+    TRACE_FREE = 3,      ///< freeConsultationRoom()
+    TRACE_SEARCH = 4     ///< searchPatient(id)
+};
+
+const int TRACE_OPERATION_COUNT = 4;
+
+/**
+ * DECODED TRACE RECORD
+ * - Names and symptoms are indexes into the built-in synthetic tables,
+ *   which keeps the binary format compact and fully reproducible
+ */
+struct TraceRecord {
+    std::uint64_t timeMicros;  ///< Offset from trace start (simulated clock)
+    int operation;             ///< TraceOperation
+    int priority;              ///< REGISTER: triage level 1-5
+    int age;                   ///< REGISTER: age in years
+    int firstName;             ///< REGISTER: first-name table index
+    int lastName;              ///< REGISTER: last-name table index
+    int symptom;               ///< REGISTER: symptom table index
+    int consultationSeconds;   ///< REGISTER: sampled consultation duration
+    int patientId;             ///< SEARCH: target patient ID
+};
+
+/**
+ * BINARY TRACE FORMAT (little-endian)
+ *
+ * HEADER (24 bytes):
+ * - magic "HWTR", u8 version, 3 reserved bytes, u64 seed, u64 record count
+ *
+ * RECORD:
+ * - u8 opcode, varint time delta in microseconds since previous record
+ * - REGISTER: u8 priority, u8 age, u8 first name, u8 last name, u8 symptom,
+ *             varint consultation seconds
+ * - SEARCH:   varint patient ID
+ * - ATTEND / FREE: no payload
+ *
+ * Varints use 7 bits per byte (LEB128), so a typical record is 2-10 bytes.
+ */
+class WorkloadTrace {
+public:
+    static const std::uint8_t VERSION = 1;
+
+    std::uint64_t seed;                ///< Generator seed recorded in the header
+    std::vector<TraceRecord> records;  ///< Operations in time order
+
+    WorkloadTrace() : seed(0) {}
+
+    /**
+     * WRITE / READ THE BINARY FORMAT
+     * EXCEPTION: Throws runtime_error on I/O failure or malformed input
+     */
+    void save(const std::string& path) const;
+    void load(const std::string& path);
+
+    /**
+     * SYNTHETIC DATA TABLES
+     */
+    static std::string firstNameAt(int index);
+    static std::string lastNameAt(int index);
+    static std::string symptomAt(int index);
+    static int firstNameCount();
+    static int lastNameCount();
+    static int symptomCount();
+};
+
+/**
+ * WORKLOAD GENERATOR CONFIGURATION
+ *
+ * DEFAULTS:
+ * - 100000 registrations at 14 patients per hour
+ * - Triage mix 3% / 12% / 35% / 30% / 20% (skewed toward TRIAGE III-V)
+ * - 2% of arrivals trigger a burst of up to 8 extra registrations within
+ *   a few minutes (ambulance convoy, mass-casualty incident)
+ * - One search per four registrations on average
+ */
+struct WorkloadConfig {
+    std::uint64_t seed;            ///< Random seed (same seed -> identical trace)
+    int patients;                  ///< Number of registrations to generate
+    int rooms;                     ///< Consultation rooms modelled by the generator
+    double arrivalsPerHour;        ///< Base Poisson arrival rate
+    double triageMix[5];           ///< Probability of each level (TRIAGE I..V)
+    double burstProbability;       ///< Chance an arrival starts a burst
+    int maxBurstSize;              ///< Extra registrations per burst (uniform 1..max)
+    double searchesPerRegistration;///< Expected SEARCH operations per registration
+
+    WorkloadConfig();
+};
+
+/**
+ * SEEDED SYNTHETIC WORKLOAD GENERATOR
+ *
+ * MODEL: Mirrors HospitalSystem semantics with an EventCalendar
+ * - Arrivals emit REGISTER (with a sampled consultation duration)
+ * - Whenever a room is free and someone waits, an ATTEND is emitted
+ * - Consultation ends emit FREE, so replayed traces never attend into a
+ *   full department or free an empty one
+ */
+class WorkloadGenerator {
+public:
+    static void generate(const WorkloadConfig& config, WorkloadTrace& trace);
+
+    /**
+     * GENERATOR MODE ENTRY POINT
+     * @param argc/argv: "<output file> [options]" following "--generate-workload"
+     */
+    static int runFromCommandLine(int argc, char* argv[]);
+};
+
+/**
+ * TRACE REPLAY DRIVER
+ *
+ * PACING:
+ * - Maximum speed: operations are issued back to back
+ * - Wall-clock: each operation waits until its trace timestamp divided by
+ *   the speed factor (speed 60 replays one hour per minute)
+ *
+ * MEASUREMENT: Every engine call is timed with steady_clock and recorded
+ * in a per-operation HDR histogram (nanoseconds). Console output of the
+ * HospitalSystem is disabled during replay.
+ */
+class WorkloadReplayer {
+public:
+    /**
+     * REPLAY A TRACE AND PRINT THE LATENCY REPORT
+     * @param trace: Loaded trace
+     * @param rooms: Consultation rooms of the replayed HospitalSystem
+     * @param speed: Pace factor, <= 0 for maximum speed
+     * @param os: Report destination
+     */
+    static void replay(const WorkloadTrace& trace, int rooms, double speed, std::ostream& os);
+
+    /**
+     * REPLAY MODE ENTRY POINT
+     * @param argc/argv: "<trace file> [--rooms N] [--speed X]" following "--replay"
+     */
+    static int runFromCommandLine(int argc, char* argv[]);
+};
+
+#endif